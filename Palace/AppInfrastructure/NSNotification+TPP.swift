@@ -19,6 +19,9 @@ extension Notification.Name {
     static let TPPDidSignOut = Notification.Name("TPPDidSignOut")
     static let TPPIsSigningIn = Notification.Name("TPPIsSigningIn")
     static let TPPAppDelegateDidReceiveCleverRedirectURL = Notification.Name("TPPAppDelegateDidReceiveCleverRedirectURL")
+
+    /// The `userInfo` dictionary, when present, contains a `bookRegistryChangeKey`
+    /// key whose value is the `TPPBookRegistryChange` being published.
     static let TPPBookRegistryDidChange = Notification.Name("TPPBookRegistryDidChange")
     static let TPPBookRegistryStateDidChange = Notification.Name("TPPBookRegistryStateDidChange")
 
@@ -29,6 +32,8 @@ extension Notification.Name {
     /// if there's some processing going on for the book.
     static let TPPBookProcessingDidChange = Notification.Name("TPPBookProcessingDidChange")
 
+    /// The `userInfo` dictionary contains a `downloadCenterBookIdentifiersKey`
+    /// key whose value is an array of the identifiers of the downloads that changed.
     static let TPPMyBooksDownloadCenterDidChange = Notification.Name("TPPMyBooksDownloadCenterDidChange")
     static let TPPBookDetailDidClose = Notification.Name("TPPBookDetailDidClose")
     static let TPPAccountSetDidLoad = Notification.Name("TPPAccountSetDidLoad")
@@ -58,4 +63,6 @@ extension Notification.Name {
 class TPPNotificationKeys: NSObject {
     @objc public static let bookProcessingBookIDKey = "identifier"
     @objc public static let bookProcessingValueKey = "value"
+    @objc public static let bookRegistryChangeKey = "change"
+    @objc public static let downloadCenterBookIdentifiersKey = "bookIdentifiers"
 }
@@ -158,7 +158,8 @@ final class ReaderService {
                 }
             }
 
-        MyBooksDownloadCenter.shared.startDownload(for: book)
+        // The patron is waiting for this book to open.
+        MyBooksDownloadCenter.shared.startDownload(for: book, priority: .userOpen)
     }
 
     @MainActor
@@ -212,6 +212,21 @@ public class TPPBook: NSObject, ObservableObject {
         )
     }
 
+    /// `true` if `init(dictionary:)` succeeds for `dictionary`. Much cheaper than decoding the book.
+    static func canDecode(dictionary: [String: Any]) -> Bool {
+        dictionary[CategoriesKey] is [String]
+            && dictionary[IdentifierKey] is String
+            && dictionary[TitleKey] is String
+            && updatedDate(from: dictionary) != nil
+    }
+
+    /// `updated` of a persisted book. Books are written with a full RFC 3339
+    /// timestamp; date-only values are still read.
+    private static func updatedDate(from dictionary: [String: Any]) -> Date? {
+        let string = dictionary[UpdatedKey] as? String
+        return (NSDate(rfc3339String: string) ?? NSDate(iso8601DateString: string)) as Date?
+    }
+
     @objc convenience init?(dictionary: [String: Any]) {
         guard let categoryStrings = dictionary[CategoriesKey] as? [String],
               let identifier = dictionary[IdentifierKey] as? String,
@@ -253,7 +268,7 @@ public class TPPBook: NSObject, ObservableObject {
         let revokeURL = URL(string: dictionary[RevokeURLKey] as? String ?? "")
         let reportURL = URL(string: dictionary[ReportURLKey] as? String ?? "")
 
-        guard let updated = NSDate(iso8601DateString: dictionary[UpdatedKey] as? String ?? "") as? Date else { return nil }
+        guard let updated = Self.updatedDate(from: dictionary) else { return nil }
 
         self.init(
             acquisitions: acquisitions,
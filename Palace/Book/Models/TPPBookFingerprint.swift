@@ -0,0 +1,41 @@
+//
+//  TPPBookFingerprint.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Identifies the version of a loans feed entry that a registry record was built from.
+///
+/// Two fingerprints are equal if the entry has the same `updated` date and the
+/// same acquisitions, including their availability. Sync only rebuilds books
+/// whose fingerprint differs from their record's.
+struct TPPBookFingerprint: Equatable {
+    /// `updated` in whole seconds. Feed entries and persisted records both
+    /// parse it as RFC 3339, which drops fractional seconds.
+    let updated: Int64
+    /// 64-bit FNV-1a hash of the acquisitions' dictionary representations.
+    let acquisitionsHash: UInt64
+
+    init(book: TPPBook) {
+        self.init(updated: book.updated, acquisitions: book.acquisitions)
+    }
+
+    init(entry: TPPOPDSEntry) {
+        self.init(updated: entry.updated, acquisitions: entry.acquisitions)
+    }
+
+    private init(updated: Date, acquisitions: [TPPOPDSAcquisition]) {
+        self.updated = Int64(updated.timeIntervalSince1970.rounded(.down))
+
+        let representation = acquisitions.map { $0.dictionaryRepresentation() }
+        let data = (try? JSONSerialization.data(withJSONObject: representation, options: .sortedKeys)) ?? Data()
+        var hash: UInt64 = 14_695_981_039_346_656_037
+        for byte in data {
+            hash = (hash ^ UInt64(byte)) &* 1_099_511_628_211
+        }
+        self.acquisitionsHash = hash
+    }
+}
@@ -4,6 +4,7 @@ import UIKit
 
 protocol TPPBookRegistryProvider {
     var registryPublisher: AnyPublisher<[String: TPPBookRegistryRecord], Never> { get }
+    var changePublisher: AnyPublisher<TPPBookRegistryChange, Never> { get }
     var bookStatePublisher: AnyPublisher<(String, TPPBookState), Never> { get }
     var heldBooks: [TPPBook] { get }
 
@@ -111,19 +112,13 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
             }
         }
 
-    private var registry = [String: TPPBookRegistryRecord]() {
-        didSet {
-            // Capture snapshot while on sync queue to avoid concurrent read/write crash.
-            // Without this, the main thread block reads self.registry while sync queue
-            // barrier blocks may be writing to it, causing EXC_BAD_ACCESS.
-            let snapshot = registry
-            DispatchQueue.main.async { [weak self] in
-                guard let self else { return }
-                registrySubject.send(snapshot)
-                NotificationCenter.default.post(name: .TPPBookRegistryDidChange, object: nil, userInfo: nil)
-            }
-        }
-    }
+    /// Mutations must be followed by `recordChange(_:)` so that they are published.
+    private var registry = [String: TPPBookRegistryRecord]()
+
+    /// Changes not yet published. Guarded by `changeLock`.
+    private var pendingChange = TPPBookRegistryChange()
+    private var isChangePublishScheduled = false
+    private let changeLock = NSLock()
 
     private var coverRegistry = TPPBookCoverRegistry.shared
     private let syncQueue = DispatchQueue(
@@ -141,6 +136,7 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
 
     private let registrySubject = CurrentValueSubject<[String: TPPBookRegistryRecord], Never>([:])
     private let bookStateSubject = PassthroughSubject<(String, TPPBookState), Never>()
+    private let changeSubject = PassthroughSubject<TPPBookRegistryChange, Never>()
 
     var registryPublisher: AnyPublisher<[String: TPPBookRegistryRecord], Never> {
         registrySubject
@@ -152,6 +148,10 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
             .receive(on: RunLoop.main)
             .eraseToAnyPublisher()
     }
+    /// Change-sets, published on the main thread at most once per run-loop turn.
+    var changePublisher: AnyPublisher<TPPBookRegistryChange, Never> {
+        changeSubject.eraseToAnyPublisher()
+    }
 
     private var syncState = BoolWithDelay { value in
         if value {
@@ -194,12 +194,16 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
             .appendingPathComponent(registryFileName)
     }
 
+    private func store(for account: String) -> TPPBookRegistryStore? {
+        registryUrl(for: account).map { TPPBookRegistryStore.store(for: $0) }
+    }
+
     /// Tracks the account currently being loaded to prevent re-entrant loads
     private var loadingAccount: String?
 
     func load(account: String? = nil) {
         guard let account = account ?? AccountsManager.shared.currentAccountId,
-              let url     = registryUrl(for: account)
+              let store   = store(for: account)
         else { return }
 
         // Prevent re-entrant loads for the same account
@@ -220,53 +224,46 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
             guard let self = self else { return }
 
             var newRegistry = [String: TPPBookRegistryRecord]()
-            if FileManager.default.fileExists(atPath: url.path),
-               let data     = try? Data(contentsOf: url),
-               let json     = try? JSONSerialization.jsonObject(with: data) as? TPPBookRegistryData,
-               let records  = json.array(for: .records) {
+            let records = store.load()
+            if !records.isEmpty {
 
                 Log.debug(#file, "  Found \(records.count) books in registry")
 
-                for obj in records {
+                for obj in records.values {
+                    // Only the record index is decoded here. Books, locations and bookmarks
+                    // are decoded on first access or by `decodeLoadedRecords(account:)`.
                     guard var record = TPPBookRegistryRecord(record: obj) else { continue }
                     let originalState = record.state
 
-                    // Validate file existence for download states
-                    if record.state == .downloading || record.state == .SAMLStarted || record.state == .downloadSuccessful {
+                    // Validate file existence for interrupted downloads. Downloaded books
+                    // are verified after the registry is published.
+                    if record.state == .downloading || record.state == .SAMLStarted {
                         let fileExists = self.checkIfBookFileExists(for: record.book, account: account)
 
                         if record.state == .downloading {
                             if fileExists {
-                                Log.info(#file, "  ✅ '\(record.book.title)' was downloading but file exists - marking as successful")
+                                Log.info(#file, "  ✅ '\(record.title)' was downloading but file exists - marking as successful")
                                 record.state = .downloadSuccessful
                             } else {
-                                Log.warn(#file, "  ⚠️ '\(record.book.title)' was downloading but file missing - marking as failed")
+                                Log.warn(#file, "  ⚠️ '\(record.title)' was downloading but file missing - marking as failed")
                                 record.state = .downloadFailed
                             }
                         } else if record.state == .SAMLStarted {
                             if fileExists {
-                                Log.info(#file, "  ✅ '\(record.book.title)' was in SAML flow but file exists - marking as download needed")
+                                Log.info(#file, "  ✅ '\(record.title)' was in SAML flow but file exists - marking as download needed")
                                 record.state = .downloadNeeded
                             } else {
-                                Log.warn(#file, "  ⚠️ '\(record.book.title)' was in SAML flow but file missing - marking as failed")
+                                Log.warn(#file, "  ⚠️ '\(record.title)' was in SAML flow but file missing - marking as failed")
                                 record.state = .downloadFailed
                             }
-                        } else if record.state == .downloadSuccessful {
-                            if !fileExists {
-                                Log.error(#file, "  ❌ '\(record.book.title)' marked as downloaded but FILE MISSING - marking as download needed")
-                                Log.error(#file, "     This suggests the file was deleted or the path is wrong")
-                                record.state = .downloadNeeded
-                            } else {
-                                Log.debug(#file, "  ✓ '\(record.book.title)' downloaded and file verified")
-                            }
                         }
 
                         if originalState != record.state {
-                            Log.info(#file, "  🔄 State changed for '\(record.book.title)': \(originalState) → \(record.state)")
+                            Log.info(#file, "  🔄 State changed for '\(record.title)': \(originalState) → \(record.state)")
                         }
                     }
 
-                    newRegistry[record.book.identifier] = record
+                    newRegistry[record.identifier] = record
                 }
             } else {
                 Log.info(#file, "  No existing registry file found or failed to parse")
@@ -274,10 +271,9 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
 
             self.registry = newRegistry
 
-            // Capture states and snapshot while on sync queue to avoid concurrent access
+            // Capture states while on sync queue to avoid concurrent access
             let bookStates = newRegistry.map { ($0.key, $0.value.state) }
-            let snapshot = self.registry
-            let bookCount = snapshot.count
+            let bookCount = newRegistry.count
             // Capture account to clear loading state
             let loadedAccount = account
 
@@ -290,7 +286,6 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
                 }
 
                 self.state = .loaded
-                self.registrySubject.send(snapshot)
 
                 // Emit state events for ALL loaded books so ViewModels update their state
                 // This ensures any cached models or views created before load get the correct state
@@ -298,9 +293,51 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
                     self.bookStateSubject.send((identifier, state))
                 }
 
-                NotificationCenter.default.post(name: .TPPBookRegistryDidChange, object: nil)
                 Log.info(#file, "  📖 Registry loaded with \(bookCount) books")
             }
+            // Published after the block above, so observers see `state == .loaded`
+            self.recordChange { $0.isReload = true }
+
+            self.decodeLoadedRecords(account: account)
+        }
+    }
+
+    /// Decodes the books of a freshly loaded registry in the background, off the
+    /// launch path, and verifies that downloaded books still have their files.
+    private func decodeLoadedRecords(account: String) {
+        DispatchQueue.global(qos: .utility).async { [weak self] in
+            guard let self else { return }
+
+            let records = self.performSync { self.registry }
+            // Each record guards its own decoding, so books can be decoded concurrently.
+            _ = Array(records.values).concurrentMap { $0.book }
+
+            let missingFiles = records.filter { _, record in
+                record.state == .downloadSuccessful && !self.checkIfBookFileExists(for: record.book, account: account)
+            }
+            guard !missingFiles.isEmpty else { return }
+
+            self.syncQueue.async(flags: .barrier) {
+                var changedIdentifiers = Set<String>()
+                for (identifier, record) in missingFiles {
+                    // Skip records replaced since, e.g. by loading another account.
+                    guard self.registry[identifier] === record, record.state == .downloadSuccessful else { continue }
+                    Log.error(#file, "  ❌ '\(record.title)' marked as downloaded but FILE MISSING - marking as download needed")
+                    Log.error(#file, "     This suggests the file was deleted or the path is wrong")
+                    record.state = .downloadNeeded
+                    changedIdentifiers.insert(identifier)
+                }
+                guard !changedIdentifiers.isEmpty else { return }
+
+                self.save(changedIdentifiers)
+                self.recordChange { $0.stateChanged.formUnion(changedIdentifiers) }
+                DispatchQueue.main.async {
+                    for identifier in changedIdentifiers {
+                        self.bookStateSubject.send((identifier, .downloadNeeded))
+                        self.postStateNotification(bookIdentifier: identifier, state: .downloadNeeded)
+                    }
+                }
+            }
         }
     }
 
@@ -342,7 +379,7 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
     func validateDownloadedContent() {
         guard let account = AccountsManager.shared.currentAccount?.uuid else { return }
 
-        var didChange = false
+        var changedIdentifiers = Set<String>()
         syncQueue.sync {
             for (identifier, record) in self.registry {
                 guard record.state == .downloadSuccessful || record.state == .used else { continue }
@@ -350,15 +387,13 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
                 if !fileExists {
                     Log.warn(#file, "Post-update validation: '\(record.book.title)' file missing — marking as downloadNeeded")
                     self.registry[identifier]?.state = .downloadNeeded
-                    didChange = true
+                    changedIdentifiers.insert(identifier)
                 }
             }
         }
-        if didChange {
-            save()
-            DispatchQueue.main.async {
-                NotificationCenter.default.post(name: .TPPBookRegistryDidChange, object: nil)
-            }
+        if !changedIdentifiers.isEmpty {
+            save(changedIdentifiers)
+            recordChange { $0.stateChanged.formUnion(changedIdentifiers) }
         }
     }
 
@@ -367,14 +402,9 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
         syncUrl = nil
         syncQueue.async(flags: .barrier) {
             self.registry.removeAll()
+            self.recordChange { $0.isReload = true }
         }
-        if let registryUrl = registryUrl(for: account) {
-            do {
-                try FileManager.default.removeItem(at: registryUrl)
-            } catch {
-                Log.error(#file, "Error deleting registry data: \(error.localizedDescription)")
-            }
-        }
+        store(for: account)?.removeAll()
     }
 
     func sync(completion: ((_ errorDocument: [AnyHashable: Any]?, _ newBooks: Bool) -> Void)? = nil) {
@@ -384,14 +414,65 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
             return
         }
 
+        // Validators only describe the feed if the registry holds the records built from it.
+        let isRegistryLoaded = state == .loaded || state == .synced
         state = .syncing
         syncUrl = loansUrl
 
-        TPPOPDSFeed.withURL(loansUrl, shouldResetCache: true, useTokenIfAvailable: true) { [weak self] feed, errorDocument in
+        let store = currentStore()
+        let validators = isRegistryLoaded
+            ? store?.loadSyncValidators().flatMap { $0.url == loansUrl ? $0 : nil }
+            : nil
+        let knownRecords = performSync { registry }
+
+        // Only entries whose fingerprint differs from their record are built into
+        // books, while the rest of the loans feed is still downloading. The entry
+        // handler and the completion handler for a parsed feed are called serially,
+        // so these need no lock; they must not be read when the request failed.
+        var feedIdentifiers = Set<String>()
+        var changedBooks = [TPPBook]()
+        var streamedEntryCount = 0
+
+        func collect(_ entry: TPPOPDSEntry) {
+            if let record = knownRecords[entry.identifier],
+               record.state != .unregistered,
+               TPPBookFingerprint(entry: entry) == TPPBookFingerprint(book: record.book) {
+                feedIdentifiers.insert(entry.identifier)
+            } else if let book = TPPBook(entry: entry) {
+                feedIdentifiers.insert(book.identifier)
+                changedBooks.append(book)
+            }
+        }
+
+        TPPOPDSFeed.withURL(
+            loansUrl,
+            shouldResetCache: true,
+            useTokenIfAvailable: true,
+            requestHeaders: validators?.requestHeaders,
+            entryHandler: { entry in
+                streamedEntryCount += 1
+                collect(entry)
+            }
+        ) { [weak self] feed, errorDocument, response in
+            if let feed = feed, streamedEntryCount != feed.entries.count {
+                // Entries aren't streamed when the response is a single entry
+                feedIdentifiers.removeAll()
+                changedBooks.removeAll()
+                (feed.entries as? [TPPOPDSEntry] ?? []).forEach(collect)
+            }
+
             DispatchQueue.main.async { [weak self] in
                 guard let self = self else { return }
                 if self.syncUrl != loansUrl { return }
 
+                if feed == nil, errorDocument == nil, response?.isNotModified() == true {
+                    Log.debug(#file, "Loans feed not modified since last sync")
+                    self.state = .synced
+                    self.syncUrl = nil
+                    completion?(nil, false)
+                    return
+                }
+
                 if let errorDocument = errorDocument {
                     self.state = .loaded
                     self.syncUrl = nil
@@ -407,18 +488,15 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
                 }
 
                 var changesMade = false
+                var isFeedApplied = true
                 // Use barrier to get exclusive write access. updateBook() uses
                 // syncQueue.async(flags: .barrier) internally, which would defer
                 // writes until AFTER this block — causing save() to persist stale data.
                 // Inline the update logic here so save() captures current state.
                 self.syncQueue.sync(flags: .barrier) {
-                    var recordsToDelete = Set<String>(self.registry.keys)
-                    for entry in feed.entries {
-                        guard let opdsEntry = entry as? TPPOPDSEntry,
-                              let book = TPPBook(entry: opdsEntry)
-                        else { continue }
-                        recordsToDelete.remove(book.identifier)
-
+                    var change = TPPBookRegistryChange()
+                    var savedIdentifiers = Set<String>()
+                    for book in changedBooks {
                         if let record = self.registry[book.identifier] {
                             var nextState = record.state
                             if record.state == .unregistered {
@@ -437,13 +515,24 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
                                 readiumBookmarks: record.readiumBookmarks,
                                 genericBookmarks: record.genericBookmarks
                             )
-                            changesMade = true
+                            change.updated.insert(book.identifier)
+                            if nextState != record.state {
+                                change.stateChanged.insert(book.identifier)
+                            }
                         } else {
-                            let initialState = TPPBookRegistryRecord.deriveInitialState(for: book)
-                            self.registry[book.identifier] = TPPBookRegistryRecord(
-                                book: book,
-                                state: initialState
-                            )
+                            self.addSyncedBook(book, to: &change)
+                        }
+                        savedIdentifiers.insert(book.identifier)
+                        changesMade = true
+                    }
+
+                    // Unchanged entries whose records were removed while the feed was loading.
+                    let missingIdentifiers = feedIdentifiers.filter { self.registry[$0] == nil }
+                    if !missingIdentifiers.isEmpty {
+                        for entry in feed.entries as? [TPPOPDSEntry] ?? [] where missingIdentifiers.contains(entry.identifier) {
+                            guard let book = TPPBook(entry: entry) else { continue }
+                            self.addSyncedBook(book, to: &change)
+                            savedIdentifiers.insert(book.identifier)
                             changesMade = true
                         }
                     }
@@ -453,6 +542,7 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
                     // locally, it likely indicates a partial/truncated server response rather
                     // than all books being legitimately expired. In that case, skip deletion
                     // to avoid wiping downloaded content from a transient server issue.
+                    let recordsToDelete = Set(self.registry.keys).subtracting(feedIdentifiers)
                     let localCount = self.registry.count
                     let feedCount = feed.entries.count
                     let deletionCount = recordsToDelete.count
@@ -468,6 +558,7 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
 
                     if shouldSkipBulkDeletion {
                         Log.error(#file, "🛡️ Sync returned EMPTY feed but \(localCount) local books exist — skipping deletion (possible server issue)")
+                        isFeedApplied = false
                     } else if shouldWarnLargeDeletion {
                         Log.warn(#file, "⚠️ Sync would remove \(deletionCount)/\(localCount) books (\(Int(deletionRatio * 100))%) — proceeding but logging for investigation")
                     }
@@ -488,9 +579,16 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
                             changesMade = true
                         }
                     }
-                    self.save()
+                    self.save(savedIdentifiers)
+                    self.recordChange { $0.merge(change) }
                 }
 
+                // Saved after the records, so validators never describe a feed the
+                // records on disk don't reflect yet.
+                store?.saveSyncValidators(isFeedApplied
+                    ? response.flatMap { TPPBookRegistryStore.SyncValidators(url: loansUrl, response: $0) }
+                    : nil)
+
                 self.state = .synced
                 self.syncUrl = nil
                 completion?(nil, changesMade)
@@ -498,56 +596,95 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
         }
     }
 
-    private func save() {
-        guard let account = AccountsManager.shared.currentAccount?.uuid,
-              let registryUrl = registryUrl(for: account)
-        else { return }
+    /// Adds a book that first appeared in the loans feed. Must be called on `syncQueue` with a barrier.
+    private func addSyncedBook(_ book: TPPBook, to change: inout TPPBookRegistryChange) {
+        let initialState = TPPBookRegistryRecord.deriveInitialState(for: book)
+        registry[book.identifier] = TPPBookRegistryRecord(
+            book: book,
+            state: initialState
+        )
+        change.inserted.insert(book.identifier)
+    }
 
-        let snapshot: [[String: Any]] = performSync {
-            self.registry.values.map { $0.dictionaryRepresentation }
-        }
-        let registryObject = [TPPBookRegistryKey.records.rawValue: snapshot]
+    /// Persists the records for `identifiers`. Identifiers that are no longer
+    /// in the registry are removed from the persistent store.
+    private func save(_ identifiers: Set<String>) {
+        guard !identifiers.isEmpty, let store = currentStore() else { return }
 
-        DispatchQueue.global(qos: .utility).async {
-            do {
-                let directoryURL = registryUrl.deletingLastPathComponent()
-                if !FileManager.default.fileExists(atPath: directoryURL.path) {
-                    try FileManager.default.createDirectory(at: directoryURL, withIntermediateDirectories: true)
-                }
-                let registryData = try JSONSerialization.data(withJSONObject: registryObject, options: .fragmentsAllowed)
-                try registryData.write(to: registryUrl, options: .atomic)
-                DispatchQueue.main.async {
-                    NotificationCenter.default.post(name: .TPPBookRegistryDidChange, object: nil, userInfo: nil)
-                }
-            } catch {
-                Log.error(#file, "Error saving book registry: \(error.localizedDescription)")
-            }
+        store.write(persistentRecords(for: identifiers))
+    }
+
+    private func save(_ identifier: String) {
+        save([identifier])
+    }
+
+    /// Persists the records for `identifiers` (all records if `nil`) and waits until they are on disk.
+    func saveSync(_ identifiers: Set<String>? = nil) {
+        guard let store = currentStore() else { return }
+
+        let identifiers = identifiers ?? performSync { Set(self.registry.keys) }
+        guard !identifiers.isEmpty else { return }
+        if store.writeSync(persistentRecords(for: identifiers)) == nil {
+            Log.debug(#file, "🔒 Synchronously saved registry to disk")
         }
     }
 
-    func saveSync() {
-        guard let account = AccountsManager.shared.currentAccount?.uuid,
-              let registryUrl = registryUrl(for: account)
-        else { return }
+    private func currentStore() -> TPPBookRegistryStore? {
+        guard let account = AccountsManager.shared.currentAccount?.uuid else { return nil }
+        return store(for: account)
+    }
 
-        let snapshot: [[String: Any]] = performSync {
-            self.registry.values.map { $0.dictionaryRepresentation }
+    private func persistentRecords(for identifiers: Set<String>) -> [String: TPPBookRegistryStore.Record?] {
+        performSync {
+            Dictionary(uniqueKeysWithValues: identifiers.map { ($0, self.registry[$0]?.dictionaryRepresentation) })
         }
-        let registryObject = [TPPBookRegistryKey.records.rawValue: snapshot]
+    }
 
-        do {
-            let directoryURL = registryUrl.deletingLastPathComponent()
-            if !FileManager.default.fileExists(atPath: directoryURL.path) {
-                try FileManager.default.createDirectory(at: directoryURL, withIntermediateDirectories: true)
+    /// Adds to the pending change-set and schedules it to be published on the
+    /// main thread. Changes recorded before the registry is snapshotted are
+    /// published together.
+    private func recordChange(_ update: (inout TPPBookRegistryChange) -> Void) {
+        changeLock.lock()
+        update(&pendingChange)
+        let shouldSchedule = !isChangePublishScheduled
+        isChangePublishScheduled = true
+        changeLock.unlock()
+
+        if shouldSchedule {
+            // Runs after the barrier that recorded the change, so the snapshot includes it;
+            // main only receives the snapshot instead of waiting on `syncQueue`.
+            syncQueue.async { [weak self] in
+                guard let self else { return }
+                let snapshot = self.registry
+                let change = self.takePendingChange()
+                DispatchQueue.main.async { [weak self] in
+                    self?.publish(change, snapshot: snapshot)
+                }
             }
-            let registryData = try JSONSerialization.data(withJSONObject: registryObject, options: .fragmentsAllowed)
-            try registryData.write(to: registryUrl, options: .atomic)
-            Log.debug(#file, "🔒 Synchronously saved registry to disk")
-        } catch {
-            Log.error(#file, "Error saving book registry synchronously: \(error.localizedDescription)")
         }
     }
 
+    /// Takes the pending change-set; changes recorded afterwards schedule a new publish.
+    private func takePendingChange() -> TPPBookRegistryChange {
+        changeLock.lock()
+        defer { changeLock.unlock() }
+        let change = pendingChange
+        pendingChange = TPPBookRegistryChange()
+        isChangePublishScheduled = false
+        return change
+    }
+
+    private func publish(_ change: TPPBookRegistryChange, snapshot: [String: TPPBookRegistryRecord]) {
+        guard !change.isEmpty else { return }
+        registrySubject.send(snapshot)
+        changeSubject.send(change)
+        NotificationCenter.default.post(
+            name: .TPPBookRegistryDidChange,
+            object: nil,
+            userInfo: [TPPNotificationKeys.bookRegistryChangeKey: change]
+        )
+    }
+
     func load() { load(account: nil) }
     func sync() { sync(completion: nil) }
 
@@ -603,6 +740,7 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
 
         syncQueue.async(flags: .barrier) { [weak self] in
             guard let self else { return }
+            let previousRecord = self.registry[book.identifier]
             self.registry[book.identifier] = TPPBookRegistryRecord(
                 book: book,
                 location: location,
@@ -611,10 +749,19 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
                 readiumBookmarks: readiumBookmarks,
                 genericBookmarks: genericBookmarks
             )
-            self.save()
-            let snapshot = self.registry
+            self.save(book.identifier)
+            self.recordChange {
+                if let previousRecord {
+                    $0.updated.insert(book.identifier)
+                    $0.locationChanged.insert(book.identifier)
+                    if previousRecord.state != state {
+                        $0.stateChanged.insert(book.identifier)
+                    }
+                } else {
+                    $0.inserted.insert(book.identifier)
+                }
+            }
             DispatchQueue.main.async {
-                self.registrySubject.send(snapshot)
                 // CRITICAL: Also publish state change so ViewModels receive it
                 self.bookStateSubject.send((book.identifier, state))
                 // Also post notification for views using legacy observation
@@ -630,11 +777,13 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
             guard let self, let record = self.registry[book.identifier] else { return }
             record.book = book
             record.state = .unregistered
-            self.save()
+            self.save(book.identifier)
+            self.recordChange {
+                $0.updated.insert(book.identifier)
+                $0.stateChanged.insert(book.identifier)
+            }
 
-            let snapshot = self.registry
             DispatchQueue.main.async {
-                self.registrySubject.send(snapshot)
                 self.bookStateSubject.send((book.identifier, .unregistered))
                 self.postStateNotification(bookIdentifier: book.identifier, state: .unregistered)
             }
@@ -655,11 +804,11 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
             Log.info(#file, "📚 REMOVING BOOK from registry: \(bookIdentifier)")
             Log.info(#file, "📚 Book had \(bookmarksCount) generic bookmarks and \(readiumBookmarksCount) readium bookmarks that will be deleted")
 
-            self.registry.removeValue(forKey: bookIdentifier)
-            self.save()
-            let snapshot = self.registry
+            if self.registry.removeValue(forKey: bookIdentifier) != nil {
+                self.recordChange { $0.removed.insert(bookIdentifier) }
+            }
+            self.save(bookIdentifier)
             DispatchQueue.main.async {
-                self.registrySubject.send(snapshot)
                 // Publish state change for removed book
                 self.bookStateSubject.send((bookIdentifier, .unregistered))
                 self.postStateNotification(bookIdentifier: bookIdentifier, state: .unregistered)
@@ -695,11 +844,15 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
                 readiumBookmarks: record.readiumBookmarks,
                 genericBookmarks: record.genericBookmarks
             )
-            self.save()
+            self.save(book.identifier)
+            self.recordChange {
+                $0.updated.insert(book.identifier)
+                if nextState != previousState {
+                    $0.stateChanged.insert(book.identifier)
+                }
+            }
 
-            let snapshot = self.registry
             DispatchQueue.main.async {
-                self.registrySubject.send(snapshot)
                 // Publish state change if it changed
                 if nextState != previousState {
                     self.bookStateSubject.send((book.identifier, nextState))
@@ -714,7 +867,8 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
             guard let bookRecord = self.registry[book.identifier] else { return nil }
             let updatedBook = bookRecord.book.bookWithMetadata(from: book)
             self.registry[book.identifier]?.book = updatedBook
-            self.save()
+            self.save(book.identifier)
+            self.recordChange { $0.updated.insert(book.identifier) }
             return updatedBook
         }
     }
@@ -741,7 +895,10 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
 
             self.registry[bookIdentifier]?.state = state
             self.postStateNotification(bookIdentifier: bookIdentifier, state: state)
-            self.save()
+            self.save(bookIdentifier)
+            if previousState != nil {
+                self.recordChange { $0.stateChanged.insert(bookIdentifier) }
+            }
 
             DispatchQueue.main.async {
                 self.bookStateSubject.send((bookIdentifier, state))
@@ -775,7 +932,8 @@ class TPPBookRegistry: NSObject, TPPBookRegistrySyncing {
             guard let self else { return }
 
             self.registry[bookIdentifier]?.fulfillmentId = fulfillmentId
-            self.save()
+            self.save(bookIdentifier)
+            self.recordChange { $0.updated.insert(bookIdentifier) }
         }
     }
 
@@ -871,7 +1029,8 @@ extension TPPBookRegistry: TPPBookRegistryProvider {
             guard let self else { return }
 
             self.registry[bookIdentifier]?.location = location
-            self.save()
+            self.save(bookIdentifier)
+            self.recordChange { $0.locationChanged.insert(bookIdentifier) }
         }
     }
 
@@ -891,7 +1050,8 @@ extension TPPBookRegistry: TPPBookRegistryProvider {
                 Log.debug(#file, "🔒 Synchronously set location for \(bookIdentifier)")
             }
         }
-        saveSync()
+        saveSync([bookIdentifier])
+        recordChange { $0.locationChanged.insert(bookIdentifier) }
     }
 
     func location(forIdentifier bookIdentifier: String) -> TPPBookLocation? {
@@ -916,7 +1076,8 @@ extension TPPBookRegistry: TPPBookRegistryProvider {
                 self.registry[bookIdentifier]?.readiumBookmarks = [TPPReadiumBookmark]()
             }
             self.registry[bookIdentifier]?.readiumBookmarks?.append(bookmark)
-            self.save()
+            self.save(bookIdentifier)
+            self.recordChange { $0.updated.insert(bookIdentifier) }
         }
     }
 
@@ -925,7 +1086,8 @@ extension TPPBookRegistry: TPPBookRegistryProvider {
             guard let self else { return }
 
             self.registry[bookIdentifier]?.readiumBookmarks?.removeAll { $0 == bookmark }
-            self.save()
+            self.save(bookIdentifier)
+            self.recordChange { $0.updated.insert(bookIdentifier) }
         }
     }
 
@@ -935,7 +1097,8 @@ extension TPPBookRegistry: TPPBookRegistryProvider {
 
             self.registry[bookIdentifier]?.readiumBookmarks?.removeAll { $0 == oldBookmark }
             self.registry[bookIdentifier]?.readiumBookmarks?.append(newBookmark)
-            self.save()
+            self.save(bookIdentifier)
+            self.recordChange { $0.updated.insert(bookIdentifier) }
         }
     }
 
@@ -957,7 +1120,8 @@ extension TPPBookRegistry: TPPBookRegistryProvider {
             }
             self.deleteGenericBookmark(location, forIdentifier: bookIdentifier)
             self.addGenericBookmark(location, forIdentifier: bookIdentifier)
-            self.save()
+            self.save(bookIdentifier)
+            self.recordChange { $0.updated.insert(bookIdentifier) }
         }
     }
 
@@ -976,7 +1140,8 @@ extension TPPBookRegistry: TPPBookRegistryProvider {
             self.registry[bookIdentifier]?.genericBookmarks?.append(location)
             let count = self.registry[bookIdentifier]?.genericBookmarks?.count ?? 0
             Log.info(#file, "💾 REGISTRY: Added generic bookmark for \(bookIdentifier), total count now: \(count)")
-            self.save()
+            self.save(bookIdentifier)
+            self.recordChange { $0.updated.insert(bookIdentifier) }
         }
     }
 
@@ -1002,7 +1167,8 @@ extension TPPBookRegistry: TPPBookRegistryProvider {
 
                 if deleted > 0 {
                     Log.info(#file, "💾 REGISTRY: Deleted \(deleted) bookmark(s) by annotationId for \(bookIdentifier), remaining: \(afterCount)")
-                    self.save()
+                    self.save(bookIdentifier)
+                    self.recordChange { $0.updated.insert(bookIdentifier) }
                     return
                 } else {
                     Log.warn(#file, "💾 REGISTRY: No match by annotationId '\(annotationId)', trying content match")
@@ -1014,7 +1180,8 @@ extension TPPBookRegistry: TPPBookRegistryProvider {
             let afterCount = self.registry[bookIdentifier]?.genericBookmarks?.count ?? 0
             let deleted = beforeCount - afterCount
             Log.info(#file, "💾 REGISTRY: Deleted \(deleted) bookmark(s) by content for \(bookIdentifier), remaining: \(afterCount)")
-            self.save()
+            self.save(bookIdentifier)
+            self.recordChange { $0.updated.insert(bookIdentifier) }
         }
     }
 
@@ -0,0 +1,69 @@
+//
+//  TPPBookRegistryChange.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Identifiers of the registry records changed since the last published change-set.
+///
+/// `TPPBookRegistry` collects changes as records are mutated and publishes them
+/// in one change-set per main run-loop turn, so a sync that touches hundreds of
+/// records results in a single update.
+struct TPPBookRegistryChange: Equatable {
+    /// Books added to the registry.
+    var inserted = Set<String>()
+    /// Books removed from the registry.
+    var removed = Set<String>()
+    /// Books whose `TPPBookState` changed.
+    var stateChanged = Set<String>()
+    /// Books whose reading location changed.
+    var locationChanged = Set<String>()
+    /// Books whose metadata, fulfillment ID or bookmarks changed.
+    var updated = Set<String>()
+    /// The whole registry was replaced, e.g. loaded for another account or reset.
+    var isReload = false
+
+    var isEmpty: Bool {
+        !isReload && inserted.isEmpty && removed.isEmpty && stateChanged.isEmpty
+            && locationChanged.isEmpty && updated.isEmpty
+    }
+
+    /// `true` if only reading locations changed. Book lists don't depend on
+    /// locations, so they don't need to reload for these changes.
+    var isLocationOnly: Bool {
+        !isReload && !locationChanged.isEmpty && inserted.isEmpty && removed.isEmpty
+            && stateChanged.isEmpty && updated.isEmpty
+    }
+
+    /// All identifiers mentioned in this change-set.
+    var identifiers: Set<String> {
+        inserted.union(removed).union(stateChanged).union(locationChanged).union(updated)
+    }
+
+    /// `true` if this change-set may affect the book with `identifier`.
+    func affects(_ identifier: String) -> Bool {
+        isReload || identifiers.contains(identifier)
+    }
+
+    /// Adds `other`, which happened after this change-set.
+    mutating func merge(_ other: TPPBookRegistryChange) {
+        inserted.subtract(other.removed)
+        removed.subtract(other.inserted)
+        inserted.formUnion(other.inserted)
+        removed.formUnion(other.removed)
+        stateChanged.formUnion(other.stateChanged)
+        locationChanged.formUnion(other.locationChanged)
+        updated.formUnion(other.updated)
+        isReload = isReload || other.isReload
+    }
+}
+
+extension Notification {
+    /// The change-set carried by a `.TPPBookRegistryDidChange` notification, if any.
+    var bookRegistryChange: TPPBookRegistryChange? {
+        userInfo?[TPPNotificationKeys.bookRegistryChangeKey] as? TPPBookRegistryChange
+    }
+}
@@ -9,14 +9,126 @@
 import Foundation
 
 /// An element of `TPPBookRegistry`
+///
+/// Records read from the registry file keep the book, location and bookmark
+/// payloads undecoded until they are first accessed, so loading the registry
+/// only costs an index of identifiers and states. Decoding is thread-safe.
 @objcMembers
 class TPPBookRegistryRecord: NSObject {
-    var book: TPPBook
-    var location: TPPBookLocation?
     var state: TPPBookState
     var fulfillmentId: String?
-    var readiumBookmarks: [TPPReadiumBookmark]?
-    var genericBookmarks: [TPPBookLocation]?
+
+    /// Identifier of `book`, available without decoding it.
+    private(set) var identifier: String
+
+    private let decodingLock = NSLock()
+    private var decodedBook: TPPBook?
+    private var decodedLocation: TPPBookLocation?
+    private var decodedReadiumBookmarks: [TPPReadiumBookmark]?
+    private var decodedGenericBookmarks: [TPPBookLocation]?
+    // Payloads from the registry file, cleared once decoded or replaced.
+    private var encodedBook: [String: Any]?
+    private var encodedLocation: [String: Any]?
+    private var encodedReadiumBookmarks: [[String: Any]]?
+    private var encodedGenericBookmarks: [[String: Any]]?
+
+    var book: TPPBook {
+        get {
+            decodingLock.lock()
+            defer { decodingLock.unlock() }
+            if let encodedBook {
+                // `init?(record:)` checks that the payload decodes.
+                decodedBook = TPPBook(dictionary: encodedBook)
+                self.encodedBook = nil
+            }
+            return decodedBook!
+        }
+        set {
+            decodingLock.lock()
+            defer { decodingLock.unlock() }
+            decodedBook = newValue
+            encodedBook = nil
+            identifier = newValue.identifier
+        }
+    }
+
+    var location: TPPBookLocation? {
+        get {
+            decodingLock.lock()
+            defer { decodingLock.unlock() }
+            if let encodedLocation {
+                decodedLocation = TPPBookLocation(dictionary: encodedLocation)
+                self.encodedLocation = nil
+            }
+            return decodedLocation
+        }
+        set {
+            decodingLock.lock()
+            defer { decodingLock.unlock() }
+            decodedLocation = newValue
+            encodedLocation = nil
+        }
+    }
+
+    var readiumBookmarks: [TPPReadiumBookmark]? {
+        get {
+            decodingLock.lock()
+            defer { decodingLock.unlock() }
+            if let encodedReadiumBookmarks {
+                decodedReadiumBookmarks = encodedReadiumBookmarks.compactMap { TPPReadiumBookmark(dictionary: $0 as NSDictionary) }
+                self.encodedReadiumBookmarks = nil
+            }
+            return decodedReadiumBookmarks
+        }
+        set {
+            decodingLock.lock()
+            defer { decodingLock.unlock() }
+            decodedReadiumBookmarks = newValue
+            encodedReadiumBookmarks = nil
+        }
+    }
+
+    var genericBookmarks: [TPPBookLocation]? {
+        get {
+            decodingLock.lock()
+            defer { decodingLock.unlock() }
+            if let encodedGenericBookmarks {
+                decodedGenericBookmarks = encodedGenericBookmarks.compactMap { TPPBookLocation(dictionary: $0) }
+                self.encodedGenericBookmarks = nil
+            }
+            return decodedGenericBookmarks
+        }
+        set {
+            decodingLock.lock()
+            defer { decodingLock.unlock() }
+            decodedGenericBookmarks = newValue
+            encodedGenericBookmarks = nil
+        }
+    }
+
+    /// Book title, available without decoding the book.
+    var title: String {
+        decodingLock.lock()
+        defer { decodingLock.unlock() }
+        return decodedBook?.title ?? encodedBook?[TitleKey] as? String ?? ""
+    }
+
+    /// Book thumbnail URL, available without decoding the book.
+    var imageThumbnailURL: URL? {
+        decodingLock.lock()
+        defer { decodingLock.unlock() }
+        if let decodedBook {
+            return decodedBook.imageThumbnailURL
+        }
+        return (encodedBook?[ImageThumbnailURLKey] as? String).flatMap { URL(string: $0) }
+    }
+
+    /// `true` until `book` is first accessed on a record read from the registry file.
+    var isBookEncoded: Bool {
+        decodingLock.lock()
+        defer { decodingLock.unlock() }
+        return encodedBook != nil
+    }
 
     /// Creates a registry record with the specified state.
     ///
@@ -31,11 +143,12 @@ class TPPBookRegistryRecord: NSObject {
     ///   - readiumBookmarks: Readium-format bookmarks
     ///   - genericBookmarks: Generic location bookmarks
     init(book: TPPBook, location: TPPBookLocation? = nil, state: TPPBookState, fulfillmentId: String? = nil, readiumBookmarks: [TPPReadiumBookmark]? = [], genericBookmarks: [TPPBookLocation]? = []) {
-        self.book = book
-        self.location = location
+        self.identifier = book.identifier
+        self.decodedBook = book
+        self.decodedLocation = location
         self.fulfillmentId = fulfillmentId
-        self.readiumBookmarks = readiumBookmarks
-        self.genericBookmarks = genericBookmarks
+        self.decodedReadiumBookmarks = readiumBookmarks
+        self.decodedGenericBookmarks = genericBookmarks
 
         // Preserve the passed state - do NOT override based on availability
         // The caller is responsible for determining the correct state
@@ -72,37 +185,45 @@ class TPPBookRegistryRecord: NSObject {
         return derivedState
     }
 
+    /// Creates a record from its registry file representation. Only the
+    /// identifier and state are read here; see `TPPBookRegistryRecord`.
     init?(record: TPPBookRegistryData) {
         guard let bookObject = record.object(for: .book),
-              let book = TPPBook(dictionary: bookObject),
+              TPPBook.canDecode(dictionary: bookObject),
+              let identifier = bookObject[IdentifierKey] as? String,
               let stateString = record.value(for: .state) as? String,
               let state = TPPBookState(stateString)
 
         else {
             return nil
         }
-        self.book = book
+        self.identifier = identifier
+        self.encodedBook = bookObject
         self.state = state
         self.fulfillmentId = record.value(for: .fulfillmentId) as? String
-        if let location = record.object(for: .location) {
-            self.location = TPPBookLocation(dictionary: location)
-        }
-        if let recordReadiumBookmarks = record.array(for: .readiumBookmarks) {
-            self.readiumBookmarks = recordReadiumBookmarks.compactMap { TPPReadiumBookmark(dictionary: $0 as NSDictionary) }
-        }
-        if let recordGenericBookmarks = record.array(for: .genericBookmarks) {
-            self.genericBookmarks = recordGenericBookmarks.compactMap { TPPBookLocation(dictionary: $0) }
-        }
+        self.encodedLocation = record.object(for: .location)
+        self.encodedReadiumBookmarks = record.array(for: .readiumBookmarks)
+        self.encodedGenericBookmarks = record.array(for: .genericBookmarks)
     }
 
     var dictionaryRepresentation: [String: Any] {
+        decodingLock.lock()
+        defer { decodingLock.unlock() }
+
+        // Payloads that were never decoded are written back as they were read.
         var dictionary = TPPBookRegistryData()
-        dictionary.setValue(book.dictionaryRepresentation(), for: .book)
+        dictionary.setValue(encodedBook ?? decodedBook?.dictionaryRepresentation(), for: .book)
         dictionary.setValue(state.stringValue(), for: .state)
         dictionary.setValue(fulfillmentId, for: .fulfillmentId)
-        dictionary.setValue(self.location?.dictionaryRepresentation, for: .location)
-        dictionary.setValue(readiumBookmarks?.compactMap { $0.dictionaryRepresentation as? [String: Any] }, for: .readiumBookmarks)
-        dictionary.setValue(genericBookmarks?.map { $0.dictionaryRepresentation }, for: .genericBookmarks)
+        dictionary.setValue(encodedLocation ?? decodedLocation?.dictionaryRepresentation, for: .location)
+        dictionary.setValue(
+            encodedReadiumBookmarks ?? decodedReadiumBookmarks?.compactMap { $0.dictionaryRepresentation as? [String: Any] },
+            for: .readiumBookmarks
+        )
+        dictionary.setValue(
+            encodedGenericBookmarks ?? decodedGenericBookmarks?.map { $0.dictionaryRepresentation },
+            for: .genericBookmarks
+        )
         return dictionary
     }
 }
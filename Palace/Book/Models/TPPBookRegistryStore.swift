@@ -0,0 +1,392 @@
+//
+//  TPPBookRegistryStore.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Persistent storage for `TPPBookRegistry` records of one account.
+///
+/// Records are kept in two files in the registry folder:
+/// - `registry.json`, a snapshot in the original registry format (`{"records": [...]}`);
+/// - `registry.journal`, an append-only log of record upserts and deletions
+///   written after the snapshot.
+///
+/// A change only appends the changed records to the journal. When the journal
+/// outgrows the snapshot, it is compacted in the background: a new snapshot is
+/// written atomically and the journal is truncated. Replaying a journal over a
+/// newer snapshot gives the same records, so a crash at any point is safe.
+///
+/// Each journal frame is `[length: UInt32][checksum: UInt32][JSON payload]`.
+/// A torn or corrupted tail, e.g. after a crash during a write, is dropped on load.
+///
+/// An existing `registry.json` is read as the snapshot, so registries written
+/// by earlier versions migrate without a conversion step.
+///
+/// `sync.json` holds the cache validators of the last loans feed applied to
+/// the records, see `SyncValidators`.
+///
+/// All file access happens on a private serial queue. Writes are asynchronous
+/// and are performed in the order they were submitted.
+final class TPPBookRegistryStore {
+    typealias Record = [String: Any]
+
+    /// Cache validators of a loans feed response, sent with the next sync so
+    /// an unchanged feed is answered with `304 Not Modified`.
+    struct SyncValidators: Equatable {
+        /// The loans feed the validators belong to.
+        var url: URL
+        var eTag: String?
+        var lastModified: String?
+
+        init?(url: URL, eTag: String?, lastModified: String?) {
+            guard eTag != nil || lastModified != nil else { return nil }
+            self.url = url
+            self.eTag = eTag
+            self.lastModified = lastModified
+        }
+
+        init?(url: URL, response: HTTPURLResponse) {
+            self.init(url: url,
+                      eTag: response.value(forHTTPHeaderField: "ETag"),
+                      lastModified: response.value(forHTTPHeaderField: "Last-Modified"))
+        }
+
+        /// Header fields for a conditional request.
+        var requestHeaders: [String: String] {
+            var headers = [String: String]()
+            headers["If-None-Match"] = eTag
+            headers["If-Modified-Since"] = lastModified
+            return headers
+        }
+    }
+
+    static let journalFileName = "registry.journal"
+    static let syncValidatorsFileName = "sync.json"
+
+    /// The journal is compacted when it grows past this size and past the snapshot size.
+    static let minimumCompactionSize = 64 * 1024
+
+    private static let frameHeaderSize = 8
+    private static let identifierKey = "id"
+    private static let recordKey = "record"
+
+    let snapshotUrl: URL
+    let journalUrl: URL
+    let syncValidatorsUrl: URL
+
+    private let ioQueue = DispatchQueue(label: "org.thepalaceproject.bookRegistryStore", qos: .utility)
+
+    /// Records as last written, keyed by book identifier. Used for compaction.
+    private var records = [String: Record]()
+    private var journalHandle: FileHandle?
+    private var journalSize = 0
+    private var snapshotSize = 0
+    private var isLoaded = false
+    private var isCompactionScheduled = false
+
+    private static var stores = [URL: TPPBookRegistryStore]()
+    private static let storesLock = NSLock()
+
+    /// Returns the store for `snapshotUrl`, shared by every registry instance using the same files.
+    static func store(for snapshotUrl: URL) -> TPPBookRegistryStore {
+        storesLock.lock()
+        defer { storesLock.unlock() }
+        if let store = stores[snapshotUrl] {
+            return store
+        }
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        stores[snapshotUrl] = store
+        return store
+    }
+
+    init(snapshotUrl: URL) {
+        self.snapshotUrl = snapshotUrl
+        self.journalUrl = snapshotUrl.deletingLastPathComponent().appendingPathComponent(Self.journalFileName)
+        self.syncValidatorsUrl = snapshotUrl.deletingLastPathComponent().appendingPathComponent(Self.syncValidatorsFileName)
+    }
+
+    deinit {
+        try? journalHandle?.close()
+    }
+
+    // MARK: - Reading
+
+    /// Reads the snapshot and replays the journal.
+    /// - Returns: Registry records keyed by book identifier.
+    func load() -> [String: Record] {
+        ioQueue.sync {
+            loadIfNeeded(reload: true)
+            return records
+        }
+    }
+
+    /// Validators of the last loans feed applied to the records, if any.
+    func loadSyncValidators() -> SyncValidators? {
+        ioQueue.sync {
+            guard let data = try? Data(contentsOf: syncValidatorsUrl),
+                  let json = try? JSONSerialization.jsonObject(with: data) as? [String: String],
+                  let url = json["url"].flatMap(URL.init(string:))
+            else { return nil }
+            return SyncValidators(url: url, eTag: json["eTag"], lastModified: json["lastModified"])
+        }
+    }
+
+    /// Size of the journal in bytes, after all submitted writes.
+    var currentJournalSize: Int {
+        ioQueue.sync {
+            loadIfNeeded()
+            return journalSize
+        }
+    }
+
+    // MARK: - Writing
+
+    /// Appends the changed records to the journal.
+    /// - Parameter changes: Records keyed by book identifier; `nil` removes the record.
+    func write(_ changes: [String: Record?], completion: ((_ error: Error?) -> Void)? = nil) {
+        guard !changes.isEmpty else { return }
+        ioQueue.async {
+            let error = self.append(changes, synchronize: false)
+            completion?(error)
+        }
+    }
+
+    /// Appends the changed records to the journal and waits until they reach the disk.
+    @discardableResult
+    func writeSync(_ changes: [String: Record?]) -> Error? {
+        ioQueue.sync {
+            append(changes, synchronize: true)
+        }
+    }
+
+    /// Replaces the stored sync validators after all pending record writes.
+    /// - Parameter validators: `nil` forgets them, so the next sync fetches the whole feed.
+    func saveSyncValidators(_ validators: SyncValidators?) {
+        ioQueue.async {
+            guard let validators else {
+                try? FileManager.default.removeItem(at: self.syncValidatorsUrl)
+                return
+            }
+            var json = ["url": validators.url.absoluteString]
+            json["eTag"] = validators.eTag
+            json["lastModified"] = validators.lastModified
+            do {
+                let data = try JSONSerialization.data(withJSONObject: json)
+                try FileManager.default.createDirectory(at: self.syncValidatorsUrl.deletingLastPathComponent(),
+                                                        withIntermediateDirectories: true)
+                try data.write(to: self.syncValidatorsUrl, options: .atomic)
+            } catch {
+                Log.error(#file, "Error saving loans sync validators: \(error.localizedDescription)")
+            }
+        }
+    }
+
+    /// Waits for pending writes, and the compaction they scheduled, to finish.
+    func flush() {
+        ioQueue.sync { }
+        ioQueue.sync { }
+    }
+
+    /// Removes all files and forgets loaded records.
+    func removeAll() {
+        ioQueue.sync {
+            try? journalHandle?.close()
+            journalHandle = nil
+            records.removeAll()
+            journalSize = 0
+            snapshotSize = 0
+            isLoaded = false
+            for url in [snapshotUrl, journalUrl, syncValidatorsUrl] where FileManager.default.fileExists(atPath: url.path) {
+                do {
+                    try FileManager.default.removeItem(at: url)
+                } catch {
+                    Log.error(#file, "Error deleting registry data: \(error.localizedDescription)")
+                }
+            }
+        }
+    }
+
+    // MARK: - Private
+
+    private func loadIfNeeded(reload: Bool = false) {
+        guard reload || !isLoaded else { return }
+        isLoaded = true
+        try? journalHandle?.close()
+        journalHandle = nil
+        records.removeAll()
+        journalSize = 0
+        snapshotSize = 0
+
+        if let data = try? Data(contentsOf: snapshotUrl) {
+            snapshotSize = data.count
+            if let json = try? JSONSerialization.jsonObject(with: data) as? TPPBookRegistryData,
+               let snapshot = json.array(for: .records) {
+                for record in snapshot {
+                    guard let identifier = Self.identifier(of: record) else { continue }
+                    records[identifier] = record
+                }
+            } else {
+                Log.error(#file, "Book registry snapshot could not be parsed")
+            }
+        }
+
+        guard let journal = try? Data(contentsOf: journalUrl) else { return }
+        let validLength = replay(journal)
+        journalSize = validLength
+        if validLength < journal.count {
+            Log.warn(#file, "Dropping \(journal.count - validLength) bytes of incomplete book registry journal")
+            if let handle = try? FileHandle(forWritingTo: journalUrl) {
+                try? handle.truncate(atOffset: UInt64(validLength))
+                try? handle.close()
+            }
+        }
+    }
+
+    /// Applies journal frames to `records`.
+    /// - Returns: Length of the valid prefix of `journal`.
+    private func replay(_ journal: Data) -> Int {
+        journal.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) -> Int in
+            var offset = 0
+            while offset + Self.frameHeaderSize <= buffer.count {
+                let length = Int(UInt32(littleEndian: buffer.loadUnaligned(fromByteOffset: offset, as: UInt32.self)))
+                let checksum = UInt32(littleEndian: buffer.loadUnaligned(fromByteOffset: offset + 4, as: UInt32.self))
+                let start = offset + Self.frameHeaderSize
+                guard length <= buffer.count - start else { break }
+                let payload = UnsafeRawBufferPointer(rebasing: buffer[start..<(start + length)])
+                guard Self.checksum(payload) == checksum,
+                      let entry = try? JSONSerialization.jsonObject(with: Data(payload)) as? [String: Any],
+                      let identifier = entry[Self.identifierKey] as? String
+                else { break }
+
+                records[identifier] = entry[Self.recordKey] as? Record
+                offset = start + length
+            }
+            return offset
+        }
+    }
+
+    private func append(_ changes: [String: Record?], synchronize: Bool) -> Error? {
+        loadIfNeeded()
+        do {
+            var frames = Data()
+            for (identifier, record) in changes {
+                var entry: [String: Any] = [Self.identifierKey: identifier]
+                entry[Self.recordKey] = record
+                frames.append(try Self.frame(for: entry))
+                records[identifier] = record
+            }
+
+            let handle = try openJournal()
+            try handle.seek(toOffset: UInt64(journalSize))
+            try handle.write(contentsOf: frames)
+            if synchronize {
+                try handle.synchronize()
+            }
+            journalSize += frames.count
+
+            if journalSize > max(Self.minimumCompactionSize, snapshotSize) {
+                scheduleCompaction()
+            }
+            return nil
+        } catch {
+            Log.error(#file, "Error saving book registry: \(error.localizedDescription)")
+            return error
+        }
+    }
+
+    private func openJournal() throws -> FileHandle {
+        if let journalHandle {
+            return journalHandle
+        }
+        let directoryUrl = journalUrl.deletingLastPathComponent()
+        if !FileManager.default.fileExists(atPath: directoryUrl.path) {
+            try FileManager.default.createDirectory(at: directoryUrl, withIntermediateDirectories: true)
+        }
+        if !FileManager.default.fileExists(atPath: journalUrl.path) {
+            FileManager.default.createFile(atPath: journalUrl.path, contents: nil)
+        }
+        let handle = try FileHandle(forWritingTo: journalUrl)
+        journalHandle = handle
+        return handle
+    }
+
+    /// Compacts the journal on the store queue once the submitted writes are done,
+    /// so writers, including `writeSync` callers, don't wait for the snapshot.
+    private func scheduleCompaction() {
+        guard !isCompactionScheduled else { return }
+        isCompactionScheduled = true
+        ioQueue.async {
+            self.isCompactionScheduled = false
+            guard self.journalSize > max(Self.minimumCompactionSize, self.snapshotSize) else { return }
+            do {
+                try self.compact()
+            } catch {
+                Log.error(#file, "Error compacting book registry: \(error.localizedDescription)")
+            }
+        }
+    }
+
+    /// Writes all records as the new snapshot, then truncates the journal.
+    /// The snapshot and its directory entry reach the disk before the journal is truncated.
+    private func compact() throws {
+        let directoryUrl = snapshotUrl.deletingLastPathComponent()
+        if !FileManager.default.fileExists(atPath: directoryUrl.path) {
+            try FileManager.default.createDirectory(at: directoryUrl, withIntermediateDirectories: true)
+        }
+        let registryObject = [TPPBookRegistryKey.records.rawValue: Array(records.values)]
+        let data = try JSONSerialization.data(withJSONObject: registryObject, options: .fragmentsAllowed)
+
+        let temporaryUrl = directoryUrl.appendingPathComponent(snapshotUrl.lastPathComponent + ".tmp")
+        try data.write(to: temporaryUrl)
+        let snapshotHandle = try FileHandle(forWritingTo: temporaryUrl)
+        try snapshotHandle.synchronize()
+        try snapshotHandle.close()
+        guard rename(temporaryUrl.path, snapshotUrl.path) == 0 else {
+            throw POSIXError(POSIXErrorCode(rawValue: errno) ?? .EIO)
+        }
+        try Self.synchronizeDirectory(at: directoryUrl)
+        snapshotSize = data.count
+
+        let handle = try openJournal()
+        try handle.truncate(atOffset: 0)
+        try handle.synchronize()
+        journalSize = 0
+    }
+
+    /// Flushes the directory entries of `url`, e.g. a renamed file, to the disk.
+    private static func synchronizeDirectory(at url: URL) throws {
+        let descriptor = open(url.path, O_RDONLY)
+        guard descriptor >= 0 else {
+            throw POSIXError(POSIXErrorCode(rawValue: errno) ?? .EIO)
+        }
+        defer { close(descriptor) }
+        guard fsync(descriptor) == 0 else {
+            throw POSIXError(POSIXErrorCode(rawValue: errno) ?? .EIO)
+        }
+    }
+
+    private static func identifier(of record: Record) -> String? {
+        (record[TPPBookRegistryKey.book.rawValue] as? [String: Any])?[IdentifierKey] as? String
+    }
+
+    private static func frame(for entry: [String: Any]) throws -> Data {
+        let payload = try JSONSerialization.data(withJSONObject: entry)
+        var header = Data(capacity: frameHeaderSize)
+        withUnsafeBytes(of: UInt32(payload.count).littleEndian) { header.append(contentsOf: $0) }
+        let checksum = payload.withUnsafeBytes { Self.checksum($0) }
+        withUnsafeBytes(of: checksum.littleEndian) { header.append(contentsOf: $0) }
+        return header + payload
+    }
+
+    /// 32-bit FNV-1a.
+    private static func checksum(_ bytes: UnsafeRawBufferPointer) -> UInt32 {
+        var hash: UInt32 = 2_166_136_261
+        for byte in bytes {
+            hash = (hash ^ UInt32(byte)) &* 16_777_619
+        }
+        return hash
+    }
+}
@@ -276,6 +276,9 @@ final class BookDetailViewModel: ObservableObject {
     }
 
     @objc func handleBookRegistryChange(_ notification: Notification) {
+        if let change = notification.bookRegistryChange, !change.affects(book.identifier) {
+            return
+        }
         let updatedBook = registry.book(forIdentifier: book.identifier) ?? book
         // Always update book from registry - it has authoritative data including loan duration
         // after borrowing completes
@@ -16,6 +16,7 @@ enum BookService {
         }
 
         openingBooks.insert(book.identifier)
+        MyBooksDownloadCenter.shared.recordContentAccess(for: book.identifier)
         let resolvedBook = TPPBookRegistry.shared.book(forIdentifier: book.identifier) ?? book
 
         openAfterTokenRefresh(resolvedBook, onFinish: onFinish)
@@ -93,14 +94,30 @@ enum BookService {
 
     @MainActor private static func presentPDF(_ book: TPPBook, completion: (() -> Void)? = nil) {
         guard let url = MyBooksDownloadCenter.shared.fileUrl(for: book.identifier) else { completion?(); return }
-        let data = try? Data(contentsOf: url)
-        let metadata = TPPPDFDocumentMetadata(with: book)
-        let document = TPPPDFDocument(data: data ?? Data())
-        if let coordinator = NavigationCoordinatorHub.shared.coordinator {
-            coordinator.storePDF(document: document, metadata: metadata, forBookId: book.identifier)
-            coordinator.push(.pdf(BookRoute(id: book.identifier)))
+        Task { @MainActor in
+            let document = await pdfDocument(for: book, at: url)
+            let metadata = TPPPDFDocumentMetadata(with: book)
+            if let coordinator = NavigationCoordinatorHub.shared.coordinator {
+                coordinator.storePDF(document: document, metadata: metadata, forBookId: book.identifier)
+                coordinator.push(.pdf(BookRoute(id: book.identifier)))
+            }
+            completion?()
         }
-        completion?()
+    }
+
+    /// PDF document for a downloaded book; LCP PDFs are decrypted while they are read.
+    static func pdfDocument(for book: TPPBook, at url: URL) async -> TPPPDFDocument {
+        #if LCP
+        if LCPPDFs.canOpenBook(book), let lcpPDFs = LCPPDFs(url: url) {
+            do {
+                return try await lcpPDFs.document(forBookAt: url)
+            } catch {
+                TPPErrorLogger.logError(error, summary: "Failed to open LCP PDF")
+            }
+        }
+        #endif
+        let data = try? Data(contentsOf: url)
+        return TPPPDFDocument(data: data ?? Data(), thumbnailStoreURL: TPPPDFThumbnailStore.url(forBookAt: url))
     }
 
     private static func presentAudiobook(_ book: TPPBook, onFinish: (() -> Void)? = nil) {
@@ -159,8 +159,8 @@ final class CarPlaySceneDelegate: UIResponder, CPTemplateApplicationSceneDelegat
 
     private func subscribeToBookRegistryChanges() {
         // Subscribe to registry changes (fires when books are loaded from disk or synced)
-        TPPBookRegistry.shared.registryPublisher
-            .dropFirst() // Skip initial empty state
+        TPPBookRegistry.shared.changePublisher
+            .filter { !$0.isLocationOnly }
             .debounce(for: .milliseconds(500), scheduler: DispatchQueue.main)
             .sink { [weak self] _ in
                 Log.debug(#file, "🚗 Registry updated - refreshing CarPlay library")
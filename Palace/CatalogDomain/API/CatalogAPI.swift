@@ -9,15 +9,40 @@ public final class DefaultCatalogAPI: CatalogAPI {
     public let client: NetworkClient
     public let parser: OPDSParser
 
-    public init(client: NetworkClient, parser: OPDSParser) {
+    private let validatorCache: CatalogFeedValidatorCache
+
+    public convenience init(client: NetworkClient, parser: OPDSParser) {
+        self.init(client: client, parser: parser, validatorCache: .shared)
+    }
+
+    init(client: NetworkClient, parser: OPDSParser, validatorCache: CatalogFeedValidatorCache) {
         self.client = client
         self.parser = parser
+        self.validatorCache = validatorCache
     }
 
+    /// Feeds parsed before are revalidated, and reused without parsing when
+    /// the server reports them unchanged.
     public func fetchFeed(at url: URL) async throws -> CatalogFeed? {
-        let req = NetworkRequest(method: .GET, url: url)
-        let res = try await client.send(req)
-        return try parser.parseFeed(from: res.data)
+        let accountId = AccountsManager.shared.currentAccountId
+        let headers = validatorCache.conditionalHeaders(for: url, accountId: accountId)
+        let res = try await client.send(NetworkRequest(method: .GET, url: url, headers: headers))
+
+        if let feed = validatorCache.feed(for: url, accountId: accountId, unchangedIn: res.response) {
+            return feed
+        }
+        if res.response.isNotModified() {
+            // The parsed feed was evicted while the request was in flight
+            return try await parseFeed(from: client.send(NetworkRequest(method: .GET, url: url)), at: url, accountId: accountId)
+        }
+        return try parseFeed(from: res, at: url, accountId: accountId)
+    }
+
+    private func parseFeed(from res: NetworkResponse, at url: URL, accountId: String?) throws -> CatalogFeed {
+        let start = Date()
+        let feed = try parser.parseFeed(from: res.data)
+        validatorCache.store(feed, for: url, accountId: accountId, response: res.response, parseDuration: Date().timeIntervalSince(start))
+        return feed
     }
 
     public func search(query: String, baseURL: URL) async throws -> CatalogFeed? {
@@ -0,0 +1,118 @@
+//
+//  CatalogFeedValidatorCache.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Parsed catalog feeds kept with the validators of the response they were
+/// parsed from.
+///
+/// Feeds are requested with `If-None-Match` / `If-Modified-Since` once one
+/// has been parsed. When the server answers `304 Not Modified`, or sends the
+/// same entity tag again, the feed parsed before is returned as is instead of
+/// parsing the same XML again.
+final class CatalogFeedValidatorCache {
+    static let shared = CatalogFeedValidatorCache()
+
+    struct Metrics: Equatable {
+        /// Responses answered with a feed parsed before.
+        var hits = 0
+        /// Responses that had to be parsed.
+        var misses = 0
+        /// Parse time of the feeds returned on hits.
+        var parseTimeSaved: TimeInterval = 0
+
+        var hitRate: Double {
+            hits + misses == 0 ? 0 : Double(hits) / Double(hits + misses)
+        }
+    }
+
+    private struct Key: Hashable {
+        let url: URL
+        let accountId: String?
+    }
+
+    private struct Entry {
+        let feed: CatalogFeed
+        let etag: String?
+        let lastModified: String?
+        let parseDuration: TimeInterval
+    }
+
+    private var entries: LRUCache<Key, Entry>
+    private var _metrics = Metrics()
+    private let lock = NSLock()
+
+    init(capacity: Int = 32) {
+        entries = LRUCache(capacity: capacity)
+    }
+
+    /// Hits, misses and parse time saved since the cache was created.
+    var metrics: Metrics {
+        lock.withLock { _metrics }
+    }
+
+    // MARK: - Revalidation
+
+    /// Validators of the feed parsed for `url`, to send with the next request.
+    func conditionalHeaders(for url: URL, accountId: String?) -> [String: String] {
+        guard let entry = lock.withLock({ entries.peek(Key(url: url, accountId: accountId)) }) else {
+            return [:]
+        }
+
+        var headers: [String: String] = [:]
+        if let etag = entry.etag {
+            headers["If-None-Match"] = etag
+        }
+        if let lastModified = entry.lastModified {
+            headers["If-Modified-Since"] = lastModified
+        }
+        return headers
+    }
+
+    /// The feed parsed before for `url`, if `response` shows it is unchanged:
+    /// a `304 Not Modified` or a response with the same strong entity tag.
+    func feed(for url: URL, accountId: String?, unchangedIn response: HTTPURLResponse) -> CatalogFeed? {
+        lock.withLock {
+            let key = Key(url: url, accountId: accountId)
+            guard let entry = entries.peek(key) else { return nil }
+
+            let etag = response.value(forHTTPHeaderField: "ETag")
+            let isUnchanged = response.isNotModified()
+                || (etag != nil && etag == entry.etag && etag?.hasPrefix("W/") == false)
+            guard isUnchanged else { return nil }
+
+            _ = entries.value(forKey: key)
+            _metrics.hits += 1
+            _metrics.parseTimeSaved += entry.parseDuration
+            Log.debug(#file, String(format: "Reused parsed catalog feed for %@ (%.1f ms saved; hit rate %.0f%%, %.0f ms saved overall)",
+                                    url.absoluteString, entry.parseDuration * 1e3,
+                                    _metrics.hitRate * 100, _metrics.parseTimeSaved * 1e3))
+            return entry.feed
+        }
+    }
+
+    /// Keeps `feed`, parsed from `response` in `parseDuration`, if the
+    /// response carries validators.
+    func store(_ feed: CatalogFeed, for url: URL, accountId: String?, response: HTTPURLResponse, parseDuration: TimeInterval) {
+        let etag = response.value(forHTTPHeaderField: "ETag")
+        let lastModified = response.value(forHTTPHeaderField: "Last-Modified")
+        let key = Key(url: url, accountId: accountId)
+
+        lock.withLock {
+            _metrics.misses += 1
+            guard etag != nil || lastModified != nil else {
+                entries.removeValue(forKey: key)
+                return
+            }
+            entries.setValue(Entry(feed: feed, etag: etag, lastModified: lastModified, parseDuration: parseDuration), forKey: key)
+        }
+    }
+
+    func removeAll() {
+        lock.withLock { entries.removeAll() }
+    }
+}
@@ -1,16 +1,20 @@
 import Foundation
 
-public protocol CatalogRepositoryProtocol {
+protocol CatalogRepositoryProtocol {
     func loadTopLevelCatalog(at url: URL) async throws -> CatalogFeed?
     func search(query: String, baseURL: URL) async throws -> CatalogFeed?
     func fetchFeed(at url: URL) async throws -> CatalogFeed?
     func invalidateCache(for url: URL)
+    func snapshot(for url: URL) async -> CatalogSnapshot?
+    func saveSnapshot(_ snapshot: CatalogSnapshot, for url: URL)
 }
 
 public final class CatalogRepository: CatalogRepositoryProtocol {
     private let api: CatalogAPI
     private var memoryCache: [String: CachedFeed] = [:]
     private let cacheQueue = DispatchQueue(label: "catalog.cache.queue", qos: .userInitiated)
+    private let snapshotStore: CatalogSnapshotStore?
+    private let snapshotQueue = DispatchQueue(label: "catalog.snapshot.queue", qos: .userInitiated)
     private static let lastAppLaunchKey = "CatalogRepository.lastAppLaunch"
 
     /// Track if we need to refresh stale content in background
@@ -37,8 +41,13 @@ public final class CatalogRepository: CatalogRepositoryProtocol {
         }
     }
 
-    public init(api: CatalogAPI) {
+    public convenience init(api: CatalogAPI) {
+        self.init(api: api, snapshotStore: CatalogSnapshotStore())
+    }
+
+    init(api: CatalogAPI, snapshotStore: CatalogSnapshotStore?) {
         self.api = api
+        self.snapshotStore = snapshotStore
         self.checkStaleCacheStatus()
     }
 
@@ -196,6 +205,29 @@ public final class CatalogRepository: CatalogRepositoryProtocol {
         }
     }
 
+    // MARK: - Snapshots
+
+    /// The catalog last shown for `url`, persisted across launches.
+    ///
+    /// Lets the catalog show right away on a cold start, while
+    /// `loadTopLevelCatalog(at:)` fetches and parses the feed again.
+    func snapshot(for url: URL) async -> CatalogSnapshot? {
+        guard let snapshotStore else { return nil }
+        return await withCheckedContinuation { continuation in
+            snapshotQueue.async {
+                continuation.resume(returning: snapshotStore.snapshot(for: url))
+            }
+        }
+    }
+
+    /// Persists the catalog shown for `url`, replacing the previous snapshot.
+    func saveSnapshot(_ snapshot: CatalogSnapshot, for url: URL) {
+        guard let snapshotStore else { return }
+        snapshotQueue.async {
+            snapshotStore.save(snapshot, for: url)
+        }
+    }
+
     // MARK: - Background Preloading
 
     private func preloadRelatedFacets(from feed: CatalogFeed) async {
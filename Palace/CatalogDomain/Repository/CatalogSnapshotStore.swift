@@ -0,0 +1,193 @@
+//
+//  CatalogSnapshotStore.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// The catalog as last shown: lanes, book summaries and facets, without the
+/// OPDS feed they were built from.
+struct CatalogSnapshot {
+    let title: String
+    let lanes: [CatalogLaneModel]
+    let ungroupedBooks: [TPPBook]
+    let facetGroups: [CatalogFilterGroup]
+    let entryPoints: [CatalogFilter]
+    let savedAt: Date
+
+    init(
+        title: String,
+        lanes: [CatalogLaneModel],
+        ungroupedBooks: [TPPBook],
+        facetGroups: [CatalogFilterGroup],
+        entryPoints: [CatalogFilter],
+        savedAt: Date = Date()
+    ) {
+        self.title = title
+        self.lanes = lanes
+        self.ungroupedBooks = ungroupedBooks
+        self.facetGroups = facetGroups
+        self.entryPoints = entryPoints
+        self.savedAt = savedAt
+    }
+}
+
+/// Keeps the last catalog shown for each top-level catalog URL, so the next
+/// launch can show it before the feed is fetched and parsed again.
+///
+/// Snapshots are JSON files named after the hashed URL; books are stored as
+/// their `TPPBook.dictionaryRepresentation()`, like in the book registry.
+final class CatalogSnapshotStore {
+    static let directoryName = "CatalogSnapshots"
+
+    /// Snapshots older than this are not shown.
+    static let maxAge: TimeInterval = 7 * 24 * 60 * 60
+
+    private static let formatVersion = 1
+
+    private enum Key {
+        static let version = "version"
+        static let url = "url"
+        static let savedAt = "savedAt"
+        static let title = "title"
+        static let lanes = "lanes"
+        static let moreURL = "moreURL"
+        static let books = "books"
+        static let ungroupedBooks = "ungroupedBooks"
+        static let facetGroups = "facetGroups"
+        static let entryPoints = "entryPoints"
+        static let id = "id"
+        static let name = "name"
+        static let filters = "filters"
+        static let href = "href"
+        static let active = "active"
+    }
+
+    let directory: URL
+
+    init(directory: URL) {
+        self.directory = directory
+    }
+
+    convenience init() {
+        let cachesDirectory = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first!
+        self.init(directory: cachesDirectory.appendingPathComponent(Self.directoryName))
+    }
+
+    // MARK: - Reading and Writing
+
+    /// The snapshot saved for `url`, unless it's missing, unreadable or too old.
+    func snapshot(for url: URL) -> CatalogSnapshot? {
+        guard let data = try? Data(contentsOf: fileURL(for: url)),
+              let object = try? JSONSerialization.jsonObject(with: data) as? [String: Any],
+              object[Key.version] as? Int == Self.formatVersion,
+              object[Key.url] as? String == url.absoluteString,
+              let savedAtInterval = object[Key.savedAt] as? TimeInterval else {
+            return nil
+        }
+        let savedAt = Date(timeIntervalSince1970: savedAtInterval)
+        guard Date().timeIntervalSince(savedAt) <= Self.maxAge else {
+            remove(for: url)
+            return nil
+        }
+
+        let lanes = (object[Key.lanes] as? [[String: Any]] ?? []).map { lane -> CatalogLaneModel in
+            let books = Self.books(from: lane[Key.books])
+            return CatalogLaneModel(
+                title: lane[Key.title] as? String ?? "",
+                books: books,
+                moreURL: (lane[Key.moreURL] as? String).flatMap(URL.init(string:)),
+                isLoading: books.count < 3
+            )
+        }
+        let facetGroups = (object[Key.facetGroups] as? [[String: Any]] ?? []).map { group in
+            CatalogFilterGroup(
+                id: group[Key.id] as? String ?? "",
+                name: group[Key.name] as? String ?? "",
+                filters: Self.filters(from: group[Key.filters])
+            )
+        }
+
+        return CatalogSnapshot(
+            title: object[Key.title] as? String ?? "",
+            lanes: lanes,
+            ungroupedBooks: Self.books(from: object[Key.ungroupedBooks]),
+            facetGroups: facetGroups,
+            entryPoints: Self.filters(from: object[Key.entryPoints]),
+            savedAt: savedAt
+        )
+    }
+
+    func save(_ snapshot: CatalogSnapshot, for url: URL) {
+        let object: [String: Any] = [
+            Key.version: Self.formatVersion,
+            Key.url: url.absoluteString,
+            Key.savedAt: snapshot.savedAt.timeIntervalSince1970,
+            Key.title: snapshot.title,
+            Key.lanes: snapshot.lanes.map { lane -> [String: Any] in
+                [
+                    Key.title: lane.title,
+                    Key.moreURL: lane.moreURL?.absoluteString as Any,
+                    Key.books: lane.books.map { $0.dictionaryRepresentation() }
+                ]
+            },
+            Key.ungroupedBooks: snapshot.ungroupedBooks.map { $0.dictionaryRepresentation() },
+            Key.facetGroups: snapshot.facetGroups.map { group -> [String: Any] in
+                [
+                    Key.id: group.id,
+                    Key.name: group.name,
+                    Key.filters: group.filters.map(Self.dictionary(from:))
+                ]
+            },
+            Key.entryPoints: snapshot.entryPoints.map(Self.dictionary(from:))
+        ]
+
+        do {
+            try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+            let data = try JSONSerialization.data(withJSONObject: object)
+            try data.write(to: fileURL(for: url), options: .atomic)
+        } catch {
+            Log.error(#file, "Error saving catalog snapshot: \(error.localizedDescription)")
+        }
+    }
+
+    func remove(for url: URL) {
+        try? FileManager.default.removeItem(at: fileURL(for: url))
+    }
+
+    func removeAll() {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    // MARK: - Helpers
+
+    private func fileURL(for url: URL) -> URL {
+        directory.appendingPathComponent(url.absoluteString.sha256()).appendingPathExtension("json")
+    }
+
+    private static func books(from object: Any?) -> [TPPBook] {
+        (object as? [[String: Any]] ?? []).compactMap { TPPBook(dictionary: $0) }
+    }
+
+    private static func filters(from object: Any?) -> [CatalogFilter] {
+        (object as? [[String: Any]] ?? []).map { filter in
+            CatalogFilter(
+                id: filter[Key.id] as? String ?? UUID().uuidString,
+                title: filter[Key.title] as? String ?? "",
+                href: (filter[Key.href] as? String).flatMap(URL.init(string:)),
+                active: filter[Key.active] as? Bool ?? false
+            )
+        }
+    }
+
+    private static func dictionary(from filter: CatalogFilter) -> [String: Any] {
+        [
+            Key.id: filter.id,
+            Key.title: filter.title,
+            Key.href: filter.href?.absoluteString as Any,
+            Key.active: filter.active
+        ]
+    }
+}
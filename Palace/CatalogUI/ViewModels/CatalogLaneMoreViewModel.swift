@@ -161,10 +161,11 @@ class CatalogLaneMoreViewModel: ObservableObject {
     var titleToBooks: [String: [TPPBook]] = [:]
     var titleToMoreURL: [String: URL?] = [:]
     
-    for entry in entries {
+    let groupedEntries = entries.filter { $0.groupAttributes != nil }
+    for (entry, book) in zip(groupedEntries, CatalogViewModel.makeBooks(from: groupedEntries)) {
       guard let group = entry.groupAttributes else { continue }
       let groupTitle = group.title ?? ""
-      if let book = CatalogViewModel.makeBook(from: entry) {
+      if let book {
         if titleToBooks[groupTitle] == nil { orderedTitles.append(groupTitle) }
         titleToBooks[groupTitle, default: []].append(book)
         if titleToMoreURL[groupTitle] == nil { titleToMoreURL[groupTitle] = group.href }
@@ -183,7 +184,7 @@ class CatalogLaneMoreViewModel: ObservableObject {
   }
   
   private func processUngroupedFeed(entries: [TPPOPDSEntry], feedObjc: TPPOPDSFeed) {
-    ungroupedBooks = entries.compactMap { CatalogViewModel.makeBook(from: $0) }
+    ungroupedBooks = CatalogViewModel.makeBooks(from: entries).compactMap { $0 }
     
     // Store original catalog books for restoration after returns
     storeOriginalCatalogBooks(ungroupedBooks)
@@ -219,7 +220,7 @@ class CatalogLaneMoreViewModel: ObservableObject {
         extractNextPageURL(from: feedObjc)
         
         if let entries = feedObjc.entries as? [TPPOPDSEntry] {
-          let newBooks = entries.compactMap { CatalogViewModel.makeBook(from: $0) }
+          let newBooks = CatalogViewModel.makeBooks(from: entries).compactMap { $0 }
           ungroupedBooks.append(contentsOf: newBooks)
         }
       }
@@ -345,7 +346,7 @@ class CatalogLaneMoreViewModel: ObservableObject {
         if let filterURL = CatalogFilterService.findFilterInCurrentFacets(filter, in: currentFacetGroups) {
           if let feed = try await api.fetchFeed(at: filterURL) {
             if let entries = feed.opdsFeed.entries as? [TPPOPDSEntry] {
-              ungroupedBooks = entries.compactMap { CatalogViewModel.makeBook(from: $0) }
+              ungroupedBooks = CatalogViewModel.makeBooks(from: entries).compactMap { $0 }
             }
             
             if feed.opdsFeed.type == TPPOPDSFeedType.acquisitionUngrouped {
@@ -119,7 +119,7 @@ class CatalogSearchViewModel: ObservableObject {
                     var searchResults: [TPPBook] = []
 
                     if let opdsEntries = feedObjc.entries as? [TPPOPDSEntry] {
-                        searchResults = opdsEntries.compactMap { CatalogViewModel.makeBook(from: $0) }
+                        searchResults = CatalogViewModel.makeBooks(from: opdsEntries).compactMap { $0 }
                     }
 
                     self.filteredBooks = searchResults
@@ -178,7 +178,7 @@ class CatalogSearchViewModel: ObservableObject {
             extractNextPageURL(from: feedObjc)
 
             if let entries = feedObjc.entries as? [TPPOPDSEntry] {
-                let newBooks = entries.compactMap { CatalogViewModel.makeBook(from: $0) }
+                let newBooks = CatalogViewModel.makeBooks(from: entries).compactMap { $0 }
                 filteredBooks.append(contentsOf: newBooks)
 
                 // PP-3673: Announce additional results loaded
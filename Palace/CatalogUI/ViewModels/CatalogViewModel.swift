@@ -57,11 +57,20 @@ final class CatalogViewModel: ObservableObject {
     currentLoadTask = Task { [weak self] in
       guard let self, !Task.isCancelled else { return }
       
+      // Read alongside the feed and shown until the feed is parsed,
+      // unless the feed comes first
+      let snapshotTask = Task { await self.showSnapshot(for: url) }
+      defer { snapshotTask.cancel() }
+
       do {
         guard let feed = try await self.repository.loadTopLevelCatalog(at: url) else {
           guard !Task.isCancelled else { return }
+          let showsSnapshot = await snapshotTask.value
           await MainActor.run { 
-            if !Task.isCancelled {
+            if showsSnapshot {
+              Log.warn(#file, "Catalog feed unavailable, keeping the saved snapshot")
+              self.isLoading = false
+            } else if !Task.isCancelled {
               self.errorMessage = "Failed to load catalog"
               self.isLoading = false
             }
@@ -79,6 +88,7 @@ final class CatalogViewModel: ObservableObject {
         
         await MainActor.run {
           guard !Task.isCancelled else { return }
+          snapshotTask.cancel()
           self.title = mapped.title
           self.entries = mapped.entries
           self.lanes = mapped.lanes
@@ -89,6 +99,20 @@ final class CatalogViewModel: ObservableObject {
           self.isLoading = false
         }
 
+        if !mapped.lanes.isEmpty || !mapped.ungroupedBooks.isEmpty {
+          LaunchMetrics.firstCatalogLanesShown(source: "feed")
+          self.repository.saveSnapshot(
+            CatalogSnapshot(
+              title: mapped.title,
+              lanes: mapped.lanes,
+              ungroupedBooks: mapped.ungroupedBooks,
+              facetGroups: mapped.facetGroups,
+              entryPoints: mapped.entryPoints
+            ),
+            for: url
+          )
+        }
+
         guard !Task.isCancelled else { return }
         if !mapped.lanes.isEmpty {
           let visibleBooks = mapped.lanes.prefix(3).flatMap { $0.books }
@@ -103,8 +127,11 @@ final class CatalogViewModel: ObservableObject {
       } catch {
         guard !Task.isCancelled else { return }
         Log.error(#file, "Failed to load catalog: \(error.localizedDescription)")
+        let showsSnapshot = await snapshotTask.value
         await MainActor.run { 
-          if !Task.isCancelled {
+          if showsSnapshot {
+            self.isLoading = false
+          } else if !Task.isCancelled {
             self.errorMessage = error.localizedDescription
             self.isLoading = false
           }
@@ -155,7 +182,7 @@ final class CatalogViewModel: ObservableObject {
         switch feedObjc.type {
         case .acquisitionUngrouped:
           if let opdsEntries = feedObjc.entries as? [TPPOPDSEntry] {
-            let newUngrouped = opdsEntries.compactMap { Self.makeBook(from: $0) }
+            let newUngrouped = Self.makeBooks(from: opdsEntries).compactMap { $0 }
             self.lanes = []
             self.ungroupedBooks = newUngrouped
           }
@@ -167,10 +194,11 @@ final class CatalogViewModel: ObservableObject {
           var groupTitleToMoreURL: [String: URL?] = [:]
           var orderedTitles: [String] = []
           if let opdsEntries = feedObjc.entries as? [TPPOPDSEntry] {
-            for entry in opdsEntries {
+            let groupedEntries = opdsEntries.filter { $0.groupAttributes != nil }
+            for (entry, book) in zip(groupedEntries, Self.makeBooks(from: groupedEntries)) {
               guard let group = entry.groupAttributes else { continue }
               let groupTitle = group.title ?? ""
-              if let book = Self.makeBook(from: entry) {
+              if let book {
                 if groupTitleToBooks[groupTitle] == nil { orderedTitles.append(groupTitle) }
                 groupTitleToBooks[groupTitle, default: []].append(book)
                 if groupTitleToMoreURL[groupTitle] == nil { groupTitleToMoreURL[groupTitle] = group.href }
@@ -230,7 +258,7 @@ final class CatalogViewModel: ObservableObject {
         switch feedObjc.type {
         case .acquisitionUngrouped:
           if let opdsEntries = feedObjc.entries as? [TPPOPDSEntry] {
-            self.ungroupedBooks = opdsEntries.compactMap { Self.makeBook(from: $0) }
+            self.ungroupedBooks = Self.makeBooks(from: opdsEntries).compactMap { $0 }
           }
           let (groups, entries) = Self.extractFacets(from: feedObjc)
           self.facetGroups = groups
@@ -240,10 +268,11 @@ final class CatalogViewModel: ObservableObject {
           var groupTitleToMoreURL: [String: URL?] = [:]
           var orderedTitles: [String] = []
           if let opdsEntries = feedObjc.entries as? [TPPOPDSEntry] {
-            for entry in opdsEntries {
+            let groupedEntries = opdsEntries.filter { $0.groupAttributes != nil }
+            for (entry, book) in zip(groupedEntries, Self.makeBooks(from: groupedEntries)) {
               guard let group = entry.groupAttributes else { continue }
               let groupTitle = group.title ?? ""
-              if let book = Self.makeBook(from: entry) {
+              if let book {
                 if groupTitleToBooks[groupTitle] == nil { orderedTitles.append(groupTitle) }
                 groupTitleToBooks[groupTitle, default: []].append(book)
                 if groupTitleToMoreURL[groupTitle] == nil { groupTitleToMoreURL[groupTitle] = group.href }
@@ -346,7 +375,7 @@ extension CatalogViewModel {
         entryPoints: entryPoints
       )
     case .acquisitionUngrouped:
-      let ungroupedBooks = (feedObjc.entries as? [TPPOPDSEntry])?.compactMap { makeBook(from: $0) } ?? []
+      let ungroupedBooks = (feedObjc.entries as? [TPPOPDSEntry]).map { makeBooks(from: $0).compactMap { $0 } } ?? []
       let (facetGroups, entryPoints) = extractFacets(from: feedObjc)
       return MappedCatalog(
         title: title,
@@ -382,9 +411,10 @@ extension CatalogViewModel {
     var titleToMoreURL: [String: URL?] = [:]
     var orderedTitles: [String] = []
     if let entries = feed.entries as? [TPPOPDSEntry] {
-      for entry in entries {
+      let groupedEntries = entries.filter { $0.groupAttributes != nil }
+      for (entry, book) in zip(groupedEntries, makeBooks(from: groupedEntries)) {
         if let group = entry.groupAttributes,
-           let book = makeBook(from: entry) {
+           let book {
           let title = group.title ?? ""
           if titleToBooks[title] == nil { orderedTitles.append(title) }
           titleToBooks[title, default: []].append(book)
@@ -453,13 +483,58 @@ extension CatalogViewModel {
     return (groups, entryPoints)
   }
 
+  // MARK: - Snapshot
+
+  /// Shows the catalog saved for `url` by an earlier launch, if nothing is shown yet
+  /// and the task was not cancelled by the feed arriving first.
+  /// - Returns: `true` if a snapshot is shown.
+  private func showSnapshot(for url: URL) async -> Bool {
+    guard lanes.isEmpty, ungroupedBooks.isEmpty,
+          let snapshot = await repository.snapshot(for: url),
+          !Task.isCancelled, lanes.isEmpty, ungroupedBooks.isEmpty else {
+      return false
+    }
+
+    title = snapshot.title
+    // Books may have been borrowed or returned since the snapshot was saved
+    lanes = snapshot.lanes.map { lane in
+      CatalogLaneModel(
+        title: lane.title,
+        books: lane.books.compactMap(Self.prepareBook),
+        moreURL: lane.moreURL,
+        isLoading: lane.isLoading
+      )
+    }
+    ungroupedBooks = snapshot.ungroupedBooks.compactMap(Self.prepareBook)
+    facetGroups = snapshot.facetGroups
+    entryPoints = snapshot.entryPoints
+    isLoading = false
+
+    Log.info(#file, "Showing catalog snapshot saved \(Int(Date().timeIntervalSince(snapshot.savedAt)))s ago, revalidating")
+    LaunchMetrics.firstCatalogLanesShown(source: "snapshot")
+    return true
+  }
+
   private func prefetchThumbnails(for books: [TPPBook]) {
     let set = Set(books)
     TPPBookRegistry.shared.thumbnailImages(forBooks: set) { _ in }
   }
 
   static func makeBook(from entry: TPPOPDSEntry) -> TPPBook? {
-    guard var book = TPPBook(entry: entry) else { return nil }
+    TPPBook(entry: entry).flatMap(prepareBook)
+  }
+
+  /// Same as `makeBook(from:)` for every entry, keeping feed order.
+  /// Books are decoded on all cores; registry metadata is merged afterwards,
+  /// one book at a time.
+  static func makeBooks(from entries: [TPPOPDSEntry]) -> [TPPBook?] {
+    entries
+      .concurrentMap { TPPBook(entry: $0) }
+      .map { $0.flatMap(prepareBook) }
+  }
+
+  private static func prepareBook(_ book: TPPBook) -> TPPBook? {
+    var book = book
 
     if let updated = TPPBookRegistry.shared.updatedBookMetadata(book) {
       book = updated
@@ -53,6 +53,7 @@ final class HoldsViewModel: ObservableObject {
 
         let syncEnd = NotificationCenter.default.publisher(for: .TPPSyncEnded)
         let registryChange = NotificationCenter.default.publisher(for: .TPPBookRegistryDidChange)
+            .filter { !($0.bookRegistryChange?.isLocationOnly ?? false) }
 
         syncEnd
             .merge(with: registryChange)
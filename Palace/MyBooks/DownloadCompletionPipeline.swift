@@ -0,0 +1,69 @@
+//
+//  DownloadCompletionPipeline.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Runs the processing of finished downloads (sniff, validate, move, fulfill,
+/// registry update) away from the main thread.
+///
+/// Completions run at utility priority and at most `maxConcurrent` at a time,
+/// so several downloads finishing together don't compete with the UI for I/O.
+actor DownloadCompletionPipeline {
+    let maxConcurrent: Int
+    private var running = 0
+    private var waiting = [CheckedContinuation<Void, Never>]()
+
+    init(maxConcurrent: Int = 2) {
+        self.maxConcurrent = max(1, maxConcurrent)
+    }
+
+    /// Starts processing a finished download without waiting for it.
+    nonisolated func submit(_ completion: @escaping () async -> Void) {
+        Task.detached(priority: .utility) {
+            await self.perform(completion)
+        }
+    }
+
+    /// Processes a finished download once a slot is free.
+    func perform(_ completion: () async -> Void) async {
+        if running >= maxConcurrent {
+            await withCheckedContinuation { waiting.append($0) }
+        } else {
+            running += 1
+        }
+
+        await completion()
+
+        if waiting.isEmpty {
+            running -= 1
+        } else {
+            // The slot passes to the next completion.
+            waiting.removeFirst().resume()
+        }
+    }
+}
+
+/// Reads just enough of a downloaded file to classify it.
+enum DownloadedFileSniffer {
+    /// Largest document read whole: problem documents, bearer tokens, ACSM
+    /// files and OPDS entries are a few kilobytes.
+    static let maximumDocumentLength = 1024 * 1024
+
+    /// The contents of a small document, or `nil` if the file is larger than
+    /// `maximumLength`, e.g. a book mislabelled by the server.
+    static func document(at url: URL, maximumLength: Int = maximumDocumentLength) -> Data? {
+        guard let size = try? url.resourceValues(forKeys: [.fileSizeKey]).fileSize, size <= maximumLength else {
+            return nil
+        }
+        return try? Data(contentsOf: url, options: .mappedIfSafe)
+    }
+
+    /// `true` if the ACSM file fulfills to a PDF, which Adobe DRM doesn't support.
+    static func isAdobePDF(acsm: Data) -> Bool {
+        acsm.range(of: Data(">application/pdf</dc:format>".utf8)) != nil
+    }
+}
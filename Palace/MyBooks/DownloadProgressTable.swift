@@ -0,0 +1,170 @@
+//
+//  DownloadProgressTable.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+import os
+import UIKit
+
+/// Download info of the books being downloaded, readable from any thread
+/// without waiting.
+///
+/// Reads only take an unfair lock for a dictionary lookup, so UI code can call
+/// them while rendering. The table also collects which downloads changed, so
+/// `DownloadProgressBroadcaster` can publish them once per frame.
+final class DownloadProgressTable {
+    private struct State {
+        var infos = [String: MyBooksDownloadInfo]()
+        /// Latest progress not yet published, by book identifier.
+        var unpublishedProgress = [String: Double]()
+        /// Books changed since the last change notification.
+        var changedIdentifiers = Set<String>()
+        var isBroadcastScheduled = false
+    }
+
+    /// Download info isn't `Sendable`; it's only handed out, never mutated.
+    private let state = OSAllocatedUnfairLock(uncheckedState: State())
+
+    // MARK: - Reading
+
+    func get(_ identifier: String) -> MyBooksDownloadInfo? {
+        state.withLockUnchecked { $0.infos[identifier] }
+    }
+
+    func values() -> [MyBooksDownloadInfo] {
+        state.withLockUnchecked { Array($0.infos.values) }
+    }
+
+    func progress(for identifier: String) -> Double {
+        state.withLockUnchecked { Double($0.infos[identifier]?.downloadProgress ?? 0) }
+    }
+
+    // MARK: - Writing
+
+    func set(_ identifier: String, value: MyBooksDownloadInfo) {
+        state.withLockUnchecked {
+            $0.infos[identifier] = value
+            $0.changedIdentifiers.insert(identifier)
+        }
+    }
+
+    @discardableResult
+    func remove(_ identifier: String) -> MyBooksDownloadInfo? {
+        state.withLockUnchecked {
+            $0.unpublishedProgress.removeValue(forKey: identifier)
+            $0.changedIdentifiers.insert(identifier)
+            return $0.infos.removeValue(forKey: identifier)
+        }
+    }
+
+    func removeAll() {
+        state.withLockUnchecked {
+            $0.changedIdentifiers.formUnion($0.infos.keys)
+            $0.infos.removeAll()
+            $0.unpublishedProgress.removeAll()
+        }
+    }
+
+    /// Records the progress of a download, to be published on the next frame
+    /// and listed in the next change notification.
+    /// - Returns: `true` if no other progress was waiting to be published, so
+    ///   the caller has to make sure a frame is coming.
+    @discardableResult
+    func setProgress(_ progress: Double, for identifier: String) -> Bool {
+        state.withLockUnchecked {
+            if let info = $0.infos[identifier] {
+                $0.infos[identifier] = info.withDownloadProgress(CGFloat(progress))
+            }
+            $0.changedIdentifiers.insert(identifier)
+            let wasIdle = $0.unpublishedProgress.isEmpty
+            $0.unpublishedProgress[identifier] = progress
+            return wasIdle
+        }
+    }
+
+    /// Returns and forgets the progress recorded since the last call.
+    func takeUnpublishedProgress() -> [String: Double] {
+        state.withLockUnchecked {
+            defer { $0.unpublishedProgress.removeAll() }
+            return $0.unpublishedProgress
+        }
+    }
+
+    // MARK: - Change Notifications
+
+    /// Marks a change notification as scheduled.
+    /// - Returns: `false` if one is already scheduled.
+    func scheduleBroadcast() -> Bool {
+        state.withLockUnchecked {
+            defer { $0.isBroadcastScheduled = true }
+            return !$0.isBroadcastScheduled
+        }
+    }
+
+    /// Returns and forgets the books changed since the last notification, and
+    /// allows scheduling the next one.
+    func takeChangedIdentifiers() -> Set<String> {
+        state.withLockUnchecked {
+            defer {
+                $0.changedIdentifiers.removeAll()
+                $0.isBroadcastScheduled = false
+            }
+            return $0.changedIdentifiers
+        }
+    }
+}
+
+/// Publishes download progress at most once per display refresh, with the
+/// latest value of each download that changed.
+@MainActor
+final class DownloadProgressBroadcaster {
+    private let table: DownloadProgressTable
+    private let publish: (_ identifier: String, _ progress: Double) -> Void
+    private var displayLink: CADisplayLink?
+
+    init(table: DownloadProgressTable, publish: @escaping (_ identifier: String, _ progress: Double) -> Void) {
+        self.table = table
+        self.publish = publish
+    }
+
+    var isRunning: Bool {
+        displayLink != nil
+    }
+
+    /// Publishes pending progress on the next frames, until none is left.
+    func start() {
+        guard displayLink == nil else { return }
+        let displayLink = CADisplayLink(target: DisplayLinkTarget(self), selector: #selector(DisplayLinkTarget.tick))
+        displayLink.add(to: .main, forMode: .common)
+        self.displayLink = displayLink
+    }
+
+    fileprivate func tick() {
+        let progress = table.takeUnpublishedProgress()
+        guard !progress.isEmpty else {
+            // Idle: stop until the next progress.
+            displayLink?.invalidate()
+            displayLink = nil
+            return
+        }
+        for (identifier, value) in progress {
+            publish(identifier, value)
+        }
+    }
+
+    /// The display link retains its target; this keeps it from retaining the broadcaster.
+    private final class DisplayLinkTarget: NSObject {
+        weak var broadcaster: DownloadProgressBroadcaster?
+
+        init(_ broadcaster: DownloadProgressBroadcaster) {
+            self.broadcaster = broadcaster
+        }
+
+        @MainActor @objc func tick() {
+            broadcaster?.tick()
+        }
+    }
+}
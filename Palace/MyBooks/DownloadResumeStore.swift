@@ -0,0 +1,86 @@
+//
+//  DownloadResumeStore.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Keeps what is needed to continue interrupted downloads, across relaunches.
+///
+/// Each book gets a directory named after its hashed identifier, holding the
+/// resume data of a cancelled `URLSessionDownloadTask` and the parts of a
+/// `SegmentedRangeDownload`.
+final class DownloadResumeStore {
+    static let directoryName = "Partial Downloads"
+
+    private struct ResumeRecord: Codable {
+        /// URL of the request the resume data continues.
+        let url: URL
+        let data: Data
+    }
+
+    private static let resumeDataFileName = "resume-data.plist"
+    private static let segmentsDirectoryName = "segments"
+
+    let directory: URL
+
+    init(directory: URL) {
+        self.directory = directory
+    }
+
+    // MARK: - Resume Data
+
+    /// Saves the resume data of a download of `url`, replacing any previous one.
+    func saveResumeData(_ data: Data, for identifier: String, url: URL) {
+        do {
+            let fileUrl = bookDirectory(for: identifier).appendingPathComponent(Self.resumeDataFileName)
+            try FileManager.default.createDirectory(at: fileUrl.deletingLastPathComponent(), withIntermediateDirectories: true)
+            try PropertyListEncoder().encode(ResumeRecord(url: url, data: data)).write(to: fileUrl, options: .atomic)
+        } catch {
+            Log.error(#file, "Error saving resume data: \(error.localizedDescription)")
+        }
+    }
+
+    /// Removes and returns the resume data saved for a download of `url`.
+    ///
+    /// Resume data saved for another URL, e.g. after the book was borrowed
+    /// again, is discarded.
+    func takeResumeData(for identifier: String, url: URL?) -> Data? {
+        let fileUrl = bookDirectory(for: identifier).appendingPathComponent(Self.resumeDataFileName)
+        guard let data = try? Data(contentsOf: fileUrl) else { return nil }
+        try? FileManager.default.removeItem(at: fileUrl)
+
+        guard let record = try? PropertyListDecoder().decode(ResumeRecord.self, from: data), record.url == url else {
+            return nil
+        }
+        return record.data
+    }
+
+    // MARK: - Segments
+
+    /// Directory for the parts of a segmented download of the book.
+    func segmentsDirectory(for identifier: String) -> URL {
+        bookDirectory(for: identifier).appendingPathComponent(Self.segmentsDirectoryName)
+    }
+
+    func removeSegments(for identifier: String) {
+        try? FileManager.default.removeItem(at: segmentsDirectory(for: identifier))
+    }
+
+    // MARK: - Removal
+
+    /// Forgets all partial downloads of the book.
+    func remove(_ identifier: String) {
+        try? FileManager.default.removeItem(at: bookDirectory(for: identifier))
+    }
+
+    func removeAll() {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    private func bookDirectory(for identifier: String) -> URL {
+        directory.appendingPathComponent(identifier.sha256())
+    }
+}
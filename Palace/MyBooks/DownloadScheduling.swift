@@ -0,0 +1,98 @@
+//
+//  DownloadScheduling.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Why a book is being downloaded. Higher priorities start first and may
+/// suspend running downloads of lower priorities.
+@objc enum DownloadPriority: Int, Comparable {
+    /// Content fetched ahead of time, without the patron asking for it.
+    case prefetch
+    /// Content downloaded again without the patron waiting on it, e.g. after eviction.
+    case backgroundRedownload
+    /// The patron borrowed or tapped "Download".
+    case explicit
+    /// The patron tapped "Read" or "Listen" and is waiting for the content.
+    /// Suspends all prefetches and background downloads until it finishes.
+    case userOpen
+
+    static func < (lhs: DownloadPriority, rhs: DownloadPriority) -> Bool {
+        lhs.rawValue < rhs.rawValue
+    }
+}
+
+/// Adapts the number of concurrent downloads to the measured throughput.
+///
+/// Bytes received are summed over fixed windows. While every allowed download
+/// is transferring, the limit is raised by one to probe for more throughput;
+/// if the next window isn't `minimumGain` faster, the extra download only
+/// split the same bandwidth further and the limit goes back down for a while.
+struct DownloadThroughputController {
+    static let minimumLimit = 1
+    static let maximumLimit = 6
+
+    /// Current number of downloads allowed to run at once.
+    private(set) var limit: Int
+
+    let sampleInterval: TimeInterval
+    /// Relative throughput increase required to keep a raised limit.
+    let minimumGain: Double
+    /// Windows to wait after an unsuccessful probe before probing again.
+    let probeBackoff: Int
+
+    private var windowStart: Date?
+    private var windowBytes: Int64 = 0
+    private var windowTransfers = Set<String>()
+    private var previous: (limit: Int, throughput: Double)?
+    private var backoffRemaining = 0
+
+    init(initialLimit: Int = 4, sampleInterval: TimeInterval = 2, minimumGain: Double = 0.1, probeBackoff: Int = 5) {
+        self.limit = min(max(initialLimit, Self.minimumLimit), Self.maximumLimit)
+        self.sampleInterval = sampleInterval
+        self.minimumGain = minimumGain
+        self.probeBackoff = probeBackoff
+    }
+
+    /// Adds bytes received by the download for `identifier`.
+    /// - Returns: `true` if the limit changed.
+    @discardableResult
+    mutating func record(bytes: Int64, for identifier: String, at date: Date = Date()) -> Bool {
+        let start = windowStart ?? date
+        windowStart = start
+        windowBytes += bytes
+        windowTransfers.insert(identifier)
+
+        let elapsed = date.timeIntervalSince(start)
+        guard elapsed >= sampleInterval else { return false }
+
+        let throughput = Double(windowBytes) / elapsed
+        let isSaturated = windowTransfers.count >= limit
+        windowStart = date
+        windowBytes = 0
+        windowTransfers.removeAll()
+        return adapt(throughput: throughput, isSaturated: isSaturated)
+    }
+
+    private mutating func adapt(throughput: Double, isSaturated: Bool) -> Bool {
+        let oldLimit = limit
+        defer { previous = (oldLimit, throughput) }
+
+        if let previous, previous.limit < limit {
+            if throughput < previous.throughput * (1 + minimumGain) {
+                limit -= 1
+                backoffRemaining = probeBackoff
+            } else if isSaturated && limit < Self.maximumLimit {
+                limit += 1
+            }
+        } else if backoffRemaining > 0 {
+            backoffRemaining -= 1
+        } else if isSaturated && limit < Self.maximumLimit {
+            limit += 1
+        }
+        return limit != oldLimit
+    }
+}
@@ -398,14 +398,15 @@ extension BookCellModel {
             self.isLoading = false
         case .pdf:
             guard let url = MyBooksDownloadCenter.shared.fileUrl(for: book.identifier) else { self.isLoading = false; return }
-            let data = try? Data(contentsOf: url)
-            let metadata = TPPPDFDocumentMetadata(with: book)
-            let document = TPPPDFDocument(data: data ?? Data())
-            if let coordinator = NavigationCoordinatorHub.shared.coordinator {
-                coordinator.storePDF(document: document, metadata: metadata, forBookId: book.identifier)
-                coordinator.push(.pdf(BookRoute(id: book.identifier)))
+            Task { @MainActor in
+                let document = await BookService.pdfDocument(for: book, at: url)
+                let metadata = TPPPDFDocumentMetadata(with: book)
+                if let coordinator = NavigationCoordinatorHub.shared.coordinator {
+                    coordinator.storePDF(document: document, metadata: metadata, forBookId: book.identifier)
+                    coordinator.push(.pdf(BookRoute(id: book.identifier)))
+                }
+                self.isLoading = false
             }
-            self.isLoading = false
         case .audiobook:
             openAudiobookFromCell()
         default:
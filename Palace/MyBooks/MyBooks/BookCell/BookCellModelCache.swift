@@ -256,6 +256,26 @@ final class BookCellModelCache: ObservableObject {
                 }
             }
             .store(in: &cancellables)
+
+        // Registry change-sets name the books that changed, so only their models are touched:
+        // models of removed books are dropped, and books whose metadata changed (e.g. hold
+        // positions after a sync) are refreshed in place.
+        bookRegistry.changePublisher
+            .receive(on: DispatchQueue.main)
+            .sink { [weak self] change in
+                guard let self else { return }
+                for identifier in change.removed where self.cache[identifier] != nil {
+                    self.invalidate(for: identifier)
+                }
+                for identifier in change.updated {
+                    guard let model = self.cache[identifier]?.model,
+                          let book = self.bookRegistry.book(forIdentifier: identifier),
+                          model.book !== book
+                    else { continue }
+                    model.book = book
+                }
+            }
+            .store(in: &cancellables)
     }
 
     private func startPeriodicCleanup() {
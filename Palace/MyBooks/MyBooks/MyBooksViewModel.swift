@@ -178,7 +178,9 @@ enum Group: Int {
     // MARK: - Notification Handling
     private func registerNotifications() {
         let stateChange = NotificationCenter.default.publisher(for: .TPPBookRegistryStateDidChange)
+        // Reading locations aren't shown in the list; skip the reload on page turns.
         let registryChange = NotificationCenter.default.publisher(for: .TPPBookRegistryDidChange)
+            .filter { !($0.bookRegistryChange?.isLocationOnly ?? false) }
         let syncEnd = NotificationCenter.default.publisher(for: .TPPSyncEnded)
 
         stateChange
@@ -0,0 +1,165 @@
+//
+//  MyBooksContentLedger.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Persistent record of the disk space used by the downloaded books of one
+/// account, and of when each book was last opened.
+///
+/// The ledger is updated when a download completes, a book is opened and its
+/// content is deleted, so the total usage is known without listing the content
+/// directory. Mutations are applied and written to disk in order on a private
+/// serial queue; reads wait for pending mutations.
+final class MyBooksContentLedger {
+    struct Entry: Codable, Equatable {
+        /// Content files of the book, relative to the content directory.
+        var fileNames: [String]
+        var bytes: Int64
+        var lastAccess: Date
+
+        /// LCP licenses and licensed audiobooks can't be downloaded again as-is, so they are never evicted.
+        var isPinned: Bool {
+            fileNames.contains { ["lcpl", "lcpa"].contains(($0 as NSString).pathExtension.lowercased()) }
+        }
+    }
+
+    static let fileName = "content-ledger.json"
+
+    let url: URL
+
+    private let queue = DispatchQueue(label: "org.thepalaceproject.contentLedger", qos: .utility)
+    private var entries = [String: Entry]()
+    private var total: Int64 = 0
+    private var isOnDisk = false
+
+    private static var ledgers = [URL: MyBooksContentLedger]()
+    private static let ledgersLock = NSLock()
+
+    /// Returns the ledger stored at `url`, shared by all callers.
+    static func ledger(for url: URL) -> MyBooksContentLedger {
+        ledgersLock.lock()
+        defer { ledgersLock.unlock() }
+        if let ledger = ledgers[url] {
+            return ledger
+        }
+        let ledger = MyBooksContentLedger(url: url)
+        ledgers[url] = ledger
+        return ledger
+    }
+
+    init(url: URL) {
+        self.url = url
+        if let data = try? Data(contentsOf: url) {
+            do {
+                entries = try JSONDecoder().decode([String: Entry].self, from: data)
+                total = entries.values.reduce(0) { $0 + $1.bytes }
+                isOnDisk = true
+            } catch {
+                Log.error(#file, "Content ledger could not be parsed: \(error.localizedDescription)")
+            }
+        }
+    }
+
+    // MARK: - Reading
+
+    /// Bytes used by all recorded books.
+    var totalBytes: Int64 {
+        queue.sync { total }
+    }
+
+    /// `true` until the ledger has been written once. Content downloaded by
+    /// versions without a ledger has to be recorded with `rebuild(_:)`.
+    var needsRebuild: Bool {
+        queue.sync { !isOnDisk }
+    }
+
+    func entry(for identifier: String) -> Entry? {
+        queue.sync { entries[identifier] }
+    }
+
+    /// Books to evict, in order: by `rank`, then least recently opened first.
+    ///
+    /// Pinned books, books for which `rank` returns `nil` and the most recently
+    /// opened book, which may still be on screen, are left out.
+    func evictionCandidates(rank: (_ identifier: String) -> Int?) -> [String] {
+        let snapshot = queue.sync { entries }
+        let mostRecent = snapshot.max { $0.value.lastAccess < $1.value.lastAccess }?.key
+
+        return snapshot
+            .compactMap { identifier, entry -> (identifier: String, rank: Int, lastAccess: Date)? in
+                guard identifier != mostRecent, !entry.isPinned, let rank = rank(identifier) else { return nil }
+                return (identifier, rank, entry.lastAccess)
+            }
+            .sorted { ($0.rank, $0.lastAccess) < ($1.rank, $1.lastAccess) }
+            .map { $0.identifier }
+    }
+
+    // MARK: - Writing
+
+    /// Records the downloaded content of a book, replacing any previous entry.
+    func record(_ identifier: String, fileNames: [String], bytes: Int64, lastAccess: Date = Date()) {
+        queue.async {
+            let entry = Entry(fileNames: fileNames, bytes: bytes, lastAccess: lastAccess)
+            self.total += bytes - (self.entries.updateValue(entry, forKey: identifier)?.bytes ?? 0)
+            self.persist()
+        }
+    }
+
+    /// Marks a book as opened.
+    func touch(_ identifier: String, at date: Date = Date()) {
+        queue.async {
+            guard self.entries[identifier] != nil else { return }
+            self.entries[identifier]?.lastAccess = date
+            self.persist()
+        }
+    }
+
+    func remove(_ identifier: String) {
+        queue.async {
+            guard let entry = self.entries.removeValue(forKey: identifier) else { return }
+            self.total -= entry.bytes
+            self.persist()
+        }
+    }
+
+    /// Replaces all entries, e.g. with content found on disk.
+    func rebuild(_ newEntries: [String: Entry]) {
+        queue.async {
+            self.entries = newEntries
+            self.total = newEntries.values.reduce(0) { $0 + $1.bytes }
+            self.persist()
+        }
+    }
+
+    /// Forgets all entries and deletes the ledger file.
+    func removeAll() {
+        queue.async {
+            self.entries.removeAll()
+            self.total = 0
+            self.isOnDisk = false
+            try? FileManager.default.removeItem(at: self.url)
+        }
+    }
+
+    /// Waits for pending mutations to be written.
+    func flush() {
+        queue.sync { }
+    }
+
+    // MARK: - Private
+
+    private func persist() {
+        do {
+            let data = try JSONEncoder().encode(entries)
+            try FileManager.default.createDirectory(at: url.deletingLastPathComponent(), withIntermediateDirectories: true)
+            try data.write(to: url, options: .atomic)
+            isOnDisk = true
+        } catch {
+            Log.error(#file, "Error saving content ledger: \(error.localizedDescription)")
+        }
+    }
+}
@@ -16,12 +16,24 @@ import OverdriveProcessor
 #endif
 
 /// Modern Swift actor for coordinating downloads - NO LOCKS!
+///
+/// Pending downloads start by `DownloadPriority`, then in the order they were
+/// requested. Books whose running download was suspended to make room for a
+/// higher priority go back to the pending queue and are resumed from there.
 actor DownloadCoordinator {
+    private struct PendingDownload {
+        let book: TPPBook
+        let priority: DownloadPriority
+    }
+
     private var activeDownloadIdentifiers: Set<String> = []
     private var startTimes: [String: Date] = [:]
     private let minimumStartDelay: TimeInterval = 0.3
-    private var pendingQueue: [TPPBook] = []
-    private var downloadInfoCache: [String: MyBooksDownloadInfo] = [:]
+    /// Ordered by priority, then by request order.
+    private var pendingQueue: [PendingDownload] = []
+    private var priorities: [String: DownloadPriority] = [:]
+    private var throughput = DownloadThroughputController()
+    private var singleStreamIdentifiers: Set<String> = []
     private var redirectAttempts: [Int: Int] = [:]
 
     var activeCount: Int {
@@ -32,10 +44,21 @@ actor DownloadCoordinator {
         pendingQueue.count
     }
 
+    /// Number of concurrent downloads that currently gives the best throughput.
+    var concurrencyLimit: Int {
+        throughput.limit
+    }
+
     func canStartDownload(maxConcurrent: Int) -> Bool {
         activeDownloadIdentifiers.count < maxConcurrent
     }
 
+    /// `false` if all slots are taken, or a book the patron is waiting for is
+    /// downloading and `identifier` can wait until it's done.
+    func canStartDownload(_ identifier: String, maxConcurrent: Int) -> Bool {
+        canStartDownload(maxConcurrent: maxConcurrent) && !isHeldBack(priority(for: identifier))
+    }
+
     func shouldThrottleStart() async -> TimeInterval {
         guard let lastStartTime = startTimes.values.max() else {
             return 0
@@ -58,31 +81,153 @@ actor DownloadCoordinator {
         startTimes.removeValue(forKey: identifier)
     }
 
+    // MARK: - Priorities
+
+    /// Sets the priority of the book's download, including restarts after authentication or redirects.
+    func setPriority(_ priority: DownloadPriority, for identifier: String) {
+        priorities[identifier] = priority
+        if let index = pendingQueue.firstIndex(where: { $0.book.identifier == identifier }) {
+            let pending = pendingQueue.remove(at: index)
+            insertPending(PendingDownload(book: pending.book, priority: priority))
+        }
+    }
+
+    func priority(for identifier: String) -> DownloadPriority {
+        priorities[identifier] ?? .explicit
+    }
+
+    /// Forgets the priority and queue position of a download that finished, failed or was cancelled.
+    func clearScheduling(for identifier: String) {
+        priorities.removeValue(forKey: identifier)
+        pendingQueue.removeAll { $0.book.identifier == identifier }
+        singleStreamIdentifiers.remove(identifier)
+    }
+
+    /// Running downloads to suspend before starting the download for `identifier`.
+    ///
+    /// A book the patron opened suspends all prefetches and background downloads.
+    /// Otherwise, if all slots are taken, the most recently started download of
+    /// the lowest priority below the new one is suspended.
+    func preemptionVictims(for identifier: String, maxConcurrent: Int) -> [String] {
+        let newPriority = priority(for: identifier)
+        var victims = [String]()
+        if newPriority == .userOpen {
+            victims = Array(activeDownloadIdentifiers.filter { priority(for: $0) <= .backgroundRedownload })
+        }
+
+        let remaining = activeDownloadIdentifiers.subtracting(victims)
+        if remaining.count >= maxConcurrent,
+           let victim = remaining
+            .filter({ priority(for: $0) < newPriority })
+            .min(by: { lhs, rhs in
+                let (lhsPriority, rhsPriority) = (priority(for: lhs), priority(for: rhs))
+                if lhsPriority != rhsPriority {
+                    return lhsPriority < rhsPriority
+                }
+                return (startTimes[lhs] ?? .distantPast) > (startTimes[rhs] ?? .distantPast)
+            }) {
+            victims.append(victim)
+        }
+        return victims
+    }
+
+    /// Moves a suspended download from the active set back to the pending queue.
+    func registerPreempted(_ book: TPPBook) {
+        registerCompletion(identifier: book.identifier)
+        enqueuePending(book)
+    }
+
+    /// Makes room for the download of `identifier`, suspending the downloads
+    /// `preemptionVictims(for:maxConcurrent:)` picks with `suspend`, which
+    /// returns the book it suspended, or `nil` if nothing was running.
+    /// - Returns: `true` if the download can start now; otherwise the caller queues it.
+    func admit(_ identifier: String, maxConcurrent: Int, suspend: (String) async -> TPPBook?) async -> Bool {
+        guard !canStartDownload(identifier, maxConcurrent: maxConcurrent) || priority(for: identifier) == .userOpen else {
+            return true
+        }
+        for victim in preemptionVictims(for: identifier, maxConcurrent: maxConcurrent) {
+            if let book = await suspend(victim) {
+                registerPreempted(book)
+            }
+        }
+        return canStartDownload(identifier, maxConcurrent: maxConcurrent)
+    }
+
+    /// Takes the pending downloads that fit within `maxConcurrent`. Suspended
+    /// ones are continued with `resume`, which returns `false` for a book
+    /// without a suspended download, and count as started.
+    /// - Returns: Books whose download has to be started.
+    func takePendingStarts(maxConcurrent: Int, resume: (TPPBook) async -> Bool) async -> [TPPBook] {
+        var toStart = [TPPBook]()
+        for book in dequeuePending(capacity: maxConcurrent - activeCount) {
+            if await resume(book) {
+                registerStart(identifier: book.identifier)
+            } else {
+                toStart.append(book)
+            }
+        }
+        return toStart
+    }
+
+    /// `true` if the book is waiting in the pending queue.
+    func isPending(_ identifier: String) -> Bool {
+        pendingQueue.contains { $0.book.identifier == identifier }
+    }
+
+    // MARK: - Segmenting
+
+    /// Keeps the current download of the book in a single stream, e.g. after a segmented download failed.
+    func disableSegmenting(for identifier: String) {
+        singleStreamIdentifiers.insert(identifier)
+    }
+
+    func allowsSegmenting(_ identifier: String) -> Bool {
+        !singleStreamIdentifiers.contains(identifier)
+    }
+
+    // MARK: - Throughput
+
+    /// Adds bytes received for a running download.
+    /// - Returns: `true` if the concurrency limit changed.
+    func recordProgress(identifier: String, bytes: Int64) -> Bool {
+        throughput.record(bytes: bytes, for: identifier)
+    }
+
+    // MARK: - Pending Queue
+
     func enqueuePending(_ book: TPPBook) {
-        if !pendingQueue.contains(where: { $0.identifier == book.identifier }) {
-            pendingQueue.append(book)
+        if !pendingQueue.contains(where: { $0.book.identifier == book.identifier }) {
+            insertPending(PendingDownload(book: book, priority: priority(for: book.identifier)))
         }
     }
 
     func dequeuePending(capacity: Int) -> [TPPBook] {
         guard capacity > 0, !pendingQueue.isEmpty else { return [] }
 
-        let toStart = Array(pendingQueue.prefix(capacity))
-        pendingQueue.removeFirst(min(capacity, pendingQueue.count))
+        var toStart = [TPPBook]()
+        var index = pendingQueue.startIndex
+        while toStart.count < capacity && index < pendingQueue.endIndex {
+            if isHeldBack(pendingQueue[index].priority) {
+                index += 1
+            } else {
+                toStart.append(pendingQueue.remove(at: index).book)
+            }
+        }
         return toStart
     }
 
-    func cacheDownloadInfo(_ info: MyBooksDownloadInfo, for identifier: String) {
-        downloadInfoCache[identifier] = info
+    private func insertPending(_ pending: PendingDownload) {
+        let index = pendingQueue.firstIndex { $0.priority < pending.priority } ?? pendingQueue.endIndex
+        pendingQueue.insert(pending, at: index)
     }
 
-    func getCachedDownloadInfo(for identifier: String) -> MyBooksDownloadInfo? {
-        downloadInfoCache[identifier]
+    /// Prefetches and background downloads wait while a book the patron opened is downloading.
+    private func isHeldBack(_ priority: DownloadPriority) -> Bool {
+        priority <= .backgroundRedownload
+            && activeDownloadIdentifiers.contains { self.priority(for: $0) == .userOpen }
     }
 
-    func removeCachedDownloadInfo(for identifier: String) {
-        downloadInfoCache.removeValue(forKey: identifier)
-    }
+    // MARK: - Redirects
 
     func getRedirectAttempts(for taskID: Int) -> Int {
         redirectAttempts[taskID] ?? 0
@@ -100,7 +245,8 @@ actor DownloadCoordinator {
         activeDownloadIdentifiers.removeAll()
         startTimes.removeAll()
         pendingQueue.removeAll()
-        downloadInfoCache.removeAll()
+        priorities.removeAll()
+        singleStreamIdentifiers.removeAll()
         redirectAttempts.removeAll()
     }
 }
@@ -144,13 +290,30 @@ struct DownloadErrorInfo {
     private var session: URLSession!
 
     // Thread-safe actor-based dictionaries
-    private let bookIdentifierToDownloadInfo = SafeDictionary<String, MyBooksDownloadInfo>()
+    /// Read synchronously by the UI, so it doesn't wait on the actors below.
+    private let downloadProgressTable = DownloadProgressTable()
     private let bookIdentifierToDownloadTask = SafeDictionary<String, URLSessionDownloadTask>()
     private let taskIdentifierToBook = SafeDictionary<Int, TPPBook>()
+    /// Large downloads continued over range requests, by book identifier.
+    private let segmentedDownloads = SafeDictionary<String, SegmentedRangeDownload>()
+    /// Requests of downloads continued from resume data, by task identifier,
+    /// to start them over if the resume data turns out to be stale.
+    private let resumedTaskRequests = SafeDictionary<Int, URLRequest>()
 
     // Serial execution for download operations (replaces downloadQueue)
     private let downloadExecutor = SerialExecutor()
 
+    /// Receives the download session's delegate callbacks, so progress and
+    /// completions don't queue up behind the UI.
+    private let sessionDelegateQueue: OperationQueue = {
+        let queue = OperationQueue()
+        queue.name = "org.thepalaceproject.downloadCenter.sessionDelegate"
+        queue.maxConcurrentOperationCount = 1
+        queue.qualityOfService = .utility
+        return queue
+    }()
+    private let completionPipeline = DownloadCompletionPipeline()
+
     let downloadProgressPublisher = PassthroughSubject<(String, Double), Never>()
 
     /// Publishes download error alerts for a given book identifier.
@@ -159,11 +322,16 @@ struct DownloadErrorInfo {
     /// presentation, which can fail when a SwiftUI sheet is topmost.
     let downloadErrorPublisher = PassthroughSubject<DownloadErrorInfo, Never>()
 
-    private var maxConcurrentDownloads: Int = 4  // Increased from 2 for better UX
+    /// Upper bound for concurrent downloads, lowered under memory pressure. Within
+    /// it, `DownloadCoordinator.concurrencyLimit` adapts to the measured throughput.
+    private var maxConcurrentDownloads: Int = DownloadThroughputController.maximumLimit
     private let downloadCoordinator = DownloadCoordinator()
 
+    /// Publishes `downloadProgressPublisher` once per frame with the latest progress.
+    @MainActor private lazy var progressBroadcaster = DownloadProgressBroadcaster(table: downloadProgressTable) { [weak self] identifier, progress in
+        self?.downloadProgressPublisher.send((identifier, progress))
+    }
     @MainActor private var lastBroadcastTime: Date = Date.distantPast
-    @MainActor private var pendingBroadcast: DispatchWorkItem?
 
     init(
         userAccount: TPPUserAccount = TPPUserAccount.sharedAccount(),
@@ -194,7 +362,7 @@ struct DownloadErrorInfo {
         if #available(iOS 13.0, *) {
             configuration.allowsConstrainedNetworkAccess = true
         }
-        self.session = URLSession(configuration: configuration, delegate: self, delegateQueue: .main)
+        self.session = URLSession(configuration: configuration, delegate: self, delegateQueue: sessionDelegateQueue)
 
         // Setup intelligent download management
         setupNetworkMonitoring()
@@ -250,9 +418,15 @@ struct DownloadErrorInfo {
         accessibilityAnnouncements.announceStatus(title: errorInfo.title, message: errorInfo.message)
     }
 
+    /// The last step of a completed download. Only the state change runs on the main actor.
     private func markDownloadSuccessful(for book: TPPBook) {
-        bookRegistry.setState(.downloadSuccessful, for: book.identifier)
-        announceDownloadCompleted(for: book)
+        recordDownloadedContent(for: book)
+        downloadResumeStore(for: nil)?.remove(book.identifier)
+        Task { await downloadCoordinator.clearScheduling(for: book.identifier) }
+        runOnMainAsync {
+            self.bookRegistry.setState(.downloadSuccessful, for: book.identifier)
+            self.announceDownloadCompleted(for: book)
+        }
     }
 
     /// Legacy callback-based borrow method - wraps the modern async implementation
@@ -411,10 +585,23 @@ struct DownloadErrorInfo {
         }
     }
 
-    private func startDownloadAsync(for book: TPPBook, withRequest initedRequest: URLRequest? = nil) async {
+    /// Starts a download with the given priority. Downloads started again later,
+    /// e.g. after authentication, keep it until they finish.
+    @objc func startDownload(for book: TPPBook, priority: DownloadPriority) {
+        Task {
+            await downloadCoordinator.setPriority(priority, for: book.identifier)
+            await startDownloadAsync(for: book, withRequest: nil)
+        }
+    }
+
+    /// - Parameter isDequeued: The book comes from the pending queue, where it
+    ///   was already marked as downloading.
+    private func startDownloadAsync(for book: TPPBook, withRequest initedRequest: URLRequest? = nil, isDequeued: Bool = false) async {
         let existingInfo = await downloadInfoAsync(forBookIdentifier: book.identifier)
         if existingInfo != nil {
             Log.debug(#file, "Download already in progress for '\(book.title)', skipping duplicate start")
+            // A suspended download that was requested again may now outrank a running one.
+            schedulePendingStartsIfPossible()
             return
         }
 
@@ -433,9 +620,11 @@ struct DownloadErrorInfo {
                 location: location,
                 loginRequired: loginRequired
             )
-        case .downloading:
+        case .downloading where !isDequeued:
             Log.debug(#file, "Book '\(book.title)' is already downloading (state check), skipping")
             return
+        case .downloading:
+            break
         case .downloadFailed, .downloadNeeded, .holding, .SAMLStarted:
             break
         case .downloadSuccessful, .used, .unsupported, .returning:
@@ -443,11 +632,14 @@ struct DownloadErrorInfo {
             return
         }
 
-        let canStart = await downloadCoordinator.canStartDownload(maxConcurrent: maxConcurrentDownloads)
-        let activeCount = await downloadCoordinator.activeCount
+        let maxConcurrent = await effectiveConcurrencyLimit()
+        let canStart = await downloadCoordinator.admit(book.identifier, maxConcurrent: maxConcurrent) { [weak self] victim in
+            await self?.preemptDownload(for: victim)
+        }
 
         if !canStart {
-            Log.debug(#file, "Max concurrent downloads reached (\(activeCount)/\(maxConcurrentDownloads)), enqueueing '\(book.title)'")
+            let activeCount = await downloadCoordinator.activeCount
+            Log.debug(#file, "Max concurrent downloads reached (\(activeCount)/\(maxConcurrent)), enqueueing '\(book.title)'")
             enqueuePending(book)
             return
         }
@@ -790,7 +982,7 @@ struct DownloadErrorInfo {
             Log.warn(#file, "SAML re-auth already attempted for '\(book.title)' - showing sign-in modal")
 
             Task { @MainActor in
-                await self.bookIdentifierToDownloadInfo.remove(book.identifier)
+                self.downloadProgressTable.remove(book.identifier)
                 await self.downloadCoordinator.registerCompletion(identifier: book.identifier)
 
                 bookRegistry.setState(.downloadFailed, for: book.identifier)
@@ -832,7 +1024,7 @@ struct DownloadErrorInfo {
             Log.info(#file, "SAML cookies expired - triggering SAML re-auth flow")
 
             Task {
-                await self.bookIdentifierToDownloadInfo.remove(book.identifier)
+                self.downloadProgressTable.remove(book.identifier)
                 await self.downloadCoordinator.registerCompletion(identifier: book.identifier)
 
                 await MainActor.run {
@@ -907,8 +1099,8 @@ struct DownloadErrorInfo {
 
                 Task {
                     // Clean up coordinator even without a download task
-                    await self.downloadCoordinator.removeCachedDownloadInfo(for: identifier)
                     await self.downloadCoordinator.registerCompletion(identifier: identifier)
+                    await self.downloadCoordinator.clearScheduling(for: identifier)
                     let remainingCount = await self.downloadCoordinator.activeCount
                     Log.info(#file, "📊 Download cancelled (no task) for '\(identifier)', remaining active: \(remainingCount)")
                     self.schedulePendingStartsIfPossible()
@@ -933,16 +1125,22 @@ struct DownloadErrorInfo {
         bookRegistry.setState(.downloadNeeded, for: identifier)
         broadcastUpdate()
 
-        // Then cancel the task
-        info.downloadTask.cancel { [weak self] _ in
+        // Then cancel the task, keeping what was downloaded so a retry continues from there
+        let requestUrl = info.downloadTask.originalRequest?.url
+        info.downloadTask.cancel { [weak self] resumeData in
             guard let self else { return }
+            if let resumeData, let requestUrl {
+                self.downloadResumeStore(for: nil)?.saveResumeData(resumeData, for: identifier, url: requestUrl)
+            }
 
             Task {
+                await self.segmentedDownloads.remove(identifier)?.cancel()
+                await self.resumedTaskRequests.remove(taskId)
                 // CRITICAL: Remove from tracking dictionaries so retry works
-                await self.bookIdentifierToDownloadInfo.remove(identifier)
+                self.downloadProgressTable.remove(identifier)
                 await self.taskIdentifierToBook.remove(taskId)
-                await self.downloadCoordinator.removeCachedDownloadInfo(for: identifier)
                 await self.downloadCoordinator.registerCompletion(identifier: identifier)
+                await self.downloadCoordinator.clearScheduling(for: identifier)
                 let remainingCount = await self.downloadCoordinator.activeCount
                 Log.info(#file, "📊 Download cancelled for '\(identifier)', remaining active: \(remainingCount)")
                 self.schedulePendingStartsIfPossible()
@@ -954,6 +1152,8 @@ struct DownloadErrorInfo {
 extension MyBooksDownloadCenter {
     func deleteLocalContent(for identifier: String, account: String? = nil) {
         let current_account: String? = account ?? AccountsManager.shared.currentAccountId
+        contentLedger(for: current_account)?.remove(identifier)
+        downloadResumeStore(for: current_account)?.remove(identifier)
         guard let book = bookRegistry.book(forIdentifier: identifier),
               let bookURL = fileUrl(for: identifier, account: current_account) else {
             Log.warn(#file, "Could not find book to delete local content \(identifier)")
@@ -968,6 +1168,12 @@ extension MyBooksDownloadCenter {
                 } else {
                     Log.info(#file, "Content file already missing (nothing to delete): \(bookURL.lastPathComponent)")
                 }
+                if book.defaultBookContentType == .pdf {
+                    TPPPDFSearchIndex.deleteIndex(forBookAt: bookURL)
+                    TPPPDFThumbnailStore.deleteStore(forBookAt: bookURL)
+                } else {
+                    EPUBSearchIndex.deleteIndex(forBookAt: bookURL)
+                }
                 #if LCP
                 if book.defaultBookContentType == .pdf {
                     try LCPPDFs.deletePdfContent(url: bookURL)
@@ -1195,7 +1401,7 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
         didResumeAtOffset fileOffset: Int64,
         expectedTotalBytes: Int64
     ) {
-        NSLog("Ignoring unexpected resumption.")
+        Log.info(#file, "Download resumed at \(fileOffset) of \(expectedTotalBytes) bytes")
     }
 
     func urlSession(
@@ -1207,6 +1413,18 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
     ) {
         let key = downloadTask.taskIdentifier
 
+        if let identifier = SegmentedRangeDownload.identifier(fromTaskDescription: downloadTask.taskDescription) {
+            Task {
+                guard let download = await segmentedDownloads.get(identifier) else {
+                    // Left running by a previous launch; parts on disk are continued once the book is downloaded again.
+                    downloadTask.cancel()
+                    return
+                }
+                download.didWriteData(for: downloadTask, totalBytesWritten: totalBytesWritten)
+            }
+            return
+        }
+
         // Bridge to async for actor access
         Task {
             guard let book = await taskIdentifierToBook.get(key) else {
@@ -1264,7 +1482,7 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
         originalTask: URLSessionDownloadTask,
         session: URLSession
     ) async -> Bool {
-        guard let xmlData = try? Data(contentsOf: location) else {
+        guard let xmlData = DownloadedFileSniffer.document(at: location) else {
             Log.error(#file, "Failed to read OPDS entry XML for \(book.identifier)")
             return false
         }
@@ -1324,7 +1542,7 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
             rightsManagement: newRights
         )
 
-        await bookIdentifierToDownloadInfo.set(updatedBook.identifier, value: downloadInfo)
+        downloadProgressTable.set(updatedBook.identifier, value: downloadInfo)
         await taskIdentifierToBook.set(newTask.taskIdentifier, value: updatedBook)
 
         newTask.resume()
@@ -1352,26 +1570,45 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
 
             if detectedRights != .unknown {
                 if let info = await downloadInfoAsync(forBookIdentifier: book.identifier)?.withRightsManagement(detectedRights) {
-                    await bookIdentifierToDownloadInfo.set(book.identifier, value: info)
+                    downloadProgressTable.set(book.identifier, value: info)
                 }
             } else if TPPUserAccount.sharedAccount().isTokenRefreshRequired() {
                 NSLog("Authentication might be needed after all")
                 TPPNetworkExecutor.shared.refreshTokenAndResume(task: task)
                 return
             }
+
+            if detectedRights == .none,
+               await startSegmentedDownload(for: book, replacing: task, expectedLength: totalBytesExpectedToWrite) {
+                return
+            }
+        }
+
+        await recordDownloadProgress(
+            for: book,
+            bytesWritten: bytesWritten,
+            totalBytesWritten: totalBytesWritten,
+            totalBytesExpectedToWrite: totalBytesExpectedToWrite
+        )
+    }
+
+    private func recordDownloadProgress(
+        for book: TPPBook,
+        bytesWritten: Int64,
+        totalBytesWritten: Int64,
+        totalBytesExpectedToWrite: Int64
+    ) async {
+        if await downloadCoordinator.recordProgress(identifier: book.identifier, bytes: bytesWritten) {
+            let limit = await downloadCoordinator.concurrencyLimit
+            Log.debug(#file, "📊 Download concurrency adapted to \(limit)")
+            schedulePendingStartsIfPossible()
         }
 
         let rightsManagement = await downloadInfoAsync(forBookIdentifier: book.identifier)?.rightsManagement ?? .none
         if rightsManagement != .adobe && rightsManagement != .simplifiedBearerTokenJSON && rightsManagement != .overdriveManifestJSON {
             if totalBytesExpectedToWrite > 0 {
                 let progress = Double(totalBytesWritten) / Double(totalBytesExpectedToWrite)
-                if let info = await downloadInfoAsync(forBookIdentifier: book.identifier)?.withDownloadProgress(progress) {
-                    await bookIdentifierToDownloadInfo.set(book.identifier, value: info)
-                }
-
-                await MainActor.run {
-                    downloadProgressPublisher.send((book.identifier, progress))
-                }
+                publishDownloadProgress(progress, for: book.identifier)
 
                 if progress > 0.95 || Int(progress * 100) % 20 == 0 {
                     broadcastUpdate()
@@ -1392,9 +1629,20 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
             return
         }
 
-        // Now process async with preserved file
-        Task {
-            await handleDownloadCompletion(session: session, task: downloadTask, location: safeLocation)
+        if let identifier = SegmentedRangeDownload.identifier(fromTaskDescription: downloadTask.taskDescription) {
+            Task {
+                guard let download = await segmentedDownloads.get(identifier) else {
+                    try? FileManager.default.removeItem(at: safeLocation)
+                    return
+                }
+                download.didFinishDownloading(downloadTask, to: safeLocation)
+            }
+            return
+        }
+
+        // Now process the preserved file in the completion pipeline
+        completionPipeline.submit { [weak self] in
+            await self?.handleDownloadCompletion(session: session, task: downloadTask, location: safeLocation)
         }
     }
 
@@ -1405,6 +1653,15 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
 
         await downloadCoordinator.clearRedirectAttempts(for: task.taskIdentifier)
 
+        if let request = await resumedTaskRequests.remove(task.taskIdentifier),
+           let response = task.response as? HTTPURLResponse, !response.isSuccess() {
+            Log.warn(#file, "Resumed download for '\(book.title)' was rejected (\(response.statusCode)), starting over")
+            try? FileManager.default.removeItem(at: location)
+            await taskIdentifierToBook.remove(task.taskIdentifier)
+            addDownloadTask(with: request, book: book)
+            return
+        }
+
         var failureRequiringAlert = false
         var failureError = task.error
         var problemDoc: TPPProblemDocument?
@@ -1414,14 +1671,14 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
             Log.info(#file, "⚠️ Rights unknown, detecting from completion MIME type: \(mimeType)")
             rights = detectRightsManagement(from: mimeType)
             if let info = await downloadInfoAsync(forBookIdentifier: book.identifier)?.withRightsManagement(rights) {
-                await bookIdentifierToDownloadInfo.set(book.identifier, value: info)
+                downloadProgressTable.set(book.identifier, value: info)
             }
         }
 
         Log.info(#file, "Download completed for \(book.identifier) with rights: \(rights)")
 
         if let response = task.response, response.isProblemDocument() {
-            let problemDocData = (try? Data(contentsOf: location)) ?? Data()
+            let problemDocData = DownloadedFileSniffer.document(at: location) ?? Data()
             problemDoc = TPPProblemDocument.fromProblemResponseData(problemDocData)
             if problemDoc == nil {
                 TPPErrorLogger.logProblemDocumentParseError(NSError(domain: "MyBooksDownloadCenter", code: -1, userInfo: [NSLocalizedDescriptionKey: "Could not parse problem document"]), problemDocumentData: problemDocData.isEmpty ? nil : problemDocData, url: location, summary: "Error parsing problem doc downloading \(String(describing: book.distributor)) book", metadata: ["book": book.loggableShortString])
@@ -1462,14 +1719,13 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
                 failureRequiringAlert = true
             case .adobe:
                 #if FEATURE_DRM_CONNECTOR
-                if let acsmData = try? Data(contentsOf: location),
-                   let acsmString = String(data: acsmData, encoding: .utf8),
-                   acsmString.contains(">application/pdf</dc:format>") {
+                let acsmData = DownloadedFileSniffer.document(at: location)
+                if let acsmData, DownloadedFileSniffer.isAdobePDF(acsm: acsmData) {
                     let msg = NSLocalizedString("\(book.title) is an Adobe PDF, which is not supported.", comment: "")
                     failureError = NSError(domain: TPPErrorLogger.clientDomain, code: TPPErrorCode.ignore.rawValue, userInfo: [NSLocalizedDescriptionKey: msg])
                     logBookDownloadFailure(book, reason: "Received PDF for AdobeDRM rights", downloadTask: task, metadata: nil)
                     failureRequiringAlert = true
-                } else if let acsmData = try? Data(contentsOf: location) {
+                } else if let acsmData {
                     NSLog("Download finished. Fulfilling with userID: \(userAccount.userID ?? "")")
                     AdobeDRMService.shared.fulfill(withACSMData: acsmData, tag: book.identifier, userID: userAccount.userID, deviceID: userAccount.deviceID)
                 }
@@ -1477,7 +1733,7 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
             case .lcp:
                 fulfillLCPLicense(fileUrl: location, forBook: book, downloadTask: task)
             case .simplifiedBearerTokenJSON:
-                if let data = try? Data(contentsOf: location) {
+                if let data = DownloadedFileSniffer.document(at: location) {
                     if let dictionary = TPPJSONObjectFromData(data) as? [String: Any],
                        let simplifiedBearerToken = MyBooksSimplifiedBearerToken.simplifiedBearerToken(with: dictionary) {
                         let cmFulfillURL = task.originalRequest?.url
@@ -1492,7 +1748,7 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
                             rightsManagement: .none,
                             bearerToken: simplifiedBearerToken
                         )
-                        await bookIdentifierToDownloadInfo.set(book.identifier, value: downloadInfo)
+                        downloadProgressTable.set(book.identifier, value: downloadInfo)
                         book.bearerToken = simplifiedBearerToken.accessToken
                         book.bearerTokenFulfillURL = cmFulfillURL
                         await taskIdentifierToBook.set(newTask.taskIdentifier, value: book)
@@ -1535,7 +1791,7 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
 
                             Task {
                                 // Clear download tracking completely
-                                await self.bookIdentifierToDownloadInfo.remove(book.identifier)
+                                self.downloadProgressTable.remove(book.identifier)
                                 await self.taskIdentifierToBook.remove(task.taskIdentifier)
                                 await self.downloadCoordinator.registerCompletion(identifier: book.identifier)
 
@@ -1607,7 +1863,7 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
                         self.userAccount.markCredentialsStale()
 
                         Task {
-                            await self.bookIdentifierToDownloadInfo.remove(book.identifier)
+                            self.downloadProgressTable.remove(book.identifier)
                             await self.taskIdentifierToBook.remove(task.taskIdentifier)
                             await self.downloadCoordinator.registerCompletion(identifier: book.identifier)
 
@@ -1660,9 +1916,8 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
 
         broadcastUpdate()
 
-        // CRITICAL: Remove from bookIdentifierToDownloadInfo so retry works
-        await bookIdentifierToDownloadInfo.remove(book.identifier)
-        await downloadCoordinator.removeCachedDownloadInfo(for: book.identifier)
+        // CRITICAL: Remove from the progress table so retry works
+        downloadProgressTable.remove(book.identifier)
         await downloadCoordinator.registerCompletion(identifier: book.identifier)
         let remainingCount = await downloadCoordinator.activeCount
         Log.info(#file, "📊 Download flow completed for '\(book.identifier)', remaining active: \(remainingCount)")
@@ -1670,53 +1925,38 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
         schedulePendingStartsIfPossible()
     }
 
-    /// Async-first download info accessor with cache update
+    /// Async-first download info accessor
     func downloadInfoAsync(forBookIdentifier bookIdentifier: String) async -> MyBooksDownloadInfo? {
-        guard let downloadInfo = await bookIdentifierToDownloadInfo.get(bookIdentifier) else {
-            await downloadCoordinator.removeCachedDownloadInfo(for: bookIdentifier)
-            return nil
-        }
-
-        if downloadInfo is MyBooksDownloadInfo {
-            await downloadCoordinator.cacheDownloadInfo(downloadInfo, for: bookIdentifier)
-            return downloadInfo
-        } else {
-            Log.error(#file, "Corrupted download info detected for book \(bookIdentifier), removing entry")
-            await bookIdentifierToDownloadInfo.remove(bookIdentifier)
-            await downloadCoordinator.removeCachedDownloadInfo(for: bookIdentifier)
-            return nil
-        }
+        downloadProgressTable.get(bookIdentifier)
     }
 
-    /// Synchronous wrapper for legacy compatibility (@objc, UIKit delegates)
-    /// Uses semaphore but with short timeout to avoid UI blocking
+    /// Synchronous accessor for legacy compatibility (@objc, UIKit delegates).
+    /// Reads the progress table directly, so it never blocks the caller.
     @objc func downloadInfo(forBookIdentifier bookIdentifier: String) -> MyBooksDownloadInfo? {
-        let semaphore = DispatchSemaphore(value: 0)
-        var result: MyBooksDownloadInfo?
-
-        Task.detached(priority: .userInitiated) {
-            result = await self.downloadCoordinator.getCachedDownloadInfo(for: bookIdentifier)
-
-            if result == nil {
-                result = await self.downloadInfoAsync(forBookIdentifier: bookIdentifier)
-            }
+        downloadProgressTable.get(bookIdentifier)
+    }
 
-            semaphore.signal()
+    /// Records download progress; subscribers of `downloadProgressPublisher`
+    /// get it on the next frame, with only the latest value per book.
+    func publishDownloadProgress(_ progress: Double, for bookIdentifier: String) {
+        guard downloadProgressTable.setProgress(progress, for: bookIdentifier) else {
+            // A frame is already coming.
+            return
+        }
+        runOnMainAsync { [weak self] in
+            self?.progressBroadcaster.start()
         }
-
-        _ = semaphore.wait(timeout: .now() + 0.05)
-        return result
     }
 
     func broadcastUpdate() {
+        // Changes made meanwhile go out with the scheduled notification.
+        guard downloadProgressTable.scheduleBroadcast() else { return }
         Task { @MainActor [weak self] in
             self?.broadcastUpdateOnMain()
         }
     }
 
     @MainActor private func broadcastUpdateOnMain() {
-        pendingBroadcast?.cancel()
-
         let timeSinceLastBroadcast = Date().timeIntervalSince(lastBroadcastTime)
         let minimumBroadcastInterval: TimeInterval = 0.5
 
@@ -1724,23 +1964,24 @@ extension MyBooksDownloadCenter: URLSessionDownloadDelegate {
             broadcastUpdateNow()
         } else {
             let delay = minimumBroadcastInterval - timeSinceLastBroadcast
-            let workItem = DispatchWorkItem { [weak self] in
+            DispatchQueue.main.asyncAfter(deadline: .now() + delay) { [weak self] in
                 Task { @MainActor in
                     self?.broadcastUpdateNow()
                 }
             }
-            pendingBroadcast = workItem
-            DispatchQueue.main.asyncAfter(deadline: .now() + delay, execute: workItem)
         }
     }
 
+    /// Posts `TPPMyBooksDownloadCenterDidChange` with the downloads that
+    /// changed since the previous post.
     @MainActor private func broadcastUpdateNow() {
         lastBroadcastTime = Date()
-        pendingBroadcast = nil
+        let changedIdentifiers = downloadProgressTable.takeChangedIdentifiers()
 
         NotificationCenter.default.post(
             name: Notification.Name.TPPMyBooksDownloadCenterDidChange,
-            object: self
+            object: self,
+            userInfo: [TPPNotificationKeys.downloadCenterBookIdentifiersKey: Array(changedIdentifiers)]
         )
     }
 }
@@ -1801,16 +2042,43 @@ extension MyBooksDownloadCenter: URLSessionTaskDelegate {
     }
 
     private func handleTaskCompletion(task: URLSessionTask, error: Error?) async {
+        if let identifier = SegmentedRangeDownload.identifier(fromTaskDescription: task.taskDescription) {
+            await downloadCoordinator.clearRedirectAttempts(for: task.taskIdentifier)
+            await segmentedDownloads.get(identifier)?.didComplete(task, error: error)
+            return
+        }
+
         guard let book = await taskIdentifierToBook.get(task.taskIdentifier) else {
+            // Tasks of a previous launch are only known by their description.
+            if let identifier = task.taskDescription, let error = error as NSError? {
+                saveResumeData(from: task, error: error, for: identifier)
+            }
             return
         }
 
         await downloadCoordinator.clearRedirectAttempts(for: task.taskIdentifier)
+
+        let error = error as NSError?
+        if error?.code == NSURLErrorCancelled, await segmentedDownloads.contains(book.identifier) {
+            // Replaced by a segmented download, which completes the book.
+            return
+        }
+
+        if let error, error.code != NSURLErrorCancelled {
+            if let request = await resumedTaskRequests.remove(task.taskIdentifier) {
+                Log.warn(#file, "Resumed download for '\(book.title)' failed (\(error.code)), starting over")
+                await taskIdentifierToBook.remove(task.taskIdentifier)
+                addDownloadTask(with: request, book: book)
+                return
+            }
+            saveResumeData(from: task, error: error, for: book.identifier)
+        }
+
         await downloadCoordinator.registerCompletion(identifier: book.identifier)
         let remainingCount = await downloadCoordinator.activeCount
         Log.info(#file, "📊 Download completed for '\(book.title)', remaining active: \(remainingCount)")
 
-        if let error = error as NSError?, error.code != NSURLErrorCancelled {
+        if let error, error.code != NSURLErrorCancelled {
             logBookDownloadFailure(book, reason: "networking error", downloadTask: task, metadata: ["urlSessionError": error])
             failDownloadWithAlert(for: book)
             return
@@ -1819,9 +2087,27 @@ extension MyBooksDownloadCenter: URLSessionTaskDelegate {
         schedulePendingStartsIfPossible()
     }
 
+    /// Keeps the resume data of a download that failed, so the next attempt continues it.
+    private func saveResumeData(from task: URLSessionTask, error: NSError, for identifier: String) {
+        guard let resumeData = error.userInfo[NSURLSessionDownloadTaskResumeData] as? Data,
+              let requestUrl = task.originalRequest?.url
+        else { return }
+        downloadResumeStore(for: nil)?.saveResumeData(resumeData, for: identifier, url: requestUrl)
+    }
+
     private func addDownloadTask(with request: URLRequest, book: TPPBook) {
         var modifiableRequest = request
-        let task = self.session.downloadTask(with: modifiableRequest.applyCustomUserAgent())
+        let request = modifiableRequest.applyCustomUserAgent()
+        let resumeData = downloadResumeStore(for: nil)?.takeResumeData(for: book.identifier, url: request.url)
+        let isResumed = resumeData != nil
+        let task: URLSessionDownloadTask
+        if let resumeData {
+            Log.info(#file, "Continuing download for '\(book.title)' from resume data")
+            task = self.session.downloadTask(withResumeData: resumeData)
+        } else {
+            task = self.session.downloadTask(with: request)
+        }
+        task.taskDescription = book.identifier
 
         let downloadInfo = MyBooksDownloadInfo(
             downloadProgress: 0.0,
@@ -1830,8 +2116,11 @@ extension MyBooksDownloadCenter: URLSessionTaskDelegate {
         )
 
         Task {
-            await self.bookIdentifierToDownloadInfo.set(book.identifier, value: downloadInfo)
+            self.downloadProgressTable.set(book.identifier, value: downloadInfo)
             await self.taskIdentifierToBook.set(task.taskIdentifier, value: book)
+            if isResumed {
+                await self.resumedTaskRequests.set(task.taskIdentifier, value: request)
+            }
 
             let currentCount = await downloadCoordinator.activeCount
             Log.info(#file, "📊 Active downloads: \(currentCount)/\(maxConcurrentDownloads) (started '\(book.title)')")
@@ -1850,7 +2139,11 @@ extension MyBooksDownloadCenter: URLSessionTaskDelegate {
             self.announceDownloadStarted(for: book)
 
             runOnMainAsync {
-                NotificationCenter.default.post(name: .TPPMyBooksDownloadCenterDidChange, object: self)
+                NotificationCenter.default.post(
+                    name: .TPPMyBooksDownloadCenterDidChange,
+                    object: self,
+                    userInfo: [TPPNotificationKeys.downloadCenterBookIdentifiersKey: [book.identifier]]
+                )
             }
 
             // After starting one, see if we can start pending ones within capacity
@@ -1859,6 +2152,96 @@ extension MyBooksDownloadCenter: URLSessionTaskDelegate {
     }
 }
 
+// MARK: - Resumable and Segmented Downloads
+extension MyBooksDownloadCenter {
+    /// Partial downloads of the account; `nil` means the current account.
+    func downloadResumeStore(for account: String?) -> DownloadResumeStore? {
+        guard let contentDirectory = contentDirectoryURL(account ?? AccountsManager.shared.currentAccountId) else {
+            return nil
+        }
+        return DownloadResumeStore(directory: contentDirectory.appendingPathComponent(DownloadResumeStore.directoryName))
+    }
+
+    /// Continues a large download from a range-capable server over several
+    /// range requests, replacing `task`, which received the first response.
+    /// The range requests run on the background session, like `task`.
+    /// Parts downloaded before an interruption are reused.
+    /// - Returns: `true` if the segmented download started.
+    private func startSegmentedDownload(for book: TPPBook, replacing task: URLSessionDownloadTask, expectedLength: Int64) async -> Bool {
+        guard SegmentedRangeDownload.canSegment(task.response, expectedLength: expectedLength),
+              await downloadCoordinator.allowsSegmenting(book.identifier),
+              let response = task.response as? HTTPURLResponse,
+              let request = task.currentRequest,
+              let store = downloadResumeStore(for: nil)
+        else { return false }
+
+        let download: SegmentedRangeDownload
+        do {
+            download = try SegmentedRangeDownload(
+                request: request,
+                response: response,
+                expectedLength: expectedLength,
+                directory: store.segmentsDirectory(for: book.identifier),
+                session: session,
+                identifier: book.identifier
+            )
+        } catch {
+            Log.error(#file, "Could not start segmented download for '\(book.title)': \(error.localizedDescription)")
+            return false
+        }
+
+        download.progressHandler = { [weak self] bytesWritten, totalBytesWritten, totalBytesExpected in
+            Task {
+                await self?.recordDownloadProgress(
+                    for: book,
+                    bytesWritten: bytesWritten,
+                    totalBytesWritten: totalBytesWritten,
+                    totalBytesExpectedToWrite: totalBytesExpected
+                )
+            }
+        }
+
+        let bytesOnDisk = download.manifest.received.reduce(0, +)
+        Log.info(#file, "Downloading '\(book.title)' in \(download.manifest.segments.count) segments, \(bytesOnDisk) of \(expectedLength) bytes already on disk")
+
+        await segmentedDownloads.set(book.identifier, value: download)
+        task.cancel()
+        download.start { [weak self] result in
+            Task {
+                await self?.finishSegmentedDownload(for: book, replacing: task, result: result)
+            }
+        }
+        return true
+    }
+
+    private func finishSegmentedDownload(for book: TPPBook, replacing task: URLSessionDownloadTask, result: Result<URL, Error>) async {
+        guard await segmentedDownloads.remove(book.identifier) != nil else {
+            // Cancelled meanwhile.
+            if case .success(let location) = result {
+                try? FileManager.default.removeItem(at: location)
+            }
+            return
+        }
+
+        switch result {
+        case .success(let location):
+            await completionPipeline.perform {
+                await handleDownloadCompletion(session: session, task: task, location: location)
+            }
+        case .failure(let error):
+            Log.warn(#file, "Segmented download for '\(book.title)' failed, continuing as a single download: \(error.localizedDescription)")
+            await downloadCoordinator.disableSegmenting(for: book.identifier)
+            await taskIdentifierToBook.remove(task.taskIdentifier)
+            if let request = task.originalRequest {
+                addDownloadTask(with: request, book: book)
+            } else {
+                await downloadCoordinator.registerCompletion(identifier: book.identifier)
+                failDownloadWithAlert(for: book)
+            }
+        }
+    }
+}
+
 // MARK: - Download Throttling and Disk Budget
 extension MyBooksDownloadCenter {
     private func enqueuePending(_ book: TPPBook) {
@@ -1873,7 +2256,11 @@ extension MyBooksDownloadCenter {
 
             // Notify UI to refresh
             runOnMainAsync {
-                NotificationCenter.default.post(name: .TPPMyBooksDownloadCenterDidChange, object: self)
+                NotificationCenter.default.post(
+                    name: .TPPMyBooksDownloadCenterDidChange,
+                    object: self,
+                    userInfo: [TPPNotificationKeys.downloadCenterBookIdentifiersKey: [book.identifier]]
+                )
             }
         }
     }
@@ -1885,69 +2272,174 @@ extension MyBooksDownloadCenter {
     }
 
     private func schedulePendingStartsAsync() async {
-        let activeCount = await downloadCoordinator.activeCount
-        let capacity = maxConcurrentDownloads - activeCount
-
-        guard capacity > 0 else { return }
-
-        let toStart = await downloadCoordinator.dequeuePending(capacity: capacity)
+        let maxConcurrent = await effectiveConcurrencyLimit()
+        let toStart = await downloadCoordinator.takePendingStarts(maxConcurrent: maxConcurrent) { [weak self] book in
+            await self?.resumePreemptedDownload(for: book) ?? false
+        }
         guard !toStart.isEmpty else { return }
 
         let queueRemaining = await downloadCoordinator.queueCount
-        Log.info(#file, "📋 Starting \(toStart.count) pending downloads (capacity: \(capacity), queue remaining: \(queueRemaining))")
+        Log.info(#file, "📋 Starting \(toStart.count) pending downloads (queue remaining: \(queueRemaining))")
 
         for book in toStart {
-            await startDownloadAsync(for: book, withRequest: nil)
+            await startDownloadAsync(for: book, withRequest: nil, isDequeued: true)
         }
     }
 
+    /// Resumes the download of a book suspended by `preemptDownload(for:)`.
+    /// - Returns: `false` if the book has no suspended download.
+    private func resumePreemptedDownload(for book: TPPBook) async -> Bool {
+        if let segmented = await segmentedDownloads.get(book.identifier) {
+            segmented.resume()
+        } else if let task = downloadProgressTable.get(book.identifier)?.downloadTask, task.state == .suspended {
+            task.resume()
+        } else {
+            return false
+        }
+        Log.info(#file, "▶️ Resuming preempted download for '\(book.title)'")
+        return true
+    }
+
+    private func effectiveConcurrencyLimit() async -> Int {
+        min(maxConcurrentDownloads, await downloadCoordinator.concurrencyLimit)
+    }
+
+    /// Suspends a running download to make room for a higher priority one.
+    /// It's resumed from the pending queue.
+    /// - Returns: The book whose download was suspended, if it was running.
+    private func preemptDownload(for identifier: String) async -> TPPBook? {
+        guard let task = downloadProgressTable.get(identifier)?.downloadTask,
+              let book = await taskIdentifierToBook.get(task.taskIdentifier)
+        else { return nil }
+
+        if let segmented = await segmentedDownloads.get(identifier) {
+            segmented.suspend()
+        } else if task.state == .running {
+            task.suspend()
+        } else {
+            return nil
+        }
+        Log.info(#file, "⏸️ Suspending download for '\(book.title)' in favor of a higher priority download")
+        return book
+    }
+
     /// Enforces a soft content disk budget. If `adding` is >0, assumes that many bytes will be added
-    /// and makes room accordingly, deleting least-recently-used content first.
+    /// and makes room accordingly, evicting the downloads of least-recently-opened books first.
     @objc func enforceContentDiskBudgetIfNeeded(adding bytesToAdd: Int64) {
         let smallDevice = UIScreen.main.nativeBounds.height <= 1334 // iPhone 6/7/8 size and below
         // Relax budgets: give small devices ~1.2GB, others ~2.5GB before eviction
         let budgetBytes: Int64 = smallDevice ? (1_200 * 1024 * 1024) : (2_500 * 1024 * 1024)
 
-        let currentUsage = contentDirectoryUsageBytes()
-        var neededFree = (currentUsage + bytesToAdd) - budgetBytes
+        let account = AccountsManager.shared.currentAccountId
+        guard let ledger = contentLedger(for: account) else { return }
+        if ledger.needsRebuild {
+            rebuildContentLedger(ledger, account: account)
+        }
+
+        var neededFree = (ledger.totalBytes + bytesToAdd) - budgetBytes
         guard neededFree > 0 else { return }
 
-        let files = listContentFilesSortedByLRU()
-        let fm = FileManager.default
-        for url in files {
+        for identifier in ledger.evictionCandidates(rank: contentEvictionRank(for:)) {
             if neededFree <= 0 { break }
-            // Never delete LCP license/content files during eviction
-            let ext = url.pathExtension.lowercased()
-            if ext == "lcpl" || ext == "lcpa" { continue }
-            if let size = (try? url.resourceValues(forKeys: [.fileSizeKey]))?.fileSize {
-                try? fm.removeItem(at: url)
-                neededFree -= Int64(size)
+            guard let entry = ledger.entry(for: identifier) else { continue }
+            Log.info(#file, "Evicting downloaded content of \(identifier) (\(entry.bytes) bytes) to stay within disk budget")
+            evictContent(for: identifier, entry: entry, account: account)
+            neededFree -= entry.bytes
+        }
+    }
+
+    /// Books that left the registry go first, then downloaded books. Books in
+    /// any other state, e.g. downloading, are not evicted.
+    private func contentEvictionRank(for identifier: String) -> Int? {
+        guard bookRegistry.book(forIdentifier: identifier) != nil else { return 0 }
+        switch bookRegistry.state(for: identifier) {
+        case .unregistered: return 0
+        case .downloadSuccessful, .used: return 1
+        default: return nil
+        }
+    }
+
+    /// Deletes the content of a book to free disk space. A downloaded book
+    /// goes back to needing a download; a book that was returned, or left the
+    /// registry, keeps its state.
+    func evictContent(for identifier: String, entry: MyBooksContentLedger.Entry, account: String?) {
+        let state = bookRegistry.book(forIdentifier: identifier) == nil ? nil : bookRegistry.state(for: identifier)
+        if state == .downloadSuccessful || state == .used {
+            deleteLocalContent(for: identifier, account: account)
+            bookRegistry.setState(.downloadNeeded, for: identifier)
+        } else {
+            if let directory = contentDirectoryURL(account) {
+                entry.fileNames.forEach { try? FileManager.default.removeItem(at: directory.appendingPathComponent($0)) }
             }
+            contentLedger(for: account)?.remove(identifier)
         }
     }
 
-    private func contentDirectoryUsageBytes() -> Int64 {
-        guard let dir = contentDirectoryURL(AccountsManager.shared.currentAccountId) else { return 0 }
-        let fm = FileManager.default
-        guard let contents = try? fm.contentsOfDirectory(at: dir, includingPropertiesForKeys: [.fileSizeKey], options: [.skipsHiddenFiles]) else { return 0 }
-        var total: Int64 = 0
-        for url in contents {
-            if let size = (try? url.resourceValues(forKeys: [.fileSizeKey]))?.fileSize { total += Int64(size) }
+    func contentLedger(for account: String?) -> MyBooksContentLedger? {
+        guard let account,
+              let url = TPPBookContentMetadataFilesHelper.directory(for: account)?
+                .appendingPathComponent(MyBooksContentLedger.fileName)
+        else { return nil }
+        return MyBooksContentLedger.ledger(for: url)
+    }
+
+    /// Files holding the downloaded content of `book`: the content file, and
+    /// the LCP license or Adobe rights stored next to it, if any.
+    private func contentFileUrls(for book: TPPBook, account: String?) -> [URL] {
+        guard let contentUrl = fileUrl(for: book, account: account) else { return [] }
+        let candidates = [
+            contentUrl,
+            contentUrl.deletingPathExtension().appendingPathExtension("lcpl"),
+            URL(fileURLWithPath: contentUrl.path.appending("_rights.xml"))
+        ]
+        return candidates.filter { FileManager.default.fileExists(atPath: $0.path) }
+    }
+
+    /// Records the content of a completed download in the ledger.
+    private func recordDownloadedContent(for book: TPPBook) {
+        let account = AccountsManager.shared.currentAccountId
+        let urls = contentFileUrls(for: book, account: account)
+        let bytes = urls.reduce(Int64(0)) { total, url in
+            total + Int64((try? url.resourceValues(forKeys: [.fileSizeKey]))?.fileSize ?? 0)
         }
-        return total
+        contentLedger(for: account)?.record(book.identifier, fileNames: urls.map { $0.lastPathComponent }, bytes: bytes)
     }
 
-    private func listContentFilesSortedByLRU() -> [URL] {
-        guard let dir = contentDirectoryURL(AccountsManager.shared.currentAccountId) else { return [] }
-        let fm = FileManager.default
-        guard let contents = try? fm.contentsOfDirectory(at: dir, includingPropertiesForKeys: [.contentAccessDateKey, .contentModificationDateKey], options: [.skipsHiddenFiles]) else { return [] }
-        return contents.sorted { a, b in
-            let ra = try? a.resourceValues(forKeys: [.contentAccessDateKey, .contentModificationDateKey])
-            let rb = try? b.resourceValues(forKeys: [.contentAccessDateKey, .contentModificationDateKey])
-            let da = ra?.contentAccessDate ?? ra?.contentModificationDate ?? Date.distantPast
-            let db = rb?.contentAccessDate ?? rb?.contentModificationDate ?? Date.distantPast
-            return da < db
+    /// Marks a book as opened, so it is evicted after books that were opened longer ago.
+    @objc func recordContentAccess(for identifier: String) {
+        contentLedger(for: AccountsManager.shared.currentAccountId)?.touch(identifier)
+    }
+
+    /// Records content downloaded before the ledger existed. Runs once per account.
+    private func rebuildContentLedger(_ ledger: MyBooksContentLedger, account: String?) {
+        var downloadedBooks = [TPPBook]()
+        bookRegistry.with(account: account ?? "") { registry in
+            downloadedBooks = registry.myBooks.filter {
+                let state = registry.state(for: $0.identifier)
+                return state == .downloadSuccessful || state == .used
+            }
         }
+
+        var entries = [String: MyBooksContentLedger.Entry]()
+        for book in downloadedBooks {
+
+            var bytes: Int64 = 0
+            var lastAccess = Date.distantPast
+            let urls = contentFileUrls(for: book, account: account)
+            for url in urls {
+                let values = try? url.resourceValues(forKeys: [.fileSizeKey, .contentAccessDateKey, .contentModificationDateKey])
+                bytes += Int64(values?.fileSize ?? 0)
+                lastAccess = max(lastAccess, values?.contentAccessDate ?? values?.contentModificationDate ?? .distantPast)
+            }
+            guard !urls.isEmpty else { continue }
+            entries[book.identifier] = MyBooksContentLedger.Entry(
+                fileNames: urls.map { $0.lastPathComponent },
+                bytes: bytes,
+                lastAccess: lastAccess
+            )
+        }
+        Log.info(#file, "Built content ledger for \(entries.count) downloaded books")
+        ledger.rebuild(entries)
     }
 }
 
@@ -1962,7 +2454,7 @@ extension MyBooksDownloadCenter {
     }
 
     private func limitActiveDownloadsAsync(max: Int) async {
-        let allInfo = await bookIdentifierToDownloadInfo.values()
+        let allInfo = downloadProgressTable.values()
         let running = allInfo.compactMap { $0.downloadTask }.filter { $0.state == .running }
         let suspended = allInfo.compactMap { $0.downloadTask }.filter { $0.state == .suspended }
 
@@ -1984,9 +2476,18 @@ extension MyBooksDownloadCenter {
                 task.suspend()
             }
         } else if running.count < max {
-            let toResume = min(max - running.count, suspended.count)
+            // Preempted downloads are resumed by the scheduler.
+            var resumable: [URLSessionTask] = []
+            for task in suspended {
+                if let book = await taskIdentifierToBook.get(task.taskIdentifier),
+                   await downloadCoordinator.isPending(book.identifier) {
+                    continue
+                }
+                resumable.append(task)
+            }
+            let toResume = min(max - running.count, resumable.count)
             if toResume > 0 {
-                for task in suspended.prefix(toResume) { task.resume() }
+                for task in resumable.prefix(toResume) { task.resume() }
             }
         }
         await schedulePendingStartsAsync()
@@ -1999,7 +2500,7 @@ extension MyBooksDownloadCenter {
     }
 
     private func pauseAllDownloadsAsync() async {
-        let allInfo = await bookIdentifierToDownloadInfo.values()
+        let allInfo = downloadProgressTable.values()
         for info in allInfo {
             if let book = await taskIdentifierToBook.get(info.downloadTask.taskIdentifier),
                book.defaultBookContentType == .audiobook {
@@ -2070,16 +2571,8 @@ extension MyBooksDownloadCenter {
 
         let lcpProgress: (Double) -> Void = { [weak self] progressValue in
             guard let self = self else { return }
-            Task {
-                if let info = await self.downloadInfoAsync(forBookIdentifier: book.identifier)?.withDownloadProgress(progressValue) {
-                    await self.bookIdentifierToDownloadInfo.set(book.identifier, value: info)
-                }
-                // Publish to progress publisher so UI updates (HalfSheet, BookCell, etc.)
-                await MainActor.run {
-                    self.downloadProgressPublisher.send((book.identifier, progressValue))
-                }
-                self.broadcastUpdate()
-            }
+            self.publishDownloadProgress(progressValue, for: book.identifier)
+            self.broadcastUpdate()
         }
 
         let lcpCompletion: (URL?, Error?) -> Void = { [weak self] localUrl, error in
@@ -2150,7 +2643,7 @@ extension MyBooksDownloadCenter {
         if let fulfillmentDownloadTask = fulfillmentDownloadTask {
             let downloadInfo = MyBooksDownloadInfo(downloadProgress: 0.0, downloadTask: fulfillmentDownloadTask, rightsManagement: .none)
             Task {
-                await self.bookIdentifierToDownloadInfo.set(book.identifier, value: downloadInfo)
+                self.downloadProgressTable.set(book.identifier, value: downloadInfo)
             }
         }
         #endif
@@ -2201,10 +2694,10 @@ extension MyBooksDownloadCenter {
                 "Download failed for '\(book.title)': \(message ?? "unknown reason")",
                 category: .download
             )
-            // CRITICAL: Remove from bookIdentifierToDownloadInfo so retry works
-            await bookIdentifierToDownloadInfo.remove(book.identifier)
-            await downloadCoordinator.removeCachedDownloadInfo(for: book.identifier)
+            // CRITICAL: Remove from the progress table so retry works
+            downloadProgressTable.remove(book.identifier)
             await downloadCoordinator.registerCompletion(identifier: book.identifier)
+            await downloadCoordinator.clearScheduling(for: book.identifier)
             let remainingCount = await downloadCoordinator.activeCount
             Log.info(#file, "📊 Download failed for '\(book.title)', remaining active: \(remainingCount)")
             self.schedulePendingStartsIfPossible()
@@ -2463,6 +2956,7 @@ extension MyBooksDownloadCenter: TPPBookDownloadsDeleting {
             reset()
         } else {
             deleteAudiobooks(forAccount: account)
+            contentLedger(for: account)?.removeAll()
             do {
                 if let url = contentDirectoryURL(account) {
                     try FileManager.default.removeItem(at: url)
@@ -2481,17 +2975,23 @@ extension MyBooksDownloadCenter: TPPBookDownloadsDeleting {
         deleteAudiobooks(forAccount: currentAccountId)
 
         Task {
-            let allInfo = await bookIdentifierToDownloadInfo.values()
+            let allInfo = downloadProgressTable.values()
             for info in allInfo {
                 info.downloadTask.cancel(byProducingResumeData: { _ in })
             }
+            for download in await segmentedDownloads.values() {
+                download.cancel()
+            }
 
-            await bookIdentifierToDownloadInfo.removeAll()
+            downloadProgressTable.removeAll()
             await taskIdentifierToBook.removeAll()
+            await segmentedDownloads.removeAll()
+            await resumedTaskRequests.removeAll()
             await downloadCoordinator.reset()
         }
 
         bookIdentifierOfBookToRemove = nil
+        contentLedger(for: currentAccountId)?.removeAll()
 
         do {
             if let url = contentDirectoryURL(currentAccountId) {
@@ -2633,16 +3133,8 @@ extension MyBooksDownloadCenter: NYPLADEPTDelegate {
     }
 
     func adept(_ adept: NYPLADEPT, didUpdateProgress progress: Double, tag: String) {
-        Task {
-            if let info = await self.downloadInfoAsync(forBookIdentifier: tag)?.withDownloadProgress(progress) {
-                await self.bookIdentifierToDownloadInfo.set(tag, value: info)
-            }
-            // Publish to progress publisher so UI updates (HalfSheet, BookCell, etc.)
-            await MainActor.run {
-                self.downloadProgressPublisher.send((tag, progress))
-            }
-            self.broadcastUpdate()
-        }
+        publishDownloadProgress(progress, for: tag)
+        broadcastUpdate()
     }
 
     func adept(_ adept: NYPLADEPT, didCancelDownloadWithTag tag: String) {
@@ -0,0 +1,394 @@
+//
+//  SegmentedRangeDownload.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Downloads a large file over several concurrent HTTP range requests.
+///
+/// Each segment is fetched in parts of `partLength` bytes by download tasks of
+/// the session passed in, so a background session keeps downloading while the
+/// app is suspended. The session's delegate forwards the events of these tasks,
+/// told apart by their `taskDescription`, to `didWriteData`,
+/// `didFinishDownloading` and `didComplete`.
+///
+/// Finished parts are written at their offset in a single file in `directory`.
+/// A manifest next to it records the layout, the validators of the file and the
+/// bytes each segment has written to disk, so a download started again in the
+/// same directory continues where it stopped unless the file changed on the
+/// server.
+final class SegmentedRangeDownload: NSObject {
+    struct Segment: Codable, Equatable {
+        let start: Int64
+        /// Offset of the last byte, inclusive as in a `Range` header.
+        let end: Int64
+
+        var length: Int64 { end - start + 1 }
+    }
+
+    struct Manifest: Codable, Equatable {
+        var url: URL
+        let length: Int64
+        let eTag: String?
+        let lastModified: String?
+        let segments: [Segment]
+        /// Bytes of each segment known to be on disk.
+        var received: [Int64]
+
+        /// `true` if the parts on disk were downloaded from the same version of
+        /// the file, which can only be told with a validator.
+        func isContinued(by other: Manifest) -> Bool {
+            ifRange != nil && length == other.length && eTag == other.eTag && lastModified == other.lastModified
+        }
+
+        /// Validator sent with range requests, so a changed file is sent whole instead.
+        var ifRange: String? {
+            Self.ifRange(eTag: eTag, lastModified: lastModified)
+        }
+
+        static func ifRange(eTag: String?, lastModified: String?) -> String? {
+            if let eTag, !eTag.hasPrefix("W/") {
+                return eTag
+            }
+            return lastModified
+        }
+    }
+
+    enum Failure: Error, Equatable {
+        case unexpectedResponse(statusCode: Int)
+        case fileChanged
+        case incompleteSegment
+    }
+
+    /// Smaller files aren't worth the extra requests.
+    static let minimumLength: Int64 = 32 * 1024 * 1024
+    static let defaultSegmentCount = 4
+    /// Bytes requested at a time; parts are checkpointed as they complete.
+    static let defaultPartLength: Int64 = 8 * 1024 * 1024
+
+    static let manifestFileName = "manifest.json"
+    static let contentFileName = "content"
+
+    private static let taskDescriptionPrefix = "segment:"
+
+    /// Bytes received between progress reports.
+    private static let progressInterval: Int64 = 256 * 1024
+
+    let directory: URL
+    private(set) var manifest: Manifest
+
+    /// Called with the bytes received since the last call, the total received and the total expected.
+    var progressHandler: ((_ bytesWritten: Int64, _ totalBytesWritten: Int64, _ totalBytesExpected: Int64) -> Void)?
+
+    private let requestTemplate: URLRequest
+    private let session: URLSession
+    private let taskDescription: String
+    private let partLength: Int64
+    private let queue: OperationQueue
+    private var fileHandle: FileHandle?
+    /// Segment index by task identifier.
+    private var segmentTasks = [Int: (index: Int, task: URLSessionDownloadTask)]()
+    /// Bytes the running task of each segment has received.
+    private var inFlight = [Int64]()
+    private var unreportedBytes: Int64 = 0
+    private var completion: ((Result<URL, Error>) -> Void)?
+    private var isStopped = false
+
+    /// `true` if the download that received `response` can continue as a segmented download.
+    /// The file needs a validator, so parts of different versions are never joined.
+    static func canSegment(_ response: URLResponse?, expectedLength: Int64) -> Bool {
+        guard let response = response as? HTTPURLResponse,
+              response.statusCode == 200,
+              response.value(forHTTPHeaderField: "Content-Encoding") == nil,
+              Manifest.ifRange(
+                eTag: response.value(forHTTPHeaderField: "ETag"),
+                lastModified: response.value(forHTTPHeaderField: "Last-Modified")
+              ) != nil
+        else { return false }
+        return response.value(forHTTPHeaderField: "Accept-Ranges")?.lowercased() == "bytes"
+            && expectedLength >= minimumLength
+    }
+
+    /// `taskDescription` of the tasks fetching parts for the book `identifier`.
+    static func taskDescription(for identifier: String) -> String {
+        taskDescriptionPrefix + identifier
+    }
+
+    /// Book identifier of a task fetching parts, or `nil` for other tasks.
+    static func identifier(fromTaskDescription description: String?) -> String? {
+        guard let description, description.hasPrefix(taskDescriptionPrefix) else { return nil }
+        return String(description.dropFirst(taskDescriptionPrefix.count))
+    }
+
+    /// - Parameters:
+    ///   - request: Request for the whole file. Its headers are sent with every part.
+    ///   - response: Response to `request`, providing the validators of the file.
+    ///   - expectedLength: Length of the file.
+    ///   - directory: Where parts are kept. Parts of a previous download of the same
+    ///     version of the file are continued; anything else in it is removed.
+    ///   - session: Session creating the download tasks. Its delegate forwards their events.
+    ///   - identifier: Identifies the download in the tasks' `taskDescription`.
+    init(
+        request: URLRequest,
+        response: HTTPURLResponse,
+        expectedLength: Int64,
+        directory: URL,
+        segmentCount: Int = SegmentedRangeDownload.defaultSegmentCount,
+        partLength: Int64 = SegmentedRangeDownload.defaultPartLength,
+        session: URLSession,
+        identifier: String
+    ) throws {
+        guard let url = request.url, expectedLength > 0, segmentCount > 0, partLength > 0 else {
+            throw URLError(.badURL)
+        }
+
+        let segmentLength = (expectedLength + Int64(segmentCount) - 1) / Int64(segmentCount)
+        let segments = stride(from: Int64(0), to: expectedLength, by: segmentLength).map {
+            Segment(start: $0, end: min($0 + segmentLength, expectedLength) - 1)
+        }
+        var manifest = Manifest(
+            url: url,
+            length: expectedLength,
+            eTag: response.value(forHTTPHeaderField: "ETag"),
+            lastModified: response.value(forHTTPHeaderField: "Last-Modified"),
+            segments: segments,
+            received: segments.map { _ in 0 }
+        )
+
+        let contentUrl = directory.appendingPathComponent(Self.contentFileName)
+        let manifestUrl = directory.appendingPathComponent(Self.manifestFileName)
+        if let data = try? Data(contentsOf: manifestUrl),
+           let previous = try? JSONDecoder().decode(Manifest.self, from: data),
+           previous.isContinued(by: manifest),
+           FileManager.default.fileExists(atPath: contentUrl.path) {
+            // The URL may have changed, e.g. a signed CDN link issued again.
+            manifest = previous
+            manifest.url = url
+        } else {
+            try? FileManager.default.removeItem(at: directory)
+            try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+            guard FileManager.default.createFile(atPath: contentUrl.path, contents: nil) else {
+                throw CocoaError(.fileWriteUnknown)
+            }
+        }
+
+        self.directory = directory
+        self.manifest = manifest
+        self.inFlight = manifest.segments.map { _ in 0 }
+        self.session = session
+        self.taskDescription = Self.taskDescription(for: identifier)
+        self.partLength = partLength
+
+        var template = request
+        template.url = url
+        template.setValue(nil, forHTTPHeaderField: "Range")
+        self.requestTemplate = template
+
+        let queue = OperationQueue()
+        queue.name = "org.thepalaceproject.segmentedRangeDownload"
+        queue.maxConcurrentOperationCount = 1
+        self.queue = queue
+
+        super.init()
+        try saveManifest()
+    }
+
+    // MARK: - Control
+
+    /// Requests the missing part of every segment. `completion` receives the
+    /// downloaded file, moved out of `directory`, or the reason the download failed.
+    func start(completion: @escaping (Result<URL, Error>) -> Void) {
+        queue.addOperation {
+            self.completion = completion
+            do {
+                self.fileHandle = try FileHandle(forWritingTo: self.directory.appendingPathComponent(Self.contentFileName))
+            } catch {
+                self.fail(error)
+                return
+            }
+
+            for index in self.manifest.segments.indices {
+                self.requestNextPart(of: index)
+            }
+
+            if self.segmentTasks.isEmpty {
+                self.finish()
+            } else {
+                self.report(bytes: 0, force: true)
+            }
+        }
+    }
+
+    func suspend() {
+        queue.addOperation {
+            self.segmentTasks.values.forEach { $0.task.suspend() }
+        }
+    }
+
+    func resume() {
+        queue.addOperation {
+            self.segmentTasks.values.forEach { $0.task.resume() }
+        }
+    }
+
+    /// Stops the download, keeping the parts written so far. `completion` isn't called.
+    func cancel() {
+        queue.addOperation {
+            guard !self.isStopped else { return }
+            self.isStopped = true
+            self.stopTasks()
+            self.closeFile()
+        }
+    }
+
+    // MARK: - Task Events
+
+    /// Progress of a task fetching a part.
+    func didWriteData(for task: URLSessionTask, totalBytesWritten: Int64) {
+        queue.addOperation {
+            guard !self.isStopped, let index = self.segmentTasks[task.taskIdentifier]?.index else { return }
+            let bytes = max(0, totalBytesWritten - self.inFlight[index])
+            self.inFlight[index] = totalBytesWritten
+            self.report(bytes: bytes)
+        }
+    }
+
+    /// Writes a part fetched by `task` in place, then requests the next part of its segment.
+    /// Takes ownership of the file at `location`.
+    func didFinishDownloading(_ task: URLSessionDownloadTask, to location: URL) {
+        queue.addOperation {
+            defer { try? FileManager.default.removeItem(at: location) }
+            guard !self.isStopped, let index = self.segmentTasks.removeValue(forKey: task.taskIdentifier)?.index else { return }
+            self.inFlight[index] = 0
+            do {
+                try self.accepts(task.response, for: index)
+                try self.write(partAt: location, for: index)
+            } catch {
+                self.fail(error)
+                return
+            }
+            self.requestNextPart(of: index)
+            if self.segmentTasks.isEmpty {
+                self.finish()
+            }
+        }
+    }
+
+    /// Completion of a task fetching a part. Successful tasks are handled by `didFinishDownloading`.
+    func didComplete(_ task: URLSessionTask, error: Error?) {
+        guard let error else { return }
+        queue.addOperation {
+            guard !self.isStopped, self.segmentTasks[task.taskIdentifier] != nil else { return }
+            self.fail(error)
+        }
+    }
+
+    // MARK: - Private
+
+    /// Requests the next missing part of a segment, if any.
+    private func requestNextPart(of index: Int) {
+        let segment = manifest.segments[index]
+        let start = segment.start + manifest.received[index]
+        guard start <= segment.end else { return }
+
+        var request = requestTemplate
+        request.setValue("bytes=\(start)-\(min(start + partLength - 1, segment.end))", forHTTPHeaderField: "Range")
+        if let ifRange = manifest.ifRange {
+            request.setValue(ifRange, forHTTPHeaderField: "If-Range")
+        }
+        let task = session.downloadTask(with: request)
+        task.taskDescription = taskDescription
+        segmentTasks[task.taskIdentifier] = (index, task)
+        task.resume()
+    }
+
+    private func accepts(_ response: URLResponse?, for index: Int) throws {
+        guard let response = response as? HTTPURLResponse else {
+            throw Failure.unexpectedResponse(statusCode: 0)
+        }
+        switch response.statusCode {
+        case 206:
+            let expectedStart = manifest.segments[index].start + manifest.received[index]
+            let contentRange = response.value(forHTTPHeaderField: "Content-Range") ?? ""
+            guard contentRange.hasPrefix("bytes \(expectedStart)-"), contentRange.hasSuffix("/\(manifest.length)") else {
+                throw Failure.fileChanged
+            }
+        case 200:
+            // The server ignored the range, or If-Range didn't match.
+            throw Failure.fileChanged
+        default:
+            throw Failure.unexpectedResponse(statusCode: response.statusCode)
+        }
+    }
+
+    /// Copies a downloaded part to its offset, flushes it to disk, then records it in the manifest.
+    private func write(partAt location: URL, for index: Int) throws {
+        guard let fileHandle else { return }
+        let segment = manifest.segments[index]
+        let remaining = segment.length - manifest.received[index]
+        let data = try Data(contentsOf: location, options: .alwaysMapped)
+        guard data.count > 0, Int64(data.count) <= remaining else {
+            throw Failure.incompleteSegment
+        }
+        try fileHandle.seek(toOffset: UInt64(segment.start + manifest.received[index]))
+        try fileHandle.write(contentsOf: data)
+        try fileHandle.synchronize()
+        manifest.received[index] += Int64(data.count)
+        try saveManifest()
+    }
+
+    private func saveManifest() throws {
+        let data = try JSONEncoder().encode(manifest)
+        try data.write(to: directory.appendingPathComponent(Self.manifestFileName), options: .atomic)
+    }
+
+    private func report(bytes: Int64, force: Bool = false) {
+        unreportedBytes += bytes
+        guard force || unreportedBytes >= Self.progressInterval else { return }
+        let total = manifest.received.reduce(0, +) + inFlight.reduce(0, +)
+        progressHandler?(unreportedBytes, total, manifest.length)
+        unreportedBytes = 0
+    }
+
+    private func finish() {
+        report(bytes: 0, force: true)
+        closeFile()
+        isStopped = true
+
+        let location = FileManager.default.temporaryDirectory
+            .appendingPathComponent(UUID().uuidString + "_" + Self.contentFileName)
+        do {
+            try FileManager.default.moveItem(at: directory.appendingPathComponent(Self.contentFileName), to: location)
+            try? FileManager.default.removeItem(at: directory)
+            completion?(.success(location))
+        } catch {
+            completion?(.failure(error))
+        }
+        completion = nil
+    }
+
+    private func fail(_ error: Error) {
+        guard !isStopped else { return }
+        isStopped = true
+        stopTasks()
+        closeFile()
+        if error as? Failure == .fileChanged {
+            try? FileManager.default.removeItem(at: directory)
+        }
+        completion?(.failure(error))
+        completion = nil
+    }
+
+    private func stopTasks() {
+        segmentTasks.values.forEach { $0.task.cancel() }
+        segmentTasks.removeAll()
+    }
+
+    private func closeFile() {
+        try? fileHandle?.close()
+        fileHandle = nil
+    }
+}
@@ -4,6 +4,7 @@
 //
 
 import Foundation
+import os
 
 final class URLSessionNetworkClient: NetworkClient {
     private let executor: TPPNetworkExecutor
@@ -33,6 +34,10 @@ final class URLSessionNetworkClient: NetworkClient {
         }
         urlRequest.httpBody = request.body
 
+        if request.method == .GET {
+            return try await sendCoalesced(urlRequest)
+        }
+
         let (data, response) = try await withCheckedThrowingContinuation { continuation in
             let completion: (NYPLResult<Data>) -> Void = { result in
                 switch result {
@@ -50,6 +55,7 @@ final class URLSessionNetworkClient: NetworkClient {
 
             switch request.method {
             case .GET, .HEAD:
+                // GET requests are coalesced above
                 _ = self.executor.GET(urlRequest.url!, useTokenIfAvailable: true) { data, response, error in
                     if let error { continuation.resume(throwing: error); return }
                     guard let data = data, let response = response as? HTTPURLResponse else { continuation.resume(throwing: NetworkError.invalidResponse); return }
@@ -91,4 +97,34 @@ final class URLSessionNetworkClient: NetworkClient {
 
         return NetworkResponse(data: data, response: response)
     }
+
+    /// Sends a GET request, sharing the response with concurrent callers
+    /// asking for the same resource. Cancelling the calling task only
+    /// cancels the request if no other caller still waits for it.
+    private func sendCoalesced(_ urlRequest: URLRequest) async throws -> NetworkResponse {
+        let caller = OSAllocatedUnfairLock<TPPCoalescedRequest?>(uncheckedState: nil)
+
+        return try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { continuation in
+                let coalescedRequest = executor.executeCoalescedRequest(urlRequest, enableTokenRefresh: true) { result in
+                    switch result {
+                    case let .success(data, response):
+                        guard let response = response as? HTTPURLResponse else {
+                            continuation.resume(throwing: NetworkError.invalidResponse)
+                            return
+                        }
+                        continuation.resume(returning: NetworkResponse(data: data, response: response))
+                    case let .failure(error, _):
+                        continuation.resume(throwing: error)
+                    }
+                }
+                caller.withLockUnchecked { $0 = coalescedRequest }
+                if Task.isCancelled {
+                    coalescedRequest.cancel()
+                }
+            }
+        } onCancel: {
+            caller.withLockUnchecked { $0 }?.cancel()
+        }
+    }
 }
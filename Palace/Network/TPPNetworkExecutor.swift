@@ -21,6 +21,9 @@ enum NYPLResult<SuccessInfo> {
     private let retryQueueLock = NSLock()
     private var activeTasks: [URLSessionTask] = []
     private let activeTasksLock = NSLock()
+    private var sharedRequests: [CoalescingKey: SharedRequest] = [:]
+    private var sharedRequestMetrics = CoalescingMetrics()
+    private let sharedRequestsLock = NSLock()
 
     private let responder: TPPNetworkResponder
 
@@ -132,12 +135,23 @@ enum NYPLResult<SuccessInfo> {
 extension TPPNetworkExecutor: TPPRequestExecuting {
     @discardableResult
     func executeRequest(_ req: URLRequest, enableTokenRefresh: Bool, completion: @escaping (_: NYPLResult<Data>) -> Void) -> URLSessionDataTask? {
+        executeRequest(req, enableTokenRefresh: enableTokenRefresh, dataHandler: nil, completion: completion)
+    }
+
+    /// - Parameter dataHandler: Called with every chunk of a successful response
+    /// body as it arrives, on the URLSession delegate queue. Chunks are also
+    /// accumulated and passed to `completion` as usual.
+    @discardableResult
+    func executeRequest(_ req: URLRequest,
+                        enableTokenRefresh: Bool,
+                        dataHandler: ((Data) -> Void)?,
+                        completion: @escaping (_: NYPLResult<Data>) -> Void) -> URLSessionDataTask? {
         let accountId = AccountsManager.shared.currentAccountId
         let userAccount = TPPUserAccount.sharedAccount(libraryUUID: accountId)
 
         // SAML auth uses cookies, not tokens - proceed directly
         if let authDefinition = userAccount.authDefinition, authDefinition.isSaml {
-            return performDataTask(with: req, completion: completion)
+            return performDataTask(with: req, dataHandler: dataHandler, completion: completion)
         }
 
         // Proactive token refresh: if token will expire soon, refresh before the request
@@ -148,23 +162,177 @@ extension TPPNetworkExecutor: TPPRequestExecuting {
            authDef.tokenURL != nil {
             Log.info(#file, "Token near expiry - proactively refreshing before request")
             refreshTokenAndResume(task: nil, accountId: accountId) { [weak self] _ in
-                _ = self?.performDataTask(with: req, completion: completion)
+                _ = self?.performDataTask(with: req, dataHandler: dataHandler, completion: completion)
             }
             return nil
         }
 
-        return performDataTask(with: req, completion: completion)
+        return performDataTask(with: req, dataHandler: dataHandler, completion: completion)
     }
 
     private func performDataTask(with request: URLRequest,
+                                 dataHandler: ((Data) -> Void)? = nil,
                                  completion: @escaping (_: NYPLResult<Data>) -> Void) -> URLSessionDataTask {
         let task = urlSession.dataTask(with: request)
-        responder.addCompletion(completion, taskID: task.taskIdentifier)
+        responder.addCompletion(completion, taskID: task.taskIdentifier, dataHandler: dataHandler)
         task.resume()
         return task
     }
 }
 
+// MARK: - Request Coalescing
+
+/// A caller's share of a request made with
+/// `TPPNetworkExecutor.executeCoalescedRequest(_:enableTokenRefresh:completion:)`.
+final class TPPCoalescedRequest {
+    fileprivate let key: TPPNetworkExecutor.CoalescingKey
+    fileprivate let id = UUID()
+    private weak var executor: TPPNetworkExecutor?
+
+    fileprivate init(key: TPPNetworkExecutor.CoalescingKey, executor: TPPNetworkExecutor) {
+        self.key = key
+        self.executor = executor
+    }
+
+    /// Completes this caller with `NSURLErrorCancelled`. The request itself
+    /// is cancelled once every caller sharing it has cancelled.
+    func cancel() {
+        executor?.cancel(self)
+    }
+}
+
+extension TPPNetworkExecutor {
+    /// Requests that get the same response: same method, URL, headers
+    /// (including credentials) and library account.
+    struct CoalescingKey: Hashable {
+        let method: String
+        let url: URL?
+        let headers: [String: String]
+        let cachePolicy: UInt
+        let accountId: String?
+
+        init(request: URLRequest, accountId: String?) {
+            self.method = request.httpMethod ?? "GET"
+            self.url = request.url
+            self.headers = request.allHTTPHeaderFields ?? [:]
+            self.cachePolicy = request.cachePolicy.rawValue
+            self.accountId = accountId
+        }
+    }
+
+    struct CoalescingMetrics: Equatable {
+        /// Requests sent on behalf of one or more callers.
+        var sent = 0
+        /// Callers that joined a request already in flight: requests saved.
+        var joined = 0
+        /// Callers that cancelled their share of a request.
+        var cancelled = 0
+        /// Requests cancelled because every caller sharing them cancelled.
+        var abandoned = 0
+    }
+
+    fileprivate final class SharedRequest {
+        var task: URLSessionDataTask?
+        var isAbandoned = false
+        var callers = [UUID: (NYPLResult<Data>) -> Void]()
+    }
+
+    /// Coalescing counts since the executor was created.
+    var coalescingMetrics: CoalescingMetrics {
+        sharedRequestsLock.lock()
+        defer { sharedRequestsLock.unlock() }
+        return sharedRequestMetrics
+    }
+
+    /// Same as `executeRequest(_:enableTokenRefresh:completion:)` for a GET or
+    /// HEAD request, except that callers asking for the same resource with the
+    /// same credentials while it loads share one request and its response.
+    /// - Returns: This caller's share of the request, to cancel it.
+    @discardableResult
+    func executeCoalescedRequest(_ req: URLRequest,
+                                 enableTokenRefresh: Bool,
+                                 completion: @escaping (_: NYPLResult<Data>) -> Void) -> TPPCoalescedRequest {
+        assert(req.httpMethod == nil || req.httpMethod == "GET" || req.httpMethod == "HEAD", "Only safe requests can be coalesced")
+
+        let key = CoalescingKey(request: req, accountId: AccountsManager.shared.currentAccountId)
+        let caller = TPPCoalescedRequest(key: key, executor: self)
+
+        sharedRequestsLock.lock()
+        if let shared = sharedRequests[key] {
+            shared.callers[caller.id] = completion
+            sharedRequestMetrics.joined += 1
+            let metrics = sharedRequestMetrics
+            sharedRequestsLock.unlock()
+            Log.debug(#file, "Joined in-flight request for \(req.url?.absoluteString ?? "nil"), \(metrics.joined) of \(metrics.sent + metrics.joined) requests saved")
+            return caller
+        }
+        let shared = SharedRequest()
+        shared.callers[caller.id] = completion
+        sharedRequests[key] = shared
+        sharedRequestMetrics.sent += 1
+        sharedRequestsLock.unlock()
+
+        let task = executeRequest(req, enableTokenRefresh: enableTokenRefresh) { [weak self] result in
+            self?.complete(shared, for: key, with: result)
+        }
+
+        // Everyone may have cancelled before the task existed
+        sharedRequestsLock.lock()
+        shared.task = task
+        let isAbandoned = shared.isAbandoned
+        sharedRequestsLock.unlock()
+        if let task {
+            if isAbandoned {
+                task.cancel()
+            } else {
+                addTaskToActiveTasks(task)
+            }
+        }
+        return caller
+    }
+
+    private func complete(_ shared: SharedRequest, for key: CoalescingKey, with result: NYPLResult<Data>) {
+        sharedRequestsLock.lock()
+        if sharedRequests[key] === shared {
+            sharedRequests[key] = nil
+        }
+        let callers = Array(shared.callers.values)
+        shared.callers.removeAll()
+        let task = shared.task
+        sharedRequestsLock.unlock()
+
+        if let task {
+            removeTaskFromActiveTasks(task)
+        }
+        callers.forEach { $0(result) }
+    }
+
+    fileprivate func cancel(_ caller: TPPCoalescedRequest) {
+        sharedRequestsLock.lock()
+        guard let shared = sharedRequests[caller.key],
+              let completion = shared.callers.removeValue(forKey: caller.id) else {
+            sharedRequestsLock.unlock()
+            return
+        }
+        sharedRequestMetrics.cancelled += 1
+        var abandonedTask: URLSessionDataTask?
+        if shared.callers.isEmpty {
+            // Later callers start a new request
+            sharedRequests[caller.key] = nil
+            shared.isAbandoned = true
+            abandonedTask = shared.task
+            sharedRequestMetrics.abandoned += 1
+        }
+        sharedRequestsLock.unlock()
+
+        abandonedTask?.cancel()
+        let error = NSError(domain: NSURLErrorDomain, code: NSURLErrorCancelled, userInfo: nil)
+        DispatchQueue.global(qos: .userInitiated).async {
+            completion(.failure(error, nil))
+        }
+    }
+}
+
 extension TPPNetworkExecutor {
     private func createErrorForRetryFailure() -> NSError {
         return NSError(
@@ -271,6 +439,33 @@ extension TPPNetworkExecutor {
         return executeRequest(updatedReq, enableTokenRefresh: useTokenIfAvailable, completion: completionWrapper)
     }
 
+    /// Same as `GET(request:cachePolicy:useTokenIfAvailable:completion:)`, but
+    /// also hands every chunk of a successful response body to `dataHandler` as
+    /// soon as it arrives, so that it can be processed while downloading.
+    /// `dataHandler` is called serially on the URLSession delegate queue and
+    /// should return quickly.
+    /// - Parameter headers: Additional request header fields, e.g. validators
+    ///   for a conditional request. A `304 Not Modified` response to a
+    ///   conditional request completes successfully with empty data.
+    @objc func GET(_ reqURL: URL,
+                   cachePolicy: NSURLRequest.CachePolicy,
+                   useTokenIfAvailable: Bool,
+                   headers: [String: String]?,
+                   dataHandler: @escaping (_ data: Data) -> Void,
+                   completion: @escaping (_ result: Data?, _ response: URLResponse?, _ error: Error?) -> Void) -> URLSessionDataTask? {
+        var req = request(for: reqURL)
+        req.cachePolicy = cachePolicy
+        headers?.forEach { req.setValue($1, forHTTPHeaderField: $0) }
+
+        let completionWrapper: (_ result: NYPLResult<Data>) -> Void = { result in
+            switch result {
+            case let .success(data, response): completion(data, response, nil)
+            case let .failure(error, response): completion(nil, response, error)
+            }
+        }
+        return executeRequest(req, enableTokenRefresh: useTokenIfAvailable, dataHandler: dataHandler, completion: completionWrapper)
+    }
+
     @objc func PUT(_ reqURL: URL,
                    useTokenIfAvailable: Bool,
                    completion: @escaping (_ result: Data?, _ response: URLResponse?, _ error: Error?) -> Void) -> URLSessionDataTask? {
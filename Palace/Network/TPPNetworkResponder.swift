@@ -12,12 +12,16 @@ private struct TPPNetworkTaskInfo {
     var progressData: Data
     var startDate: Date
     var completion: ((NYPLResult<Data>) -> Void)
+    /// Optional consumer of response body chunks, for incremental processing.
+    var dataHandler: ((Data) -> Void)?
 
     // ----------------------------------------------------------------------------
-    init(completion: (@escaping (NYPLResult<Data>) -> Void)) {
+    init(completion: (@escaping (NYPLResult<Data>) -> Void),
+         dataHandler: ((Data) -> Void)? = nil) {
         self.progressData = Data()
         self.startDate = Date()
         self.completion = completion
+        self.dataHandler = dataHandler
     }
 }
 
@@ -94,9 +98,11 @@ class TPPNetworkResponder: NSObject {
 
     // ----------------------------------------------------------------------------
     func addCompletion(_ completion: @escaping (NYPLResult<Data>) -> Void,
-                       taskID: TaskID) {
+                       taskID: TaskID,
+                       dataHandler: ((Data) -> Void)? = nil) {
         taskInfoQueue.sync {
-            self.taskInfo[taskID] = TPPNetworkTaskInfo(completion: completion)
+            self.taskInfo[taskID] = TPPNetworkTaskInfo(completion: completion,
+                                                       dataHandler: dataHandler)
         }
     }
 
@@ -153,6 +159,16 @@ extension TPPNetworkResponder: URLSessionDataDelegate {
     func urlSession(_ session: URLSession,
                     dataTask: URLSessionDataTask,
                     didReceive data: Data) {
+        // Delegate callbacks are serial, so chunks reach the handler in order.
+        // Error bodies (e.g. problem documents, 401s before a retry) are not streamed.
+        if let http = dataTask.response as? HTTPURLResponse, http.isSuccess() {
+            var dataHandler: ((Data) -> Void)?
+            taskInfoQueue.sync {
+                dataHandler = self.taskInfo[dataTask.taskIdentifier]?.dataHandler
+            }
+            dataHandler?(data)
+        }
+
         taskInfoQueue.async { [ weak self] in
             var info = self?.taskInfo[dataTask.taskIdentifier]
             info?.progressData.append(data)
@@ -248,7 +264,7 @@ extension TPPNetworkResponder: URLSessionDataDelegate {
             // Use URL-based retry tracking instead of broken hasRetried flag
             let isFailedRetry = !canRetry(url: requestURL)
 
-            if !http.isSuccess() {
+            if !http.isSuccess() && !(http.isNotModified() && task.originalRequest?.isConditional == true) {
                 let err: TPPUserFriendlyError
                 let data = info.progressData
 
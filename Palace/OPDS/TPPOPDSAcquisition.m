@@ -66,8 +66,10 @@ NYPLOPDSAcquisitionRelationWithString(NSString *const _Nonnull string,
                                       TPPOPDSAcquisitionRelation *const _Nonnull relationPointer)
 {
   static NSDictionary<NSString *, NSNumber *> *lazyStringToRelationObjectDict = nil;
+  static dispatch_once_t onceToken;
 
-  if (lazyStringToRelationObjectDict == nil) {
+  // Entries are built concurrently for large feeds
+  dispatch_once(&onceToken, ^{
     lazyStringToRelationObjectDict = @{
       genericRelationString: @(TPPOPDSAcquisitionRelationGeneric),
       openAccessRelationString: @(TPPOPDSAcquisitionRelationOpenAccess),
@@ -78,7 +80,7 @@ NYPLOPDSAcquisitionRelationWithString(NSString *const _Nonnull string,
       acquisitionPreviewRelationString: @(TPPOPDSAcquisitionRelationPreview),
       subscribeRelationString: @(TPPOPDSAcquisitionRelationSubscribe)
     };
-  }
+  });
 
   NSNumber *const relationObject = lazyStringToRelationObjectDict[string];
   if (!relationObject) {
@@ -46,8 +46,9 @@ NSString * const _Nonnull ContentTypeBiblioboard = @"application/json";
 + (NSSet<NSString *> *_Nonnull)supportedTypes
 {
   static NSSet<NSString *> *types = nil;
+  static dispatch_once_t onceToken;
 
-  if (!types) {
+  dispatch_once(&onceToken, ^{
     types = [NSSet setWithArray:@[
       ContentTypeOPDSCatalog,
       ContentTypeBearerToken,
@@ -69,7 +70,7 @@ NSString * const _Nonnull ContentTypeBiblioboard = @"application/json";
 #endif
       ContentTypeAudiobookZip
     ]];
-  }
+  });
 
 #if FEATURE_DRM_CONNECTOR
   // Adobe DRM crashes the app when certificate is expired.
@@ -93,7 +94,8 @@ NSString * const _Nonnull ContentTypeBiblioboard = @"application/json";
     with content subtype of ContentTypeEpubZip if it is a book or ContentTypeAudiobookZip for an audiobook;
     this file is later fulfilled by LCP library and we get a real epub book or audiobook.
    */
-  if (!subtypesForTypes) {
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
     subtypesForTypes = @{
       ContentTypeOPDSCatalog: [NSSet setWithArray:@[
         ContentTypeAdobeAdept,
@@ -123,7 +125,7 @@ NSString * const _Nonnull ContentTypeBiblioboard = @"application/json";
         ContentTypeOpenAccessAudiobook
       ]]
     };
-  }
+  });
   
   NSSet<NSString *> *types = subtypesForTypes[type];
   
@@ -1,3 +1,4 @@
+@class TPPOPDSEntry;
 @class TPPXML;
 
 typedef NS_ENUM(NSInteger, TPPOPDSFeedType) {
@@ -32,6 +33,33 @@ typedef NS_ENUM(NSInteger, TPPOPDSFeedType) {
 useTokenIfAvailable:(BOOL)useTokenIfAvailable
 completionHandler:(void (^)(TPPOPDSFeed *feed, NSDictionary *error))handler;
 
+/// Same as @c withURL:shouldResetCache:useTokenIfAvailable:completionHandler:,
+/// but the feed is parsed while it is downloaded and every entry is passed to
+/// @c entryHandler as soon as it has been received, in document order and
+/// before @c handler is called with the parsed feed.
+/// @param entryHandler Called serially on a background queue for every valid
+/// entry. Entries may already have been delivered when the request eventually
+/// fails.
++ (void) withURL:(NSURL *)URL
+ shouldResetCache:(BOOL)shouldResetCache
+useTokenIfAvailable:(BOOL)useTokenIfAvailable
+    entryHandler:(void (^)(TPPOPDSEntry *entry))entryHandler
+completionHandler:(void (^)(TPPOPDSFeed *feed, NSDictionary *error))handler;
+
+/// Same as @c withURL:shouldResetCache:useTokenIfAvailable:entryHandler:completionHandler:,
+/// but sends @c requestHeaders with the request and passes the HTTP response
+/// to @c handler, e.g. to read cache validators for the next request.
+/// @param requestHeaders Additional header fields. If they contain
+/// @c If-None-Match or @c If-Modified-Since and the server answers
+/// @c 304 Not Modified, @c handler is called with a @c nil feed, a @c nil
+/// error and the response, and @c entryHandler is never called.
++ (void) withURL:(NSURL *)URL
+ shouldResetCache:(BOOL)shouldResetCache
+useTokenIfAvailable:(BOOL)useTokenIfAvailable
+  requestHeaders:(NSDictionary<NSString *, NSString *> *)requestHeaders
+    entryHandler:(void (^)(TPPOPDSEntry *entry))entryHandler
+completionHandler:(void (^)(TPPOPDSFeed *feed, NSDictionary *error, NSHTTPURLResponse *response))handler;
+
 /// Designated initializer.
 - (instancetype)initWithXML:(TPPXML *)feedXML;
 
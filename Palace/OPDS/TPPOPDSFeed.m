@@ -54,12 +54,95 @@ static TPPOPDSFeedType TypeImpliedByEntry(TPPOPDSEntry *const entry)
           : TPPOPDSFeedTypeNavigation);
 }
 
+/// Feeds with fewer entries than this are not worth splitting across cores.
+static NSUInteger const ConcurrentEntryThreshold = 32;
+
+/// Builds entries from their elements, keeping document order and skipping malformed ones.
+/// Large feeds are split into contiguous ranges of entries that are built concurrently;
+/// the elements must not be modified meanwhile.
+static NSArray *EntriesWithXMLs(NSArray *const entryXMLs)
+{
+  NSUInteger const count = entryXMLs.count;
+  NSMutableArray *const entries = [NSMutableArray arrayWithCapacity:count];
+
+  if(count < ConcurrentEntryThreshold) {
+    for(TPPXML *const entryXML in entryXMLs) {
+      TPPOPDSEntry *const entry = [[TPPOPDSEntry alloc] initWithXML:entryXML];
+      if(!entry) {
+        TPPLOG(@"Ingoring malformed 'entry' element.");
+        continue;
+      }
+      [entries addObject:entry];
+    }
+    return entries;
+  }
+
+  // Every slot is written by exactly one iteration.
+  __strong TPPOPDSEntry **const results = (__strong TPPOPDSEntry **)calloc(count, sizeof(TPPOPDSEntry *));
+  // A few ranges per core even out entries of different sizes.
+  size_t const rangeCount = MIN(count, [NSProcessInfo processInfo].activeProcessorCount * 4);
+  dispatch_apply(rangeCount, DISPATCH_APPLY_AUTO, ^(size_t const range) {
+    @autoreleasepool {
+      NSUInteger const end = (range + 1) * count / rangeCount;
+      for(NSUInteger i = range * count / rangeCount; i < end; i++) {
+        results[i] = [[TPPOPDSEntry alloc] initWithXML:entryXMLs[i]];
+      }
+    }
+  });
+
+  for(NSUInteger i = 0; i < count; i++) {
+    if(results[i]) {
+      [entries addObject:results[i]];
+      results[i] = nil;
+    } else {
+      TPPLOG(@"Ingoring malformed 'entry' element.");
+    }
+  }
+  free(results);
+
+  return entries;
+}
+
 @implementation TPPOPDSFeed
 
 + (void)withURL:(NSURL *)URL
 shouldResetCache:(BOOL)shouldResetCache
 useTokenIfAvailable:(BOOL)useTokenIfAvailable
 completionHandler:(void (^)(TPPOPDSFeed *feed, NSDictionary *error))handler
+{
+  [self withURL:URL
+shouldResetCache:shouldResetCache
+useTokenIfAvailable:useTokenIfAvailable
+   entryHandler:nil
+completionHandler:handler];
+}
+
++ (void)withURL:(NSURL *)URL
+shouldResetCache:(BOOL)shouldResetCache
+useTokenIfAvailable:(BOOL)useTokenIfAvailable
+   entryHandler:(void (^)(TPPOPDSEntry *entry))entryHandler
+completionHandler:(void (^)(TPPOPDSFeed *feed, NSDictionary *error))handler
+{
+  if(!handler) {
+    @throw NSInvalidArgumentException;
+  }
+
+  [self withURL:URL
+shouldResetCache:shouldResetCache
+useTokenIfAvailable:useTokenIfAvailable
+ requestHeaders:nil
+   entryHandler:entryHandler
+completionHandler:^(TPPOPDSFeed *feed, NSDictionary *error, __unused NSHTTPURLResponse *response) {
+    handler(feed, error);
+  }];
+}
+
++ (void)withURL:(NSURL *)URL
+shouldResetCache:(BOOL)shouldResetCache
+useTokenIfAvailable:(BOOL)useTokenIfAvailable
+ requestHeaders:(NSDictionary<NSString *, NSString *> *)requestHeaders
+   entryHandler:(void (^)(TPPOPDSEntry *entry))entryHandler
+completionHandler:(void (^)(TPPOPDSFeed *feed, NSDictionary *error, NSHTTPURLResponse *response))handler
 {
   if(!handler) {
     @throw NSInvalidArgumentException;
@@ -79,18 +162,69 @@ completionHandler:(void (^)(TPPOPDSFeed *feed, NSDictionary *error))handler
                              metadata:@{
                                @"shouldResetCache": @(shouldResetCache)
                              }];
-    TPPAsyncDispatch(^{handler(nil, nil);});
+    TPPAsyncDispatch(^{handler(nil, nil, nil);});
     return;
   }
 
+  // The feed is parsed while it downloads: chunks are pushed to the parser as
+  // they arrive. With an entry handler, entries are built as soon as their
+  // element is closed; otherwise they are built concurrently once the whole
+  // feed has been parsed. Parser state is only touched on `parseQueue`;
+  // entries and the parsed feed are handed over on `deliveryQueue` so that
+  // they arrive in order.
+  dispatch_queue_t const parseQueue =
+    dispatch_queue_create("org.thepalaceproject.opdsFeed.parse", DISPATCH_QUEUE_SERIAL);
+  dispatch_queue_t const deliveryQueue =
+    dispatch_queue_create("org.thepalaceproject.opdsFeed.delivery", DISPATCH_QUEUE_SERIAL);
+  // Completions outside `parseQueue` go through it first, so they follow
+  // every chunk being parsed and every entry handed over.
+  void (^const deliverAfterParsing)(dispatch_block_t) = ^(dispatch_block_t const block) {
+    dispatch_async(parseQueue, ^{dispatch_async(deliveryQueue, block);});
+  };
+  NSMutableArray *entries = nil;
+  void (^elementHandler)(TPPXML *) = nil;
+  if(entryHandler) {
+    entries = [NSMutableArray array];
+    elementHandler = ^(TPPXML *const element) {
+      if(![element.name isEqualToString:@"entry"]) {
+        return;
+      }
+      TPPOPDSEntry *const entry = [[TPPOPDSEntry alloc] initWithXML:element];
+      if(!entry) {
+        TPPLOG(@"Ingoring malformed 'entry' element.");
+        return;
+      }
+      [entries addObject:entry];
+      dispatch_async(deliveryQueue, ^{entryHandler(entry);});
+    };
+  }
+  __block BOOL receivedData = NO;
+  TPPXMLStreamParser *const parser = [[TPPXMLStreamParser alloc] initWithElementHandler:elementHandler];
+
   request = [[[TPPNetworkExecutor shared] GET:URL
                                   cachePolicy:cachePolicy
                                   useTokenIfAvailable:useTokenIfAvailable
+                                  headers:requestHeaders
+                                  dataHandler:^(NSData *data) {
+    dispatch_async(parseQueue, ^{
+      receivedData = YES;
+      [parser parseData:data];
+    });
+  }
                                   completion:^(NSData *data, NSURLResponse *response, NSError *error) {
 
+    NSHTTPURLResponse *const httpResponse =
+      [response isKindOfClass:[NSHTTPURLResponse class]] ? (NSHTTPURLResponse *)response : nil;
+
     if (error != nil) {
       // Note: NYPLNetworkExecutor already logged this error
-      TPPAsyncDispatch(^{handler(nil, error.problemDocument.dictionaryValue);});
+      deliverAfterParsing(^{handler(nil, error.problemDocument.dictionaryValue, httpResponse);});
+      return;
+    }
+
+    // The validators in `requestHeaders` still match: there is nothing to parse.
+    if (httpResponse.statusCode == 304) {
+      deliverAfterParsing(^{handler(nil, nil, httpResponse);});
       return;
     }
 
@@ -101,18 +235,16 @@ completionHandler:(void (^)(TPPOPDSFeed *feed, NSDictionary *error))handler
                                  @"Request": [request loggableString] ?: @"N/A",
                                  @"Response": response ?: @"N/A",
                                }];
-      TPPAsyncDispatch(^{handler(nil, nil);});
+      deliverAfterParsing(^{handler(nil, nil, httpResponse);});
       return;
     }
 
-    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
-      NSHTTPURLResponse *httpResp = (NSHTTPURLResponse*)response;
-
-      if (httpResp.statusCode < 200 || httpResp.statusCode > 299) {
+    if (httpResponse) {
+      if (httpResponse.statusCode < 200 || httpResponse.statusCode > 299) {
         // this captures a situation where (e.g.) borrow requests to the
         // Brooklyn lib come back with a 500 status code, no error, and non-nil
         // data containing "An internal error occurred" plain text.
-        NSString *msg = [NSString stringWithFormat:@"Got %ld HTTP status with no error object.", (long)httpResp.statusCode];
+        NSString *msg = [NSString stringWithFormat:@"Got %ld HTTP status with no error object.", (long)httpResponse.statusCode];
 
         NSString *dataString = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
 
@@ -133,44 +265,57 @@ completionHandler:(void (^)(TPPOPDSFeed *feed, NSDictionary *error))handler
                                   @"context": msg ?: @"N/A"
                                 }];
 
-        TPPAsyncDispatch(^{handler(nil, problemDocDict);});
+        deliverAfterParsing(^{handler(nil, problemDocDict, httpResponse);});
         return;
       }
     }
     
-    TPPXML *const feedXML = [TPPXML XMLWithData:data];
-    if(!feedXML) {
-      TPPLOG(@"Failed to parse data as XML.");
-      [TPPErrorLogger logErrorWithCode:TPPErrorCodeFeedParseFail
-                                summary:@"NYPLOPDSFeed: Failed to parse data as XML"
-                               metadata:@{
-                                 @"request": request.loggableString ?: @"N/A",
-                                 @"response": response ?: @"N/A",
-                               }];
-      // this error may be nil
-      NSDictionary *error = [NSJSONSerialization JSONObjectWithData:data options:(NSJSONReadingOptions)0 error:nil];
-      TPPAsyncDispatch(^{handler(nil, error);});
-      return;
-    }
+    dispatch_async(parseQueue, ^{
+      // Responses served without incremental delivery are parsed in one go.
+      if(!receivedData) {
+        [parser parseData:data];
+      }
+      TPPXML *const feedXML = [parser finish];
+      if(!feedXML) {
+        TPPLOG(@"Failed to parse data as XML.");
+        [TPPErrorLogger logErrorWithCode:TPPErrorCodeFeedParseFail
+                                  summary:@"NYPLOPDSFeed: Failed to parse data as XML"
+                                 metadata:@{
+                                   @"request": request.loggableString ?: @"N/A",
+                                   @"response": response ?: @"N/A",
+                                 }];
+        // this error may be nil
+        NSDictionary *error = [NSJSONSerialization JSONObjectWithData:data options:(NSJSONReadingOptions)0 error:nil];
+        dispatch_async(deliveryQueue, ^{handler(nil, error, httpResponse);});
+        return;
+      }
     
-    TPPOPDSFeed *const feed = [[TPPOPDSFeed alloc] initWithXML:feedXML];
-    if(!feed) {
-      TPPLOG(@"Could not interpret XML as OPDS.");
-      [TPPErrorLogger logErrorWithCode:TPPErrorCodeOpdsFeedParseFail
-                                summary:@"NYPLOPDSFeed: Failed to parse XML as OPDS"
-                               metadata:@{
-                                 @"request": request.loggableString ?: @"N/A",
-                                 @"response": response ?: @"N/A",
-                               }];
-      TPPAsyncDispatch(^{handler(nil, nil);});
-      return;
-    }
+      TPPOPDSFeed *const feed = [[TPPOPDSFeed alloc] initWithXML:feedXML entries:entries];
+      if(!feed) {
+        TPPLOG(@"Could not interpret XML as OPDS.");
+        [TPPErrorLogger logErrorWithCode:TPPErrorCodeOpdsFeedParseFail
+                                  summary:@"NYPLOPDSFeed: Failed to parse XML as OPDS"
+                                 metadata:@{
+                                   @"request": request.loggableString ?: @"N/A",
+                                   @"response": response ?: @"N/A",
+                                 }];
+        dispatch_async(deliveryQueue, ^{handler(nil, nil, httpResponse);});
+        return;
+      }
     
-    TPPAsyncDispatch(^{handler(feed, nil);});
+      dispatch_async(deliveryQueue, ^{handler(feed, nil, httpResponse);});
+    });
   }] originalRequest];
 }
 
 - (instancetype)initWithXML:(TPPXML *const)feedXML
+{
+  return [self initWithXML:feedXML entries:nil];
+}
+
+/// @param entries Entries already built from @c feedXML while it was parsed,
+/// or @c nil to build them from @c feedXML.
+- (instancetype)initWithXML:(TPPXML *const)feedXML entries:(NSArray *const)entries
 {
   self = [super init];
   if(!self) return nil;
@@ -231,20 +376,7 @@ completionHandler:(void (^)(TPPOPDSFeed *feed, NSDictionary *error))handler
     }
   }
   
-  {
-    NSMutableArray *const entries = [NSMutableArray array];
-    
-    for(TPPXML *const entryXML in [feedXML childrenWithName:@"entry"]) {
-      TPPOPDSEntry *const entry = [[TPPOPDSEntry alloc] initWithXML:entryXML];
-      if(!entry) {
-        TPPLOG(@"Ingoring malformed 'entry' element.");
-        continue;
-      }
-      [entries addObject:entry];
-    }
-    
-    self.entries = entries;
-  }
+  self.entries = entries ? [entries copy] : EntriesWithXMLs([feedXML childrenWithName:@"entry"]);
   
   {
     TPPXML *patronXML = [feedXML firstChildWithName:@"patron"];
@@ -0,0 +1,152 @@
+//
+//  LRUCache.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Fixed-capacity dictionary that evicts its least recently used entry.
+///
+/// Entries live in a slot array linked in access order, so lookups,
+/// insertions, removals and evictions are all O(1). Removed slots are
+/// reused rather than compacting the array.
+struct LRUCache<Key: Hashable, Value> {
+
+    private struct Node {
+        let key: Key
+        var value: Value
+        var previous: Int?
+        var next: Int?
+    }
+
+    let capacity: Int
+
+    private var slots = [Node?]()
+    private var indices = [Key: Int]()
+    private var freeSlots = [Int]()
+    /// Least recently used slot.
+    private var head: Int?
+    /// Most recently used slot.
+    private var tail: Int?
+
+    init(capacity: Int) {
+        self.capacity = max(1, capacity)
+    }
+
+    var count: Int { indices.count }
+    var isEmpty: Bool { indices.isEmpty }
+
+    /// Keys from least to most recently used.
+    var keys: [Key] {
+        var keys = [Key]()
+        keys.reserveCapacity(count)
+        var slot = head
+        while let current = slot, let node = slots[current] {
+            keys.append(node.key)
+            slot = node.next
+        }
+        return keys
+    }
+
+    /// Value for `key`, marking it most recently used.
+    mutating func value(forKey key: Key) -> Value? {
+        guard let slot = indices[key] else { return nil }
+        moveToTail(slot)
+        return slots[slot]?.value
+    }
+
+    /// Value for `key`, without changing the access order.
+    func peek(_ key: Key) -> Value? {
+        indices[key].flatMap { slots[$0]?.value }
+    }
+
+    /// Stores `value` as most recently used.
+    /// - Returns: The entry evicted to stay within capacity, if any.
+    @discardableResult
+    mutating func setValue(_ value: Value, forKey key: Key) -> (key: Key, value: Value)? {
+        if let slot = indices[key] {
+            slots[slot]?.value = value
+            moveToTail(slot)
+            return nil
+        }
+
+        var evicted: (key: Key, value: Value)?
+        if count >= capacity, let oldest = head, let node = slots[oldest] {
+            evicted = (node.key, node.value)
+            removeSlot(oldest)
+        }
+
+        let node = Node(key: key, value: value, previous: tail, next: nil)
+        let slot: Int
+        if let free = freeSlots.popLast() {
+            slot = free
+            slots[slot] = node
+        } else {
+            slot = slots.count
+            slots.append(node)
+        }
+        if let tail {
+            slots[tail]?.next = slot
+        } else {
+            head = slot
+        }
+        tail = slot
+        indices[key] = slot
+        return evicted
+    }
+
+    @discardableResult
+    mutating func removeValue(forKey key: Key) -> Value? {
+        guard let slot = indices[key] else { return nil }
+        let value = slots[slot]?.value
+        removeSlot(slot)
+        return value
+    }
+
+    mutating func removeAll() {
+        slots.removeAll()
+        indices.removeAll()
+        freeSlots.removeAll()
+        head = nil
+        tail = nil
+    }
+
+    // MARK: - Links
+
+    private mutating func unlink(_ slot: Int) {
+        guard let node = slots[slot] else { return }
+        if let previous = node.previous {
+            slots[previous]?.next = node.next
+        } else {
+            head = node.next
+        }
+        if let next = node.next {
+            slots[next]?.previous = node.previous
+        } else {
+            tail = node.previous
+        }
+    }
+
+    private mutating func moveToTail(_ slot: Int) {
+        guard slot != tail else { return }
+        unlink(slot)
+        slots[slot]?.previous = tail
+        slots[slot]?.next = nil
+        if let tail {
+            slots[tail]?.next = slot
+        } else {
+            head = slot
+        }
+        tail = slot
+    }
+
+    private mutating func removeSlot(_ slot: Int) {
+        guard let node = slots[slot] else { return }
+        unlink(slot)
+        slots[slot] = nil
+        indices.removeValue(forKey: node.key)
+        freeSlots.append(slot)
+    }
+}
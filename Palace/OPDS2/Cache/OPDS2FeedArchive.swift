@@ -0,0 +1,209 @@
+//
+//  OPDS2FeedArchive.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Binary encoding of a cached OPDS2 feed that decodes publications on demand.
+///
+/// Feed metadata, links, navigation, facets and group headers are decoded
+/// when the archive is opened; each publication is a separate record found
+/// through an offset table, so showing the first screen of a large feed
+/// decodes only the publications on it.
+///
+/// Layout, little-endian:
+///
+///     "OF2A" | version u32 | header length u32 | header (binary plist)
+///     publication count u32 | (count + 1) × offset u32 | publication records (binary plist)
+///
+/// Publications of the feed come first in the record table, followed by
+/// those of each group in order.
+struct OPDS2FeedArchive: Sendable {
+
+    enum ArchiveError: Error {
+        case invalidFormat
+    }
+
+    private static let magic = Data("OF2A".utf8)
+    private static let formatVersion: UInt32 = 1
+
+    private struct Header: Codable {
+        let timestamp: Date
+        let etag: String?
+        let lastModified: String?
+        let metadata: OPDS2FeedMetadata
+        let links: [OPDS2Link]
+        /// `nil` when the feed has no `publications` array.
+        let publicationCount: Int?
+        let navigation: [OPDS2NavigationLink]?
+        let groups: [Group]?
+        let facets: [OPDS2FacetGroup]?
+    }
+
+    private struct Group: Codable {
+        let metadata: OPDS2GroupMetadata
+        let links: [OPDS2Link]?
+        let navigation: [OPDS2NavigationLink]?
+        let publicationCount: Int?
+    }
+
+    private let data: Data
+    private let header: Header
+    /// Start of the offset table.
+    private let tableOffset: Int
+    /// Start of the publication records.
+    private let recordsOffset: Int
+    private let recordCount: Int
+
+    var timestamp: Date { header.timestamp }
+    var etag: String? { header.etag }
+    var lastModified: String? { header.lastModified }
+    var metadata: OPDS2FeedMetadata { header.metadata }
+    var links: [OPDS2Link] { header.links }
+    var navigation: [OPDS2NavigationLink]? { header.navigation }
+    var facets: [OPDS2FacetGroup]? { header.facets }
+
+    /// Number of publications in the feed, outside groups.
+    var publicationCount: Int { header.publicationCount ?? 0 }
+
+    /// Size of the encoded feed.
+    var byteCount: Int { data.count }
+
+    func isExpired(maxAge: TimeInterval) -> Bool {
+        Date().timeIntervalSince(timestamp) > maxAge
+    }
+
+    // MARK: - Decoding
+
+    /// Opens an archive, decoding only its header.
+    init(data: Data) throws {
+        guard data.count >= 12, data.prefix(4) == Self.magic,
+              data.readLittleEndian(UInt32.self, at: 4) == Self.formatVersion else {
+            throw ArchiveError.invalidFormat
+        }
+        let headerLength = Int(data.readLittleEndian(UInt32.self, at: 8))
+        let countOffset = 12 + headerLength
+        guard countOffset + 4 <= data.count else {
+            throw ArchiveError.invalidFormat
+        }
+
+        let start = data.startIndex
+        header = try PropertyListDecoder().decode(Header.self, from: data.subdata(in: start + 12..<start + countOffset))
+        recordCount = Int(data.readLittleEndian(UInt32.self, at: countOffset))
+        tableOffset = countOffset + 4
+        recordsOffset = tableOffset + (recordCount + 1) * 4
+        let groupRecords = header.groups?.reduce(0) { $0 + ($1.publicationCount ?? 0) } ?? 0
+        guard recordsOffset <= data.count,
+              publicationCount + groupRecords == recordCount,
+              recordsOffset + Int(data.readLittleEndian(UInt32.self, at: tableOffset + recordCount * 4)) == data.count else {
+            throw ArchiveError.invalidFormat
+        }
+        self.data = data
+    }
+
+    /// Publications of the feed at `range`, clamped to the ones it has.
+    func publications(in range: Range<Int>) throws -> [OPDS2Publication] {
+        try records(in: range.clamped(to: 0..<publicationCount))
+    }
+
+    /// Groups with up to `publicationLimit` publications each.
+    func groups(publicationLimit: Int? = nil) throws -> [OPDS2Group]? {
+        guard let groups = header.groups else { return nil }
+        var firstRecord = publicationCount
+        return try groups.map { group -> OPDS2Group in
+            let count = group.publicationCount ?? 0
+            let decoded = min(count, publicationLimit ?? count)
+            defer { firstRecord += count }
+            return OPDS2Group(
+                metadata: group.metadata,
+                links: group.links,
+                publications: try group.publicationCount.map { _ in try records(in: firstRecord..<firstRecord + decoded) },
+                navigation: group.navigation
+            )
+        }
+    }
+
+    /// The feed, with up to `publicationLimit` publications in it and in
+    /// each group, or all of them.
+    func feed(publicationLimit: Int? = nil) throws -> OPDS2Feed {
+        OPDS2Feed(
+            metadata: header.metadata,
+            links: header.links,
+            publications: try header.publicationCount.map { count in
+                try publications(in: 0..<min(count, publicationLimit ?? count))
+            },
+            navigation: header.navigation,
+            groups: try groups(publicationLimit: publicationLimit),
+            facets: header.facets
+        )
+    }
+
+    /// The cache entry, with the publications of `feed(publicationLimit:)` decoded.
+    func entry(publicationLimit: Int? = nil) throws -> OPDSCacheEntry<OPDS2Feed> {
+        OPDSCacheEntry(
+            feed: try feed(publicationLimit: publicationLimit),
+            timestamp: header.timestamp,
+            etag: header.etag,
+            lastModified: header.lastModified
+        )
+    }
+
+    private func records(in range: Range<Int>) throws -> [OPDS2Publication] {
+        let decoder = PropertyListDecoder()
+        let start = data.startIndex + recordsOffset
+        return try range.map { index -> OPDS2Publication in
+            let lower = Int(data.readLittleEndian(UInt32.self, at: tableOffset + index * 4))
+            let upper = Int(data.readLittleEndian(UInt32.self, at: tableOffset + (index + 1) * 4))
+            guard lower <= upper, start + upper <= data.endIndex else {
+                throw ArchiveError.invalidFormat
+            }
+            return try decoder.decode(OPDS2Publication.self, from: data.subdata(in: start + lower..<start + upper))
+        }
+    }
+
+    // MARK: - Encoding
+
+    static func encode(_ entry: OPDSCacheEntry<OPDS2Feed>) throws -> Data {
+        let feed = entry.feed
+        let encoder = PropertyListEncoder()
+        encoder.outputFormat = .binary
+
+        let header = Header(
+            timestamp: entry.timestamp,
+            etag: entry.etag,
+            lastModified: entry.lastModified,
+            metadata: feed.metadata,
+            links: feed.links,
+            publicationCount: feed.publications?.count,
+            navigation: feed.navigation,
+            groups: feed.groups?.map {
+                Group(metadata: $0.metadata, links: $0.links, navigation: $0.navigation, publicationCount: $0.publications?.count)
+            },
+            facets: feed.facets
+        )
+        let publications = (feed.publications ?? []) + (feed.groups ?? []).flatMap { $0.publications ?? [] }
+
+        var records = Data()
+        var offsets: [UInt32] = [0]
+        offsets.reserveCapacity(publications.count + 1)
+        for publication in publications {
+            records.append(try encoder.encode(publication))
+            offsets.append(UInt32(records.count))
+        }
+
+        let headerData = try encoder.encode(header)
+        var data = Data()
+        data.reserveCapacity(16 + headerData.count + offsets.count * 4 + records.count)
+        data.append(magic)
+        data.appendLittleEndian(formatVersion)
+        data.appendLittleEndian(UInt32(headerData.count))
+        data.append(headerData)
+        data.appendLittleEndian(UInt32(publications.count))
+        offsets.forEach { data.appendLittleEndian($0) }
+        data.append(records)
+        return data
+    }
+}
@@ -91,8 +91,7 @@ actor OPDS2FeedCache: OPDSFeedCaching {
 
     // MARK: - Properties
 
-    private var memoryCache: [String: OPDSCacheEntry<OPDS2Feed>] = [:]
-    private var accessOrder: [String] = []
+    private var memoryCache: LRUCache<String, OPDSCacheEntry<OPDS2Feed>>
     private let configuration: Configuration
     private let diskCache: GeneralCache<String, Data>?
 
@@ -102,6 +101,7 @@ actor OPDS2FeedCache: OPDSFeedCaching {
 
     public init(configuration: Configuration = .default) {
         self.configuration = configuration
+        self.memoryCache = LRUCache(capacity: configuration.maxMemoryEntries)
 
         if configuration.persistToDisk {
             self.diskCache = GeneralCache<String, Data>(cacheName: "OPDS2Feeds", mode: .memoryAndDisk)
@@ -113,13 +113,19 @@ actor OPDS2FeedCache: OPDSFeedCaching {
     // MARK: - Cache Operations
 
     public func get(for url: URL) async -> OPDSCacheEntry<OPDS2Feed>? {
-        let key = cacheKey(for: url)
+        await get(for: url, publicationLimit: nil)
+    }
 
-        // Try memory cache first
-        if let entry = memoryCache[key] {
-            // Update access order for LRU
-            updateAccessOrder(key)
+    /// The cached feed, decoding at most `publicationLimit` publications of the
+    /// feed and of each group when it is read from disk, e.g. those of the first
+    /// screen. Use `publications(for:in:)` for the others.
+    ///
+    /// Only a feed decoded whole is kept in memory.
+    public func get(for url: URL, publicationLimit: Int?) async -> OPDSCacheEntry<OPDS2Feed>? {
+        let key = cacheKey(for: url)
 
+        // Try memory cache first; the lookup marks it recently used
+        if let entry = memoryCache.value(forKey: key) {
             // Check if expired
             if entry.isExpired(maxAge: configuration.maxAge) {
                 memoryCache.removeValue(forKey: key)
@@ -129,56 +135,57 @@ actor OPDS2FeedCache: OPDSFeedCaching {
             return entry
         }
 
-        // Try disk cache
-        if let diskCache = diskCache,
-           let data = diskCache.get(for: key),
-           let entry = try? JSONDecoder().decode(OPDSCacheEntry<OPDS2Feed>.self, from: data) {
+        // Try disk cache, checking expiry before decoding publications
+        guard let archive = diskArchive(for: key) else {
+            return nil
+        }
+        guard let entry = try? archive.entry(publicationLimit: publicationLimit) else {
+            diskCache?.remove(for: key)
+            return nil
+        }
 
-            // Check if expired
-            if entry.isExpired(maxAge: configuration.maxAge) {
-                diskCache.remove(for: key)
-                return nil
-            }
+        // Promote to memory cache
+        if publicationLimit == nil {
+            memoryCache.setValue(entry, forKey: key)
+        }
 
-            // Promote to memory cache
-            memoryCache[key] = entry
-            updateAccessOrder(key)
+        return entry
+    }
 
-            return entry
+    /// Publications of the cached feed at `range`, outside groups, decoding only those.
+    public func publications(for url: URL, in range: Range<Int>) async -> [OPDS2Publication]? {
+        let key = cacheKey(for: url)
+        if let entry = memoryCache.value(forKey: key), !entry.isExpired(maxAge: configuration.maxAge) {
+            let publications = entry.feed.publications ?? []
+            return Array(publications[range.clamped(to: publications.indices)])
         }
-
-        return nil
+        return try? diskArchive(for: key)?.publications(in: range)
     }
 
     public func set(_ entry: OPDSCacheEntry<OPDS2Feed>, for url: URL) async {
         let key = cacheKey(for: url)
 
-        // Evict if at capacity
-        if memoryCache.count >= configuration.maxMemoryEntries {
-            evictLRU()
-        }
-
-        // Store in memory
-        memoryCache[key] = entry
-        updateAccessOrder(key)
+        // Store in memory, evicting the least recently used entry at capacity
+        memoryCache.setValue(entry, forKey: key)
 
         // Persist to disk
-        if let diskCache = diskCache,
-           let data = try? JSONEncoder().encode(entry) {
-            diskCache.set(data, for: key, expiresIn: configuration.maxAge)
+        if let diskCache = diskCache {
+            do {
+                diskCache.set(try OPDS2FeedArchive.encode(entry), for: key, expiresIn: configuration.maxAge)
+            } catch {
+                Log.warn(#file, "Failed to archive OPDS2 feed for \(key): \(error)")
+            }
         }
     }
 
     public func remove(for url: URL) async {
         let key = cacheKey(for: url)
         memoryCache.removeValue(forKey: key)
-        accessOrder.removeAll { $0 == key }
         diskCache?.remove(for: key)
     }
 
     public func clear() async {
         memoryCache.removeAll()
-        accessOrder.removeAll()
         diskCache?.clear()
     }
 
@@ -187,14 +194,16 @@ actor OPDS2FeedCache: OPDSFeedCaching {
     /// Gets cached feed, returns stale data immediately while refreshing in background
     /// - Parameters:
     ///   - url: The feed URL
+    ///   - publicationLimit: Publications to decode from a feed cached on disk, see `get(for:publicationLimit:)`
     ///   - fetcher: Async function to fetch fresh data
     /// - Returns: The feed (possibly stale) and whether a background refresh was triggered
     public func getWithRevalidation(
         for url: URL,
+        publicationLimit: Int? = nil,
         fetcher: @escaping () async throws -> (OPDS2Feed, etag: String?, lastModified: String?)
     ) async throws -> (feed: OPDS2Feed, isStale: Bool, didTriggerRefresh: Bool) {
 
-        if let entry = await get(for: url) {
+        if let entry = await get(for: url, publicationLimit: publicationLimit) {
             let isStale = entry.isStale(ttl: configuration.staleTTL)
 
             if isStale {
@@ -236,15 +245,25 @@ actor OPDS2FeedCache: OPDSFeedCaching {
 
     /// Get headers for conditional fetch (If-None-Match, If-Modified-Since)
     public func conditionalHeaders(for url: URL) async -> [String: String] {
-        guard let entry = await get(for: url) else { return [:] }
+        // Validators are in the archive header, so no publication is decoded
+        let key = cacheKey(for: url)
+        let etag: String?
+        let lastModified: String?
+        if let entry = memoryCache.peek(key), !entry.isExpired(maxAge: configuration.maxAge) {
+            (etag, lastModified) = (entry.etag, entry.lastModified)
+        } else if let archive = diskArchive(for: key) {
+            (etag, lastModified) = (archive.etag, archive.lastModified)
+        } else {
+            return [:]
+        }
 
         var headers: [String: String] = [:]
 
-        if let etag = entry.etag {
+        if let etag {
             headers["If-None-Match"] = etag
         }
 
-        if let lastModified = entry.lastModified {
+        if let lastModified {
             headers["If-Modified-Since"] = lastModified
         }
 
@@ -263,15 +282,17 @@ actor OPDS2FeedCache: OPDSFeedCaching {
         url.absoluteString
     }
 
-    private func updateAccessOrder(_ key: String) {
-        accessOrder.removeAll { $0 == key }
-        accessOrder.append(key)
-    }
-
-    private func evictLRU() {
-        guard let oldestKey = accessOrder.first else { return }
-        memoryCache.removeValue(forKey: oldestKey)
-        accessOrder.removeFirst()
+    /// Opens the disk entry for `key`, removing it if it's expired or unreadable.
+    private func diskArchive(for key: String) -> OPDS2FeedArchive? {
+        guard let diskCache, let data = diskCache.get(for: key) else {
+            return nil
+        }
+        guard let archive = try? OPDS2FeedArchive(data: data),
+              !archive.isExpired(maxAge: configuration.maxAge) else {
+            diskCache.remove(for: key)
+            return nil
+        }
+        return archive
     }
 }
 
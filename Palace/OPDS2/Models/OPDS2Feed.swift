@@ -266,6 +266,10 @@ extension OPDS2Feed {
             let container = try decoder.singleValueContainer()
             let dateString = try container.decode(String.self)
 
+            if let date = NSDate(rfc3339String: dateString) as Date? {
+                return date
+            }
+
             // Try with fractional seconds first
             if let date = formatter.date(from: dateString) {
                 return date
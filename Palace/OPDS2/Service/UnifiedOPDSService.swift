@@ -94,7 +94,12 @@ actor UnifiedOPDSService {
 
     // MARK: - State
 
-    private var inflightRequests: [URL: Task<UnifiedOPDSFeed, Error>] = [:]
+    private struct RequestKey: Hashable {
+        let url: URL
+        let publicationLimit: Int?
+    }
+
+    private var inflightRequests: [RequestKey: Task<UnifiedOPDSFeed, Error>] = [:]
 
     // MARK: - Singleton
 
@@ -116,15 +121,19 @@ actor UnifiedOPDSService {
 
     /// Fetches a feed, preferring OPDS2 format with automatic OPDS1 fallback
     /// Uses stale-while-revalidate caching for optimal performance
+    /// - Parameter publicationLimit: Publications to decode from an OPDS2 feed cached on disk;
+    ///   load the others with `publications(from:in:)`. `nil` decodes the whole feed.
     public func fetchFeed(
         from url: URL,
         preferOPDS2: Bool = true,
         useToken: Bool = true,
-        forceRefresh: Bool = false
+        forceRefresh: Bool = false,
+        publicationLimit: Int? = nil
     ) async throws -> UnifiedOPDSFeed {
+        let key = RequestKey(url: url, publicationLimit: publicationLimit)
 
         // Check for existing inflight request
-        if let existing = inflightRequests[url] {
+        if let existing = inflightRequests[key] {
             return try await existing.value
         }
 
@@ -133,7 +142,7 @@ actor UnifiedOPDSService {
             // Try OPDS2 first if preferred
             if preferOPDS2 {
                 do {
-                    let feed = try await fetchOPDS2Feed(from: url, useToken: useToken, forceRefresh: forceRefresh)
+                    let feed = try await fetchOPDS2Feed(from: url, useToken: useToken, forceRefresh: forceRefresh, publicationLimit: publicationLimit)
                     return .opds2(feed)
                 } catch {
                     Log.info(#file, "OPDS2 fetch failed, falling back to OPDS1: \(error.localizedDescription)")
@@ -145,10 +154,10 @@ actor UnifiedOPDSService {
             return .opds1(feed)
         }
 
-        inflightRequests[url] = task
+        inflightRequests[key] = task
 
         defer {
-            inflightRequests[url] = nil
+            inflightRequests[key] = nil
         }
 
         return try await task.value
@@ -197,12 +206,13 @@ actor UnifiedOPDSService {
     private func fetchOPDS2Feed(
         from url: URL,
         useToken: Bool,
-        forceRefresh: Bool
+        forceRefresh: Bool,
+        publicationLimit: Int? = nil
     ) async throws -> OPDS2Feed {
 
         // Check cache unless forcing refresh
         if !forceRefresh {
-            let result = try await opds2Cache.getWithRevalidation(for: url) { [self] in
+            let result = try await opds2Cache.getWithRevalidation(for: url, publicationLimit: publicationLimit) { [self] in
                 try await performOPDS2Fetch(from: url, useToken: useToken)
             }
             return result.feed
@@ -259,6 +269,12 @@ actor UnifiedOPDSService {
         return (feed, etag, lastModified)
     }
 
+    /// Publications of the cached OPDS2 feed at `range`, e.g. the ones after
+    /// the first screen of a feed fetched with a `publicationLimit`.
+    public func publications(from url: URL, in range: Range<Int>) async -> [OPDS2Publication]? {
+        await opds2Cache.publications(for: url, in: range)
+    }
+
     // MARK: - OPDS1 Fetch (Fallback)
 
     private func fetchOPDS1Feed(
@@ -335,8 +351,10 @@ actor UnifiedOPDSService {
     // MARK: - Request Management
 
     public func cancelRequest(for url: URL) {
-        inflightRequests[url]?.cancel()
-        inflightRequests[url] = nil
+        for key in inflightRequests.keys where key.url == url {
+            inflightRequests[key]?.cancel()
+            inflightRequests[key] = nil
+        }
     }
 
     public func cancelAllRequests() {
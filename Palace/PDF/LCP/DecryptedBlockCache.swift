@@ -0,0 +1,246 @@
+//
+//  DecryptedBlockCache.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+import os
+import UIKit
+
+/// Decrypted blocks of an encrypted file, least recently used evicted first.
+///
+/// PDF rendering reads a page as many small consecutive reads, and page turns
+/// go back and forth over a few pages; keeping several decrypted blocks means
+/// each block is decrypted once while the reader stays around it. Reads
+/// spanning blocks are stitched together, and the blocks after (or before,
+/// when paging back) the last read are decrypted ahead on a background queue.
+final class DecryptedBlockCache {
+    typealias BlockDecryptor = (_ range: Range<Int>) -> Data?
+
+    static let defaultBlockSize = 1024 * 1024
+
+    /// Number of cached blocks for the device memory.
+    static var defaultCapacity: Int {
+        let deviceMemoryMB = ProcessInfo.processInfo.physicalMemory / (1024 * 1024)
+        if deviceMemoryMB < 2048 {
+            return 8
+        } else if deviceMemoryMB < 4096 {
+            return 16
+        } else {
+            return 24
+        }
+    }
+
+    let length: Int
+    let blockSize: Int
+    let capacity: Int
+    let readAheadCount: Int
+
+    private struct State {
+        var blocks = [Int: Data]()
+        /// Block indexes, least recently used first.
+        var recency = [Int]()
+        /// Blocks being decrypted, to wait for instead of decrypting them twice.
+        var inFlight = [Int: DispatchGroup]()
+        var lastReadBlock: Int?
+
+        mutating func touch(_ index: Int) {
+            if let position = recency.firstIndex(of: index) {
+                recency.remove(at: position)
+            }
+            recency.append(index)
+        }
+
+        mutating func insert(_ data: Data, at index: Int, capacity: Int) {
+            blocks[index] = data
+            touch(index)
+            while recency.count > capacity {
+                blocks.removeValue(forKey: recency.removeFirst())
+            }
+        }
+    }
+
+    private let state = OSAllocatedUnfairLock(initialState: State())
+    private let decryptor: BlockDecryptor
+    private let readAheadQueue = DispatchQueue(label: "org.thepalaceproject.decryptedBlockCache.readAhead", qos: .utility)
+    private var memoryWarningObserver: NSObjectProtocol?
+
+    /// - Parameters:
+    ///   - length: Length of the encrypted file.
+    ///   - blockSize: Size of the decrypted blocks.
+    ///   - capacity: Maximum number of blocks kept.
+    ///   - readAheadCount: Number of blocks decrypted ahead of the reader.
+    ///   - decryptor: Decrypts a block range of the file.
+    init(
+        length: Int,
+        blockSize: Int = DecryptedBlockCache.defaultBlockSize,
+        capacity: Int = DecryptedBlockCache.defaultCapacity,
+        readAheadCount: Int = 2,
+        decryptor: @escaping BlockDecryptor
+    ) {
+        self.length = length
+        self.blockSize = max(1, blockSize)
+        self.capacity = max(1, capacity)
+        // Read-ahead must not evict the blocks being read.
+        self.readAheadCount = max(0, min(readAheadCount, capacity - 2))
+        self.decryptor = decryptor
+
+        memoryWarningObserver = NotificationCenter.default.addObserver(
+            forName: UIApplication.didReceiveMemoryWarningNotification,
+            object: nil,
+            queue: nil
+        ) { [weak self] _ in
+            self?.removeAll()
+        }
+    }
+
+    deinit {
+        if let observer = memoryWarningObserver {
+            NotificationCenter.default.removeObserver(observer)
+        }
+    }
+
+    /// Number of blocks currently cached.
+    var count: Int {
+        state.withLock { $0.blocks.count }
+    }
+
+    func removeAll() {
+        state.withLock {
+            $0.blocks.removeAll()
+            $0.recency.removeAll()
+        }
+    }
+
+    /// Decrypted data in `range`.
+    /// - Returns: `nil` if the range is empty, outside the file, or a block
+    ///   can't be decrypted.
+    func read(_ range: Range<Int>) -> Data? {
+        guard !range.isEmpty else { return nil }
+        var data = Data(count: range.count)
+        let success = data.withUnsafeMutableBytes { buffer in
+            read(range, into: buffer.baseAddress!)
+        }
+        return success ? data : nil
+    }
+
+    /// Copies decrypted data in `range` straight from the cached blocks into
+    /// `buffer`, which must hold `range.count` bytes.
+    /// - Returns: `false` if the range is empty, outside the file, or a block
+    ///   can't be decrypted.
+    func read(_ range: Range<Int>, into buffer: UnsafeMutableRawPointer) -> Bool {
+        guard !range.isEmpty, range.lowerBound >= 0, range.upperBound <= length else {
+            return false
+        }
+        let firstBlock = range.lowerBound / blockSize
+        let lastBlock = (range.upperBound - 1) / blockSize
+
+        scheduleReadAhead(firstBlock: firstBlock, lastBlock: lastBlock)
+
+        var destination = buffer
+        for index in firstBlock...lastBlock {
+            guard let block = block(at: index) else { return false }
+            let offset = index * blockSize
+            let lower = max(range.lowerBound, offset) - offset
+            let upper = min(range.upperBound, offset + block.count) - offset
+            block.withUnsafeBytes { source in
+                destination.copyMemory(from: source.baseAddress! + lower, byteCount: upper - lower)
+            }
+            destination += upper - lower
+        }
+        return true
+    }
+
+    // MARK: - Blocks
+
+    private func blockRange(_ index: Int) -> Range<Int> {
+        let start = index * blockSize
+        return start..<min(start + blockSize, length)
+    }
+
+    private enum Lookup {
+        case cached(Data)
+        case inFlight(DispatchGroup)
+        case load(DispatchGroup)
+    }
+
+    private func lookup(_ index: Int) -> Lookup {
+        state.withLock { state in
+            if let data = state.blocks[index] {
+                state.touch(index)
+                return .cached(data)
+            }
+            if let group = state.inFlight[index] {
+                return .inFlight(group)
+            }
+            let group = DispatchGroup()
+            group.enter()
+            state.inFlight[index] = group
+            return .load(group)
+        }
+    }
+
+    private func block(at index: Int) -> Data? {
+        switch lookup(index) {
+        case .cached(let data):
+            return data
+        case .inFlight(let group):
+            group.wait()
+            if let data = state.withLock({ $0.blocks[index] }) {
+                return data
+            }
+            // Evicted meanwhile, or failed to decrypt.
+            let range = blockRange(index)
+            return decryptor(range).flatMap { $0.count == range.count ? $0 : nil }
+        case .load(let group):
+            return load(index, group: group)
+        }
+    }
+
+    private func load(_ index: Int, group: DispatchGroup) -> Data? {
+        defer { group.leave() }
+        let range = blockRange(index)
+        let data = decryptor(range).flatMap { $0.count == range.count ? $0 : nil }
+        let capacity = capacity
+        state.withLock {
+            $0.inFlight.removeValue(forKey: index)
+            if let data {
+                $0.insert(data, at: index, capacity: capacity)
+            }
+        }
+        return data
+    }
+
+    // MARK: - Read-Ahead
+
+    /// Decrypts the next blocks in the reading direction when a read moves to
+    /// another block.
+    private func scheduleReadAhead(firstBlock: Int, lastBlock: Int) {
+        guard readAheadCount > 0 else { return }
+        let previousBlock = state.withLock { state -> Int? in
+            defer { state.lastReadBlock = lastBlock }
+            return state.lastReadBlock
+        }
+        guard let previousBlock, previousBlock != lastBlock else { return }
+
+        let blockCount = (length + blockSize - 1) / blockSize
+        let ahead: [Int]
+        if lastBlock > previousBlock {
+            ahead = Array((lastBlock + 1)..<min(lastBlock + 1 + readAheadCount, blockCount))
+        } else {
+            ahead = Array(max(0, firstBlock - readAheadCount)..<firstBlock).reversed()
+        }
+        guard !ahead.isEmpty else { return }
+
+        readAheadQueue.async { [weak self] in
+            guard let self else { return }
+            for index in ahead {
+                if case .load(let group) = self.lookup(index) {
+                    _ = self.load(index, group: group)
+                }
+            }
+        }
+    }
+}
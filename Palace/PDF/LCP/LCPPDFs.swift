@@ -9,6 +9,7 @@
 #if LCP
 
 import Foundation
+import os
 import ReadiumShared
 import ReadiumStreamer
 import ReadiumLCP
@@ -114,37 +115,34 @@ import ReadiumZIPFoundation
     /// Decrypting data takes time;
     /// PDF data provider reads data in consequent blocks for several bytes to ~16kb,
     /// caching decrypted data between reads improves reading speed a lot
-    private var dataCache: Data?
-    private var dataCacheSize = 1024 * 1024
-    private var dataCachePage: Int?
-
-    /// Update cached data
-    /// - Parameters:
-    ///   - encryptedData: Encrypted data
-    ///   - page: offset in `dataCacheSize` pages of data to cache
-    private func updateCache(data encryptedData: Data, page: Int) {
-        let start = page * dataCacheSize
-        let end = min(encryptedData.count, start + dataCacheSize)
-        dataCache = decryptRawData(data: encryptedData, start: start, end: end)
-        if dataCache == nil {
-            dataCachePage = nil
-        } else {
-            dataCachePage = page
+    private let decryptedBlocks = OSAllocatedUnfairLock<(source: DataIdentity, cache: DecryptedBlockCache)?>(uncheckedState: nil)
+
+    /// Identifies the encrypted data by the address of its bytes, so documents of the same length
+    /// never share decrypted blocks. The cache keeps the data alive, so its address
+    /// is not reused while cached.
+    private struct DataIdentity: Equatable {
+        let baseAddress: UnsafeRawPointer?
+        let count: Int
+
+        init(_ data: Data) {
+            baseAddress = data.withUnsafeBytes { $0.baseAddress.map(UnsafeRawPointer.init) }
+            count = data.count
         }
     }
 
-    /// Simple cache read function
-    /// - Parameters:
-    ///   - start: Start position of the block to read
-    ///   - end: End position of the block to read
-    /// - Returns: Decrypted data from `dataCache`; nil of `start` or `end` miss the cache.
-    private func readCached(start: Int, end: Int) -> Data? {
-        guard let data = dataCache else {
-            return nil
+    /// Block cache for the document data, created on the first read of each document
+    private func blockCache(for encryptedData: Data) -> DecryptedBlockCache {
+        let source = DataIdentity(encryptedData)
+        return decryptedBlocks.withLockUnchecked { entry in
+            if let entry, entry.source == source {
+                return entry.cache
+            }
+            let newCache = DecryptedBlockCache(length: encryptedData.count) { [weak self] range in
+                self?.decryptRawData(data: encryptedData, start: range.lowerBound, end: range.upperBound)
+            }
+            entry = (source, newCache)
+            return newCache
         }
-        let cacheStart = start % dataCacheSize
-        let cacheEnd = end % dataCacheSize
-        return data[cacheStart..<cacheEnd]
     }
 
     /// Decrypt data
@@ -156,16 +154,31 @@ import ReadiumZIPFoundation
     ///
     /// This funciton tries to read decrypted data for cache, then from encrypted data
     @objc func decryptData(data encryptedData: Data, start: Int, end: Int) -> Data? {
-        let startPage = start / dataCacheSize
-        let endPage = end / dataCacheSize
-        var data: Data?
-        if startPage == endPage {
-            if startPage != dataCachePage {
-                updateCache(data: encryptedData, page: startPage)
-            }
-            data = readCached(start: start, end: end)
+        if start < end, let data = blockCache(for: encryptedData).read(start..<end) {
+            return data
         }
-        return data ?? decryptRawData(data: encryptedData, start: start, end: end)
+        return decryptRawData(data: encryptedData, start: start, end: end)
+    }
+
+    /// Decrypt data into a buffer
+    /// - Parameters:
+    ///   - encryptedData: Encrypted data
+    ///   - start: Start position of the block to decrypt
+    ///   - end: End position of the block to decrypt
+    ///   - buffer: Buffer for `end - start` bytes of decrypted data
+    /// - Returns: `true` if the data was decrypted
+    ///
+    /// This function copies decrypted data from the cache without intermediate `Data`,
+    /// for `TPPEncryptedPDFDataProvider` buffer decryptors
+    @objc func decryptData(data encryptedData: Data, start: Int, end: Int, into buffer: UnsafeMutableRawPointer) -> Bool {
+        if start < end, blockCache(for: encryptedData).read(start..<end, into: buffer) {
+            return true
+        }
+        guard start < end, let data = decryptRawData(data: encryptedData, start: start, end: end), data.count == end - start else {
+            return false
+        }
+        data.copyBytes(to: buffer.assumingMemoryBound(to: UInt8.self), count: data.count)
+        return true
     }
 
     /// Decrypt data
@@ -220,6 +233,23 @@ import ReadiumZIPFoundation
         return resultUrl
     }
 
+    /// Open the PDF in a book archive for reading
+    /// - Parameter url: Book archive URL
+    /// - Returns: Encrypted PDF document decrypting straight into Core Graphics buffers
+    ///
+    /// The returned document keeps this object, with its decrypted block cache, for its decryptor.
+    func document(forBookAt url: URL) async throws -> TPPPDFDocument {
+        let pdfUrl = try await extract(url: url)
+        let encryptedData = try Data(contentsOf: pdfUrl, options: .alwaysMapped)
+        return TPPPDFDocument(
+            encryptedData: encryptedData,
+            searchIndexURL: TPPPDFSearchIndex.url(forBookAt: url),
+            thumbnailStoreURL: TPPPDFThumbnailStore.url(forBookAt: url)
+        ) { data, start, end, buffer in
+            self.decryptData(data: data, start: Int(start), end: Int(end), into: buffer)
+        }
+    }
+
     /// Extract PDF from `.zip` archive
     /// - Parameters:
     ///   - url: Source `.zip` archive with PDF file
@@ -25,6 +25,30 @@ protocol PDFDocumentProviding: AnyObject {
 
     /// Initiates background thumbnail generation for all pages.
     func makeThumbnails()
+
+    /// Renders a thumbnail ahead of background thumbnail generation.
+    /// - Parameters:
+    ///   - page: Page number (0-indexed).
+    ///   - completion: Called on the main queue with the thumbnail.
+    /// - Returns: Request to cancel when the thumbnail leaves the screen, or nil if it can't be cancelled.
+    func requestThumbnail(for page: Int, completion: @escaping (UIImage?) -> Void) -> TPPPDFThumbnailPipeline.Request?
+
+    /// Cancels a thumbnail request that hasn't started rendering.
+    func cancelThumbnailRequest(_ request: TPPPDFThumbnailPipeline.Request)
+}
+
+extension PDFDocumentProviding {
+    func requestThumbnail(for page: Int, completion: @escaping (UIImage?) -> Void) -> TPPPDFThumbnailPipeline.Request? {
+        DispatchQueue.pdfThumbnailRenderingQueue.async {
+            let thumbnail = self.thumbnail(for: page)
+            DispatchQueue.main.async {
+                completion(thumbnail)
+            }
+        }
+        return nil
+    }
+
+    func cancelThumbnailRequest(_ request: TPPPDFThumbnailPipeline.Request) {}
 }
 
 // MARK: - TPPEncryptedPDFDocument Conformance
@@ -7,14 +7,29 @@
 //
 
 #import <Foundation/Foundation.h>
+#import <CoreGraphics/CoreGraphics.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// Returns decrypted bytes of `data` in `start..<end`.
+typedef NSData * _Nullable (^TPPPDFDecryptor)(NSData *data, NSUInteger start, NSUInteger end);
+
+/// Decrypts bytes of `data` in `start..<end` into `buffer`, `end - start` bytes long.
+/// Returns `NO` if the bytes can't be decrypted.
+typedef BOOL (^TPPPDFBufferDecryptor)(NSData *data, NSUInteger start, NSUInteger end, void *buffer);
+
+/// Serves decrypted bytes of an encrypted PDF document to Core Graphics.
+///
+/// Each provider keeps its own data and decryptor, so several documents can
+/// be read at the same time.
 @interface TPPEncryptedPDFDataProvider : NSObject
 
-- (instancetype)initWithData:(NSData *)data decryptor:(NSData * (^)(NSData *data, NSUInteger start, NSUInteger end))decryptor;
+- (instancetype)initWithData:(NSData *)data decryptor:(TPPPDFDecryptor)decryptor;
+
+/// Decrypts straight into the buffers Core Graphics reads into.
+- (instancetype)initWithData:(NSData *)data bufferDecryptor:(TPPPDFBufferDecryptor)decryptor;
 
-- (CGDataProviderRef)dataProvider;
+- (CGDataProviderRef)dataProvider CF_RETURNS_RETAINED;
 
 @end
 
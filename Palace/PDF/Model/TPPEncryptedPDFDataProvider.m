@@ -11,50 +11,91 @@
 /// Data providers are fully discussed here:
 /// https://developer.apple.com/documentation/coregraphics/cgdataprovider
 /// TPPPDFReader uses `CGDataProviderDirectCallbacks` to get the access to blocks of encrypted data.
+/// Callbacks receive the provider's `TPPEncryptedPDFDataProviderContext` as `info`.
 
-@implementation TPPEncryptedPDFDataProvider
+@interface TPPEncryptedPDFDataProviderContext : NSObject
 
-NSData *_encryptedData;
-NSData * (^_decryptor)(NSData *data, NSUInteger start, NSUInteger end);
+@property (nonatomic, readonly) NSData *encryptedData;
+@property (nonatomic, copy, readonly, nullable) TPPPDFDecryptor decryptor;
+@property (nonatomic, copy, readonly, nullable) TPPPDFBufferDecryptor bufferDecryptor;
 
-static const void *dataPointer(__attribute__((unused)) void *info) {
-  return info;
+@end
+
+@implementation TPPEncryptedPDFDataProviderContext
+
+- (instancetype)initWithData:(NSData *)data
+                   decryptor:(nullable TPPPDFDecryptor)decryptor
+             bufferDecryptor:(nullable TPPPDFBufferDecryptor)bufferDecryptor {
+  self = [super init];
+  if (self) {
+    _encryptedData = data;
+    _decryptor = [decryptor copy];
+    _bufferDecryptor = [bufferDecryptor copy];
+  }
+  return self;
 }
 
-static void releaseData(__attribute__((unused)) void *info, const void *pointer) {
-  free(pointer);
+/// Copies decrypted bytes in `start..<end` into `buffer`.
+- (BOOL)readFrom:(NSUInteger)start to:(NSUInteger)end into:(void *)buffer {
+  if (self.bufferDecryptor) {
+    return self.bufferDecryptor(self.encryptedData, start, end, buffer);
+  }
+  NSData *data = self.decryptor(self.encryptedData, start, end);
+  if (data.length < end - start) {
+    return NO;
+  }
+  memcpy(buffer, data.bytes, end - start);
+  return YES;
 }
 
-static size_t bytesAtPosition(__attribute__((unused)) void *info, void *buffer, off_t pos, size_t n) {
-  NSUInteger start = pos;
-  NSUInteger end = pos + n;
-  NSData *data = _decryptor(_encryptedData, start, end);
-  memcpy(buffer, data.bytes, n);
-  return n;
+@end
+
+@implementation TPPEncryptedPDFDataProvider {
+  TPPEncryptedPDFDataProviderContext *_context;
+}
+
+static size_t bytesAtPosition(void *info, void *buffer, off_t pos, size_t n) {
+  TPPEncryptedPDFDataProviderContext *context = (__bridge TPPEncryptedPDFDataProviderContext *)info;
+  NSUInteger length = context.encryptedData.length;
+  if (pos < 0 || (NSUInteger)pos >= length || n == 0) {
+    return 0;
+  }
+  NSUInteger start = (NSUInteger)pos;
+  NSUInteger end = MIN(start + n, length);
+  return [context readFrom:start to:end into:buffer] ? end - start : 0;
 }
 
 static void releaseInfo(void *info) {
-  free(info);
+  CFBridgingRelease(info);
 }
 
 static CGDataProviderDirectCallbacks callbacks = {
   0,
-  dataPointer,
-  releaseData,
+  NULL, // No byte pointer: Core Graphics reads through `bytesAtPosition`
+  NULL,
   bytesAtPosition,
   releaseInfo,
 };
 
--(id)initWithData:(NSData *)data decryptor:(NSData * (^)(NSData *data, NSUInteger start, NSUInteger end))decryptor {
+- (instancetype)initWithData:(NSData *)data decryptor:(TPPPDFDecryptor)decryptor {
+  self = [super init];
+  if (self) {
+    _context = [[TPPEncryptedPDFDataProviderContext alloc] initWithData:data decryptor:decryptor bufferDecryptor:nil];
+  }
+  return self;
+}
+
+- (instancetype)initWithData:(NSData *)data bufferDecryptor:(TPPPDFBufferDecryptor)decryptor {
   self = [super init];
-  _encryptedData = data;
-  _decryptor = decryptor;
+  if (self) {
+    _context = [[TPPEncryptedPDFDataProviderContext alloc] initWithData:data decryptor:nil bufferDecryptor:decryptor];
+  }
   return self;
 }
 
 - (CGDataProviderRef)dataProvider {
-  CGDataProviderRef dataProvider = CGDataProviderCreateDirect(nil, _encryptedData.length, &callbacks);
-  return dataProvider;
+  void *info = (__bridge_retained void *)_context;
+  return CGDataProviderCreateDirect(info, _context.encryptedData.length, &callbacks);
 }
 
 @end
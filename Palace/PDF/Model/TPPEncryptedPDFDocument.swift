@@ -7,12 +7,12 @@
 //
 
 import Foundation
+import os
 import UIKit
 
 /// Encrypted PDF document.
 @objcMembers class TPPEncryptedPDFDocument: NSObject {
 
-    private var thumbnailsCache = NSCache<NSNumber, NSData>()
     private var memoryWarningObserver: NSObjectProtocol?
 
     /// PDF document data.
@@ -27,46 +27,95 @@ import UIKit
     var title: String?
     var cover: UIImage?
 
-    init(encryptedData: Data, decryptor: @escaping (_ data: Data, _ start: UInt, _ end: UInt) -> Data) {
+    /// Location of the persistent search index, next to the book file.
+    let searchIndexURL: URL?
+    private var searchIndexTask: Task<Void, Never>?
+    /// Search index, once it has been loaded or built.
+    private let searchIndex = OSAllocatedUnfairLock<TPPPDFSearchIndex?>(uncheckedState: nil)
+
+    /// Location of the persistent thumbnail store, next to the book file.
+    let thumbnailStoreURL: URL?
+    /// Renders thumbnails and previews, pages on screen first.
+    private(set) lazy var thumbnailPipeline: TPPPDFThumbnailPipeline = {
+        let store = thumbnailStoreURL.map { TPPPDFThumbnailStore(url: $0, documentLength: data.count) }
+        return TPPPDFThumbnailPipeline(store: store) { [weak self] page, kind in
+            guard let pdfPage = self?.page(at: page) else { return nil }
+            return kind == .thumbnail ? pdfPage.thumbnail : pdfPage.preview
+        }
+    }()
+
+    init(
+        encryptedData: Data,
+        searchIndexURL: URL? = nil,
+        thumbnailStoreURL: URL? = nil,
+        decryptor: @escaping (_ data: Data, _ start: UInt, _ end: UInt) -> Data
+    ) {
         self.data = encryptedData
         self.decryptor = decryptor
+        self.searchIndexURL = searchIndexURL
+        self.thumbnailStoreURL = thumbnailStoreURL
         let pdfDataProvider = TPPEncryptedPDFDataProvider(data: encryptedData, decryptor: decryptor)
-        let dataProvider = pdfDataProvider.dataProvider().takeUnretainedValue()
-        self.document = CGPDFDocument(dataProvider)
+        self.document = CGPDFDocument(pdfDataProvider.dataProvider())
+        super.init()
+
+        configure()
+    }
+
+    /// Initializes with a decryptor writing straight into Core Graphics buffers.
+    /// - Parameters:
+    ///   - encryptedData: Encrypted PDF document data
+    ///   - bufferDecryptor: Decrypts `start..<end` into the buffer; returns `false` on failure
+    init(
+        encryptedData: Data,
+        searchIndexURL: URL? = nil,
+        thumbnailStoreURL: URL? = nil,
+        bufferDecryptor: @escaping (_ data: Data, _ start: UInt, _ end: UInt, _ buffer: UnsafeMutableRawPointer) -> Bool
+    ) {
+        self.data = encryptedData
+        self.searchIndexURL = searchIndexURL
+        self.thumbnailStoreURL = thumbnailStoreURL
+        self.decryptor = { data, start, end in
+            var decrypted = Data(count: Int(end - start))
+            let success = decrypted.withUnsafeMutableBytes { buffer in
+                guard let baseAddress = buffer.baseAddress else { return true }
+                return bufferDecryptor(data, start, end, baseAddress)
+            }
+            return success ? decrypted : Data()
+        }
+        let pdfDataProvider = TPPEncryptedPDFDataProvider(data: encryptedData, bufferDecryptor: bufferDecryptor)
+        self.document = CGPDFDocument(pdfDataProvider.dataProvider())
         super.init()
 
-        configureCacheLimits()
+        configure()
+    }
+
+    private func configure() {
         setupMemoryWarningHandler()
 
         setPageCount()
         setTitle()
         setCover()
+        prepareSearchIndex()
     }
 
     deinit {
+        searchIndexTask?.cancel()
         if let observer = memoryWarningObserver {
             NotificationCenter.default.removeObserver(observer)
         }
     }
 
-    private func configureCacheLimits() {
-        let deviceMemoryMB = ProcessInfo.processInfo.physicalMemory / (1024 * 1024)
-        let cacheMemoryMB: Int
-        let countLimit: Int
-
-        if deviceMemoryMB < 2048 {
-            cacheMemoryMB = 30
-            countLimit = 50
-        } else if deviceMemoryMB < 4096 {
-            cacheMemoryMB = 50
-            countLimit = 100
-        } else {
-            cacheMemoryMB = 80
-            countLimit = 150
+    /// Loads the search index, or builds it in the background on first open.
+    private func prepareSearchIndex() {
+        guard let searchIndexURL, let document else { return }
+        let documentLength = data.count
+        let searchIndex = self.searchIndex
+        searchIndexTask = Task.detached(priority: .utility) {
+            guard let index = try? await TPPPDFSearchIndex.loadOrBuild(at: searchIndexURL, document: document, documentLength: documentLength) else {
+                return
+            }
+            searchIndex.withLockUnchecked { $0 = index }
         }
-
-        thumbnailsCache.totalCostLimit = cacheMemoryMB * 1024 * 1024
-        thumbnailsCache.countLimit = countLimit
     }
 
     private func setupMemoryWarningHandler() {
@@ -75,9 +124,7 @@ import UIKit
             object: nil,
             queue: .main
         ) { [weak self] _ in
-            DispatchQueue.global(qos: .utility).async {
-                self?.thumbnailsCache.removeAllObjects()
-            }
+            self?.thumbnailPipeline.clearMemoryCache()
         }
     }
 
@@ -106,22 +153,9 @@ import UIKit
         document?.page(at: n + 1)
     }
 
+    /// Renders thumbnails of pages not stored yet, after the ones on screen.
     func makeThumbnails() {
-        Task {
-            DispatchQueue.pdfThumbnailRenderingQueue.async {
-                for page in 0..<self.pageCount {
-                    let pageNumber = NSNumber(value: page)
-                    if self.thumbnailsCache.object(forKey: pageNumber) != nil {
-                        continue
-                    }
-                    if let thumbnail = self.thumbnail(for: page), let thumbnailData = thumbnail.jpegData(compressionQuality: 0.5) {
-                        DispatchQueue.main.async {
-                            self.thumbnailsCache.setObject(thumbnailData as NSData, forKey: pageNumber, cost: thumbnailData.count)
-                        }
-                    }
-                }
-            }
-        }
+        thumbnailPipeline.prefetch(pages: 0..<pageCount, kind: .thumbnail)
     }
 
     var tableOfContents: [TPPPDFLocation] = []
@@ -132,6 +166,11 @@ import UIKit
         }
 
         let searchText = text.lowercased()
+        // Pages are scanned until the index is ready
+        if let index = searchIndex.withLockUnchecked({ $0 }) {
+            return index.search(text: searchText)
+        }
+
         var result = [TPPPDFLocation]()
         for pageNumber in 1...pageCount {
             guard let page = document.page(at: pageNumber) else {
@@ -169,7 +208,7 @@ extension TPPEncryptedPDFDocument {
     ///
     /// `preview` returns a larger image than `thumbnail`
     func preview(for page: Int) -> UIImage? {
-        self.page(at: page)?.preview
+        thumbnailPipeline.image(page: page, kind: .preview)
     }
 
     /// Thumbnail image for a page
@@ -178,32 +217,31 @@ extension TPPEncryptedPDFDocument {
     ///
     /// `thumbnail` returns a smaller image than `preview`
     ///
-    /// This function caches thumbnail image data and returnes a cached image when one is available.
+    /// This function stores thumbnail images and returns a stored image when one is available.
     func thumbnail(for page: Int) -> UIImage? {
-        let pageNumber = NSNumber(value: page)
-        if let cachedData = thumbnailsCache.object(forKey: pageNumber), let cachedImage = UIImage(data: cachedData as Data) {
-            return cachedImage
-        } else {
-            if let image = self.page(at: page)?.thumbnail, let data = image.jpegData(compressionQuality: 0.5) {
-                thumbnailsCache.setObject(data as NSData, forKey: pageNumber, cost: data.count)
-                return image
-            } else {
-                return nil
-            }
-        }
+        thumbnailPipeline.image(page: page, kind: .thumbnail)
     }
 
     /// Cached thumbnail image for a page
     /// - Parameter page: Page number
-    /// - Returns: Thumbnail image, if it is available in cached images, `nil` otherwise.
+    /// - Returns: Thumbnail image, if it is available in cached or stored images, `nil` otherwise.
     ///
     /// This function doesn't render new thumbnail images.
     func cachedThumbnail(for page: Int) -> UIImage? {
-        let pageNumber = NSNumber(value: page)
-        if let cachedData = thumbnailsCache.object(forKey: pageNumber), let cachedImage = UIImage(data: cachedData as Data) {
-            return cachedImage
-        }
-        return nil
+        thumbnailPipeline.cachedImage(page: page, kind: .thumbnail)
+    }
+
+    /// Renders a thumbnail ahead of background rendering.
+    /// - Parameters:
+    ///   - page: Page number
+    ///   - completion: Called on the main queue with the thumbnail
+    /// - Returns: Request to cancel when the thumbnail is no longer on screen.
+    func requestThumbnail(for page: Int, completion: @escaping (UIImage?) -> Void) -> TPPPDFThumbnailPipeline.Request? {
+        thumbnailPipeline.request(page: page, kind: .thumbnail, completion: completion)
+    }
+
+    func cancelThumbnailRequest(_ request: TPPPDFThumbnailPipeline.Request) {
+        thumbnailPipeline.cancel(request)
     }
 
     /// Image for a page
@@ -18,26 +18,73 @@ protocol TPPPDFDocumentDelegate {
 @objcMembers class TPPPDFDocument: NSObject {
     let data: Data
     let decryptor: ((_ data: Data, _ start: UInt, _ end: UInt) -> Data)?
+    private let bufferDecryptor: ((_ data: Data, _ start: UInt, _ end: UInt, _ buffer: UnsafeMutableRawPointer) -> Bool)?
     let isEncrypted: Bool
+    /// Search index location for encrypted documents
+    private let searchIndexURL: URL?
+    /// Location of the persistent thumbnail store, next to the book file
+    let thumbnailStoreURL: URL?
 
     var delegate: TPPPDFDocumentDelegate?
 
     /// Initialize with a non-encrypted document
-    /// - Parameter data: PDF document data
-    init(data: Data) {
+    /// - Parameters:
+    ///   - data: PDF document data
+    ///   - thumbnailStoreURL: Location of the persistent thumbnail store
+    init(data: Data, thumbnailStoreURL: URL? = nil) {
         self.data = data
         self.decryptor = nil
+        self.bufferDecryptor = nil
         self.isEncrypted = false
+        self.searchIndexURL = nil
+        self.thumbnailStoreURL = thumbnailStoreURL
     }
 
     /// Initialize with an encrypted PDF document data
     /// - Parameters:
     ///   - encryptedData: Encrypted PDF document data
+    ///   - searchIndexURL: Location of the persistent search index, built on first open
+    ///   - thumbnailStoreURL: Location of the persistent thumbnail store
     ///   - decryptor: Decryptor function
-    init(encryptedData: Data, decryptor: @escaping (_ data: Data, _ start: UInt, _ end: UInt) -> Data) {
+    init(
+        encryptedData: Data,
+        searchIndexURL: URL? = nil,
+        thumbnailStoreURL: URL? = nil,
+        decryptor: @escaping (_ data: Data, _ start: UInt, _ end: UInt) -> Data
+    ) {
         self.data = encryptedData
         self.decryptor = decryptor
+        self.bufferDecryptor = nil
         self.isEncrypted = true
+        self.searchIndexURL = searchIndexURL
+        self.thumbnailStoreURL = thumbnailStoreURL
+    }
+
+    /// Initialize with an encrypted PDF document data, decrypted straight into Core Graphics buffers
+    /// - Parameters:
+    ///   - encryptedData: Encrypted PDF document data
+    ///   - searchIndexURL: Location of the persistent search index, built on first open
+    ///   - thumbnailStoreURL: Location of the persistent thumbnail store
+    ///   - bufferDecryptor: Decrypts `start..<end` into the buffer; returns `false` on failure
+    init(
+        encryptedData: Data,
+        searchIndexURL: URL? = nil,
+        thumbnailStoreURL: URL? = nil,
+        bufferDecryptor: @escaping (_ data: Data, _ start: UInt, _ end: UInt, _ buffer: UnsafeMutableRawPointer) -> Bool
+    ) {
+        self.data = encryptedData
+        self.decryptor = { data, start, end in
+            var decrypted = Data(count: Int(end - start))
+            let success = decrypted.withUnsafeMutableBytes { buffer in
+                guard let baseAddress = buffer.baseAddress else { return true }
+                return bufferDecryptor(data, start, end, baseAddress)
+            }
+            return success ? decrypted : Data()
+        }
+        self.bufferDecryptor = bufferDecryptor
+        self.isEncrypted = true
+        self.searchIndexURL = searchIndexURL
+        self.thumbnailStoreURL = thumbnailStoreURL
     }
 
     /// Encrypted PDF document
@@ -45,7 +92,31 @@ protocol TPPPDFDocumentDelegate {
         guard let decryptor = decryptor, isEncrypted else {
             return nil
         }
-        return TPPEncryptedPDFDocument(encryptedData: data, decryptor: decryptor)
+        if let bufferDecryptor {
+            return TPPEncryptedPDFDocument(
+                encryptedData: data,
+                searchIndexURL: searchIndexURL,
+                thumbnailStoreURL: thumbnailStoreURL,
+                bufferDecryptor: bufferDecryptor
+            )
+        }
+        return TPPEncryptedPDFDocument(
+            encryptedData: data,
+            searchIndexURL: searchIndexURL,
+            thumbnailStoreURL: thumbnailStoreURL,
+            decryptor: decryptor
+        )
+    }()
+
+    /// Renders page thumbnails and previews, pages on screen first
+    lazy var thumbnailPipeline: TPPPDFThumbnailPipeline = {
+        if let encryptedDocument {
+            return encryptedDocument.thumbnailPipeline
+        }
+        let store = thumbnailStoreURL.map { TPPPDFThumbnailStore(url: $0, documentLength: data.count) }
+        return TPPPDFThumbnailPipeline(store: store) { [weak self] page, kind in
+            self?.image(page: page, size: kind == .thumbnail ? .pdfThumbnailSize : .pdfPreviewSize)
+        }
     }()
 
     /// PDFKit PDF document
@@ -93,7 +164,7 @@ extension TPPPDFDocument {
     ///
     /// `preview` returns a larger image than `thumbnail`
     func preview(for page: Int) -> UIImage? {
-        image(page: page, size: .pdfPreviewSize)
+        thumbnailPipeline.image(page: page, kind: .preview)
     }
 
     /// Thumbnail image for a page
@@ -102,9 +173,7 @@ extension TPPPDFDocument {
     ///
     /// `thumbnail` returns a smaller image than `preview`
     func thumbnail(for page: Int) -> UIImage? {
-        isEncrypted ?
-            encryptedDocument?.thumbnail(for: page) :
-            image(page: page, size: .pdfThumbnailSize)
+        thumbnailPipeline.image(page: page, kind: .thumbnail)
     }
 
     /// Image for a page
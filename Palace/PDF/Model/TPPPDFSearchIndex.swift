@@ -0,0 +1,105 @@
+//
+//  TPPPDFSearchIndex.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Full-text index of a PDF document, stored encrypted next to the book file.
+///
+/// Holds the text blocks of each page and, for every lowercased word, the
+/// pages it appears on. A query only scans the blocks of pages containing all
+/// its words, so it returns the same locations as scanning every page.
+struct TPPPDFSearchIndex: SealedSearchIndex, Equatable {
+    static let currentVersion = 3
+
+    let version: Int
+    /// Length of the indexed document data, to detect a replaced file.
+    let documentLength: Int
+    /// Text blocks of each page, as extracted by `TPPPDFTextExtractor`.
+    let pageBlocks: [[String]]
+    /// Pages containing each lowercased word.
+    let wordIndex: PostingListIndex
+
+    var pageCount: Int {
+        pageBlocks.count
+    }
+
+    init(pageBlocks: [[String]], documentLength: Int) {
+        self.version = Self.currentVersion
+        self.documentLength = documentLength
+        self.pageBlocks = pageBlocks
+        self.wordIndex = PostingListIndex(sections: pageBlocks.map { $0.map { $0.lowercased() } })
+    }
+
+    // MARK: - Search
+
+    /// Text blocks containing `text`, in page order.
+    /// - Parameter text: Lowercased search string.
+    func search(text: String) -> [TPPPDFLocation] {
+        guard !text.isEmpty else { return [] }
+
+        var result = [TPPPDFLocation]()
+        for page in wordIndex.candidateSections(for: text) {
+            for block in pageBlocks[page] where block.lowercased().contains(text) {
+                result.append(TPPPDFLocation(title: block, subtitle: nil, pageLabel: nil, pageNumber: page))
+            }
+        }
+        return result
+    }
+
+    // MARK: - Storage
+
+    /// Loads an index saved for a document of `documentLength` bytes.
+    /// - Returns: `nil` if there is none, or it is outdated.
+    static func load(from url: URL, documentLength: Int) -> TPPPDFSearchIndex? {
+        loadSealed(from: url).flatMap { $0.documentLength == documentLength ? $0 : nil }
+    }
+
+    // MARK: - Indexing
+
+    /// Extracts the text of every page in parallel, one task per core.
+    ///
+    /// Throws `CancellationError` if the task is cancelled.
+    static func build(document: CGPDFDocument, documentLength: Int) async throws -> TPPPDFSearchIndex {
+        let pageCount = document.numberOfPages
+        var pageBlocks = [[String]](repeating: [], count: pageCount)
+        let concurrency = max(1, ProcessInfo.processInfo.activeProcessorCount)
+
+        try await withThrowingTaskGroup(of: (Int, [String]).self) { group in
+            var nextPage = 0
+            func addPage() {
+                guard nextPage < pageCount else { return }
+                let page = nextPage
+                nextPage += 1
+                group.addTask(priority: .utility) {
+                    try Task.checkCancellation()
+                    // CGPDFDocument counts pages from 1
+                    guard let pdfPage = document.page(at: page + 1) else { return (page, []) }
+                    return (page, TPPPDFTextExtractor().extractText(page: pdfPage))
+                }
+            }
+
+            for _ in 0..<concurrency {
+                addPage()
+            }
+            while let (page, blocks) = try await group.next() {
+                pageBlocks[page] = blocks
+                addPage()
+            }
+        }
+
+        return TPPPDFSearchIndex(pageBlocks: pageBlocks, documentLength: documentLength)
+    }
+
+    /// Loads the index saved at `url`, or builds and saves it.
+    static func loadOrBuild(at url: URL, document: CGPDFDocument, documentLength: Int) async throws -> TPPPDFSearchIndex {
+        try await loadOrBuild(
+            at: url,
+            isCurrent: { $0.documentLength == documentLength && $0.pageCount == document.numberOfPages },
+            build: { try await build(document: document, documentLength: documentLength) }
+        )
+    }
+}
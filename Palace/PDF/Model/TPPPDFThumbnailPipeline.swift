@@ -0,0 +1,173 @@
+//
+//  TPPPDFThumbnailPipeline.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+import os
+import UIKit
+
+/// Renders page thumbnails and previews, visible pages first.
+///
+/// Requests for pages on screen run before background rendering of the
+/// whole document, and are cancelled when their views go away. Rendered
+/// images are kept in memory and in the book's `TPPPDFThumbnailStore`, so
+/// they're rendered once per book rather than once per session.
+final class TPPPDFThumbnailPipeline {
+    typealias Kind = TPPPDFThumbnailStore.Kind
+    typealias Key = TPPPDFThumbnailStore.Key
+    typealias Renderer = (_ page: Int, _ kind: Kind) -> UIImage?
+
+    /// Identifies a request, to cancel it.
+    struct Request: Hashable {
+        fileprivate let key: Key
+        fileprivate let id: UUID
+    }
+
+    private struct Pending {
+        let operation: Operation
+        var completions = [UUID: (UIImage?) -> Void]()
+    }
+
+    let store: TPPPDFThumbnailStore?
+    private let renderer: Renderer
+    private let memoryCache = NSCache<NSNumber, UIImage>()
+    private let pending = OSAllocatedUnfairLock(uncheckedState: [Key: Pending]())
+    private let queue: OperationQueue = {
+        let queue = OperationQueue()
+        queue.name = "org.thepalaceproject.palace.pdfThumbnailPipeline"
+        queue.maxConcurrentOperationCount = 2
+        queue.qualityOfService = .userInitiated
+        return queue
+    }()
+
+    init(store: TPPPDFThumbnailStore?, renderer: @escaping Renderer) {
+        self.store = store
+        self.renderer = renderer
+        memoryCache.totalCostLimit = 30 * 1024 * 1024
+    }
+
+    deinit {
+        queue.cancelAllOperations()
+    }
+
+    func clearMemoryCache() {
+        memoryCache.removeAllObjects()
+    }
+
+    // MARK: - Images
+
+    /// Image already rendered in this or an earlier session, without rendering.
+    func cachedImage(page: Int, kind: Kind) -> UIImage? {
+        let key = Key(page: page, kind: kind)
+        if let image = memoryCache.object(forKey: cacheKey(key)) {
+            return image
+        }
+        guard let image = store?.image(for: key) else { return nil }
+        cache(image, for: key)
+        return image
+    }
+
+    /// Image for a page, rendered on the calling thread if needed.
+    func image(page: Int, kind: Kind) -> UIImage? {
+        cachedImage(page: page, kind: kind) ?? render(Key(page: page, kind: kind))
+    }
+
+    /// Renders an image ahead of everything requested in the background.
+    /// - Parameter completion: Called on the main queue, unless cancelled.
+    @discardableResult
+    func request(page: Int, kind: Kind, completion: @escaping (UIImage?) -> Void) -> Request {
+        let key = Key(page: page, kind: kind)
+        let request = Request(key: key, id: UUID())
+        enqueue(key, priority: .veryHigh, completion: (request.id, completion))
+        return request
+    }
+
+    /// Cancels a request; rendering stops if nothing else waits for the image.
+    func cancel(_ request: Request) {
+        pending.withLockUnchecked { pending in
+            guard var entry = pending[request.key] else { return }
+            entry.completions.removeValue(forKey: request.id)
+            if entry.completions.isEmpty && entry.operation.queuePriority == .veryHigh && !entry.operation.isExecuting {
+                entry.operation.cancel()
+                pending.removeValue(forKey: request.key)
+            } else {
+                pending[request.key] = entry
+            }
+        }
+    }
+
+    /// Renders and stores images of `pages` that aren't stored yet, after
+    /// any requested image.
+    func prefetch(pages: Range<Int>, kind: Kind) {
+        for page in pages {
+            let key = Key(page: page, kind: kind)
+            if store?.contains(key) == true {
+                continue
+            }
+            enqueue(key, priority: .veryLow, completion: nil)
+        }
+    }
+
+    // MARK: - Rendering
+
+    private func enqueue(_ key: Key, priority: Operation.QueuePriority, completion: (UUID, (UIImage?) -> Void)?) {
+        let operation = pending.withLockUnchecked { pending -> Operation? in
+            if var entry = pending[key] {
+                if priority.rawValue > entry.operation.queuePriority.rawValue {
+                    entry.operation.queuePriority = priority
+                }
+                if let completion {
+                    entry.completions[completion.0] = completion.1
+                }
+                pending[key] = entry
+                return nil
+            }
+            let operation = BlockOperation()
+            operation.queuePriority = priority
+            var entry = Pending(operation: operation)
+            if let completion {
+                entry.completions[completion.0] = completion.1
+            }
+            pending[key] = entry
+            return operation
+        }
+        guard let operation else { return }
+
+        operation.addExecutionBlock { [weak self, weak operation] in
+            guard let self else { return }
+            let image = operation?.isCancelled == true ? nil : self.image(page: key.page, kind: key.kind)
+            let completions = self.pending.withLockUnchecked { pending in
+                pending.removeValue(forKey: key)?.completions.values.map { $0 } ?? []
+            }
+            guard !completions.isEmpty else { return }
+            DispatchQueue.main.async {
+                completions.forEach { $0(image) }
+            }
+        }
+        queue.addOperation(operation)
+    }
+
+    private func render(_ key: Key) -> UIImage? {
+        guard let image = renderer(key.page, key.kind),
+              let jpegData = image.jpegData(compressionQuality: key.kind == .thumbnail ? 0.5 : 0.7) else {
+            return nil
+        }
+        store?.store(jpegData, for: key)
+        cache(image, for: key)
+        return image
+    }
+
+    private func cacheKey(_ key: Key) -> NSNumber {
+        NSNumber(value: key.page * 2 + Int(key.kind.rawValue))
+    }
+
+    /// Images are charged their decoded bitmap size, which is what they take
+    /// in memory once drawn, rather than their JPEG size.
+    private func cache(_ image: UIImage, for key: Key) {
+        let cost = Int(image.size.width * image.size.height * image.scale * image.scale) * 4
+        memoryCache.setObject(image, forKey: cacheKey(key), cost: cost)
+    }
+}
@@ -0,0 +1,238 @@
+//
+//  TPPPDFThumbnailStore.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+import os
+import UIKit
+
+/// Page thumbnails and previews of a book, packed in one file next to it.
+///
+/// The file is a header followed by appended records, each a page number,
+/// an image kind, a length and JPEG data. It is memory-mapped when opened,
+/// so images stored in earlier sessions are read without loading the file.
+/// Images stored in this session are kept in memory only until they're
+/// written; the file is then mapped again to read them.
+/// A record cut short by a crash is dropped on the next open.
+final class TPPPDFThumbnailStore {
+
+    enum Kind: UInt8 {
+        /// Small image for the preview bar
+        case thumbnail = 0
+        /// Larger image for the preview grid
+        case preview = 1
+    }
+
+    struct Key: Hashable {
+        let page: Int
+        let kind: Kind
+    }
+
+    private static let magic = Data("PTS1".utf8)
+    /// Magic and the length of the document the images were rendered from.
+    private static let headerLength = 12
+    /// Page (4 bytes), kind (1), padding (3), data length (4).
+    private static let recordHeaderLength = 12
+
+    let url: URL
+    let documentLength: Int
+
+    private struct State {
+        /// The store file, mapped when opened and again to read records
+        /// written after that.
+        var mappedData = Data()
+        /// Records in the file, by key.
+        var ranges = [Key: Range<Int>]()
+        /// Images waiting to be written, with the number of their write.
+        var pending = [Key: (data: Data, write: Int)]()
+        var writeCount = 0
+    }
+
+    private let state = OSAllocatedUnfairLock(initialState: State())
+    private let writeQueue = DispatchQueue(label: "org.thepalaceproject.palace.pdfThumbnailStore", qos: .utility)
+    private var fileHandle: FileHandle?
+    private var memoryWarningObserver: NSObjectProtocol?
+
+    /// Opens the store at `url`, starting over if it was written for another
+    /// version of the document.
+    init(url: URL, documentLength: Int) {
+        self.url = url
+        self.documentLength = documentLength
+
+        var mappedData = (try? Data(contentsOf: url, options: .alwaysMapped)) ?? Data()
+        var ranges = [Key: Range<Int>]()
+        if let validLength = Self.scan(mappedData, documentLength: documentLength, into: &ranges) {
+            if validLength < mappedData.count {
+                // Drop a partial record.
+                try? FileHandle(forWritingTo: url).truncate(atOffset: UInt64(validLength))
+            }
+        } else {
+            try? FileManager.default.removeItem(at: url)
+            mappedData = Data()
+            ranges = [:]
+        }
+        state.withLock { [mappedData] state in
+            state.mappedData = mappedData
+            state.ranges = ranges
+        }
+
+        memoryWarningObserver = NotificationCenter.default.addObserver(
+            forName: UIApplication.didReceiveMemoryWarningNotification,
+            object: nil,
+            queue: nil
+        ) { [weak self] _ in
+            self?.releaseMemory()
+        }
+    }
+
+    deinit {
+        if let observer = memoryWarningObserver {
+            NotificationCenter.default.removeObserver(observer)
+        }
+        try? fileHandle?.close()
+    }
+
+    /// Store location for a book file.
+    static func url(forBookAt bookURL: URL) -> URL {
+        bookURL.appendingPathExtension("thumbnails")
+    }
+
+    static func deleteStore(forBookAt bookURL: URL) {
+        try? FileManager.default.removeItem(at: url(forBookAt: bookURL))
+    }
+
+    // MARK: - Reading
+
+    func contains(_ key: Key) -> Bool {
+        state.withLock { $0.ranges[key] != nil || $0.pending[key] != nil }
+    }
+
+    /// JPEG data of an image; slices of the mapped file aren't copied.
+    func data(for key: Key) -> Data? {
+        let stored = state.withLock { state -> (Data, Range<Int>?, Data?) in
+            (state.mappedData, state.ranges[key], state.pending[key]?.data)
+        }
+        if let data = stored.2 {
+            return data
+        }
+        guard let range = stored.1 else { return nil }
+
+        var mappedData = stored.0
+        if range.upperBound > mappedData.count {
+            // Written after the file was mapped
+            guard let data = try? Data(contentsOf: url, options: .alwaysMapped), range.upperBound <= data.count else {
+                return nil
+            }
+            mappedData = data
+            state.withLock { state in
+                if data.count > state.mappedData.count {
+                    state.mappedData = data
+                }
+            }
+        }
+        return mappedData[mappedData.startIndex + range.lowerBound..<mappedData.startIndex + range.upperBound]
+    }
+
+    func image(for key: Key) -> UIImage? {
+        data(for: key).flatMap(UIImage.init(data:))
+    }
+
+    // MARK: - Writing
+
+    /// Appends an image to the store file in the background.
+    func store(_ jpegData: Data, for key: Key) {
+        let write = state.withLock { state in
+            state.writeCount += 1
+            state.pending[key] = (jpegData, state.writeCount)
+            return state.writeCount
+        }
+        writeQueue.async { [weak self] in
+            guard let self else { return }
+            let range = self.append(jpegData, for: key)
+            self.state.withLock { state in
+                if let range {
+                    state.ranges[key] = range
+                }
+                // A newer image for the page stays until it is written too
+                if state.pending[key]?.write == write {
+                    state.pending.removeValue(forKey: key)
+                }
+            }
+        }
+    }
+
+    /// Waits for images passed to `store(_:for:)` to be written.
+    func waitForWrites() {
+        writeQueue.sync {}
+    }
+
+    /// Drops images not written yet and the file mapping, which is made
+    /// again on the next read.
+    private func releaseMemory() {
+        state.withLock { state in
+            state.pending.removeAll()
+            state.mappedData = Data()
+        }
+    }
+
+    /// - Returns: Range of the JPEG data in the file, or `nil` if it couldn't be written.
+    private func append(_ jpegData: Data, for key: Key) -> Range<Int>? {
+        do {
+            let handle = try openForAppending()
+            var record = Data(capacity: Self.recordHeaderLength + jpegData.count)
+            record.appendLittleEndian(UInt32(key.page))
+            record.append(contentsOf: [key.kind.rawValue, 0, 0, 0])
+            record.appendLittleEndian(UInt32(jpegData.count))
+            record.append(jpegData)
+            let start = Int(try handle.offset()) + Self.recordHeaderLength
+            try handle.write(contentsOf: record)
+            return start..<start + jpegData.count
+        } catch {
+            Log.error(#file, "Failed to store PDF thumbnail: \(error.localizedDescription)")
+            return nil
+        }
+    }
+
+    private func openForAppending() throws -> FileHandle {
+        if let fileHandle {
+            return fileHandle
+        }
+        if !FileManager.default.fileExists(atPath: url.path) {
+            var header = Self.magic
+            header.appendLittleEndian(UInt64(documentLength))
+            try header.write(to: url, options: .completeFileProtectionUntilFirstUserAuthentication)
+        }
+        let handle = try FileHandle(forWritingTo: url)
+        try handle.seekToEnd()
+        fileHandle = handle
+        return handle
+    }
+
+    // MARK: - File Format
+
+    /// Reads the records of a store file.
+    /// - Returns: Length of the complete records, or `nil` if the file is
+    ///   empty, corrupt or for another document.
+    private static func scan(_ data: Data, documentLength: Int, into ranges: inout [Key: Range<Int>]) -> Int? {
+        guard data.count >= headerLength,
+              data.prefix(magic.count) == magic,
+              data.readLittleEndian(UInt64.self, at: magic.count) == UInt64(documentLength) else {
+            return nil
+        }
+        var offset = headerLength
+        while offset + recordHeaderLength <= data.count {
+            let page = Int(data.readLittleEndian(UInt32.self, at: offset))
+            guard let kind = Kind(rawValue: data[data.startIndex + offset + 4]) else { return nil }
+            let length = Int(data.readLittleEndian(UInt32.self, at: offset + 8))
+            let start = offset + recordHeaderLength
+            guard start + length <= data.count else { break }
+            // Later records replace earlier ones.
+            ranges[Key(page: page, kind: kind)] = start..<start + length
+            offset = start + length
+        }
+        return offset
+    }
+}
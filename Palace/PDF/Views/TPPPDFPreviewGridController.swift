@@ -40,12 +40,8 @@ class TPPPDFPreviewGridController: UICollectionViewController {
 
     private var document: TPPPDFDocument?
     private let cellId = "cell"
-    private let previewCache = NSCache<NSNumber, UIImage>()
-
-    private func configurePreviewCache() {
-        previewCache.totalCostLimit = 20 * 1024 * 1024
-        previewCache.countLimit = 50
-    }
+    /// Preview requests of visible cells, cancelled when cells scroll away
+    private var previewRequests = [IndexPath: TPPPDFThumbnailPipeline.Request]()
     private let itemSpacing = 10.0
 
     @available(*, unavailable)
@@ -73,13 +69,12 @@ class TPPPDFPreviewGridController: UICollectionViewController {
 
     override func didReceiveMemoryWarning() {
         super.didReceiveMemoryWarning()
-        previewCache.removeAllObjects()
+        document?.thumbnailPipeline.clearMemoryCache()
     }
 
     override func viewDidLoad() {
         super.viewDidLoad()
         title = NSLocalizedString("Page Previews", comment: "PDF page preview grid title")
-        configurePreviewCache()
         collectionView.bounces = true
         collectionView.decelerationRate = .normal
         collectionView.isUserInteractionEnabled = true
@@ -115,35 +110,45 @@ class TPPPDFPreviewGridController: UICollectionViewController {
 
     override func collectionView(_ collectionView: UICollectionView, cellForItemAt indexPath: IndexPath) -> UICollectionViewCell {
         let page = self.pageNumber(for: indexPath.item)
-        let key = NSNumber(value: page)
         guard let cell = collectionView.dequeueReusableCell(withReuseIdentifier: cellId, for: indexPath) as? TPPPDFPreviewGridCell else {
             return collectionView.dequeueReusableCell(withReuseIdentifier: cellId, for: indexPath)
         }
         cell.pageNumber = page
         cell.pageLabel.text = document?.label(page: page) ?? "\(page + 1)"
-        if let image = previewCache.object(forKey: key) {
+        guard let pipeline = document?.thumbnailPipeline else {
+            cell.imageView.image = nil
+            return cell
+        }
+        cancelPreviewRequest(at: indexPath)
+        if let image = pipeline.cachedImage(page: page, kind: .preview) {
             cell.imageView.image = image
         } else {
-            if let pageSize = document?.size(page: page) {
+            // Stored thumbnail, or blank page, until the preview is rendered
+            if let thumbnail = pipeline.cachedImage(page: page, kind: .thumbnail) {
+                cell.imageView.image = thumbnail
+            } else if let pageSize = document?.size(page: page) {
                 cell.imageView.image = UIImage(color: .white, size: pageSize)
             } else {
                 cell.imageView.image = nil
             }
-            DispatchQueue.pdfThumbnailRenderingQueue.async {
-                let image: UIImage? = self.document?.preview(for: page)
-                if let image = image {
-                    self.previewCache.setObject(image, forKey: key)
-                }
-                if page == cell.pageNumber {
-                    DispatchQueue.main.async {
-                        cell.imageView.image = image
-                    }
-                }
+            previewRequests[indexPath] = pipeline.request(page: page, kind: .preview) { [weak cell] image in
+                guard let cell, let image, page == cell.pageNumber else { return }
+                cell.imageView.image = image
             }
         }
         return cell
     }
 
+    override func collectionView(_ collectionView: UICollectionView, didEndDisplaying cell: UICollectionViewCell, forItemAt indexPath: IndexPath) {
+        cancelPreviewRequest(at: indexPath)
+    }
+
+    private func cancelPreviewRequest(at indexPath: IndexPath) {
+        if let request = previewRequests.removeValue(forKey: indexPath) {
+            document?.thumbnailPipeline.cancel(request)
+        }
+    }
+
     override func collectionView(_ collectionView: UICollectionView, didSelectItemAt indexPath: IndexPath) {
         let page = pageNumber(for: indexPath.item)
         delegate?.didSelectPage(page)
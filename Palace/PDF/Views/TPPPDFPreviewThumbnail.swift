@@ -40,6 +40,8 @@ struct TPPPDFPreviewThumbnail: View {
         let document: any PDFDocumentProviding
         let index: Int
         @Published var image: UIImage
+        private var request: TPPPDFThumbnailPipeline.Request?
+
         init(document: any PDFDocumentProviding, index: Int) {
             self.document = document
             self.index = index
@@ -51,13 +53,19 @@ struct TPPPDFPreviewThumbnail: View {
             }
         }
 
+        deinit {
+            // The thumbnail left the screen before it was rendered
+            if let request {
+                document.cancelThumbnailRequest(request)
+            }
+        }
+
         private func fetchThumbnail() {
-            DispatchQueue.pdfThumbnailRenderingQueue.async {
-                let thumbnail = self.document.thumbnail(for: self.index)
-                DispatchQueue.main.async {
-                    if let thumbnail = thumbnail {
-                        self.image = thumbnail
-                    }
+            request = document.requestThumbnail(for: index) { [weak self] thumbnail in
+                guard let self else { return }
+                self.request = nil
+                if let thumbnail = thumbnail {
+                    self.image = thumbnail
                 }
             }
         }
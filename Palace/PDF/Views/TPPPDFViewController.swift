@@ -18,7 +18,7 @@ class TPPPDFViewController: NSObject {
         var controller: UIViewController!
         if document.isEncrypted && document.data.count < supportedEncryptedDataSize {
             let data = document.decrypt(data: document.data, start: 0, end: UInt(document.data.count))
-            controller = UIHostingController(rootView: TPPPDFReaderView(document: TPPPDFDocument(data: data)).environmentObject(metadata))
+            controller = UIHostingController(rootView: TPPPDFReaderView(document: TPPPDFDocument(data: data, thumbnailStoreURL: document.thumbnailStoreURL)).environmentObject(metadata))
         } else {
             controller = UIHostingController(rootView: TPPPDFReaderView(document: document).environmentObject(metadata))
         }
@@ -17,6 +17,21 @@
 /// The date is in `*.epub_rights.xml` files, xpath `/licenseToken/permissions/display/until`
 static NSString * _Nonnull const AdobeDRMContainerExpiredLicenseError = @"E_INVALID_LICENSE";
 
+/// Incremental decryptor for a single file inside ePub file.
+/// Encrypted data is passed in order, chunk by chunk; each call returns the data decrypted so far.
+@interface AdobeDRMDecryptionStream : NSObject
+NS_ASSUME_NONNULL_BEGIN
+- (instancetype)init NS_UNAVAILABLE;
+/// Decrypt next chunk of encrypted data
+/// @param data Encrypted data chunk
+/// @param isFinal `YES` for the last chunk of the file
+/// @return Decrypted data, may be empty; `nil` in case of error
+- (nullable NSData *)decryptChunk:(NSData *)data final:(BOOL)isFinal;
+NS_ASSUME_NONNULL_END
+/// Error message from the decryptor
+@property (nonatomic, readonly) NSString * _Nullable error;
+@end
+
 @interface AdobeDRMContainer : NSObject
 NS_ASSUME_NONNULL_BEGIN
 - (instancetype)init NS_UNAVAILABLE;
@@ -27,10 +42,36 @@ NS_ASSUME_NONNULL_BEGIN
 /// Decrypt encrypted data for file ar path inside ePub file
 /// @param data Encrypted data
 /// @param path File path inside ePub file
+/// @param error Error message for this call, `nil` on success
+/// @return Decrypted data, or `data` if it can't be decrypted
+- (NSData *)decodeData:(NSData *)data at:(NSString *)path error:(NSString * _Nullable * _Nullable)error;
+/// Decrypt encrypted data for file ar path inside ePub file, see `epubDecodingError`
+/// @param data Encrypted data
+/// @param path File path inside ePub file
 - (NSData *)decodeData:(NSData *)data at:(NSString *)path;
+/// `YES` if the file at path inside ePub file is listed in encryption.xml
+/// @param path File path inside ePub file
+- (BOOL)isEncryptedAt:(NSString *)path;
+/// Decrypted length of the file at path inside ePub file, from `OriginalLength` in encryption.xml
+/// @param path File path inside ePub file
+/// @return `nil` if encryption.xml doesn't list the length
+- (nullable NSNumber *)originalLengthAt:(NSString *)path;
+/// Creates a streaming decryptor for file at path inside ePub file
+/// @param path File path inside ePub file
+/// @param error Error message for this call, `nil` on success
+/// @return `nil` if the file can't be decrypted
+- (nullable AdobeDRMDecryptionStream *)decryptionStreamAt:(NSString *)path error:(NSString * _Nullable * _Nullable)error;
+/// Creates a streaming decryptor for file at path inside ePub file
+/// @param path File path inside ePub file
+/// @return `nil` if the file can't be decrypted, see `epubDecodingError`
+- (nullable AdobeDRMDecryptionStream *)decryptionStreamAt:(NSString *)path;
 NS_ASSUME_NONNULL_END
-/// Error messages from the container or underlying classes
-@property (nonatomic, strong) NSString * _Nullable epubDecodingError;
+/// Error message of the latest `decodeData:at:` or `decryptionStreamAt:` call on any thread.
+/// Concurrent callers should use the variants returning the error of their own call.
+@property (atomic, copy) NSString * _Nullable epubDecodingError;
+/// `NO` parses encryption.xml and creates the item decryptor on every call under the global lock,
+/// as before item decryptors were cached. Only meant for benchmarks; `YES` by default.
+@property (nonatomic) BOOL cachesItemDecryptors;
 /// Display until date from epub_rights.xml document permissions
 @property (nonatomic, strong) NSDate * _Nullable displayUntilDate;
 @property (nonatomic, strong) NSURL * _Nullable fileURL;
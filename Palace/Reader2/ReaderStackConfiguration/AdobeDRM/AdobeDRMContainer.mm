@@ -16,15 +16,123 @@
 #include "dp_all.h"
 #pragma clang diagnostic pop
 
+#import "NSDate+NYPLDateAdditions.h"
 #import "TPPXML.h"
 
+/// Serializes calls into the Adobe SDK factories (metadata parsing, decryptor creation),
+/// which share process-wide state. Decryption itself is guarded per item.
 static id acsdrm_lock = nil;
 
+/// Cached encryption info and decryptor for a single item in encryption.xml
+@interface AdobeDRMItemDecryptor : NSObject {
+  @public dp::ref<dputils::EncryptionItemInfo> itemInfo;
+  @public dp::ref<dputils::EPubManifestItemDecryptor> decryptor;
+}
+/// Error produced while creating the decryptor
+@property (nonatomic, copy) NSString * _Nullable error;
+@end
+
+@implementation AdobeDRMItemDecryptor
+@end
+
+/// Wraps decrypted buffer without copying; the buffer is kept alive by the returned data
+static NSData *AdobeDRMDataWithBuffer(dp::ref<dp::Buffer> buffer) {
+  if (!buffer || buffer->length() == 0) {
+    return [NSData data];
+  }
+  dp::ref<dp::Buffer> retainedBuffer = buffer;
+  return [[NSData alloc] initWithBytesNoCopy:(void *)buffer->data()
+                                      length:NSUInteger(buffer->length())
+                                 deallocator:^(void *, NSUInteger) {
+    (void)retainedBuffer;
+  }];
+}
+
+/// Size of encryption block; chunks are passed to decryptor in multiples of it
+static const NSUInteger AdobeDRMCipherBlockSize = 16;
+
+@interface AdobeDRMDecryptionStream () {
+  @private dp::ref<dputils::EPubManifestItemDecryptor> decryptor;
+  /// Tail of the previous chunk that didn't fill an encryption block
+  @private NSMutableData *pendingData;
+  @private BOOL started;
+  @private BOOL finished;
+}
+@property (nonatomic, readwrite) NSString * _Nullable error;
+- (instancetype)initWithDecryptor:(dp::ref<dputils::EPubManifestItemDecryptor>)itemDecryptor;
+@end
+
+@implementation AdobeDRMDecryptionStream
+
+- (instancetype)initWithDecryptor:(dp::ref<dputils::EPubManifestItemDecryptor>)itemDecryptor {
+  if (self = [super init]) {
+    decryptor = itemDecryptor;
+    pendingData = [NSMutableData data];
+  }
+  return self;
+}
+
+- (NSData *)decryptChunk:(NSData *)data final:(BOOL)isFinal {
+  if (finished) {
+    self.error = @"Decryption stream is finished";
+    return nil;
+  }
+
+  // Input for this call is the pending tail followed by the new chunk
+  const uint8_t *bytes = (const uint8_t *)data.bytes;
+  size_t len = data.length;
+  if (pendingData.length > 0) {
+    [pendingData appendData:data];
+    bytes = (const uint8_t *)pendingData.bytes;
+    len = pendingData.length;
+  }
+
+  // Middle blocks are passed in whole encryption blocks, the rest waits for the next chunk
+  size_t blockLen = isFinal ? len : len - len % AdobeDRMCipherBlockSize;
+  if (blockLen == 0 && !isFinal) {
+    if (pendingData.length == 0) {
+      [pendingData appendData:data];
+    }
+    return [NSData data];
+  }
+
+  int blockType = 0;
+  if (!started) {
+    blockType |= dputils::EPubManifestItemDecryptor::FIRST_BLOCK;
+  }
+  if (isFinal) {
+    blockType |= dputils::EPubManifestItemDecryptor::FINAL_BLOCK;
+  }
+
+  dp::ref<dp::Buffer> filteredData = NULL;
+  dp::String error = decryptor->decryptBlock(blockType, (uint8_t *)bytes, blockLen, NULL, filteredData);
+  started = YES;
+  finished = isFinal;
+  if (!error.isNull()) {
+    self.error = [NSString stringWithUTF8String:error.utf8()];
+    finished = YES;
+    return nil;
+  }
+
+  NSData *tail = [NSData dataWithBytes:bytes + blockLen length:len - blockLen];
+  [pendingData setData:tail];
+  return AdobeDRMDataWithBuffer(filteredData);
+}
+
+@end
+
 @interface AdobeDRMContainer () {
   @private dpdev::Device *device;
   @private dp::Data rightsXMLData;
   @private NSData *encryptionData;
   @private TPPXML *permissionsNode;
+  /// encryption.xml parsed once per container, on first decode
+  @private dp::ref<dputils::EncryptionMetadata> encryptionMetadata;
+  @private BOOL encryptionMetadataParsed;
+  /// Item decryptors by path inside the ePub file
+  @private NSMutableDictionary<NSString *, AdobeDRMItemDecryptor *> *itemDecryptors;
+  /// Decrypted lengths by path inside the ePub file, read from encryption.xml on first use
+  @private NSDictionary<NSString *, NSNumber *> *originalLengths;
 }
 @end
 
@@ -33,11 +141,18 @@ static id acsdrm_lock = nil;
 
 @synthesize displayUntilDate = _displayUntilDate;
 
++ (void)initialize {
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    acsdrm_lock = [[NSObject alloc] init];
+  });
+}
 
 - (instancetype)initWithURL:(NSURL *)fileURL encryptionData:(NSData *)data {
   if (self = [super init]) {
-    acsdrm_lock = [[NSObject alloc] init];
     encryptionData = data;
+    itemDecryptors = [NSMutableDictionary dictionary];
+    _cachesItemDecryptors = YES;
     self.fileURL = fileURL;
     NSString *path = fileURL.path;
 
@@ -67,74 +182,229 @@ static id acsdrm_lock = nil;
     /// The date is in `*.epub_rights.xml` files, xpath `/licenseToken/permissions/display/until`
     TPPXML *dateUntilNode = [[permissionsNode firstChildWithName:@"display"] firstChildWithName:@"until"];
     NSString *dateUntilValue = dateUntilNode.value;
-    NSDateFormatter *df = [[NSDateFormatter alloc] init];
-    df.dateFormat = @"yyyy-MM-dd'T'HH:mm:ssZ";
-    _displayUntilDate = [df dateFromString:dateUntilValue];
+    _displayUntilDate = [NSDate dateWithRFC3339String:dateUntilValue];
   }
   return _displayUntilDate;
 }
 
-- (NSData *)decodeData:(NSData *)data at:(NSString *)path {
+/// Parses encryption.xml.
+/// Must be called with `acsdrm_lock` held.
+- (dp::ref<dputils::EncryptionMetadata>)parseEncryptionMetadata {
+  size_t encryptionLen = encryptionData.length;
+  unsigned char *encryptionContent = (unsigned char *)encryptionData.bytes;
+  dp::Data encryptionXMLData (encryptionContent, encryptionLen);
+  return dputils::EncryptionMetadata::createFromXMLData(encryptionXMLData);
+}
 
-  @synchronized (acsdrm_lock) {
-    // clear any error
-    self.epubDecodingError = nil;
-
-    // itemInfo describes encription protocol for a file in encryption.xml
-    // this way decryptor knows how to decode a block of data
-    // Encryption metadata for the file from encryption.xml
-    size_t encryptionLen = encryptionData.length;
-    unsigned char *encryptionContent = (unsigned char *)encryptionData.bytes;
-    dp::Data encryptionXMLData (encryptionContent, encryptionLen);
-    dp::ref<dputils::EncryptionMetadata> encryptionMetadata = dputils::EncryptionMetadata::createFromXMLData(encryptionXMLData);
-    uft::String itemPath (path.UTF8String);
+/// Creates the encryption info and decryptor for the item at `path`.
+/// Must be called with `acsdrm_lock` held.
+- (AdobeDRMItemDecryptor *)createItemDecryptorFor:(NSString *)path metadata:(dp::ref<dputils::EncryptionMetadata>)metadata {
+  AdobeDRMItemDecryptor *itemDecryptor = [[AdobeDRMItemDecryptor alloc] init];
 
-    if (!encryptionMetadata) {
-      self.epubDecodingError = @"Missing EncryptionMetadata";
-      return data;
+  // itemInfo describes encription protocol for a file in encryption.xml
+  // this way decryptor knows how to decode a block of data
+  uft::String itemPath (path.UTF8String);
+  itemDecryptor->itemInfo = metadata->getItemForURI(itemPath);
+
+  if (!itemDecryptor->itemInfo) {
+    itemDecryptor.error = @"Missing EncryptionItemInfo";
+    return itemDecryptor;
+  }
+
+  if (rightsXMLData.isNull()) {
+    itemDecryptor.error = @"Missing Rights XML Data";
+    return itemDecryptor;
+  }
+
+  if (!device) {
+    itemDecryptor.error = @"Device information is empty";
+    return itemDecryptor;
+  }
+
+  // Create decryptor
+  dp::String decryptorEerror;
+  itemDecryptor->decryptor = dpdrm::DRMProcessor::createEPubManifestItemDecryptor(itemDecryptor->itemInfo, rightsXMLData, device, decryptorEerror);
+
+  if (!itemDecryptor->decryptor && !decryptorEerror.isNull()) {
+    itemDecryptor.error = [NSString stringWithUTF8String:decryptorEerror.utf8()];
+  }
+  return itemDecryptor;
+}
+
+/// Looks up the item decryptor for `path`.
+/// Encryption metadata and decryptors are created once under `acsdrm_lock`;
+/// lookups of already known items only take the container lock.
+- (AdobeDRMItemDecryptor *)itemDecryptorFor:(NSString *)path error:(NSString **)error {
+  if (!self.cachesItemDecryptors) {
+    @synchronized (acsdrm_lock) {
+      dp::ref<dputils::EncryptionMetadata> metadata = [self parseEncryptionMetadata];
+      if (!metadata) {
+        *error = @"Missing EncryptionMetadata";
+        return nil;
+      }
+      return [self createItemDecryptorFor:path metadata:metadata];
     }
+  }
 
-    dp::ref<dputils::EncryptionItemInfo> itemInfo = encryptionMetadata->getItemForURI(itemPath);
+  @synchronized (itemDecryptors) {
+    AdobeDRMItemDecryptor *itemDecryptor = itemDecryptors[path];
+    if (itemDecryptor) {
+      return itemDecryptor;
+    }
+  }
 
-    if (!itemInfo) {
-      self.epubDecodingError = @"Missing EncryptionItemInfo";
-      return data;
+  @synchronized (acsdrm_lock) {
+    // Another thread may have created the decryptor while we were waiting
+    AdobeDRMItemDecryptor *itemDecryptor;
+    @synchronized (itemDecryptors) {
+      itemDecryptor = itemDecryptors[path];
     }
-    
-    if (rightsXMLData.isNull()) {
-      self.epubDecodingError = @"Missing Rights XML Data";
-      return data;
+    if (itemDecryptor) {
+      return itemDecryptor;
     }
-    
-    if (!device) {
-      self.epubDecodingError = @"Device information is empty";
-      return data;
+
+    if (!encryptionMetadataParsed) {
+      // Encryption metadata for the file from encryption.xml
+      encryptionMetadata = [self parseEncryptionMetadata];
+      encryptionMetadataParsed = YES;
     }
 
-    // Create decryptor
-    dp::String decryptorEerror;
-    dp::ref<dputils::EPubManifestItemDecryptor> decryptor = dpdrm::DRMProcessor::createEPubManifestItemDecryptor(itemInfo, rightsXMLData, device, decryptorEerror);
+    if (!encryptionMetadata) {
+      *error = @"Missing EncryptionMetadata";
+      return nil;
+    }
 
-    if (!decryptor) {
-      if (!decryptorEerror.isNull()) {
-        self.epubDecodingError = [NSString stringWithUTF8String:decryptorEerror.utf8()];
+    itemDecryptor = [self createItemDecryptorFor:path metadata:encryptionMetadata];
+    // A failed decryptor is returned for its error, but not cached, so the next read tries again
+    if (itemDecryptor->decryptor) {
+      @synchronized (itemDecryptors) {
+        itemDecryptors[path] = itemDecryptor;
       }
-      return data;
     }
-    
+    return itemDecryptor;
+  }
+}
+
+- (NSData *)decodeData:(NSData *)data at:(NSString *)path error:(NSString **)error {
+  NSString *decodingError = nil;
+  NSData *decoded = [self decodeData:data at:path decodingError:&decodingError];
+  if (error) {
+    *error = decodingError;
+  }
+  return decoded;
+}
+
+- (NSData *)decodeData:(NSData *)data at:(NSString *)path {
+  NSString *error = nil;
+  NSData *decoded = [self decodeData:data at:path decodingError:&error];
+  self.epubDecodingError = error;
+  return decoded;
+}
+
+- (NSData *)decodeData:(NSData *)data at:(NSString *)path decodingError:(NSString **)decodingError {
+  AdobeDRMItemDecryptor *itemDecryptor = [self itemDecryptorFor:path error:decodingError];
+  if (!itemDecryptor) {
+    return data;
+  }
+
+  if (!itemDecryptor->decryptor) {
+    *decodingError = itemDecryptor.error;
+    return data;
+  }
+
+  // Decryptor keeps block state, so each item is decrypted by one thread at a time;
+  // different items decrypt in parallel. Uncached decryptors decrypt under the global lock.
+  @synchronized (self.cachesItemDecryptors ? itemDecryptor : acsdrm_lock) {
     // Buffer for decrypted data
     dp::ref<dp::Buffer> filteredData = NULL;
     // data is the first and the last block (the whole block of data is decoded at once)
     int blockType = dputils::EPubManifestItemDecryptor::FIRST_BLOCK | dputils::EPubManifestItemDecryptor::FINAL_BLOCK;
     size_t len = data.length;
     uint8_t *encryptedData = (uint8_t *)data.bytes;
-    dp::String error = decryptor->decryptBlock(blockType, encryptedData, len, NULL, filteredData);
+    dp::String error = itemDecryptor->decryptor->decryptBlock(blockType, encryptedData, len, NULL, filteredData);
     if (!error.isNull()) {
-      self.epubDecodingError = [NSString stringWithUTF8String:error.utf8()];
+      *decodingError = [NSString stringWithUTF8String:error.utf8()];
       return data;
     }
-    return [NSData dataWithBytes:filteredData->data() length: NSUInteger(filteredData->length())];
+    return AdobeDRMDataWithBuffer(filteredData);
+  }
+}
+
+- (BOOL)isEncryptedAt:(NSString *)path {
+  NSString *error = nil;
+  AdobeDRMItemDecryptor *itemDecryptor = [self itemDecryptorFor:path error:&error];
+  if (!itemDecryptor || !itemDecryptor->itemInfo) {
+    return NO;
+  }
+  return YES;
+}
+
+- (NSNumber *)originalLengthAt:(NSString *)path {
+  @synchronized (self) {
+    if (!originalLengths) {
+      // <EncryptedData>
+      //   <CipherData><CipherReference URI="path"/></CipherData>
+      //   <EncryptionProperties><EncryptionProperty><Compression OriginalLength="length"/>
+      NSMutableDictionary<NSString *, NSNumber *> *lengths = [NSMutableDictionary dictionary];
+      TPPXML *encryptionXML = [TPPXML XMLWithData:encryptionData];
+      for (TPPXML *encryptedData in [encryptionXML childrenWithName:@"EncryptedData"]) {
+        NSString *uri = [[encryptedData firstChildWithName:@"CipherData"] firstChildWithName:@"CipherReference"].attributes[@"URI"];
+        TPPXML *compression = [[[encryptedData firstChildWithName:@"EncryptionProperties"]
+                                firstChildWithName:@"EncryptionProperty"]
+                               firstChildWithName:@"Compression"];
+        NSString *originalLength = compression.attributes[@"OriginalLength"];
+        if (uri && originalLength) {
+          lengths[uri] = @(originalLength.longLongValue);
+        }
+      }
+      originalLengths = lengths;
+    }
+    return originalLengths[path];
+  }
+}
+
+- (AdobeDRMDecryptionStream *)decryptionStreamAt:(NSString *)path error:(NSString **)error {
+  NSString *decodingError = nil;
+  AdobeDRMDecryptionStream *stream = [self decryptionStreamAt:path decodingError:&decodingError];
+  if (error) {
+    *error = decodingError;
+  }
+  return stream;
+}
+
+- (AdobeDRMDecryptionStream *)decryptionStreamAt:(NSString *)path {
+  NSString *error = nil;
+  AdobeDRMDecryptionStream *stream = [self decryptionStreamAt:path decodingError:&error];
+  self.epubDecodingError = error;
+  return stream;
+}
+
+- (AdobeDRMDecryptionStream *)decryptionStreamAt:(NSString *)path decodingError:(NSString **)decodingError {
+  AdobeDRMItemDecryptor *itemDecryptor = [self itemDecryptorFor:path error:decodingError];
+  if (!itemDecryptor) {
+    return nil;
+  }
+
+  if (!itemDecryptor->decryptor) {
+    *decodingError = itemDecryptor.error;
+    return nil;
+  }
+
+  // Each stream has its own decryptor, so streams don't share block state
+  // and don't hold the item lock between chunks.
+  dp::String decryptorEerror;
+  dp::ref<dputils::EPubManifestItemDecryptor> decryptor;
+  @synchronized (acsdrm_lock) {
+    decryptor = dpdrm::DRMProcessor::createEPubManifestItemDecryptor(itemDecryptor->itemInfo, rightsXMLData, device, decryptorEerror);
+  }
+
+  if (!decryptor) {
+    *decodingError = decryptorEerror.isNull()
+      ? @"Failed to create decryptor"
+      : [NSString stringWithUTF8String:decryptorEerror.utf8()];
+    return nil;
   }
+  return [[AdobeDRMDecryptionStream alloc] initWithDecryptor:decryptor];
 }
 
 @end
@@ -103,34 +103,38 @@ extension AdobeDRMContainer: Container {
     public subscript(url: any URLConvertible) -> Resource? {
         let path = url.anyURL.string
 
-        let data: Data? = {
-            var result: Data?
+        let entry: ArchiveEntryData? = {
+            var result: ArchiveEntryData?
             let semaphore = DispatchSemaphore(value: 0)
-            self.retrieveDataSynchronously(for: path) { retrievedData in
-                result = retrievedData
+            self.retrieveDataSynchronously(for: path) { retrievedEntry in
+                result = retrievedEntry
                 semaphore.signal()
             }
             semaphore.wait()
             return result
         }()
 
-        guard let data else {
+        guard let entry else {
             return nil
         }
 
+        guard let data = entry.data else {
+            return DRMStreamingResource(path: path, encryptedLength: entry.length, drmContainer: self, sourceURL: sourceURL)
+        }
+
         return DRMDataResource(encryptedData: data, path: path, drmContainer: self, sourceURL: sourceURL)
     }
 
-    private func retrieveDataSynchronously(for path: String, completion: @escaping (Data?) -> Void) {
+    private func retrieveDataSynchronously(for path: String, completion: @escaping (ArchiveEntryData?) -> Void) {
         DispatchQueue.global(qos: .userInitiated).async {
             let runLoop = CFRunLoopGetCurrent()
-            var retrievedData: Data?
+            var retrievedEntry: ArchiveEntryData?
             var isCompleted = false
             Task {
                 do {
-                    retrievedData = try await self.retrieveData(for: path)
+                    retrievedEntry = try await self.retrieveData(for: path)
                 } catch {
-                    retrievedData = nil
+                    retrievedEntry = nil
                 }
 
                 isCompleted = true
@@ -145,24 +149,33 @@ extension AdobeDRMContainer: Container {
                 }
             }
 
-            completion(retrievedData)
+            completion(retrievedEntry)
         }
     }
 
     // MARK: - Helpers
+
+    /// Encrypted entry in the archive.
+    /// `data` is only read for entries small enough to be decrypted at once.
+    private struct ArchiveEntryData {
+        let length: UInt64
+        let data: Data?
+    }
+
     /// Retrieves encrypted data for the resource at a given path.
-    private func retrieveData(for path: String) async throws -> Data {
-        guard let rawData = try await readDataFromArchive(at: path) else {
+    /// Large resources are not read here, they are streamed by `DRMStreamingResource`.
+    private func retrieveData(for path: String) async throws -> ArchiveEntryData {
+        guard let entry = try await readDataFromArchive(at: path) else {
             throw DebugError("Failed to locate resource at path: \(path)")
         }
-        return rawData
+        return entry
     }
 
     private func listPathsFromArchive() -> [String]? {
         return ["META-INF/container.xml", "OEBPS/content.opf"]
     }
 
-    private func readDataFromArchive(at path: String) async throws -> Data? {
+    private func readDataFromArchive(at path: String) async throws -> ArchiveEntryData? {
         guard let fileURL else { return nil }
         let archive = try await Archive(url: fileURL, accessMode: .read)
 
@@ -170,10 +183,15 @@ extension AdobeDRMContainer: Container {
             return nil
         }
 
+        let length = UInt64(entry.uncompressedSize)
+        guard length < DRMStreamingResource.minimumStreamingLength else {
+            return ArchiveEntryData(length: length, data: nil)
+        }
+
         do {
             var data = Data()
             _ = try await archive.extract(entry, consumer: { data.append($0) })
-            return data
+            return ArchiveEntryData(length: length, data: data)
         } catch {
             return nil
         }
@@ -205,7 +223,8 @@ public actor DRMDataResource: Resource {
         if let cached = _decryptedData {
             return cached
         }
-        let decrypted = drmContainer.decode(encryptedData, at: path)
+        // Entries that aren't encrypted are returned as they are.
+        let decrypted = drmContainer.decode(encryptedData, at: path, error: nil)
         let result: ReadResult<Data> = .success(decrypted)
         _decryptedData = result
         return result
@@ -236,15 +255,167 @@ public actor DRMDataResource: Resource {
     }
 
     public func properties() async -> ReadResult<ResourceProperties> {
-        let fullData = try? await decryptedData().get()
         var props = ResourceProperties()
-        props.length = fullData.map { UInt64($0.count) }
+        props.length = await length()
         return .success(props)
     }
 
     public func estimatedLength() async -> ReadResult<UInt64?> {
+        .success(await length())
+    }
+
+    /// Decrypted length, from encryption.xml if the data isn't decrypted yet.
+    private func length() async -> UInt64? {
+        if _decryptedData == nil, let originalLength = drmContainer.originalLength(at: path) {
+            return originalLength.uint64Value
+        }
         let fullData = try? await decryptedData().get()
-        return .success(fullData.map { UInt64($0.count) })
+        return fullData.map { UInt64($0.count) }
+    }
+}
+
+/// A DRM-enabled Resource for large files (images, media) that decrypts its data
+/// chunk by chunk while it is read from the archive.
+/// Only the last chunk read is kept, so peak memory is bounded by the chunk size, not by the resource size.
+/// Encryption is not seekable, but the resource keeps its read position, so reads that
+/// go forward, as media playback does, continue from the previous read.
+/// Entries that aren't listed in encryption.xml are read as they are.
+public actor DRMStreamingResource: Resource {
+    /// Resources at least this large are streamed instead of being decrypted at once
+    static let minimumStreamingLength: UInt64 = 1024 * 1024
+
+    /// Size of encrypted chunks read from the archive
+    static let chunkSize = 64 * 1024
+
+    public let sourceURL: AbsoluteURL?
+
+    private let path: String
+    private let encryptedLength: UInt64
+    private let drmContainer: AdobeDRMContainer
+
+    /// Decrypted length, known after a complete pass over the resource.
+    private var decryptedLength: UInt64?
+
+    private var location: ZIPEntryLocation?
+    private var isEncrypted: Bool?
+    /// Reader positioned after the previous read.
+    private var reader: DRMEntryReader?
+    /// Last chunk returned by `reader`, ending at `reader.offset`.
+    private var lastChunk = Data()
+
+    public init(path: String, encryptedLength: UInt64, drmContainer: AdobeDRMContainer, sourceURL: AbsoluteURL? = nil) {
+        self.path = path
+        self.encryptedLength = encryptedLength
+        self.drmContainer = drmContainer
+        self.sourceURL = sourceURL
+    }
+
+    public func stream(range: Range<UInt64>?, consume: @escaping (Data) -> Void) async -> ReadResult<Void> {
+        let start = range?.lowerBound ?? 0
+        do {
+            let reader = try reader(startingAt: start)
+
+            // Decrypted bytes are delivered as long as they fall into the range.
+            var chunk = lastChunk
+            while true {
+                let chunkStart = reader.offset - UInt64(chunk.count)
+                let lower = max(start, chunkStart)
+                let upper = min(range?.upperBound ?? reader.offset, reader.offset)
+                if lower < upper {
+                    consume(chunk.subdata(in: Int(lower - chunkStart)..<Int(upper - chunkStart)))
+                }
+                if let range, reader.offset >= range.upperBound {
+                    // The rest of the chunk may be read next.
+                    lastChunk = chunk
+                    break
+                }
+                guard let next = try reader.next() else {
+                    decryptedLength = reader.offset
+                    lastChunk = Data()
+                    break
+                }
+                chunk = next
+            }
+            return .success(())
+        } catch {
+            self.reader = nil
+            lastChunk = Data()
+            return .failure(.access(.other(error)))
+        }
+    }
+
+    public func read(range: Range<UInt64>?) async throws -> Data {
+        var data = Data()
+        try await stream(range: range) { data.append($0) }.get()
+        return data
+    }
+
+    public func properties() async -> ReadResult<ResourceProperties> {
+        var props = ResourceProperties()
+        props.length = length()
+        return .success(props)
+    }
+
+    public func estimatedLength() async -> ReadResult<UInt64?> {
+        .success(decryptedLength ?? drmContainer.originalLength(at: path)?.uint64Value ?? encryptedLength)
+    }
+
+    /// Exact decrypted length: the stored entry size of unencrypted entries, `OriginalLength`
+    /// from encryption.xml of encrypted ones. Without either, it is computed once with a pass
+    /// over the resource that doesn't keep the data.
+    private func length() -> UInt64? {
+        if let decryptedLength {
+            return decryptedLength
+        }
+        if let originalLength = drmContainer.originalLength(at: path) {
+            decryptedLength = originalLength.uint64Value
+            return decryptedLength
+        }
+        guard let reader = try? makeReader() else {
+            return nil
+        }
+        if let decryptedLength {
+            // Set by `makeReader()` for unencrypted entries
+            return decryptedLength
+        }
+        while (try? reader.next()) != nil {}
+        guard reader.isAtEnd else {
+            return nil
+        }
+        decryptedLength = reader.offset
+        return decryptedLength
+    }
+
+    /// The current reader if it hasn't passed `start` yet, a new one otherwise.
+    private func reader(startingAt start: UInt64) throws -> DRMEntryReader {
+        if let reader, reader.offset - UInt64(lastChunk.count) <= start {
+            return reader
+        }
+        let reader = try makeReader()
+        self.reader = reader
+        lastChunk = Data()
+        return reader
+    }
+
+    private func makeReader() throws -> DRMEntryReader {
+        guard let fileURL = drmContainer.fileURL else {
+            throw ReadError.access(.fileSystem(.fileNotFound(nil)))
+        }
+        let location = try self.location ?? ZIPEntryLocation.locate(path, in: fileURL)
+        self.location = location
+
+        let isEncrypted = self.isEncrypted ?? drmContainer.isEncrypted(at: path)
+        self.isEncrypted = isEncrypted
+        guard isEncrypted else {
+            decryptedLength = location.uncompressedSize
+            return try DRMEntryReader(fileURL: fileURL, location: location, decryptor: nil, chunkSize: Self.chunkSize)
+        }
+
+        var decryptorError: NSString?
+        guard let decryptor = drmContainer.decryptionStream(at: path, error: &decryptorError) else {
+            throw ReadError.decoding(DebugError((decryptorError as String?) ?? "Failed to create decryptor for \(path)"))
+        }
+        return try DRMEntryReader(fileURL: fileURL, location: location, decryptor: decryptor, chunkSize: Self.chunkSize)
     }
 }
 
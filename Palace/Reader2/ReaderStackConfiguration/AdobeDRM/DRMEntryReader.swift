@@ -0,0 +1,235 @@
+//
+//  DRMEntryReader.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+#if FEATURE_DRM_CONNECTOR
+
+import Compression
+import Foundation
+import ReadiumShared
+
+/// Location of an entry's data in a ZIP file.
+struct ZIPEntryLocation: Equatable {
+    /// Offset of the entry data in the file
+    let dataOffset: UInt64
+    let compressedSize: UInt64
+    let uncompressedSize: UInt64
+    let isDeflated: Bool
+
+    private enum Signature: UInt32 {
+        case endOfCentralDirectory = 0x06054b50
+        case zip64EndOfCentralDirectoryLocator = 0x07064b50
+        case zip64EndOfCentralDirectory = 0x06064b50
+        case centralDirectoryHeader = 0x02014b50
+        case localFileHeader = 0x04034b50
+    }
+
+    private static let endOfCentralDirectoryLength = 22
+    private static let maximumCommentLength = 0xFFFF
+
+    /// Finds the entry at `path` by reading the central directory of the ZIP file at `fileURL`.
+    static func locate(_ path: String, in fileURL: URL) throws -> ZIPEntryLocation {
+        let file = try FileHandle(forReadingFrom: fileURL)
+        defer { try? file.close() }
+
+        let fileLength = try file.seekToEnd()
+        let tailLength = min(fileLength, UInt64(endOfCentralDirectoryLength + maximumCommentLength))
+        let tail = try read(file, at: fileLength - tailLength, count: Int(tailLength))
+        guard let eocd = stride(from: tail.count - endOfCentralDirectoryLength, through: 0, by: -1)
+            .first(where: { tail.uint32(at: $0) == Signature.endOfCentralDirectory.rawValue })
+        else {
+            throw DebugError("Missing ZIP end of central directory")
+        }
+
+        var entryCount = UInt64(tail.uint16(at: eocd + 10))
+        var directoryLength = UInt64(tail.uint32(at: eocd + 12))
+        var directoryOffset = UInt64(tail.uint32(at: eocd + 16))
+
+        if entryCount == 0xFFFF || directoryLength == 0xFFFF_FFFF || directoryOffset == 0xFFFF_FFFF {
+            let eocdOffset = fileLength - tailLength + UInt64(eocd)
+            guard eocdOffset >= 20 else {
+                throw DebugError("Missing ZIP64 end of central directory locator")
+            }
+            let locatorOffset = eocdOffset - 20
+            let locator = try read(file, at: locatorOffset, count: 20)
+            guard locator.uint32(at: 0) == Signature.zip64EndOfCentralDirectoryLocator.rawValue else {
+                throw DebugError("Missing ZIP64 end of central directory locator")
+            }
+            let zip64 = try read(file, at: locator.uint64(at: 8), count: 56)
+            guard zip64.uint32(at: 0) == Signature.zip64EndOfCentralDirectory.rawValue else {
+                throw DebugError("Missing ZIP64 end of central directory")
+            }
+            entryCount = zip64.uint64(at: 32)
+            directoryLength = zip64.uint64(at: 40)
+            directoryOffset = zip64.uint64(at: 48)
+        }
+
+        let directory = try read(file, at: directoryOffset, count: Int(directoryLength))
+        let name = Data(path.utf8)
+        var offset = 0
+        for _ in 0..<entryCount {
+            guard offset + 46 <= directory.count,
+                  directory.uint32(at: offset) == Signature.centralDirectoryHeader.rawValue
+            else { break }
+
+            let nameLength = Int(directory.uint16(at: offset + 28))
+            let extraLength = Int(directory.uint16(at: offset + 30))
+            let commentLength = Int(directory.uint16(at: offset + 32))
+            let nameStart = offset + 46
+            defer { offset = nameStart + nameLength + extraLength + commentLength }
+            guard nameStart + nameLength + extraLength <= directory.count,
+                  directory[nameStart..<(nameStart + nameLength)] == name
+            else { continue }
+
+            let method = directory.uint16(at: offset + 10)
+            var compressedSize = UInt64(directory.uint32(at: offset + 20))
+            var uncompressedSize = UInt64(directory.uint32(at: offset + 24))
+            var headerOffset = UInt64(directory.uint32(at: offset + 42))
+
+            // ZIP64 extended information holds the values that didn't fit, in this order
+            let extra = directory[(nameStart + nameLength)..<(nameStart + nameLength + extraLength)]
+            if var field = zip64ExtendedInformation(in: Data(extra)) {
+                if uncompressedSize == 0xFFFF_FFFF { uncompressedSize = field.next() }
+                if compressedSize == 0xFFFF_FFFF { compressedSize = field.next() }
+                if headerOffset == 0xFFFF_FFFF { headerOffset = field.next() }
+            }
+
+            let header = try read(file, at: headerOffset, count: 30)
+            guard header.uint32(at: 0) == Signature.localFileHeader.rawValue, method == 0 || method == 8 else {
+                throw DebugError("Unsupported ZIP entry \(path)")
+            }
+            return ZIPEntryLocation(
+                dataOffset: headerOffset + 30 + UInt64(header.uint16(at: 26)) + UInt64(header.uint16(at: 28)),
+                compressedSize: compressedSize,
+                uncompressedSize: uncompressedSize,
+                isDeflated: method == 8
+            )
+        }
+        throw DebugError("Missing ZIP entry \(path)")
+    }
+
+    /// Values of the ZIP64 extended information field, read in order.
+    private struct ExtendedInformation {
+        let data: Data
+        var offset = 0
+
+        mutating func next() -> UInt64 {
+            guard offset + 8 <= data.count else { return 0 }
+            defer { offset += 8 }
+            return data.uint64(at: offset)
+        }
+    }
+
+    private static func zip64ExtendedInformation(in extra: Data) -> ExtendedInformation? {
+        var offset = 0
+        while offset + 4 <= extra.count {
+            let id = extra.uint16(at: offset)
+            let length = Int(extra.uint16(at: offset + 2))
+            if id == 0x0001 {
+                return ExtendedInformation(data: extra.subdata(in: (offset + 4)..<min(offset + 4 + length, extra.count)))
+            }
+            offset += 4 + length
+        }
+        return nil
+    }
+
+    private static func read(_ file: FileHandle, at offset: UInt64, count: Int) throws -> Data {
+        try file.seek(toOffset: offset)
+        let data = try file.read(upToCount: count) ?? Data()
+        guard data.count == count else {
+            throw DebugError("Unexpected end of ZIP file")
+        }
+        return data
+    }
+}
+
+/// Reads an entry of a ZIP file chunk by chunk, decrypting it when it is encrypted.
+/// Reading only goes forward; the reader keeps its position between reads.
+final class DRMEntryReader {
+    /// Offset in the decrypted entry of the next chunk
+    private(set) var offset: UInt64 = 0
+    private(set) var isAtEnd = false
+
+    private let location: ZIPEntryLocation
+    private let chunkSize: Int
+    private let file: FileHandle
+    private let decryptor: AdobeDRMDecryptionStream?
+    private var inflater: InputFilter<Data>?
+    /// Bytes of entry data read from the file
+    private var compressedOffset: UInt64 = 0
+    /// Bytes of the encrypted stream read, after inflating
+    private var encryptedOffset: UInt64 = 0
+
+    /// - Parameter decryptor: `nil` for entries that aren't encrypted.
+    init(fileURL: URL, location: ZIPEntryLocation, decryptor: AdobeDRMDecryptionStream?, chunkSize: Int) throws {
+        self.location = location
+        self.decryptor = decryptor
+        self.chunkSize = chunkSize
+        self.file = try FileHandle(forReadingFrom: fileURL)
+        try file.seek(toOffset: location.dataOffset)
+
+        if location.isDeflated {
+            inflater = try InputFilter(.decompress, using: .zlib, bufferCapacity: chunkSize) { [unowned self] length in
+                try self.readCompressed(upTo: length)
+            }
+        }
+    }
+
+    deinit {
+        try? file.close()
+    }
+
+    /// Next decrypted chunk, possibly empty; `nil` at the end of the entry.
+    func next() throws -> Data? {
+        guard !isAtEnd else { return nil }
+
+        let chunk: Data
+        if let inflater {
+            chunk = try inflater.readData(ofLength: chunkSize) ?? Data()
+        } else {
+            chunk = try readCompressed(upTo: chunkSize) ?? Data()
+        }
+        encryptedOffset += UInt64(chunk.count)
+        let isFinal = chunk.isEmpty || encryptedOffset >= location.uncompressedSize
+
+        var decrypted = chunk
+        if let decryptor {
+            guard let data = decryptor.decryptChunk(chunk, final: isFinal) else {
+                throw DebugError(decryptor.error ?? "Failed to decrypt entry")
+            }
+            decrypted = data
+        }
+        offset += UInt64(decrypted.count)
+        isAtEnd = isFinal
+        return decrypted
+    }
+
+    private func readCompressed(upTo length: Int) throws -> Data? {
+        let count = Int(min(UInt64(length), location.compressedSize - compressedOffset))
+        guard count > 0, let data = try file.read(upToCount: count), !data.isEmpty else {
+            return nil
+        }
+        compressedOffset += UInt64(data.count)
+        return data
+    }
+}
+
+private extension Data {
+    func uint16(at offset: Int) -> UInt16 {
+        let start = startIndex + offset
+        return UInt16(self[start]) | UInt16(self[start + 1]) << 8
+    }
+
+    func uint32(at offset: Int) -> UInt32 {
+        UInt32(uint16(at: offset)) | UInt32(uint16(at: offset + 2)) << 16
+    }
+
+    func uint64(at offset: Int) -> UInt64 {
+        UInt64(uint32(at: offset)) | UInt64(uint32(at: offset + 4)) << 32
+    }
+}
+
+#endif
@@ -0,0 +1,216 @@
+//
+//  EPUBSearchIndex.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+import ReadiumShared
+
+/// Full-text index of an EPUB publication, stored encrypted next to the book file.
+///
+/// Holds the text of each HTML resource in the reading order and, for every
+/// folded word, the resources it appears on. Queries scan only resources
+/// containing all their words and return every match at once, instead of
+/// decrypting and scanning the whole book like `Publication.search`.
+struct EPUBSearchIndex: SealedSearchIndex, Equatable {
+    static let currentVersion = 3
+
+    /// Characters of context around a match.
+    private static let snippetLength = 60
+    private static let foldingOptions: String.CompareOptions = [.caseInsensitive, .diacriticInsensitive]
+
+    struct Resource: Codable, Equatable {
+        let href: String
+        let mediaType: String?
+        /// Table of contents title of the resource.
+        let title: String?
+        let text: String
+    }
+
+    let version: Int
+    /// Identifier of the indexed publication, to detect a replaced book.
+    let publicationIdentifier: String?
+    let resources: [Resource]
+    /// Resources containing each folded word.
+    let wordIndex: PostingListIndex
+
+    init(resources: [Resource], publicationIdentifier: String?) {
+        self.version = Self.currentVersion
+        self.publicationIdentifier = publicationIdentifier
+        self.resources = resources
+        self.wordIndex = PostingListIndex(sections: resources.map { [Self.fold($0.text)] })
+    }
+
+    private static func fold(_ text: String) -> String {
+        text.folding(options: foldingOptions, locale: nil)
+    }
+
+    // MARK: - Search
+
+    /// Every match of `query`, in reading order.
+    func search(query: String) -> [Locator] {
+        let query = query.trimmingCharacters(in: .whitespacesAndNewlines)
+        guard !query.isEmpty else { return [] }
+
+        let lengths = resources.map(\.text.count)
+        let totalLength = max(1, lengths.reduce(0, +))
+
+        var locators = [Locator]()
+        for index in wordIndex.candidateSections(for: Self.fold(query)) {
+            let resource = resources[index]
+            guard let href = AnyURL(string: resource.href) else { continue }
+            let mediaType = resource.mediaType.flatMap { MediaType($0) } ?? .xhtml
+            let text = resource.text
+            let lengthBefore = lengths[..<index].reduce(0, +)
+
+            var offset = 0
+            var previousMatch = text.startIndex
+            var searchRange = text.startIndex..<text.endIndex
+            while let match = text.range(of: query, options: Self.foldingOptions, range: searchRange) {
+                offset += text.distance(from: previousMatch, to: match.lowerBound)
+                previousMatch = match.lowerBound
+                let beforeStart = text.index(match.lowerBound, offsetBy: -Self.snippetLength, limitedBy: text.startIndex) ?? text.startIndex
+                let afterEnd = text.index(match.upperBound, offsetBy: Self.snippetLength, limitedBy: text.endIndex) ?? text.endIndex
+                locators.append(Locator(
+                    href: href,
+                    mediaType: mediaType,
+                    title: resource.title,
+                    locations: Locator.Locations(
+                        progression: Double(offset) / Double(max(1, lengths[index])),
+                        totalProgression: Double(lengthBefore + offset) / Double(totalLength)
+                    ),
+                    text: Locator.Text(
+                        after: String(text[match.upperBound..<afterEnd]),
+                        before: String(text[beforeStart..<match.lowerBound]),
+                        highlight: String(text[match])
+                    )
+                ))
+                searchRange = match.upperBound..<text.endIndex
+            }
+        }
+        return locators
+    }
+
+    // MARK: - Storage
+
+    /// Loads an index saved for the publication `publicationIdentifier`.
+    /// - Returns: `nil` if there is none, or it is outdated.
+    static func load(from url: URL, publicationIdentifier: String?) -> EPUBSearchIndex? {
+        loadSealed(from: url).flatMap { $0.publicationIdentifier == publicationIdentifier ? $0 : nil }
+    }
+
+    // MARK: - Indexing
+
+    /// Extracts the text of every HTML resource in the reading order.
+    ///
+    /// Throws `CancellationError` if the task is cancelled.
+    static func build(publication: Publication) async throws -> EPUBSearchIndex {
+        var titles = [String: String]()
+        if case .success(let tableOfContents) = await publication.tableOfContents() {
+            collectTitles(of: tableOfContents, into: &titles)
+        }
+
+        var resources = [Resource]()
+        for link in publication.readingOrder where link.mediaType?.isHTML ?? true {
+            try Task.checkCancellation()
+            guard let resource = publication.get(link) else { continue }
+            switch await resource.readAsString() {
+            case .success(let html):
+                let href = hrefWithoutFragment(link.href)
+                resources.append(Resource(
+                    href: link.href,
+                    mediaType: link.mediaType?.string,
+                    title: titles[href] ?? link.title,
+                    text: plainText(fromHTML: html)
+                ))
+            case .failure(let error):
+                Log.warn(#file, "Skipped EPUB resource in search index: \(error)")
+            }
+        }
+
+        return EPUBSearchIndex(resources: resources, publicationIdentifier: publication.metadata.identifier)
+    }
+
+    /// Loads the index saved at `url`, or builds and saves it.
+    static func loadOrBuild(at url: URL, publication: Publication) async throws -> EPUBSearchIndex {
+        try await loadOrBuild(
+            at: url,
+            isCurrent: { $0.publicationIdentifier == publication.metadata.identifier },
+            build: { try await build(publication: publication) }
+        )
+    }
+
+    private static func collectTitles(of links: [ReadiumShared.Link], into titles: inout [String: String]) {
+        for link in links {
+            let href = hrefWithoutFragment(link.href)
+            if titles[href] == nil, let title = link.title {
+                titles[href] = title
+            }
+            collectTitles(of: link.children, into: &titles)
+        }
+    }
+
+    private static func hrefWithoutFragment(_ href: String) -> String {
+        href.split(separator: "#", maxSplits: 1, omittingEmptySubsequences: false).first.map(String.init) ?? href
+    }
+
+    // MARK: - HTML
+
+    private static let entities: [String: String] = [
+        "amp": "&", "lt": "<", "gt": ">", "quot": "\"", "apos": "'", "nbsp": " ",
+        "mdash": "—", "ndash": "–", "hellip": "…", "lsquo": "‘", "rsquo": "’", "ldquo": "“", "rdquo": "”"
+    ]
+
+    /// Text content of the `body` of an HTML document, with whitespace collapsed.
+    static func plainText(fromHTML html: String) -> String {
+        var source = Substring(html)
+        if let bodyStart = source.range(of: "<body", options: .caseInsensitive) {
+            source = source[bodyStart.lowerBound...]
+        }
+
+        var text = ""
+        text.reserveCapacity(source.utf8.count / 2)
+        var skippedElement: String?
+        var index = source.startIndex
+        while index < source.endIndex {
+            let character = source[index]
+            if character == "<" {
+                guard let tagEnd = source[index...].firstIndex(of: ">") else { break }
+                let tag = source[source.index(after: index)..<tagEnd].lowercased()
+                let name = tag.prefix { !$0.isWhitespace && $0 != "/" }
+                if let skipped = skippedElement {
+                    if tag.hasPrefix("/") && tag.dropFirst().hasPrefix(skipped) {
+                        skippedElement = nil
+                    }
+                } else if name == "script" || name == "style" {
+                    skippedElement = String(name)
+                } else {
+                    // Tags separate words
+                    text.append(" ")
+                }
+                index = source.index(after: tagEnd)
+            } else if skippedElement != nil {
+                index = source.index(after: index)
+            } else if character == "&", let entityEnd = source[index...].prefix(10).firstIndex(of: ";") {
+                let entity = String(source[source.index(after: index)..<entityEnd])
+                text.append(decode(entity: entity) ?? "&\(entity);")
+                index = source.index(after: entityEnd)
+            } else {
+                text.append(character)
+                index = source.index(after: index)
+            }
+        }
+        return text.split(whereSeparator: \.isWhitespace).joined(separator: " ")
+    }
+
+    private static func decode(entity: String) -> String? {
+        if entity.hasPrefix("#") {
+            let number = entity.dropFirst()
+            let value = number.first == "x" || number.first == "X" ? UInt32(number.dropFirst(), radix: 16) : UInt32(number)
+            return value.flatMap(Unicode.Scalar.init).map { String(Character($0)) }
+        }
+        return entities[entity]
+    }
+}
@@ -41,15 +41,26 @@ final class EPUBSearchViewModel: ObservableObject {
     @Published private(set) var sections: [SearchViewSection] = []
 
     private var publication: Publication
+    /// Index built for the book; searches use the publication search service without it.
+    private let searchIndex: EPUBSearchIndex?
     weak var delegate: EPUBSearchDelegate?
 
-    init(publication: Publication) {
+    init(publication: Publication, searchIndex: EPUBSearchIndex? = nil) {
         self.publication = publication
+        self.searchIndex = searchIndex
     }
 
     func search(with query: String) async {
         cancelSearch()
 
+        if let searchIndex {
+            // The index returns every result at once
+            results = searchIndex.search(query: query)
+            groupResults()
+            state = .end
+            return
+        }
+
         state = .starting
         let result = await publication.search(query: query)
         switch result {
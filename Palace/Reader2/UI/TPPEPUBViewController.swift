@@ -22,6 +22,10 @@ class TPPEPUBViewController: TPPBaseReaderViewController {
     private var keyboardDisconnectObserver: NSObjectProtocol?
     private var isShiftPressed = false
     private lazy var keyboardNavigationHandler = KeyboardNavigationHandler(navigable: self)
+    /// Location of the persistent search index, next to the book file.
+    private let searchIndexURL: URL?
+    private var searchIndexTask: Task<EPUBSearchIndex?, Never>?
+    private var searchIndex: EPUBSearchIndex?
 
     init(publication: Publication,
          book: TPPBook,
@@ -32,6 +36,7 @@ class TPPEPUBViewController: TPPBaseReaderViewController {
 
         self.systemUserInterfaceStyle = UITraitCollection.current.userInterfaceStyle
         self.preferences = preferences
+        self.searchIndexURL = forSample ? nil : MyBooksDownloadCenter.shared.fileUrl(for: book.identifier).map(EPUBSearchIndex.url(forBookAt:))
 
         self.searchButton = UIBarButtonItem(barButtonSystemItem: .search, target: nil, action: #selector(presentEPUBSearch))
         self.searchButton.accessibilityLabel = Strings.Generic.searchInBook
@@ -100,6 +105,10 @@ class TPPEPUBViewController: TPPBaseReaderViewController {
         log(.info, "TPPEPUBViewController initialized with publication: \(publication.metadata.title ?? "Unknown Title").")
     }
 
+    deinit {
+        searchIndexTask?.cancel()
+    }
+
     var epubNavigator: EPUBNavigatorViewController {
         self.navigator as! EPUBNavigatorViewController
     }
@@ -124,6 +133,22 @@ class TPPEPUBViewController: TPPBaseReaderViewController {
         // FKA intercepts arrow keys at the system level for focus navigation.
         // Users can press Tab-Z to access these custom actions for page turning.
         configureAccessibilityActions()
+
+        prepareSearchIndex()
+    }
+
+    /// Loads the search index, or builds it in the background on first open.
+    private func prepareSearchIndex() {
+        guard let searchIndexURL else { return }
+        let publication = publication
+        let task = Task.detached(priority: .utility) {
+            try? await EPUBSearchIndex.loadOrBuild(at: searchIndexURL, publication: publication)
+        }
+        searchIndexTask = task
+        Task { @MainActor [weak self] in
+            let searchIndex = await task.value
+            self?.searchIndex = searchIndex
+        }
     }
 
     // MARK: - Accessibility (Full Keyboard Access support)
@@ -450,7 +475,7 @@ class TPPEPUBViewController: TPPBaseReaderViewController {
     }
 
     @objc private func presentEPUBSearch() {
-        let searchViewModel = EPUBSearchViewModel(publication: publication)
+        let searchViewModel = EPUBSearchViewModel(publication: publication, searchIndex: searchIndex)
         searchViewModel.delegate = self
         let searchView = EPUBSearchView(viewModel: searchViewModel)
         let hostingController = UIHostingController(rootView: searchView)
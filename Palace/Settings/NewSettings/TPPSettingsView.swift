@@ -73,7 +73,10 @@ struct TPPSettingsView: View {
             updateAccountsList()
             librariesRefreshToken = UUID()
         }
-        .onReceive(NotificationCenter.default.publisher(for: .TPPBookRegistryDidChange)) { _ in
+        .onReceive(
+            NotificationCenter.default.publisher(for: .TPPBookRegistryDidChange)
+                .filter { !($0.bookRegistryChange?.isLocationOnly ?? false) }
+        ) { _ in
             updateAccountsList()
             librariesRefreshToken = UUID()
         }
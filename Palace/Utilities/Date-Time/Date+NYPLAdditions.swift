@@ -41,19 +41,10 @@ public extension Date {
         return Date.rfc1123DateFormatter.string(from: self)
     }
 
-    /// A static date formatter to get date strings formatted per RFC 339
-    /// without incurring in the high cost of creating a new DateFormatter
-    /// each time, which would be ~300% more expensive.
-    static let rfc339StringFormatter: DateFormatter = {
-        let df = DateFormatter()
-        df.locale = Locale(identifier: "en_US_POSIX")
-        df.timeZone = TimeZone(identifier: "GMT")
-        df.dateFormat = "yyyy'-'MM'-'dd'T'HH':'mm':'ss'Z'"
-        return df
-    }()
-
+    /// A date string formatted per RFC 3339 in UTC, without fractional seconds.
+    /// Example: 2020-03-25T01:23:45Z
     var rfc339String: String {
-        return Date.rfc339StringFormatter.string(from: self)
+        return (self as NSDate).rfc3339String()
     }
 
     /// A date string with the choice of short or long suffix
@@ -1,5 +1,178 @@
 #import "NSDate+NYPLDateAdditions.h"
 
+#pragma mark - Parsing and formatting kernel
+
+// OPDS feeds, availability and the book registry only use a couple of date formats. They are
+// parsed and formatted here by hand, without allocating; anything unusual is left to
+// NSDateFormatter.
+
+/// Longest date string handled by the kernel, e.g. "2020-01-22T10:00:00.123456789+02:00".
+static NSUInteger const TPPDateMaxLength = 48;
+
+static int64_t const TPPDateSecondsPerDay = 86400;
+
+/// Days since 1970-01-01 in the proleptic Gregorian calendar.
+static int64_t TPPDateDaysFromCivil(int64_t year, unsigned const month, unsigned const day)
+{
+  year -= month <= 2;
+  int64_t const era = (year >= 0 ? year : year - 399) / 400;
+  unsigned const yearOfEra = (unsigned)(year - era * 400);
+  unsigned const dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  unsigned const dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  return era * 146097 + (int64_t)dayOfEra - 719468;
+}
+
+/// Inverse of @c TPPDateDaysFromCivil.
+static void TPPDateCivilFromDays(int64_t days, int64_t *const year, unsigned *const month, unsigned *const day)
+{
+  days += 719468;
+  int64_t const era = (days >= 0 ? days : days - 146096) / 146097;
+  unsigned const dayOfEra = (unsigned)(days - era * 146097);
+  unsigned const yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+  unsigned const dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  unsigned const shiftedMonth = (5 * dayOfYear + 2) / 153;
+  *day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+  *month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+  *year = (int64_t)yearOfEra + era * 400 + (*month <= 2);
+}
+
+static unsigned TPPDateDaysInMonth(int64_t const year, unsigned const month)
+{
+  static unsigned const days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  if(month == 2 && year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) {
+    return 29;
+  }
+  return days[month - 1];
+}
+
+/// Reads @c count decimal digits at @c characters.
+static BOOL TPPDateReadDigits(const unichar *const characters, unsigned const count, unsigned *const value)
+{
+  unsigned result = 0;
+  for(unsigned i = 0; i < count; i++) {
+    unichar const c = characters[i];
+    if(c < '0' || c > '9') return NO;
+    result = result * 10 + (c - '0');
+  }
+  *value = result;
+  return YES;
+}
+
+/// Copies the UTF-16 contents of @c string to @c buffer if it could be a date.
+static NSUInteger TPPDateGetCharacters(NSString *const string, unichar buffer[TPPDateMaxLength])
+{
+  NSUInteger const length = string.length;
+  if(length == 0 || length > TPPDateMaxLength) return 0;
+  [string getCharacters:buffer range:NSMakeRange(0, length)];
+  return length;
+}
+
+/// Parses "YYYY-MM-DD" at the start of @c characters.
+static BOOL TPPDateParseFullDate(const unichar *const characters, NSUInteger const length, int64_t *const days)
+{
+  unsigned year, month, day;
+  if(length < 10
+     || !TPPDateReadDigits(characters, 4, &year) || characters[4] != '-'
+     || !TPPDateReadDigits(characters + 5, 2, &month) || characters[7] != '-'
+     || !TPPDateReadDigits(characters + 8, 2, &day)) {
+    return NO;
+  }
+  if(month < 1 || month > 12 || day < 1 || day > TPPDateDaysInMonth(year, month)) {
+    return NO;
+  }
+  *days = TPPDateDaysFromCivil(year, month, day);
+  return YES;
+}
+
+/// Parses "YYYY-MM-DDTHH:MM:SS[.F+](Z|+HH:MM|-HH:MM|+HHMM|-HHMM)".
+static BOOL TPPDateParseRFC3339(const unichar *const characters, NSUInteger const length,
+                                NSTimeInterval *const interval)
+{
+  int64_t days;
+  unsigned hour, minute, second;
+  if(!TPPDateParseFullDate(characters, length, &days)
+     || length < 20 || characters[10] != 'T'
+     || !TPPDateReadDigits(characters + 11, 2, &hour) || characters[13] != ':'
+     || !TPPDateReadDigits(characters + 14, 2, &minute) || characters[16] != ':'
+     || !TPPDateReadDigits(characters + 17, 2, &second)) {
+    return NO;
+  }
+  // Leap seconds are left to the formatter.
+  if(hour > 23 || minute > 59 || second > 59) return NO;
+
+  NSUInteger i = 19;
+  double fraction = 0;
+  if(characters[i] == '.') {
+    double scale = 0.1;
+    NSUInteger const start = ++i;
+    for(; i < length && characters[i] >= '0' && characters[i] <= '9'; i++) {
+      fraction += (characters[i] - '0') * scale;
+      scale /= 10;
+    }
+    if(i == start || i == length) return NO;
+  }
+
+  int offset = 0;
+  if(characters[i] == 'Z') {
+    i++;
+  } else if(characters[i] == '+' || characters[i] == '-') {
+    int const sign = characters[i] == '-' ? -1 : 1;
+    unsigned offsetHours, offsetMinutes;
+    i++;
+    if(i + 2 > length || !TPPDateReadDigits(characters + i, 2, &offsetHours)) return NO;
+    i += 2;
+    if(i < length && characters[i] == ':') i++;
+    if(i + 2 > length || !TPPDateReadDigits(characters + i, 2, &offsetMinutes)) return NO;
+    i += 2;
+    if(offsetHours > 23 || offsetMinutes > 59) return NO;
+    offset = sign * (int)(offsetHours * 3600 + offsetMinutes * 60);
+  } else {
+    return NO;
+  }
+  if(i != length) return NO;
+
+  int64_t const seconds = days * TPPDateSecondsPerDay + hour * 3600 + minute * 60 + second - offset;
+  *interval = (NSTimeInterval)seconds + fraction;
+  return YES;
+}
+
+/// Writes @c interval as "YYYY-MM-DDTHH:MM:SSZ", truncating fractional seconds.
+/// @return The length of the string, or 0 if the date is out of the range of four-digit years.
+static NSUInteger TPPDateFormatRFC3339(NSTimeInterval const interval, char buffer[20])
+{
+  if(!isfinite(interval)) return 0;
+  double const wholeSeconds = floor(interval);
+  // Years 0000 through 9999
+  if(wholeSeconds < -62167219200.0 || wholeSeconds >= 253402300800.0) return 0;
+
+  int64_t const seconds = (int64_t)wholeSeconds;
+  int64_t days = seconds / TPPDateSecondsPerDay;
+  int64_t secondOfDay = seconds % TPPDateSecondsPerDay;
+  if(secondOfDay < 0) {
+    secondOfDay += TPPDateSecondsPerDay;
+    days--;
+  }
+
+  int64_t year;
+  unsigned month, day;
+  TPPDateCivilFromDays(days, &year, &month, &day);
+  unsigned const hour = (unsigned)(secondOfDay / 3600);
+  unsigned const minute = (unsigned)(secondOfDay / 60 % 60);
+  unsigned const second = (unsigned)(secondOfDay % 60);
+
+  unsigned const fields[] = {(unsigned)year / 100, (unsigned)year % 100, month, day, hour, minute, second};
+  static char const separators[] = {0, '-', '-', 'T', ':', ':', 'Z'};
+  NSUInteger length = 0;
+  for(unsigned i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+    buffer[length++] = (char)('0' + fields[i] / 10);
+    buffer[length++] = (char)('0' + fields[i] % 10);
+    if(separators[i]) buffer[length++] = separators[i];
+  }
+  return length;
+}
+
+#pragma mark -
+
 @implementation NSDate (TPPDateAdditions)
 
 + (NSDate *)dateWithRFC3339String:(NSString *const)string
@@ -9,20 +182,33 @@
     return nil;
   }
 
+  unichar characters[TPPDateMaxLength];
+  NSUInteger const length = TPPDateGetCharacters(string, characters);
+  NSTimeInterval interval;
+  if(length && TPPDateParseRFC3339(characters, length, &interval)) {
+    return [NSDate dateWithTimeIntervalSince1970:interval];
+  }
+
+  // Formatters are never mutated after setup so that they can be shared between threads.
   static NSDateFormatter *dateFormatter;
+  static NSDateFormatter *fractionalDateFormatter;
   static dispatch_once_t onceToken;
   dispatch_once(&onceToken, ^{
     dateFormatter = [[NSDateFormatter alloc] init];
     dateFormatter.locale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
     dateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    dateFormatter.dateFormat = @"yyyy'-'MM'-'dd'T'HH':'mm':'ssX5";
+
+    fractionalDateFormatter = [[NSDateFormatter alloc] init];
+    fractionalDateFormatter.locale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+    fractionalDateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    fractionalDateFormatter.dateFormat = @"yyyy'-'MM'-'dd'T'HH':'mm':'ss.SSSSSSX5";
   });
 
-  dateFormatter.dateFormat = @"yyyy'-'MM'-'dd'T'HH':'mm':'ssX5";
   NSDate *const date = [dateFormatter dateFromString:string];
   
   if(!date) {
-    dateFormatter.dateFormat = @"yyyy'-'MM'-'dd'T'HH':'mm':'ss.SSSSSSX5";
-    return [dateFormatter dateFromString:string];
+    return [fractionalDateFormatter dateFromString:string];
   }
   
   return date;
@@ -35,18 +221,32 @@
     return nil;
   }
 
-  NSDate *date;
-  NSISO8601DateFormatter *const ISODateFormatter = [[NSISO8601DateFormatter alloc] init];
+  // Like NSISO8601DateFormatter with only the full date option, a time after the
+  // date is ignored.
+  unichar characters[TPPDateMaxLength];
+  NSUInteger const length = TPPDateGetCharacters(string, characters);
+  int64_t days;
+  if(length >= 10 && (length == 10 || characters[10] == 'T') && TPPDateParseFullDate(characters, length, &days)) {
+    return [NSDate dateWithTimeIntervalSince1970:(NSTimeInterval)(days * TPPDateSecondsPerDay)];
+  }
 
-  ISODateFormatter.formatOptions = NSISO8601DateFormatWithFullDate;
-  ISODateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+  // Formatters are never mutated after setup so that they can be shared between threads.
+  static NSISO8601DateFormatter *ISODateFormatter;
+  static NSDateFormatter *yearFormatter;
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    ISODateFormatter = [[NSISO8601DateFormatter alloc] init];
+    ISODateFormatter.formatOptions = NSISO8601DateFormatWithFullDate;
+    ISODateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+
+    yearFormatter = [[NSDateFormatter alloc] init];
+    yearFormatter.dateFormat = @"yyyy";
+  });
 
-  date = [ISODateFormatter dateFromString:string];
+  NSDate *const date = [ISODateFormatter dateFromString:string];
 
   if(!date) {
-    NSDateFormatter *const dateFormatter = [[NSDateFormatter alloc] init];
-    dateFormatter.dateFormat = @"yyyy";
-    return [dateFormatter dateFromString:string];
+    return [yearFormatter dateFromString:string];
   }
 
   return date;
@@ -54,6 +254,12 @@
 
 - (NSString *)RFC3339String
 {
+  char buffer[20];
+  NSUInteger const length = TPPDateFormatRFC3339(self.timeIntervalSince1970, buffer);
+  if(length) {
+    return [[NSString alloc] initWithBytes:buffer length:length encoding:NSASCIIStringEncoding];
+  }
+
   static NSDateFormatter *dateFormatter;
   static dispatch_once_t onceToken;
   dispatch_once(&onceToken, ^{
@@ -1,3 +1,5 @@
+import Foundation
+
 extension Array {
     subscript(safe index: Int) -> Element? {
         get {
@@ -10,3 +12,29 @@ extension Array {
         }
     }
 }
+
+extension Array {
+    /// Returns the results of calling `transform` on every element, in order.
+    ///
+    /// Large arrays are split into contiguous ranges that are transformed
+    /// concurrently on all cores, so `transform` must be safe to call from
+    /// multiple threads. Small arrays are transformed on the calling thread.
+    func concurrentMap<T>(minimumConcurrentCount: Int = 32, _ transform: (Element) -> T) -> [T] {
+        guard count >= minimumConcurrentCount else {
+            return map(transform)
+        }
+
+        // A few ranges per core even out elements of different sizes.
+        let rangeCount = Swift.min(count, ProcessInfo.processInfo.activeProcessorCount * 4)
+        var results = [T?](repeating: nil, count: count)
+        results.withUnsafeMutableBufferPointer { buffer in
+            let results = buffer
+            DispatchQueue.concurrentPerform(iterations: rangeCount) { range in
+                for index in (range * count / rangeCount)..<((range + 1) * count / rangeCount) {
+                    results[index] = transform(self[index])
+                }
+            }
+        }
+        return results.map { $0! }
+    }
+}
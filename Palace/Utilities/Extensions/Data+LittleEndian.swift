@@ -0,0 +1,24 @@
+//
+//  Data+LittleEndian.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Fixed-width integers in the little-endian binary formats of the on-disk caches.
+extension Data {
+    mutating func appendLittleEndian<T: FixedWidthInteger>(_ value: T) {
+        Swift.withUnsafeBytes(of: value.littleEndian) { append(contentsOf: $0) }
+    }
+
+    /// Reads a value at `offset` from the start of the data.
+    func readLittleEndian<T: FixedWidthInteger>(_ type: T.Type, at offset: Int) -> T {
+        var value = T.zero
+        Swift.withUnsafeMutableBytes(of: &value) { buffer in
+            _ = copyBytes(to: buffer, from: startIndex + offset..<startIndex + offset + MemoryLayout<T>.size)
+        }
+        return T(littleEndian: value)
+    }
+}
@@ -0,0 +1,417 @@
+import Foundation
+import os
+
+/// Log-structured disk storage for `GeneralCache`.
+///
+/// Values are appended to a few large segment files instead of one file per
+/// key. An in-memory index maps each key to its record, and segments are
+/// memory-mapped for reads, so a lookup costs no file system calls. Values
+/// are copied out of the mapping because segments are truncated and deleted
+/// while callers may still hold them. Removing a key appends a tombstone.
+/// When the segments outgrow `maxBytes`, the oldest segment is dropped in the
+/// background, keeping the records read since they were written; segments
+/// that are mostly stale are rewritten.
+final class CacheSegmentStore {
+
+    private struct Location {
+        let segment: Int
+        /// Offset of the value in the segment.
+        let offset: Int
+        let length: Int
+        let expiration: Date?
+        /// Read since it was written, so kept when its segment is evicted.
+        var isReferenced = false
+
+        var isExpired: Bool {
+            expiration.map { $0 < Date() } ?? false
+        }
+    }
+
+    /// A write not appended yet; `value` is `nil` for a removal.
+    private struct PendingWrite {
+        let value: Data?
+        let expiration: Date?
+        let id: UInt64
+    }
+
+    private struct State {
+        var index = [String: Location]()
+        /// Segments holding the tombstone of each removed key.
+        var tombstones = [String: Int]()
+        var pendingWrites = [String: PendingWrite]()
+        var nextWriteID: UInt64 = 0
+        /// Mapped segment contents, remapped when a read goes past the end.
+        var mappedSegments = [Int: Data]()
+        /// Bytes of each segment file.
+        var segmentSizes = [Int: Int]()
+        /// Bytes of current records in each segment.
+        var liveSizes = [Int: Int]()
+        var activeSegment = 0
+        var isCompactionScheduled = false
+
+        var totalSize: Int {
+            segmentSizes.values.reduce(0, +)
+        }
+    }
+
+    /// Key length (4 bytes), value length (4), expiration (8), flags (4).
+    private static let recordHeaderLength = 20
+    private static let tombstoneFlag: UInt32 = 1
+    private static let segmentExtension = "segment"
+
+    let directory: URL
+    let maxBytes: Int
+    let segmentBytes: Int
+
+    private let state = OSAllocatedUnfairLock(uncheckedState: State())
+    private let writeQueue = DispatchQueue(label: "org.thepalaceproject.palace.cacheSegmentStore", qos: .utility)
+    private var activeHandle: FileHandle?
+
+    /// Opens the segments in `directory`, rebuilding the index from them.
+    /// - Parameters:
+    ///   - maxBytes: Size of all segments that triggers eviction
+    ///   - segmentBytes: Size at which a new segment is started
+    init(directory: URL, maxBytes: Int, segmentBytes: Int = 8 * 1024 * 1024) {
+        self.directory = directory
+        self.maxBytes = maxBytes
+        self.segmentBytes = min(segmentBytes, max(1, maxBytes / 4))
+        try? FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+
+        var state = State()
+        for segment in Self.segmentNumbers(in: directory) {
+            Self.load(segment: segment, in: directory, into: &state)
+            state.activeSegment = segment
+        }
+        self.state.withLockUnchecked { $0 = state }
+    }
+
+    deinit {
+        try? activeHandle?.close()
+    }
+
+    var count: Int {
+        state.withLockUnchecked { $0.index.count }
+    }
+
+    /// Size of all segment files.
+    var totalSize: Int {
+        state.withLockUnchecked { $0.totalSize }
+    }
+
+    // MARK: - Reading
+
+    private enum Lookup {
+        case pending(Data, expiration: Date?)
+        case stored(Location, mapped: Data?)
+    }
+
+    /// Stored value of `key`, or `nil` if there is none or it expired.
+    func data(for key: String) -> Data? {
+        record(for: key)?.data
+    }
+
+    /// Stored value of `key` and its expiration date.
+    func record(for key: String) -> (data: Data, expiration: Date?)? {
+        let lookup = state.withLockUnchecked { state -> Lookup? in
+            if let pending = state.pendingWrites[key] {
+                let isExpired = pending.expiration.map { $0 < Date() } ?? false
+                guard let value = pending.value, !isExpired else { return nil }
+                return .pending(value, expiration: pending.expiration)
+            }
+            guard var location = state.index[key] else { return nil }
+            if location.isExpired {
+                state.index.removeValue(forKey: key)
+                state.liveSizes[location.segment, default: 0] -= Self.recordLength(key: key, valueLength: location.length)
+                return nil
+            }
+            location.isReferenced = true
+            state.index[key] = location
+            return .stored(location, mapped: state.mappedSegments[location.segment])
+        }
+
+        switch lookup {
+        case nil:
+            return nil
+        case let .pending(value, expiration):
+            return (value, expiration)
+        case let .stored(location, mapped):
+            let end = location.offset + location.length
+            var segmentData = mapped
+            if (segmentData?.count ?? 0) < end {
+                // Map again to see records appended since the last mapping.
+                segmentData = try? Data(contentsOf: segmentURL(location.segment), options: .alwaysMapped)
+                if let segmentData {
+                    state.withLockUnchecked { $0.mappedSegments[location.segment] = segmentData }
+                }
+            }
+            guard let segmentData, segmentData.count >= end else { return nil }
+            return (segmentData.subdata(in: segmentData.startIndex + location.offset..<segmentData.startIndex + end), location.expiration)
+        }
+    }
+
+    // MARK: - Writing
+
+    /// Appends a value in the background; it can be read back right away.
+    func set(_ value: Data, for key: String, expiration: Date?) {
+        enqueueWrite(key: key, value: value, expiration: expiration)
+    }
+
+    func remove(_ key: String) {
+        enqueueWrite(key: key, value: nil, expiration: nil)
+    }
+
+    /// Removes every segment.
+    func removeAll() {
+        writeQueue.sync {
+            try? activeHandle?.close()
+            activeHandle = nil
+            let segments = state.withLockUnchecked { state -> [Int] in
+                let segments = Array(state.segmentSizes.keys)
+                state = State()
+                return segments
+            }
+            for segment in segments {
+                try? FileManager.default.removeItem(at: segmentURL(segment))
+            }
+        }
+    }
+
+    /// Waits for queued writes and compaction to finish.
+    func waitForWrites() {
+        repeat {
+            writeQueue.sync {}
+        } while state.withLockUnchecked({ $0.isCompactionScheduled })
+    }
+
+    private func enqueueWrite(key: String, value: Data?, expiration: Date?) {
+        let id = state.withLockUnchecked { state -> UInt64 in
+            state.nextWriteID += 1
+            state.pendingWrites[key] = PendingWrite(value: value, expiration: expiration, id: state.nextWriteID)
+            return state.nextWriteID
+        }
+        writeQueue.async { [weak self] in
+            guard let self else { return }
+            if let value {
+                self.append(key: key, value: value, expiration: expiration, isTombstone: false)
+            } else if self.state.withLockUnchecked({ $0.index[key] != nil }) {
+                self.append(key: key, value: Data(), expiration: nil, isTombstone: true)
+            }
+            self.state.withLockUnchecked { state in
+                if state.pendingWrites[key]?.id == id {
+                    state.pendingWrites.removeValue(forKey: key)
+                }
+            }
+            self.scheduleCompactionIfNeeded()
+        }
+    }
+
+    private func append(key: String, value: Data, expiration: Date?, isTombstone: Bool) {
+        let keyData = Data(key.utf8)
+        var record = Data(capacity: Self.recordHeaderLength + keyData.count + value.count)
+        record.appendLittleEndian(UInt32(keyData.count))
+        record.appendLittleEndian(UInt32(value.count))
+        record.appendLittleEndian((expiration?.timeIntervalSince1970 ?? 0).bitPattern)
+        record.appendLittleEndian(isTombstone ? Self.tombstoneFlag : 0)
+        record.append(keyData)
+        record.append(value)
+
+        do {
+            let (segment, handle) = try activeSegmentHandle(adding: record.count)
+            let offset = Int(try handle.offset())
+            try handle.write(contentsOf: record)
+            state.withLockUnchecked { state in
+                state.segmentSizes[segment] = offset + record.count
+                if let previous = state.index.removeValue(forKey: key) {
+                    state.liveSizes[previous.segment, default: 0] -= Self.recordLength(key: key, valueLength: previous.length)
+                }
+                if isTombstone {
+                    state.tombstones[key] = segment
+                } else {
+                    state.tombstones.removeValue(forKey: key)
+                    state.index[key] = Location(
+                        segment: segment,
+                        offset: offset + Self.recordHeaderLength + keyData.count,
+                        length: value.count,
+                        expiration: expiration
+                    )
+                    state.liveSizes[segment, default: 0] += record.count
+                }
+            }
+        } catch {
+            Log.error(#file, "Cache segment write failed: \(error.localizedDescription)")
+        }
+    }
+
+    /// Handle of the segment to append to, starting a new one when it is full.
+    private func activeSegmentHandle(adding length: Int) throws -> (Int, FileHandle) {
+        var (segment, size) = state.withLockUnchecked { ($0.activeSegment, $0.segmentSizes[$0.activeSegment] ?? 0) }
+        if size > 0 && size + length > segmentBytes {
+            try? activeHandle?.close()
+            activeHandle = nil
+            segment += 1
+            size = 0
+            state.withLockUnchecked { $0.activeSegment = segment }
+        }
+        if let activeHandle {
+            return (segment, activeHandle)
+        }
+        let url = segmentURL(segment)
+        if !FileManager.default.fileExists(atPath: url.path) {
+            FileManager.default.createFile(atPath: url.path, contents: nil)
+        }
+        let handle = try FileHandle(forWritingTo: url)
+        try handle.seekToEnd()
+        activeHandle = handle
+        return (segment, handle)
+    }
+
+    // MARK: - Compaction
+
+    /// Starts compacting on the write queue, one segment at a time so
+    /// writes aren't held up.
+    private func scheduleCompactionIfNeeded() {
+        let isNeeded = state.withLockUnchecked { state -> Bool in
+            guard !state.isCompactionScheduled, Self.nextCompaction(in: state, maxBytes: maxBytes) != nil else {
+                return false
+            }
+            state.isCompactionScheduled = true
+            return true
+        }
+        if isNeeded {
+            writeQueue.async { [weak self] in
+                self?.compactNextSegment()
+            }
+        }
+    }
+
+    /// A sealed segment with less than a quarter of its bytes current.
+    private static func staleSegment(in state: State) -> Int? {
+        state.segmentSizes
+            .filter { $0.key != state.activeSegment && $0.value > 0 && (state.liveSizes[$0.key] ?? 0) * 4 < $0.value }
+            .map(\.key)
+            .min()
+    }
+
+    /// Segment to evict while the store is too large, then stale segments.
+    private static func nextCompaction(in state: State, maxBytes: Int) -> (segment: Int, isEviction: Bool)? {
+        if state.totalSize > maxBytes,
+           let oldest = state.segmentSizes.keys.filter({ $0 != state.activeSegment }).min() {
+            return (oldest, true)
+        }
+        return staleSegment(in: state).map { ($0, false) }
+    }
+
+    private func compactNextSegment() {
+        let next = state.withLockUnchecked { state -> (segment: Int, isEviction: Bool)? in
+            guard let next = Self.nextCompaction(in: state, maxBytes: maxBytes) else {
+                state.isCompactionScheduled = false
+                return nil
+            }
+            return next
+        }
+        guard let next else {
+            Log.debug(#file, "Cache segments compacted to \(totalSize) bytes")
+            return
+        }
+        rewrite(segment: next.segment, keepingOnlyReferenced: next.isEviction)
+        writeQueue.async { [weak self] in
+            self?.compactNextSegment()
+        }
+    }
+
+    /// Moves current records of `segment` to the active segment and deletes it.
+    private func rewrite(segment: Int, keepingOnlyReferenced: Bool) {
+        let (records, tombstones, mapped) = state.withLockUnchecked { state -> ([(String, Location)], [String], Data?) in
+            let records = state.index.filter { $0.value.segment == segment }.map { ($0.key, $0.value) }
+            // Tombstones are only needed while older segments may hold their keys.
+            let hasOlderSegments = state.segmentSizes.keys.contains { $0 < segment }
+            let tombstones = hasOlderSegments ? state.tombstones.filter { $0.value == segment }.map(\.key) : []
+            return (records, tombstones, state.mappedSegments[segment])
+        }
+        let segmentData = mapped ?? (try? Data(contentsOf: segmentURL(segment), options: .alwaysMapped))
+
+        for (key, location) in records where !location.isExpired && (!keepingOnlyReferenced || location.isReferenced) {
+            guard let segmentData, segmentData.count >= location.offset + location.length else { continue }
+            let start = segmentData.startIndex + location.offset
+            let value = segmentData.subdata(in: start..<start + location.length)
+            // Still current if nothing replaced it meanwhile
+            guard state.withLockUnchecked({ $0.index[key]?.segment == segment }) else { continue }
+            append(key: key, value: value, expiration: location.expiration, isTombstone: false)
+        }
+        for key in tombstones where state.withLockUnchecked({ $0.tombstones[key] == segment }) {
+            append(key: key, value: Data(), expiration: nil, isTombstone: true)
+        }
+
+        state.withLockUnchecked { state in
+            state.index = state.index.filter { $0.value.segment != segment }
+            state.tombstones = state.tombstones.filter { $0.value != segment }
+            state.mappedSegments.removeValue(forKey: segment)
+            state.segmentSizes.removeValue(forKey: segment)
+            state.liveSizes.removeValue(forKey: segment)
+        }
+        // Mappings held by readers stay valid after the file is deleted.
+        try? FileManager.default.removeItem(at: segmentURL(segment))
+    }
+
+    // MARK: - Files
+
+    private func segmentURL(_ segment: Int) -> URL {
+        directory.appendingPathComponent(String(format: "%08d", segment)).appendingPathExtension(Self.segmentExtension)
+    }
+
+    private static func segmentNumbers(in directory: URL) -> [Int] {
+        let urls = (try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: nil)) ?? []
+        return urls
+            .filter { $0.pathExtension == segmentExtension }
+            .compactMap { Int($0.deletingPathExtension().lastPathComponent) }
+            .sorted()
+    }
+
+    private static func recordLength(key: String, valueLength: Int) -> Int {
+        recordHeaderLength + key.utf8.count + valueLength
+    }
+
+    /// Adds the records of a segment file to the index, in write order,
+    /// truncating a record cut short by a crash.
+    private static func load(segment: Int, in directory: URL, into state: inout State) {
+        let url = directory.appendingPathComponent(String(format: "%08d", segment)).appendingPathExtension(segmentExtension)
+        guard let data = try? Data(contentsOf: url, options: .alwaysMapped) else { return }
+
+        var offset = 0
+        while offset + recordHeaderLength <= data.count {
+            let keyLength = Int(data.readLittleEndian(UInt32.self, at: offset))
+            let valueLength = Int(data.readLittleEndian(UInt32.self, at: offset + 4))
+            let expiration = Double(bitPattern: data.readLittleEndian(UInt64.self, at: offset + 8))
+            let flags = data.readLittleEndian(UInt32.self, at: offset + 16)
+            let keyStart = offset + recordHeaderLength
+            let end = keyStart + keyLength + valueLength
+            guard end <= data.count,
+                  let key = String(data: data.subdata(in: data.startIndex + keyStart..<data.startIndex + keyStart + keyLength), encoding: .utf8) else {
+                break
+            }
+
+            if let previous = state.index.removeValue(forKey: key) {
+                state.liveSizes[previous.segment, default: 0] -= recordLength(key: key, valueLength: previous.length)
+            }
+            if flags & tombstoneFlag != 0 {
+                state.tombstones[key] = segment
+            } else {
+                state.tombstones.removeValue(forKey: key)
+                state.index[key] = Location(
+                    segment: segment,
+                    offset: keyStart + keyLength,
+                    length: valueLength,
+                    expiration: expiration > 0 ? Date(timeIntervalSince1970: expiration) : nil
+                )
+                state.liveSizes[segment, default: 0] += end - offset
+            }
+            offset = end
+        }
+
+        if offset < data.count {
+            try? FileHandle(forWritingTo: url).truncate(atOffset: UInt64(offset))
+        }
+        state.segmentSizes[segment] = offset
+        state.mappedSegments[segment] = data
+    }
+}
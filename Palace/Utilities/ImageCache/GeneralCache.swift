@@ -17,12 +17,21 @@ public enum CachePolicy {
     case noCache
 }
 
+public enum CacheDiskStorage {
+    /// One file per key
+    case files
+    /// Entries appended to memory-mapped segment files, evicting the oldest
+    /// ones not read recently once the segments outgrow `maxBytes`
+    case segments(maxBytes: Int)
+}
+
 public final class GeneralCache<Key: Hashable & Codable, Value: Codable> {
     private let memoryCache = NSCache<WrappedKey, Entry>()
     private let fileManager = FileManager.default
     private let cacheDirectory: URL
     private let queue = DispatchQueue(label: "com.Palace.GeneralCache", attributes: .concurrent)
     private let mode: CachingMode
+    private let segmentStore: CacheSegmentStore?
     private var memoryWarningObserver: NSObjectProtocol?
 
     private final class Entry: Codable {
@@ -48,11 +57,16 @@ public final class GeneralCache<Key: Hashable & Codable, Value: Codable> {
         }
     }
 
-    public init(cacheName: String = "GeneralCache", mode: CachingMode = .memoryAndDisk) {
+    public init(cacheName: String = "GeneralCache", mode: CachingMode = .memoryAndDisk, diskStorage: CacheDiskStorage = .files) {
         self.mode = mode
         let cachesDir = fileManager.urls(for: .cachesDirectory, in: .userDomainMask).first!
         cacheDirectory = cachesDir.appendingPathComponent(cacheName, isDirectory: true)
         try? fileManager.createDirectory(at: cacheDirectory, withIntermediateDirectories: true)
+        if case .segments(let maxBytes) = diskStorage, mode == .diskOnly || mode == .memoryAndDisk {
+            segmentStore = CacheSegmentStore(directory: cacheDirectory, maxBytes: maxBytes)
+        } else {
+            segmentStore = nil
+        }
 
         configureCacheLimits()
         setupMemoryWarningHandler()
@@ -131,6 +145,9 @@ public final class GeneralCache<Key: Hashable & Codable, Value: Codable> {
                 return entry.value
             }
             if mode == .memoryOnly { return nil }
+            if let segmentStore {
+                return segmentValue(for: key, in: segmentStore)
+            }
             let url = fileURL(for: key)
             do {
                 let attrs = try fileManager.attributesOfItem(atPath: url.path)
@@ -166,6 +183,24 @@ public final class GeneralCache<Key: Hashable & Codable, Value: Codable> {
         }
     }
 
+    private func segmentValue(for key: Key, in segmentStore: CacheSegmentStore) -> Value? {
+        guard let record = segmentStore.record(for: segmentKey(for: key)) else { return nil }
+        let raw = record.data
+        let value: Value
+        if Value.self == Data.self, let d = raw as? Value {
+            value = d
+        } else {
+            guard let diskEntry = try? JSONDecoder().decode(Entry.self, from: raw), !diskEntry.isExpired else {
+                return nil
+            }
+            value = diskEntry.value
+        }
+        if mode == .memoryAndDisk {
+            memoryCache.setObject(Entry(value: value, expiration: record.expiration), forKey: WrappedKey(key), cost: estimatedCost(for: value))
+        }
+        return value
+    }
+
     @discardableResult
     public func get(_ key: Key,
                     policy: CachePolicy,
@@ -214,7 +249,9 @@ public final class GeneralCache<Key: Hashable & Codable, Value: Codable> {
             if self.mode == .memoryOnly || self.mode == .memoryAndDisk {
                 self.memoryCache.removeObject(forKey: wrappedKey)
             }
-            if self.mode == .diskOnly || self.mode == .memoryAndDisk {
+            if let segmentStore = self.segmentStore {
+                segmentStore.remove(self.segmentKey(for: key))
+            } else if self.mode == .diskOnly || self.mode == .memoryAndDisk {
                 try? self.fileManager.removeItem(at: self.fileURL(for: key))
             }
         }
@@ -225,7 +262,9 @@ public final class GeneralCache<Key: Hashable & Codable, Value: Codable> {
             if self.mode == .memoryOnly || self.mode == .memoryAndDisk {
                 self.memoryCache.removeAllObjects()
             }
-            if self.mode == .diskOnly || self.mode == .memoryAndDisk {
+            if let segmentStore = self.segmentStore {
+                segmentStore.removeAll()
+            } else if self.mode == .diskOnly || self.mode == .memoryAndDisk {
                 (try? self.fileManager.contentsOfDirectory(at: self.cacheDirectory,
                                                            includingPropertiesForKeys: nil))?
                     .forEach { try? self.fileManager.removeItem(at: $0) }
@@ -248,6 +287,10 @@ public final class GeneralCache<Key: Hashable & Codable, Value: Codable> {
             } else {
                 raw = try JSONEncoder().encode(entry)
             }
+            if let segmentStore {
+                segmentStore.set(raw, for: segmentKey(for: key), expiration: entry.expiration)
+                return
+            }
             try raw.write(to: url, options: .atomic)
             if let exp = entry.expiration {
                 try fileManager.setAttributes([.modificationDate: exp],
@@ -258,6 +301,14 @@ public final class GeneralCache<Key: Hashable & Codable, Value: Codable> {
         }
     }
 
+    /// Key of an entry in the segment store; unlike file names, keys aren't sanitized.
+    private func segmentKey(for key: Key) -> String {
+        if let str = key as? String {
+            return str
+        }
+        return (try? JSONEncoder().encode(key)).flatMap { String(data: $0, encoding: .utf8) } ?? String(describing: key)
+    }
+
     public func fileURL(for key: Key) -> URL {
         let name: String
         if let str = key as? String {
@@ -17,7 +17,11 @@ public extension ImageCacheType {
 public final class ImageCache: ImageCacheType {
     public static let shared = ImageCache()
 
-    private let dataCache = GeneralCache<String, Data>(cacheName: "ImageCache", mode: .memoryAndDisk)
+    private let dataCache = GeneralCache<String, Data>(
+        cacheName: "ImageCache",
+        mode: .memoryAndDisk,
+        diskStorage: .segments(maxBytes: 200 * 1024 * 1024)
+    )
     private let memoryImages = NSCache<NSString, UIImage>()
     private let defaultTTL: TimeInterval = 14 * 24 * 60 * 60
     private let maxDimension: CGFloat
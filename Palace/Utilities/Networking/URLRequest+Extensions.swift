@@ -41,3 +41,12 @@ extension URLRequest {
         return self
     }
 }
+
+extension URLRequest {
+    /// `true` if the request carries its own cache validators, in which case
+    /// URLSession hands a `304 Not Modified` response to the caller.
+    var isConditional: Bool {
+        value(forHTTPHeaderField: "If-None-Match") != nil
+            || value(forHTTPHeaderField: "If-Modified-Since") != nil
+    }
+}
@@ -25,4 +25,10 @@ extension HTTPURLResponse {
     @objc func isSuccess() -> Bool {
         return (200...299).contains(statusCode)
     }
+
+    /// `true` for `304 Not Modified`. URLSession only passes these on for
+    /// requests that carry their own validators; see `URLRequest.isConditional`.
+    @objc func isNotModified() -> Bool {
+        return statusCode == 304
+    }
 }
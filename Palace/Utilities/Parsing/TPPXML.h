@@ -1,5 +1,9 @@
 /**
- Wrapper around NSXMLParser.
+ Compact XML DOM built with libxml2's SAX parser.
+
+ Elements of a document are stored in a single arena with interned names; a @c TPPXML is a
+ lightweight handle to an element in it, created on access. Handles for the same element compare
+ equal with @c isEqual: but are not necessarily the same object.
 
  @note This class does not do any logging to Crashlytics.
 
@@ -14,7 +18,7 @@ suitable for handling markup (e.g. XHTML).
 @property (nonatomic, readonly) NSArray *children;
 @property (nonatomic, readonly) NSString *name;
 @property (nonatomic, readonly) NSString *namespaceURI;
-@property (nonatomic, weak, readonly) TPPXML *parent; // nilable
+@property (nonatomic, readonly) TPPXML *parent; // nilable
 @property (nonatomic, readonly) NSString *qualifiedName;
 @property (nonatomic, readonly) NSString *value;
 
@@ -28,3 +32,27 @@ suitable for handling markup (e.g. XHTML).
 - (TPPXML *)firstChildWithName:(NSString *)name;
 
 @end
+
+/**
+ Incremental parser for documents that arrive in chunks, e.g. while they are downloaded.
+
+ The element handler is called on the parsing thread as soon as a child of the root element is
+ closed, with the complete element. The element and its descendants must not be accessed from
+ other threads until parsing is finished.
+ */
+@interface TPPXMLStreamParser : NSObject
+
++ (id)new NS_UNAVAILABLE;
+- (id)init NS_UNAVAILABLE;
+
+- (instancetype)initWithElementHandler:(void (^)(TPPXML *element))handler;
+
+/// Parses next chunk of the document.
+/// @return @c NO if the document is not well-formed; the rest of the document is ignored then.
+- (BOOL)parseData:(NSData *)data;
+
+/// Finishes parsing.
+/// @return The root element, or @c nil if the document is not well-formed.
+- (TPPXML *)finish;
+
+@end
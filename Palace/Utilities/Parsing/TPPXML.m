@@ -1,14 +1,352 @@
+#import <libxml/parser.h>
+#import <libxml/dict.h>
+#import <libxml/parserInternals.h>
+
 #import "TPPXML.h"
 
-@interface TPPXML () <NSXMLParserDelegate>
+static uint32_t const TPPXMLNoNode = UINT32_MAX;
+
+/// Index of the empty string in the interned strings table.
+static uint32_t const TPPXMLEmptyString = 0;
+
+/// Element node stored in the document arena. Links and names are indexes, so the whole
+/// tree is a single allocation no matter how many elements the document has.
+typedef struct {
+  uint32_t parent;
+  uint32_t firstChild;
+  uint32_t lastChild;
+  uint32_t nextSibling;
+  uint32_t childCount;
+  uint32_t name;
+  uint32_t namespaceURI;
+  uint32_t qualifiedName;
+  uint32_t firstAttribute;
+  uint32_t attributeCount;
+  uint32_t valueOffset;
+  uint32_t valueLength;
+} TPPXMLNode;
+
+typedef struct {
+  uint32_t qualifiedName;
+  uint32_t valueOffset;
+  uint32_t valueLength;
+} TPPXMLAttribute;
+
+/// Growable byte buffer.
+typedef struct {
+  char *bytes;
+  size_t length;
+  size_t capacity;
+} TPPXMLBuffer;
+
+static void TPPXMLBufferAppend(TPPXMLBuffer *const buffer, const char *const bytes, size_t const length)
+{
+  if(buffer->length + length > buffer->capacity) {
+    size_t capacity = buffer->capacity ? buffer->capacity : 256;
+    while(capacity < buffer->length + length) {
+      capacity *= 2;
+    }
+    buffer->bytes = realloc(buffer->bytes, capacity);
+    buffer->capacity = capacity;
+  }
+  memcpy(buffer->bytes + buffer->length, bytes, length);
+  buffer->length += length;
+}
+
+/// Owns the arena of a parsed document. Every `TPPXML` is a lightweight handle to a node in it.
+@interface TPPXMLDocument : NSObject
+{
+  @public TPPXMLNode *nodes;
+  @public uint32_t nodeCount;
+  @public TPPXMLAttribute *attributes;
+  @public uint32_t attributeCount;
+  /// Element text and attribute values, UTF-8
+  @public TPPXMLBuffer text;
+  /// Interned element names, namespace URIs and attribute names
+  @public NSMutableArray<NSString *> *strings;
+  /// Interned string indexes by string, used to look up children by name
+  @public NSMutableDictionary<NSString *, NSNumber *> *stringIndexes;
+}
+@end
+
+@implementation TPPXMLDocument
 
-@property (nonatomic) NSDictionary *attributes;
-@property (nonatomic) NSMutableArray *mutableChildren;
-@property (nonatomic) NSMutableString *mutableValue;
-@property (nonatomic) NSString *name;
-@property (nonatomic) NSString *namespaceURI;
-@property (nonatomic, weak) TPPXML *parent;
-@property (nonatomic) NSString *qualifiedName;
+- (void)dealloc
+{
+  free(nodes);
+  free(attributes);
+  free(text.bytes);
+}
+
+- (NSString *)stringWithOffset:(uint32_t const)offset length:(uint32_t const)length
+{
+  if(length == 0) return @"";
+  return [[NSString alloc] initWithBytes:text.bytes + offset length:length encoding:NSUTF8StringEncoding];
+}
+
+@end
+
+#pragma mark - Builder
+
+/// Parser state while the document is being built from libxml2 SAX events.
+typedef struct {
+  __unsafe_unretained TPPXMLDocument *document;
+  xmlParserCtxtPtr context;
+  uint32_t nodeCapacity;
+  uint32_t attributeCapacity;
+  uint32_t currentNode;
+  uint32_t depth;
+  /// Text of every open element, by depth. Buffers are reused between siblings.
+  TPPXMLBuffer *pendingText;
+  uint32_t pendingTextCapacity;
+  /// Interned libxml2 dictionary pointers to string indexes
+  CFMutableDictionaryRef internedStrings;
+  /// Called when a child of the root element is closed, used for incremental parsing
+  void (*elementHandler)(void *info, uint32_t index);
+  void *elementHandlerInfo;
+} TPPXMLBuilder;
+
+static uint32_t TPPXMLIntern(TPPXMLBuilder *const builder, const xmlChar *const string)
+{
+  if(!string || !*string) return TPPXMLEmptyString;
+
+  // libxml2 interns names in the parser dictionary, so pointers are unique per name
+  const void *const existing = CFDictionaryGetValue(builder->internedStrings, string);
+  if(existing) {
+    return (uint32_t)(uintptr_t)existing;
+  }
+
+  TPPXMLDocument *const document = builder->document;
+  uint32_t const index = (uint32_t)document->strings.count;
+  NSString *const value = [NSString stringWithUTF8String:(const char *)string] ?: @"";
+  [document->strings addObject:value];
+  if(!document->stringIndexes[value]) {
+    document->stringIndexes[value] = @(index);
+  }
+  CFDictionarySetValue(builder->internedStrings, string, (const void *)(uintptr_t)index);
+  return index;
+}
+
+static uint32_t TPPXMLInternQualifiedName(TPPXMLBuilder *const builder,
+                                          const xmlChar *const prefix,
+                                          const xmlChar *const localname)
+{
+  if(!prefix) return TPPXMLIntern(builder, localname);
+  return TPPXMLIntern(builder, xmlDictQLookup(builder->context->dict, prefix, localname));
+}
+
+/// Appends attribute value from libxml2. Without entity substitution libxml2 escapes every `&`
+/// in attribute values as `&#38;`, and a raw `&` can't appear otherwise, so it is unescaped here.
+static void TPPXMLAppendAttributeValue(TPPXMLBuffer *const buffer, const char *const begin, const char *const end)
+{
+  static const char escapedAmpersand[] = "&#38;";
+  size_t const escapedLength = sizeof(escapedAmpersand) - 1;
+
+  const char *start = begin;
+  const char *ampersand;
+  while((ampersand = memchr(start, '&', (size_t)(end - start)))) {
+    TPPXMLBufferAppend(buffer, start, (size_t)(ampersand - start));
+    if((size_t)(end - ampersand) >= escapedLength && !memcmp(ampersand, escapedAmpersand, escapedLength)) {
+      TPPXMLBufferAppend(buffer, "&", 1);
+      start = ampersand + escapedLength;
+    } else {
+      TPPXMLBufferAppend(buffer, "&", 1);
+      start = ampersand + 1;
+    }
+  }
+  TPPXMLBufferAppend(buffer, start, (size_t)(end - start));
+}
+
+static void TPPXMLStartElement(void *const context,
+                               const xmlChar *const localname,
+                               const xmlChar *const prefix,
+                               const xmlChar *const URI,
+                               __attribute__((unused)) int const namespaceCount,
+                               __attribute__((unused)) const xmlChar **const namespaces,
+                               int const attributeCount,
+                               __attribute__((unused)) int const defaultedCount,
+                               const xmlChar **const attributes)
+{
+  TPPXMLBuilder *const builder = context;
+  TPPXMLDocument *const document = builder->document;
+
+  if(document->nodeCount == builder->nodeCapacity) {
+    builder->nodeCapacity = builder->nodeCapacity ? builder->nodeCapacity * 2 : 64;
+    document->nodes = realloc(document->nodes, builder->nodeCapacity * sizeof(TPPXMLNode));
+  }
+
+  uint32_t const index = document->nodeCount++;
+  TPPXMLNode *const node = &document->nodes[index];
+  *node = (TPPXMLNode) {
+    .parent = builder->currentNode,
+    .firstChild = TPPXMLNoNode,
+    .lastChild = TPPXMLNoNode,
+    .nextSibling = TPPXMLNoNode,
+    .name = TPPXMLIntern(builder, localname),
+    .namespaceURI = TPPXMLIntern(builder, URI),
+    .qualifiedName = TPPXMLInternQualifiedName(builder, prefix, localname),
+    .firstAttribute = document->attributeCount,
+    .attributeCount = (uint32_t)attributeCount,
+  };
+
+  // Attributes come as (localname, prefix, URI, value, end) tuples;
+  // namespace declarations are not reported, same as NSXMLParser.
+  for(int i = 0; i < attributeCount; i++) {
+    const xmlChar **const attribute = &attributes[i * 5];
+    if(document->attributeCount == builder->attributeCapacity) {
+      builder->attributeCapacity = builder->attributeCapacity ? builder->attributeCapacity * 2 : 64;
+      document->attributes = realloc(document->attributes, builder->attributeCapacity * sizeof(TPPXMLAttribute));
+    }
+    size_t const offset = document->text.length;
+    TPPXMLAppendAttributeValue(&document->text, (const char *)attribute[3], (const char *)attribute[4]);
+    document->attributes[document->attributeCount++] = (TPPXMLAttribute) {
+      .qualifiedName = TPPXMLInternQualifiedName(builder, attribute[1], attribute[0]),
+      .valueOffset = (uint32_t)offset,
+      .valueLength = (uint32_t)(document->text.length - offset),
+    };
+  }
+
+  if(builder->currentNode != TPPXMLNoNode) {
+    TPPXMLNode *const parent = &document->nodes[builder->currentNode];
+    if(parent->lastChild == TPPXMLNoNode) {
+      parent->firstChild = index;
+    } else {
+      document->nodes[parent->lastChild].nextSibling = index;
+    }
+    parent->lastChild = index;
+    parent->childCount++;
+  }
+
+  builder->currentNode = index;
+  builder->depth++;
+  if(builder->depth > builder->pendingTextCapacity) {
+    uint32_t const capacity = builder->pendingTextCapacity ? builder->pendingTextCapacity * 2 : 16;
+    builder->pendingText = realloc(builder->pendingText, capacity * sizeof(TPPXMLBuffer));
+    memset(builder->pendingText + builder->pendingTextCapacity, 0,
+           (capacity - builder->pendingTextCapacity) * sizeof(TPPXMLBuffer));
+    builder->pendingTextCapacity = capacity;
+  }
+  builder->pendingText[builder->depth - 1].length = 0;
+}
+
+static void TPPXMLEndElement(void *const context,
+                             __attribute__((unused)) const xmlChar *const localname,
+                             __attribute__((unused)) const xmlChar *const prefix,
+                             __attribute__((unused)) const xmlChar *const URI)
+{
+  TPPXMLBuilder *const builder = context;
+  TPPXMLDocument *const document = builder->document;
+  TPPXMLNode *const node = &document->nodes[builder->currentNode];
+
+  // Text of the element is moved to the arena in one piece once all of it is known
+  TPPXMLBuffer *const pending = &builder->pendingText[builder->depth - 1];
+  node->valueOffset = (uint32_t)document->text.length;
+  node->valueLength = (uint32_t)pending->length;
+  TPPXMLBufferAppend(&document->text, pending->bytes, pending->length);
+
+  builder->currentNode = node->parent;
+  builder->depth--;
+
+  if(builder->depth == 1 && builder->elementHandler) {
+    builder->elementHandler(builder->elementHandlerInfo, (uint32_t)(node - document->nodes));
+  }
+}
+
+static void TPPXMLCharacters(void *const context, const xmlChar *const characters, int const length)
+{
+  TPPXMLBuilder *const builder = context;
+  if(builder->depth == 0) return;
+  TPPXMLBufferAppend(&builder->pendingText[builder->depth - 1], (const char *)characters, (size_t)length);
+}
+
+// CDATA sections are not part of element values, same as with NSXMLParser.
+static void TPPXMLCDATABlock(__attribute__((unused)) void *const context,
+                             __attribute__((unused)) const xmlChar *const value,
+                             __attribute__((unused)) int const length)
+{
+}
+
+static void TPPXMLStructuredError(__attribute__((unused)) void *const context,
+                                  __attribute__((unused)) xmlErrorPtr const error)
+{
+  // Errors are reported via `wellFormed`; don't print them to the console.
+}
+
+static xmlSAXHandler TPPXMLSAXHandler(void)
+{
+  xmlSAXHandler handler;
+  memset(&handler, 0, sizeof(handler));
+  handler.initialized = XML_SAX2_MAGIC;
+  handler.startElementNs = TPPXMLStartElement;
+  handler.endElementNs = TPPXMLEndElement;
+  handler.characters = TPPXMLCharacters;
+  handler.ignorableWhitespace = TPPXMLCharacters;
+  handler.cdataBlock = TPPXMLCDATABlock;
+  handler.serror = TPPXMLStructuredError;
+  return handler;
+}
+
+static TPPXMLBuilder TPPXMLBuilderCreate(TPPXMLDocument *const document)
+{
+  document->strings = [NSMutableArray arrayWithObject:@""];
+  document->stringIndexes = [NSMutableDictionary dictionaryWithObject:@(TPPXMLEmptyString) forKey:@""];
+  return (TPPXMLBuilder) {
+    .document = document,
+    .currentNode = TPPXMLNoNode,
+    // Pointer keys and integer values, no retain/release callbacks
+    .internedStrings = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, NULL, NULL),
+  };
+}
+
+static void TPPXMLBuilderDestroy(TPPXMLBuilder *const builder)
+{
+  for(uint32_t i = 0; i < builder->pendingTextCapacity; i++) {
+    free(builder->pendingText[i].bytes);
+  }
+  free(builder->pendingText);
+  builder->pendingText = NULL;
+  builder->pendingTextCapacity = 0;
+  if(builder->internedStrings) {
+    CFRelease(builder->internedStrings);
+    builder->internedStrings = NULL;
+  }
+}
+
+static TPPXMLDocument *TPPXMLParseDocument(NSData *const data)
+{
+  if(data.length == 0 || data.length > INT_MAX) return nil;
+
+  xmlParserCtxtPtr const context = xmlCreateMemoryParserCtxt(data.bytes, (int)data.length);
+  if(!context) return nil;
+
+  xmlSAXHandler handler = TPPXMLSAXHandler();
+  TPPXMLDocument *const document = [[TPPXMLDocument alloc] init];
+  TPPXMLBuilder builder = TPPXMLBuilderCreate(document);
+  builder.context = context;
+
+  xmlSAXHandlerPtr const defaultHandler = context->sax;
+  context->sax = &handler;
+  context->userData = &builder;
+  xmlCtxtUseOptions(context, XML_PARSE_NONET);
+  xmlParseDocument(context);
+  BOOL const wellFormed = context->wellFormed && document->nodeCount > 0;
+  context->sax = defaultHandler;
+  xmlFreeParserCtxt(context);
+
+  TPPXMLBuilderDestroy(&builder);
+
+  return wellFormed ? document : nil;
+}
+
+#pragma mark - TPPXML
+
+@interface TPPXML ()
+
+@property (nonatomic) TPPXMLDocument *document;
+@property (nonatomic) uint32_t index;
+
++ (instancetype)XMLWithDocument:(TPPXMLDocument *)document index:(uint32_t)index;
+- (TPPXMLNode const *)node;
 
 @end
 
@@ -18,98 +356,217 @@
 {
   if(!data) return nil;
 
-  TPPXML *const document = [[self alloc] init];
-  
-  // TODO: This seemingly pointless copy appears to work around a bug with NSXMLParser that causes a
-  // crash in 64-bit simulators. Calling |copy| does *not* solve the problem: It must be a mutable
-  // copy for reasons completely unknown. Attempts to find a more pleasing workaround have been
-  // unsuccessful thus far, but something should eventually be figured out.
-  NSMutableData *const mutableData = [data mutableCopy];
-  
-  NSXMLParser *const parser = [[NSXMLParser alloc] initWithData:mutableData];
-  parser.delegate = document;
-  parser.shouldProcessNamespaces = YES;
-  [parser parse];
-  
-  if(parser.parserError) {
-    return nil;
-  } else {
-    TPPXML *const root = document.children[0];
-    root.parent = nil;
-    return root;
+  TPPXMLDocument *const document = TPPXMLParseDocument(data);
+  if(!document) return nil;
+
+  return [self XMLWithDocument:document index:0];
+}
+
++ (instancetype)XMLWithDocument:(TPPXMLDocument *const)document index:(uint32_t const)index
+{
+  TPPXML *const XML = [[self alloc] init];
+  XML.document = document;
+  XML.index = index;
+  return XML;
+}
+
+- (TPPXMLNode const *)node
+{
+  return &self.document->nodes[self.index];
+}
+
+- (NSDictionary *)attributes
+{
+  TPPXMLNode const *const node = [self node];
+  if(node->attributeCount == 0) return @{};
+
+  TPPXMLDocument *const document = self.document;
+  NSMutableDictionary *const attributes = [NSMutableDictionary dictionaryWithCapacity:node->attributeCount];
+  for(uint32_t i = node->firstAttribute; i < node->firstAttribute + node->attributeCount; i++) {
+    TPPXMLAttribute const attribute = document->attributes[i];
+    NSString *const value = [document stringWithOffset:attribute.valueOffset length:attribute.valueLength];
+    attributes[document->strings[attribute.qualifiedName]] = value ?: @"";
   }
+  return attributes;
 }
 
 - (NSArray *)children
 {
-  return self.mutableChildren ? self.mutableChildren : @[];
+  TPPXMLNode const *const node = [self node];
+  if(node->childCount == 0) return @[];
+
+  NSMutableArray *const children = [NSMutableArray arrayWithCapacity:node->childCount];
+  for(uint32_t child = node->firstChild; child != TPPXMLNoNode; child = self.document->nodes[child].nextSibling) {
+    [children addObject:[[self class] XMLWithDocument:self.document index:child]];
+  }
+  return children;
+}
+
+- (NSString *)name
+{
+  return self.document->strings[[self node]->name];
+}
+
+- (NSString *)namespaceURI
+{
+  return self.document->strings[[self node]->namespaceURI];
+}
+
+- (TPPXML *)parent
+{
+  uint32_t const parent = [self node]->parent;
+  if(parent == TPPXMLNoNode) return nil;
+  return [[self class] XMLWithDocument:self.document index:parent];
+}
+
+- (NSString *)qualifiedName
+{
+  return self.document->strings[[self node]->qualifiedName];
 }
 
 - (NSString *)value
 {
-  return self.mutableValue ? self.mutableValue : @"";
+  TPPXMLNode const *const node = [self node];
+  return [self.document stringWithOffset:node->valueOffset length:node->valueLength] ?: @"";
 }
 
 - (NSArray *)childrenWithName:(NSString *const)name
 {
   if(!name) return @[];
-  
+
+  NSNumber *const nameIndex = self.document->stringIndexes[name];
+  if(!nameIndex) return @[];
+
+  uint32_t const interned = nameIndex.unsignedIntValue;
   NSMutableArray *const children = [NSMutableArray array];
-  
-  for(TPPXML *const XML in self.children) {
-    if([name isEqualToString:XML.name]) {
-      [children addObject:XML];
+  TPPXMLNode const *const nodes = self.document->nodes;
+  for(uint32_t child = [self node]->firstChild; child != TPPXMLNoNode; child = nodes[child].nextSibling) {
+    if(nodes[child].name == interned) {
+      [children addObject:[[self class] XMLWithDocument:self.document index:child]];
     }
   }
-  
+
   return children;
 }
 
 - (TPPXML *)firstChildWithName:(NSString *const)name
 {
-  return [[self childrenWithName:name] firstObject];
+  if(!name) return nil;
+
+  NSNumber *const nameIndex = self.document->stringIndexes[name];
+  if(!nameIndex) return nil;
+
+  uint32_t const interned = nameIndex.unsignedIntValue;
+  TPPXMLNode const *const nodes = self.document->nodes;
+  for(uint32_t child = [self node]->firstChild; child != TPPXMLNoNode; child = nodes[child].nextSibling) {
+    if(nodes[child].name == interned) {
+      return [[self class] XMLWithDocument:self.document index:child];
+    }
+  }
+  return nil;
+}
+
+#pragma mark NSObject
+
+- (BOOL)isEqual:(id const)object
+{
+  if(self == object) return YES;
+  if(![object isKindOfClass:[TPPXML class]]) return NO;
+  TPPXML *const other = object;
+  return other.document == self.document && other.index == self.index;
+}
+
+- (NSUInteger)hash
+{
+  return (NSUInteger)(uintptr_t)(__bridge void *)self.document ^ self.index;
 }
 
-#pragma mark NSXMLParserDelegate
+@end
+
+#pragma mark - TPPXMLStreamParser
 
-- (void)parser:(NSXMLParser *const)parser
-didStartElement:(NSString *const)name
-  namespaceURI:(NSString *const)namespaceURI
- qualifiedName:(NSString *const)qualifiedName
-    attributes:(NSDictionary *const)attributes
+@interface TPPXMLStreamParser ()
 {
-  TPPXML *const child = [[[self class] alloc] init];
-  child.attributes = attributes;
-  child.name = name;
-  child.namespaceURI = namespaceURI;
-  child.parent = self;
-  child.qualifiedName = qualifiedName;
-  
-  if(self.mutableChildren) {
-    [self.mutableChildren addObject:child];
-  } else {
-    self.mutableChildren = [NSMutableArray arrayWithObject:child];
+  TPPXMLBuilder builder;
+  xmlParserCtxtPtr context;
+}
+
+@property (nonatomic) TPPXMLDocument *document;
+@property (nonatomic, copy) void (^elementHandler)(TPPXML *element);
+@property (nonatomic) BOOL failed;
+
+@end
+
+static void TPPXMLStreamParserElementHandler(void *const info, uint32_t const index)
+{
+  TPPXMLStreamParser *const parser = (__bridge TPPXMLStreamParser *)info;
+  parser.elementHandler([TPPXML XMLWithDocument:parser.document index:index]);
+}
+
+@implementation TPPXMLStreamParser
+
+- (instancetype)initWithElementHandler:(void (^const)(TPPXML *element))handler
+{
+  self = [super init];
+  if(!self) return nil;
+
+  self.elementHandler = handler;
+  self.document = [[TPPXMLDocument alloc] init];
+  builder = TPPXMLBuilderCreate(self.document);
+  if(handler) {
+    builder.elementHandler = TPPXMLStreamParserElementHandler;
+    builder.elementHandlerInfo = (__bridge void *)self;
   }
-  
-  parser.delegate = child;
+
+  xmlSAXHandler SAXHandler = TPPXMLSAXHandler();
+  context = xmlCreatePushParserCtxt(&SAXHandler, &builder, NULL, 0, NULL);
+  if(!context) return nil;
+  builder.context = context;
+  xmlCtxtUseOptions(context, XML_PARSE_NONET);
+
+  return self;
 }
 
-- (void)parser:(NSXMLParser *const)parser
- didEndElement:(__attribute__((unused)) NSString *)elementName
-  namespaceURI:(__attribute__((unused)) NSString *)namespaceURI
- qualifiedName:(__attribute__((unused)) NSString *)qName
+- (void)dealloc
 {
-	parser.delegate = self.parent;
+  if(context) {
+    xmlFreeParserCtxt(context);
+  }
+  TPPXMLBuilderDestroy(&builder);
 }
 
-- (void)parser:(__attribute__((unused)) NSXMLParser *)parser
-foundCharacters:(NSString *const)string
+- (BOOL)parseData:(NSData *const)data
 {
-  if(self.mutableValue) {
-    [self.mutableValue appendString:string];
-  } else {
-    self.mutableValue = [string mutableCopy];
+  if(self.failed || !context) return NO;
+
+  // Chunks larger than `int` can hold are passed in parts
+  const char *bytes = data.bytes;
+  NSUInteger remaining = data.length;
+  while(remaining > 0 && !self.failed) {
+    int const length = (int)MIN(remaining, (NSUInteger)INT_MAX);
+    xmlParseChunk(context, bytes, length, 0);
+    bytes += length;
+    remaining -= (NSUInteger)length;
+    self.failed = !context->wellFormed;
   }
+  return !self.failed;
+}
+
+- (TPPXML *)finish
+{
+  if(!context) return nil;
+
+  if(!self.failed) {
+    xmlParseChunk(context, NULL, 0, 1);
+    self.failed = !context->wellFormed;
+  }
+
+  xmlFreeParserCtxt(context);
+  context = NULL;
+  TPPXMLBuilderDestroy(&builder);
+
+  if(self.failed || self.document->nodeCount == 0) return nil;
+  return [TPPXML XMLWithDocument:self.document index:0];
 }
 
 @end
@@ -0,0 +1,133 @@
+//
+//  PostingListIndex.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+
+/// Words of a book's sections (EPUB resources, PDF pages) and the sections
+/// each word appears in, shared by the full-text search indexes.
+///
+/// Texts are normalized (lowercased or folded) by the caller, the same way
+/// as the queries later looked up.
+struct PostingListIndex: Codable, Equatable {
+    let sectionCount: Int
+    /// Sections containing each word, ascending.
+    let postings: [String: [Int32]]
+
+    /// - Parameter sections: Normalized texts of each section; words don't span texts.
+    init(sections: [[String]]) {
+        var postings = [String: [Int32]]()
+        for (section, texts) in sections.enumerated() {
+            var sectionWords = Set<String>()
+            for text in texts {
+                sectionWords.formUnion(Self.words(in: text))
+            }
+            for word in sectionWords {
+                postings[word, default: []].append(Int32(section))
+            }
+        }
+        self.sectionCount = sections.count
+        self.postings = postings
+    }
+
+    /// Runs of letters and digits in `text`.
+    static func words(in text: String) -> [String] {
+        text.split { !($0.isLetter || $0.isNumber) }.map(String.init)
+    }
+
+    /// Sections that may contain `query`, ascending: text containing it contains
+    /// its inner words whole, its first word as a word suffix, and its last word
+    /// as a word prefix.
+    /// - Parameter query: Normalized search string.
+    func candidateSections(for query: String) -> [Int] {
+        let queryWords = Self.words(in: query)
+        guard !queryWords.isEmpty else {
+            return Array(0..<sectionCount)
+        }
+
+        var candidates: Set<Int32>?
+        for (position, queryWord) in queryWords.enumerated() {
+            let isFirst = position == 0
+            let isLast = position == queryWords.count - 1
+            var sections = Set<Int32>()
+            if !isFirst && !isLast {
+                sections.formUnion(postings[queryWord] ?? [])
+            } else {
+                for (word, wordSections) in postings {
+                    let matches: Bool
+                    switch (isFirst, isLast) {
+                    case (true, true): matches = word.contains(queryWord)
+                    case (true, false): matches = word.hasSuffix(queryWord)
+                    default: matches = word.hasPrefix(queryWord)
+                    }
+                    if matches {
+                        sections.formUnion(wordSections)
+                    }
+                }
+            }
+            candidates = candidates.map { $0.intersection(sections) } ?? sections
+            if candidates?.isEmpty == true {
+                return []
+            }
+        }
+        return (candidates ?? []).map(Int.init).sorted()
+    }
+}
+
+// MARK: - Storage
+
+/// A search index stored next to its book file, encrypted with `SearchIndexCipher`
+/// because it holds the text of the book.
+protocol SealedSearchIndex: Codable {
+    static var currentVersion: Int { get }
+    var version: Int { get }
+}
+
+extension SealedSearchIndex {
+
+    /// Index location for a book file.
+    static func url(forBookAt bookURL: URL) -> URL {
+        bookURL.appendingPathExtension("searchindex")
+    }
+
+    static func deleteIndex(forBookAt bookURL: URL) {
+        try? FileManager.default.removeItem(at: url(forBookAt: bookURL))
+    }
+
+    func save(to url: URL) throws {
+        let encoder = PropertyListEncoder()
+        encoder.outputFormat = .binary
+        try SearchIndexCipher.seal(encoder.encode(self)).write(to: url, options: [.atomic, .completeFileProtectionUntilFirstUserAuthentication])
+    }
+
+    /// Loads the index saved at `url`.
+    /// - Returns: `nil` if there is none, it can't be opened, or it is of another version.
+    static func loadSealed(from url: URL) -> Self? {
+        guard let sealed = try? Data(contentsOf: url, options: .mappedIfSafe),
+              let data = try? SearchIndexCipher.open(sealed),
+              let index = try? PropertyListDecoder().decode(Self.self, from: data),
+              index.version == currentVersion else {
+            return nil
+        }
+        return index
+    }
+
+    /// Loads the index saved at `url` if `isCurrent`, or builds and saves it.
+    static func loadOrBuild(at url: URL, isCurrent: (Self) -> Bool, build: () async throws -> Self) async throws -> Self {
+        if let index = loadSealed(from: url), isCurrent(index) {
+            return index
+        }
+        let start = Date()
+        let index = try await build()
+        do {
+            try index.save(to: url)
+        } catch {
+            Log.error(#file, "Failed to save \(Self.self): \(error.localizedDescription)")
+        }
+        Log.info(#file, "Built \(Self.self) in \(String(format: "%.2f", Date().timeIntervalSince(start)))s")
+        return index
+    }
+}
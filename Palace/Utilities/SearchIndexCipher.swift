@@ -0,0 +1,51 @@
+//
+//  SearchIndexCipher.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import CryptoKit
+import Foundation
+
+/// Encrypts search indexes stored next to books.
+///
+/// An index holds the text of its book, so for DRM-protected books it must not
+/// be readable outside the app. Index files are compressed, then sealed with
+/// AES-GCM under a key kept in the keychain. An index that can't be opened,
+/// e.g. after the keychain was reset, is built again.
+enum SearchIndexCipher {
+    private static let keychainKey = "TPPSearchIndexKey"
+    private static let lock = NSLock()
+    private static var cachedKey: SymmetricKey?
+
+    static func seal(_ data: Data) throws -> Data {
+        let compressed = try (data as NSData).compressed(using: .lzfse) as Data
+        guard let sealed = try AES.GCM.seal(compressed, using: key()).combined else {
+            throw CryptoKitError.incorrectParameterSize
+        }
+        return sealed
+    }
+
+    static func open(_ data: Data) throws -> Data {
+        let compressed = try AES.GCM.open(AES.GCM.SealedBox(combined: data), using: key())
+        return try (compressed as NSData).decompressed(using: .lzfse) as Data
+    }
+
+    private static func key() -> SymmetricKey {
+        lock.withLock {
+            if let cachedKey {
+                return cachedKey
+            }
+            let key: SymmetricKey
+            if let data = TPPKeychain.shared()?.object(forKey: keychainKey) as? Data, data.count == 32 {
+                key = SymmetricKey(data: data)
+            } else {
+                key = SymmetricKey(size: .bits256)
+                TPPKeychain.shared()?.setObject(key.withUnsafeBytes { Data($0) }, forKey: keychainKey)
+            }
+            cachedKey = key
+            return key
+        }
+    }
+}
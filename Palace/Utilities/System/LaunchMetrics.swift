@@ -0,0 +1,40 @@
+//
+//  LaunchMetrics.swift
+//  Palace
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import Foundation
+import os
+
+/// Milestones of a cold start, logged once per launch and marked with signposts
+/// for Instruments.
+enum LaunchMetrics {
+
+    private static let signposter = OSSignposter(subsystem: Bundle.main.bundleIdentifier ?? "Palace", category: "Launch")
+    private static let hasReportedFirstCatalogLanes = OSAllocatedUnfairLock(initialState: false)
+
+    /// Records that the first catalog lanes were shown, from `source`.
+    static func firstCatalogLanesShown(source: String) {
+        let isFirst = hasReportedFirstCatalogLanes.withLock { reported in
+            defer { reported = true }
+            return !reported
+        }
+        guard isFirst else { return }
+
+        signposter.emitEvent("First catalog lanes", "\(source, privacy: .public)")
+        guard let launchDate = processStartDate() else { return }
+        Log.info(#file, "First catalog lanes shown from \(source) \(Int(Date().timeIntervalSince(launchDate) * 1000)) ms after launch")
+    }
+
+    /// When the kernel started the process, before any app code ran.
+    private static func processStartDate() -> Date? {
+        var info = kinfo_proc()
+        var size = MemoryLayout<kinfo_proc>.stride
+        var mib: [Int32] = [CTL_KERN, KERN_PROC, KERN_PROC_PID, getpid()]
+        guard sysctl(&mib, u_int(mib.count), &info, &size, nil, 0) == 0 else { return nil }
+        let start = info.kp_proc.p_un.__p_starttime
+        return Date(timeIntervalSince1970: Double(start.tv_sec) + Double(start.tv_usec) / 1_000_000)
+    }
+}
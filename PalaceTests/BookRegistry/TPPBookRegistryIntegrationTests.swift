@@ -368,6 +368,69 @@ final class TPPBookRegistryPublisherTests: XCTestCase {
         XCTAssertNil(receivedRegistry?[book.identifier])
     }
 
+    // MARK: - changePublisher Tests
+
+    func testChangePublisher_CoalescesLocationUpdates() {
+        let registry = TPPBookRegistry.shared
+        let book = TPPBookMocker.mockBook(identifier: "change-location-\(UUID().uuidString)", title: "Change Location Test", distributorType: .EpubZip)
+        registry.addBook(book, state: .downloadSuccessful)
+
+        let addExpectation = self.expectation(description: "Book added")
+        DispatchQueue.main.asyncAfter(deadline: .now() + 0.2) {
+            addExpectation.fulfill()
+        }
+        waitForExpectations(timeout: 1.0)
+
+        var changes = [TPPBookRegistryChange]()
+        registry.changePublisher
+            .filter { $0.affects(book.identifier) }
+            .sink { changes.append($0) }
+            .store(in: &cancellables)
+
+        let pageTurns = 50
+        for page in 0..<pageTurns {
+            let location = TPPBookLocation(locationString: "{\"page\": \(page)}", renderer: "TestRenderer")
+            registry.setLocation(location, forIdentifier: book.identifier)
+        }
+
+        let publishExpectation = self.expectation(description: "Changes published")
+        DispatchQueue.main.asyncAfter(deadline: .now() + 0.5) {
+            publishExpectation.fulfill()
+        }
+        waitForExpectations(timeout: 2.0)
+
+        XCTAssertFalse(changes.isEmpty)
+        XCTAssertLessThan(changes.count, pageTurns, "Location updates should be published in batches")
+        XCTAssertTrue(changes.allSatisfy { $0.isLocationOnly })
+        XCTAssertEqual(registry.location(forIdentifier: book.identifier)?.locationString, "{\"page\": \(pageTurns - 1)}")
+
+        registry.removeBook(forIdentifier: book.identifier)
+    }
+
+    func testChangePublisher_ReportsInsertionAndRemoval() {
+        let registry = TPPBookRegistry.shared
+        let book = TPPBookMocker.mockBook(identifier: "change-insert-\(UUID().uuidString)", title: "Change Insert Test", distributorType: .EpubZip)
+
+        let insertExpectation = self.expectation(description: "Insertion published")
+        let removeExpectation = self.expectation(description: "Removal published")
+        registry.changePublisher
+            .sink { change in
+                if change.inserted.contains(book.identifier) {
+                    insertExpectation.fulfill()
+                }
+                if change.removed.contains(book.identifier) {
+                    removeExpectation.fulfill()
+                }
+            }
+            .store(in: &cancellables)
+
+        registry.addBook(book, state: .downloadNeeded)
+        wait(for: [insertExpectation], timeout: 2.0)
+
+        registry.removeBook(forIdentifier: book.identifier)
+        wait(for: [removeExpectation], timeout: 2.0)
+    }
+
     // MARK: - bookStatePublisher Tests
 
     func testBookStatePublisher_EmitsOnStateChange() {
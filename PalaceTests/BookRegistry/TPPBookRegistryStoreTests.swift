@@ -0,0 +1,333 @@
+//
+//  TPPBookRegistryStoreTests.swift
+//  PalaceTests
+//
+//  Tests for journaled book registry persistence: replay, recovery from torn
+//  writes, migration from the JSON registry file, compaction and loans sync
+//  validators.
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+final class TPPBookRegistryStoreTests: XCTestCase {
+
+    private var tempDirectory: URL!
+    private var snapshotUrl: URL!
+
+    override func setUp() {
+        super.setUp()
+        tempDirectory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("TPPBookRegistryStoreTests-\(UUID().uuidString)")
+        snapshotUrl = tempDirectory
+            .appendingPathComponent("registry")
+            .appendingPathComponent("registry.json")
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: tempDirectory)
+        super.tearDown()
+    }
+
+    // MARK: - Helpers
+
+    private func makeRecord(_ identifier: String, state: TPPBookState = .downloadNeeded) -> TPPBookRegistryStore.Record {
+        let book = TPPBookMocker.mockBook(identifier: identifier, title: "Book \(identifier)", distributorType: .EpubZip)
+        let location = TPPBookLocation(locationString: "{\"page\": 1}", renderer: "TestRenderer")
+        return TPPBookRegistryRecord(book: book, location: location, state: state).dictionaryRepresentation
+    }
+
+    private func reloadedRecords() -> [String: TPPBookRegistryStore.Record] {
+        TPPBookRegistryStore(snapshotUrl: snapshotUrl).load()
+    }
+
+    private func state(of record: TPPBookRegistryStore.Record?) -> String? {
+        record?[TPPBookRegistryKey.state.rawValue] as? String
+    }
+
+    private func writeLegacyRegistry(_ identifiers: [String]) throws {
+        try FileManager.default.createDirectory(at: snapshotUrl.deletingLastPathComponent(), withIntermediateDirectories: true)
+        let registryObject = [TPPBookRegistryKey.records.rawValue: identifiers.map { makeRecord($0) }]
+        let data = try JSONSerialization.data(withJSONObject: registryObject)
+        try data.write(to: snapshotUrl)
+    }
+
+    // MARK: - Journal
+
+    func testWrite_thenLoad_returnsRecords() {
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        store.write(["a": makeRecord("a"), "b": makeRecord("b", state: .holding)])
+        store.flush()
+
+        let records = reloadedRecords()
+
+        XCTAssertEqual(Set(records.keys), ["a", "b"])
+        XCTAssertEqual(state(of: records["b"]), "holding")
+        XCTAssertFalse(FileManager.default.fileExists(atPath: snapshotUrl.path))
+    }
+
+    func testWrite_laterChangeWins() {
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        store.write(["a": makeRecord("a")])
+        store.write(["a": makeRecord("a", state: .downloadSuccessful)])
+        store.flush()
+
+        XCTAssertEqual(state(of: reloadedRecords()["a"]), "download-successful")
+    }
+
+    func testWrite_nilRecord_removesRecord() {
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        store.write(["a": makeRecord("a"), "b": makeRecord("b")])
+        store.write(["a": nil])
+        store.flush()
+
+        XCTAssertEqual(Set(reloadedRecords().keys), ["b"])
+    }
+
+    func testWriteSync_isOnDiskWhenItReturns() {
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+
+        XCTAssertNil(store.writeSync(["a": makeRecord("a")]))
+        XCTAssertEqual(Set(reloadedRecords().keys), ["a"])
+    }
+
+    // MARK: - Recovery
+
+    func testLoad_tornJournalTail_isDroppedAndTruncated() throws {
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        store.writeSync(["a": makeRecord("a")])
+        store.writeSync(["b": makeRecord("b")])
+        let journalUrl = store.journalUrl
+        let journal = try Data(contentsOf: journalUrl)
+        let intactLength = store.currentJournalSize
+
+        // Simulate a crash in the middle of the next append.
+        let handle = try FileHandle(forWritingTo: journalUrl)
+        try handle.seekToEnd()
+        try handle.write(contentsOf: journal.prefix(journal.count / 3))
+        try handle.close()
+
+        let recovered = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        XCTAssertEqual(Set(recovered.load().keys), ["a", "b"])
+        XCTAssertEqual(try Data(contentsOf: journalUrl).count, intactLength)
+
+        recovered.writeSync(["c": makeRecord("c")])
+        XCTAssertEqual(Set(reloadedRecords().keys), ["a", "b", "c"])
+    }
+
+    func testLoad_corruptedFrame_stopsReplay() throws {
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        store.writeSync(["a": makeRecord("a")])
+        let firstFrameLength = store.currentJournalSize
+        store.writeSync(["b": makeRecord("b")])
+
+        var journal = try Data(contentsOf: store.journalUrl)
+        journal[firstFrameLength + 20] ^= 0xFF
+        try journal.write(to: store.journalUrl)
+
+        XCTAssertEqual(Set(reloadedRecords().keys), ["a"])
+    }
+
+    // MARK: - Migration
+
+    func testLoad_legacyRegistryFile_isReadAsSnapshot() throws {
+        try writeLegacyRegistry(["a", "b", "c"])
+
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        XCTAssertEqual(Set(store.load().keys), ["a", "b", "c"])
+
+        store.write(["b": nil, "d": makeRecord("d")])
+        store.flush()
+
+        XCTAssertEqual(Set(reloadedRecords().keys), ["a", "c", "d"])
+    }
+
+    // MARK: - Compaction
+
+    func testCompaction_writesSnapshotAndClearsJournal() throws {
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        let recordSize = try JSONSerialization.data(withJSONObject: makeRecord("0")).count
+        let writes = TPPBookRegistryStore.minimumCompactionSize / recordSize + 10
+
+        for index in 0..<writes {
+            store.write(["\(index % 5)": makeRecord("\(index % 5)")])
+        }
+        store.flush()
+
+        XCTAssertTrue(FileManager.default.fileExists(atPath: snapshotUrl.path))
+        XCTAssertLessThan(store.currentJournalSize, TPPBookRegistryStore.minimumCompactionSize)
+
+        let snapshot = try JSONSerialization.jsonObject(with: Data(contentsOf: snapshotUrl)) as? TPPBookRegistryData
+        XCTAssertEqual(snapshot?.array(for: .records)?.count, 5)
+        XCTAssertEqual(Set(reloadedRecords().keys), ["0", "1", "2", "3", "4"])
+    }
+
+    func testCompaction_afterSyncWrites_keepsEveryRecord() throws {
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        let recordSize = try JSONSerialization.data(withJSONObject: makeRecord("0")).count
+        let writes = TPPBookRegistryStore.minimumCompactionSize / recordSize + 10
+
+        for index in 0..<writes {
+            store.writeSync(["\(index)": makeRecord("\(index)")])
+        }
+        store.flush()
+
+        XCTAssertFalse(FileManager.default.fileExists(atPath: snapshotUrl.path + ".tmp"))
+        XCTAssertEqual(reloadedRecords().count, writes)
+    }
+
+    func testRemoveAll_deletesFiles() throws {
+        try writeLegacyRegistry(["a"])
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        store.writeSync(["b": makeRecord("b")])
+
+        store.removeAll()
+
+        XCTAssertFalse(FileManager.default.fileExists(atPath: snapshotUrl.path))
+        XCTAssertFalse(FileManager.default.fileExists(atPath: store.journalUrl.path))
+        XCTAssertTrue(store.load().isEmpty)
+    }
+
+    // MARK: - Sync Validators
+
+    func testSyncValidators_roundTrip() throws {
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        let loansUrl = try XCTUnwrap(URL(string: "https://example.com/loans"))
+        let validators = TPPBookRegistryStore.SyncValidators(url: loansUrl, eTag: "\"abc\"", lastModified: nil)
+
+        store.saveSyncValidators(validators)
+
+        XCTAssertEqual(TPPBookRegistryStore(snapshotUrl: snapshotUrl).loadSyncValidators(), validators)
+        XCTAssertEqual(validators?.requestHeaders, ["If-None-Match": "\"abc\""])
+    }
+
+    func testSyncValidators_fromResponse() throws {
+        let loansUrl = try XCTUnwrap(URL(string: "https://example.com/loans"))
+        let response = try XCTUnwrap(HTTPURLResponse(url: loansUrl, statusCode: 200, httpVersion: nil, headerFields: [
+            "ETag": "W/\"1\"",
+            "Last-Modified": "Wed, 21 Oct 2015 07:28:00 GMT"
+        ]))
+        let bare = try XCTUnwrap(HTTPURLResponse(url: loansUrl, statusCode: 200, httpVersion: nil, headerFields: nil))
+
+        let validators = TPPBookRegistryStore.SyncValidators(url: loansUrl, response: response)
+
+        XCTAssertEqual(validators?.requestHeaders, [
+            "If-None-Match": "W/\"1\"",
+            "If-Modified-Since": "Wed, 21 Oct 2015 07:28:00 GMT"
+        ])
+        XCTAssertNil(TPPBookRegistryStore.SyncValidators(url: loansUrl, response: bare))
+    }
+
+    func testSyncValidators_areRemovedWithRecords() throws {
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        let loansUrl = try XCTUnwrap(URL(string: "https://example.com/loans"))
+        store.writeSync(["a": makeRecord("a")])
+        store.saveSyncValidators(TPPBookRegistryStore.SyncValidators(url: loansUrl, eTag: "1", lastModified: nil))
+        store.flush()
+
+        store.removeAll()
+
+        XCTAssertNil(store.loadSyncValidators())
+    }
+
+    // MARK: - Performance Tests
+
+    /// Save latency for one changed record (e.g. a page turn) against registry size.
+    private func measureSingleRecordSave(registrySize: Int) throws {
+        try writeLegacyRegistry((0..<registrySize).map { "\($0)" })
+        let store = TPPBookRegistryStore(snapshotUrl: snapshotUrl)
+        _ = store.load()
+        let record = makeRecord("0", state: .used)
+
+        measure {
+            for _ in 0..<100 {
+                store.write(["0": record])
+            }
+            store.flush()
+        }
+    }
+
+    func testPerformance_saveOneRecord_100Books() throws {
+        try measureSingleRecordSave(registrySize: 100)
+    }
+
+    func testPerformance_saveOneRecord_1000Books() throws {
+        try measureSingleRecordSave(registrySize: 1000)
+    }
+
+    /// Baseline: the whole-file JSON rewrite previously done for every change.
+    func testPerformance_wholeRegistryRewrite_1000Books() throws {
+        try FileManager.default.createDirectory(at: snapshotUrl.deletingLastPathComponent(), withIntermediateDirectories: true)
+        let records = (0..<1000).map { makeRecord("\($0)") }
+
+        measure {
+            for _ in 0..<100 {
+                let registryObject = [TPPBookRegistryKey.records.rawValue: records]
+                let data = try? JSONSerialization.data(withJSONObject: registryObject, options: .fragmentsAllowed)
+                try? data?.write(to: snapshotUrl, options: .atomic)
+            }
+        }
+    }
+
+    // MARK: - Cold Start Benchmark
+
+    /// Writes a registry of `count` books with `bookmarkCount` bookmarks each, as a heavy reader has.
+    private func writeLargeRegistry(count: Int, bookmarkCount: Int = 20) throws {
+        try FileManager.default.createDirectory(at: snapshotUrl.deletingLastPathComponent(), withIntermediateDirectories: true)
+        let acquisition = TPPFake.genericAcquisition.dictionaryRepresentation()
+        let records: [[String: Any]] = (0..<count).map { index in
+            let bookmarks = (0..<bookmarkCount).map { page in
+                ["locationString": "{\"page\": \(page)}", "renderer": "TestRenderer"]
+            }
+            return [
+                TPPBookRegistryKey.book.rawValue: [
+                    "id": "book-\(index)",
+                    "title": "Book \(index)",
+                    "categories": ["Fiction"],
+                    "authors": ["Author \(index)"],
+                    "updated": "2024-01-01T00:00:00Z",
+                    "acquisitions": [acquisition]
+                ],
+                TPPBookRegistryKey.state.rawValue: TPPBookState.downloadSuccessful.stringValue(),
+                TPPBookRegistryKey.genericBookmarks.rawValue: bookmarks
+            ]
+        }
+        let data = try JSONSerialization.data(withJSONObject: [TPPBookRegistryKey.records.rawValue: records])
+        try data.write(to: snapshotUrl)
+    }
+
+    /// Launch path: read the registry and build the record index.
+    private func measureColdStart(count: Int, decodeAll: Bool) throws {
+        try writeLargeRegistry(count: count)
+
+        measure {
+            let records = TPPBookRegistryStore(snapshotUrl: snapshotUrl).load()
+                .values
+                .compactMap { TPPBookRegistryRecord(record: $0) }
+            XCTAssertEqual(records.count, count)
+            if decodeAll {
+                // What loading did before records were decoded lazily.
+                for record in records {
+                    _ = record.book
+                    _ = record.location
+                    _ = record.genericBookmarks
+                    _ = record.readiumBookmarks
+                }
+            }
+        }
+    }
+
+    func testPerformance_coldStart_100Books() throws {
+        try measureColdStart(count: 100, decodeAll: false)
+    }
+
+    func testPerformance_coldStart_1000Books() throws {
+        try measureColdStart(count: 1000, decodeAll: false)
+    }
+
+    func testPerformance_coldStartDecodingAllRecords_1000Books() throws {
+        try measureColdStart(count: 1000, decodeAll: true)
+    }
+}
@@ -86,6 +86,93 @@ final class TPPBookRegistryRecordPersistenceTests: XCTestCase {
     }
 }
 
+// MARK: - Lazy Record Decoding Tests
+
+final class TPPBookRegistryRecordLazyDecodingTests: XCTestCase {
+
+    private func makeRecordData(identifier: String = "lazy-test") -> TPPBookRegistryData {
+        let book = TPPBookMocker.mockBook(identifier: identifier, title: "Lazy Book", distributorType: .EpubZip)
+        let location = TPPBookLocation(locationString: "{\"page\": 7}", renderer: "TestRenderer")
+        let bookmarks = (0..<3).compactMap { TPPBookLocation(locationString: "{\"page\": \($0)}", renderer: "TestRenderer") }
+        return TPPBookRegistryRecord(
+            book: book,
+            location: location,
+            state: .downloadSuccessful,
+            fulfillmentId: "lazy-fulfillment",
+            genericBookmarks: bookmarks
+        ).dictionaryRepresentation
+    }
+
+    func testRecordFromDictionary_DefersBookDecoding() {
+        let record = TPPBookRegistryRecord(record: makeRecordData())
+
+        XCTAssertNotNil(record)
+        XCTAssertEqual(record?.identifier, "lazy-test")
+        XCTAssertEqual(record?.title, "Lazy Book")
+        XCTAssertEqual(record?.state, .downloadSuccessful)
+        XCTAssertTrue(record?.isBookEncoded ?? false)
+
+        XCTAssertEqual(record?.book.identifier, "lazy-test")
+        XCTAssertFalse(record?.isBookEncoded ?? true)
+    }
+
+    func testRecordFromDictionary_DecodesLocationAndBookmarksOnAccess() {
+        let record = TPPBookRegistryRecord(record: makeRecordData())
+
+        XCTAssertEqual(record?.location?.locationString, "{\"page\": 7}")
+        XCTAssertEqual(record?.genericBookmarks?.count, 3)
+        XCTAssertEqual(record?.readiumBookmarks?.count, 0)
+    }
+
+    func testRecordFromDictionary_InvalidBook_ReturnsNil() {
+        var data = makeRecordData()
+        var bookData = data.object(for: .book)
+        bookData?["updated"] = "not a date"
+        data.setValue(bookData, for: .book)
+
+        XCTAssertNil(TPPBookRegistryRecord(record: data))
+    }
+
+    func testUndecodedRecord_DictionaryRepresentationRoundTrips() {
+        guard let record = TPPBookRegistryRecord(record: makeRecordData()) else {
+            return XCTFail("Record should decode")
+        }
+        record.state = .used
+
+        let restored = TPPBookRegistryRecord(record: record.dictionaryRepresentation)
+
+        XCTAssertTrue(record.isBookEncoded, "Serializing should not decode the book")
+        XCTAssertEqual(restored?.state, .used)
+        XCTAssertEqual(restored?.fulfillmentId, "lazy-fulfillment")
+        XCTAssertEqual(restored?.genericBookmarks?.count, 3)
+        XCTAssertEqual(restored?.book.title, "Lazy Book")
+    }
+
+    func testSettingBookmarksReplacesUndecodedPayload() {
+        let record = TPPBookRegistryRecord(record: makeRecordData())
+
+        record?.genericBookmarks = []
+
+        XCTAssertEqual(record?.genericBookmarks?.count, 0)
+        XCTAssertEqual((record?.dictionaryRepresentation["genericBookmarks"] as? [Any])?.count, 0)
+    }
+
+    func testConcurrentAccess_DecodesBookOnce() {
+        guard let record = TPPBookRegistryRecord(record: makeRecordData()) else {
+            return XCTFail("Record should decode")
+        }
+        let books = UnsafeMutableBufferPointer<TPPBook?>.allocate(capacity: 16)
+        books.initialize(repeating: nil)
+        defer { books.deallocate() }
+
+        DispatchQueue.concurrentPerform(iterations: 16) { index in
+            books[index] = record.book
+        }
+
+        XCTAssertTrue(books.allSatisfy { $0 === books[0] })
+    }
+}
+
 // MARK: - TPPBookRegistryData Extension Tests
 
 final class TPPBookRegistryDataTests: XCTestCase {
@@ -395,6 +482,107 @@ final class DeriveInitialStateTests: XCTestCase {
     }
 }
 
+// MARK: - TPPBookRegistryChange Tests
+
+final class TPPBookRegistryChangeTests: XCTestCase {
+
+    func testEmptyChange() {
+        XCTAssertTrue(TPPBookRegistryChange().isEmpty)
+        XCTAssertFalse(TPPBookRegistryChange(isReload: true).isEmpty)
+        XCTAssertFalse(TPPBookRegistryChange(locationChanged: ["a"]).isEmpty)
+    }
+
+    func testIsLocationOnly() {
+        XCTAssertTrue(TPPBookRegistryChange(locationChanged: ["a", "b"]).isLocationOnly)
+        XCTAssertFalse(TPPBookRegistryChange().isLocationOnly)
+        XCTAssertFalse(TPPBookRegistryChange(stateChanged: ["a"], locationChanged: ["a"]).isLocationOnly)
+        XCTAssertFalse(TPPBookRegistryChange(locationChanged: ["a"], isReload: true).isLocationOnly)
+    }
+
+    func testAffects() {
+        let change = TPPBookRegistryChange(inserted: ["a"], updated: ["b"])
+
+        XCTAssertTrue(change.affects("a"))
+        XCTAssertTrue(change.affects("b"))
+        XCTAssertFalse(change.affects("c"))
+        XCTAssertTrue(TPPBookRegistryChange(isReload: true).affects("c"))
+    }
+
+    func testMerge_unionsIdentifiers() {
+        var change = TPPBookRegistryChange(stateChanged: ["a"], locationChanged: ["b"])
+        change.merge(TPPBookRegistryChange(stateChanged: ["c"], updated: ["a"]))
+
+        XCTAssertEqual(change.stateChanged, ["a", "c"])
+        XCTAssertEqual(change.locationChanged, ["b"])
+        XCTAssertEqual(change.updated, ["a"])
+        XCTAssertFalse(change.isReload)
+    }
+
+    func testMerge_laterRemovalCancelsInsertion() {
+        var change = TPPBookRegistryChange(inserted: ["a", "b"])
+        change.merge(TPPBookRegistryChange(removed: ["a"]))
+
+        XCTAssertEqual(change.inserted, ["b"])
+        XCTAssertEqual(change.removed, ["a"])
+
+        change.merge(TPPBookRegistryChange(inserted: ["a"]))
+
+        XCTAssertEqual(change.inserted, ["a", "b"])
+        XCTAssertTrue(change.removed.isEmpty)
+    }
+}
+
+// MARK: - TPPBookFingerprint Tests
+
+final class TPPBookFingerprintTests: XCTestCase {
+
+    private func makeBook() throws -> TPPBook {
+        try XCTUnwrap(TPPBook(entry: TPPFake.opdsEntry))
+    }
+
+    func testEntryAndBookBuiltFromIt_match() throws {
+        let entry = TPPFake.opdsEntry
+        let book = try XCTUnwrap(TPPBook(entry: entry))
+
+        XCTAssertEqual(TPPBookFingerprint(entry: entry), TPPBookFingerprint(book: book))
+    }
+
+    func testPersistedBook_matchesEntry() throws {
+        let entry = TPPFake.opdsEntry
+        let book = try makeBook()
+        let persisted = try XCTUnwrap(TPPBook(dictionary: book.dictionaryRepresentation()))
+
+        XCTAssertEqual(TPPBookFingerprint(entry: entry), TPPBookFingerprint(book: persisted))
+    }
+
+    func testUpdatedDate_changesFingerprint() throws {
+        let book = try makeBook()
+        var dictionary = book.dictionaryRepresentation()
+        dictionary["updated"] = book.updated.addingTimeInterval(60).rfc339String
+        let updatedBook = try XCTUnwrap(TPPBook(dictionary: dictionary))
+
+        XCTAssertNotEqual(TPPBookFingerprint(book: book), TPPBookFingerprint(book: updatedBook))
+    }
+
+    func testAvailability_changesFingerprint() throws {
+        let book = try makeBook()
+        let reserved = book.acquisitions.map {
+            TPPOPDSAcquisition(
+                relation: $0.relation,
+                type: $0.type,
+                hrefURL: $0.hrefURL,
+                indirectAcquisitions: $0.indirectAcquisitions,
+                availability: TPPOPDSAcquisitionAvailabilityReserved(holdPosition: 3, copiesTotal: 5, since: nil, until: nil)
+            )
+        }
+        var dictionary = book.dictionaryRepresentation()
+        dictionary["acquisitions"] = reserved.map { $0.dictionaryRepresentation() }
+        let reservedBook = try XCTUnwrap(TPPBook(dictionary: dictionary))
+
+        XCTAssertNotEqual(TPPBookFingerprint(book: book), TPPBookFingerprint(book: reservedBook))
+    }
+}
+
 // MARK: - TPPBookRegistry Load Re-entrancy Tests
 
 /// Tests for the re-entrancy guard added to prevent EXC_BAD_ACCESS crashes
@@ -473,4 +661,30 @@ final class TPPBookRegistryLoadReentrancyTests: XCTestCase {
         }
     }
 
+    /// Observers of the reload change see the registry as loaded.
+    func testLoad_PublishesReloadAfterStateIsLoaded() {
+        guard AccountsManager.shared.currentAccountId != nil else {
+            return
+        }
+
+        // Let a load started by an earlier test finish, see above
+        RunLoop.current.run(until: Date(timeIntervalSinceNow: 0.5))
+
+        let reloaded = expectation(description: "Reload published")
+        var stateAtReload: TPPBookRegistry.RegistryState?
+        registry.changePublisher
+            .filter { $0.isReload }
+            .first()
+            .sink { [registry] _ in
+                stateAtReload = registry?.state
+                reloaded.fulfill()
+            }
+            .store(in: &cancellables)
+
+        registry.load()
+
+        wait(for: [reloaded], timeout: 5.0)
+        XCTAssertEqual(stateAtReload, .loaded)
+    }
+
 }
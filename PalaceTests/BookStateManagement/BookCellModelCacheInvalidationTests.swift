@@ -177,4 +177,48 @@ final class BookCellModelCacheInvalidationTests: XCTestCase {
         XCTAssertFalse(model1Before === model1After, "Invalidated book should have new model")
         XCTAssertTrue(model2Before === model2After, "Other books should keep same model")
     }
+
+    // MARK: - Change-set Tests
+
+    private func publishChange(_ change: TPPBookRegistryChange) {
+        mockRegistry.sendChange(change)
+        RunLoop.main.run(until: Date(timeIntervalSinceNow: 0.1))
+    }
+
+    func testRemovedChangeInvalidatesOnlyRemovedBook() {
+        let book1 = createTestBook(id: "book-1")
+        let book2 = createTestBook(id: "book-2")
+        mockRegistry.addBook(book1, state: .downloadSuccessful)
+        mockRegistry.addBook(book2, state: .downloadSuccessful)
+        let model1Before = cache.model(for: book1)
+        let model2Before = cache.model(for: book2)
+
+        publishChange(TPPBookRegistryChange(removed: [book1.identifier]))
+
+        XCTAssertFalse(model1Before === cache.model(for: book1))
+        XCTAssertTrue(model2Before === cache.model(for: book2))
+    }
+
+    func testUpdatedChangeRefreshesCachedModelBook() {
+        let book = createTestBook(id: "book-1")
+        mockRegistry.addBook(book, state: .holding)
+        let model = cache.model(for: book)
+
+        let updatedBook = createTestBook(id: "book-1")
+        mockRegistry.registry[book.identifier]?.book = updatedBook
+        publishChange(TPPBookRegistryChange(updated: [book.identifier]))
+
+        XCTAssertTrue(cache.model(for: updatedBook) === model, "Updated book should keep its model")
+        XCTAssertTrue(model.book === updatedBook)
+    }
+
+    func testLocationChangeKeepsModels() {
+        let book = createTestBook()
+        mockRegistry.addBook(book, state: .downloadSuccessful)
+        let model = cache.model(for: book)
+
+        publishChange(TPPBookRegistryChange(locationChanged: [book.identifier]))
+
+        XCTAssertTrue(cache.model(for: book) === model)
+    }
 }
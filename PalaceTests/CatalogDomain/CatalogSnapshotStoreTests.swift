@@ -0,0 +1,117 @@
+//
+//  CatalogSnapshotStoreTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+final class CatalogSnapshotStoreTests: XCTestCase {
+
+    private var directory: URL!
+    private var sut: CatalogSnapshotStore!
+
+    private let catalogURL = URL(string: "https://library.example.com/catalog")!
+
+    override func setUp() {
+        super.setUp()
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent("CatalogSnapshotStoreTests-\(UUID().uuidString)")
+        sut = CatalogSnapshotStore(directory: directory)
+    }
+
+    override func tearDown() {
+        sut.removeAll()
+        sut = nil
+        directory = nil
+        super.tearDown()
+    }
+
+    // MARK: - Helpers
+
+    private func makeSnapshot(laneCount: Int, booksPerLane: Int, savedAt: Date = Date()) -> CatalogSnapshot {
+        let lanes = (0..<laneCount).map { lane in
+            CatalogLaneModel(
+                title: "Lane \(lane)",
+                books: (0..<booksPerLane).map { TPPBookMocker.mockBook(identifier: "book-\(lane)-\($0)", title: "Book \($0)", authors: "Author") },
+                moreURL: URL(string: "https://library.example.com/lanes/\(lane)")
+            )
+        }
+        let sortBy = CatalogFilterGroup(id: "Sort by", name: "Sort by", filters: [
+            CatalogFilter(id: "title", title: "Title", href: URL(string: "https://library.example.com/catalog?order=title"), active: true),
+            CatalogFilter(id: "author", title: "Author", href: URL(string: "https://library.example.com/catalog?order=author"), active: false)
+        ])
+        return CatalogSnapshot(
+            title: "Main Library",
+            lanes: lanes,
+            ungroupedBooks: [],
+            facetGroups: [sortBy],
+            entryPoints: [CatalogFilter(id: "ebooks", title: "eBooks", href: URL(string: "https://library.example.com/catalog?entrypoint=Book"), active: true)],
+            savedAt: savedAt
+        )
+    }
+
+    // MARK: - Tests
+
+    func testSnapshot_roundTripsLanesBooksAndFacets() throws {
+        let snapshot = makeSnapshot(laneCount: 3, booksPerLane: 4)
+        sut.save(snapshot, for: catalogURL)
+
+        let loaded = try XCTUnwrap(sut.snapshot(for: catalogURL))
+
+        XCTAssertEqual(loaded.title, "Main Library")
+        XCTAssertEqual(loaded.lanes.map(\.title), ["Lane 0", "Lane 1", "Lane 2"])
+        XCTAssertEqual(loaded.lanes[1].moreURL, URL(string: "https://library.example.com/lanes/1"))
+        XCTAssertEqual(loaded.lanes[2].books.map(\.identifier), snapshot.lanes[2].books.map(\.identifier))
+        XCTAssertEqual(loaded.lanes[2].books.first?.title, "Book 0")
+        XCTAssertNotNil(loaded.lanes[2].books.first?.defaultAcquisition)
+        XCTAssertEqual(loaded.facetGroups, snapshot.facetGroups)
+        XCTAssertEqual(loaded.entryPoints, snapshot.entryPoints)
+        XCTAssertEqual(loaded.savedAt.timeIntervalSince1970, snapshot.savedAt.timeIntervalSince1970, accuracy: 0.001)
+    }
+
+    func testSnapshot_isKeptPerCatalog() {
+        sut.save(makeSnapshot(laneCount: 1, booksPerLane: 1), for: catalogURL)
+
+        XCTAssertNil(sut.snapshot(for: URL(string: "https://other.example.com/catalog")!))
+        XCTAssertNotNil(sut.snapshot(for: catalogURL))
+    }
+
+    func testSnapshot_tooOld_isRemoved() {
+        let savedAt = Date().addingTimeInterval(-CatalogSnapshotStore.maxAge - 60)
+        sut.save(makeSnapshot(laneCount: 1, booksPerLane: 1, savedAt: savedAt), for: catalogURL)
+
+        XCTAssertNil(sut.snapshot(for: catalogURL))
+        XCTAssertEqual((try? FileManager.default.contentsOfDirectory(atPath: directory.path))?.count, 0)
+    }
+
+    func testSnapshot_unreadable_isIgnored() throws {
+        sut.save(makeSnapshot(laneCount: 1, booksPerLane: 1), for: catalogURL)
+        let file = try XCTUnwrap(FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: nil).first)
+        try Data("not json".utf8).write(to: file)
+
+        XCTAssertNil(sut.snapshot(for: catalogURL))
+    }
+
+    func testRepository_savesAndLoadsSnapshot() async {
+        let repository = CatalogRepository(api: CatalogAPIMock(), snapshotStore: sut)
+        repository.saveSnapshot(makeSnapshot(laneCount: 2, booksPerLane: 2), for: catalogURL)
+
+        let loaded = await repository.snapshot(for: catalogURL)
+
+        XCTAssertEqual(loaded?.lanes.count, 2)
+    }
+
+    // MARK: - Benchmark
+
+    /// Loads a typical top-level catalog snapshot, the time it adds before
+    /// the first lane shows on a cold start.
+    func testBenchmark_loadSnapshot() {
+        sut.save(makeSnapshot(laneCount: 12, booksPerLane: 20), for: catalogURL)
+
+        measure {
+            XCTAssertEqual(sut.snapshot(for: catalogURL)?.lanes.count, 12)
+        }
+    }
+}
@@ -81,4 +81,86 @@ class Date_NYPLAdditionsTests: XCTestCase {
         XCTAssertEqual(dateString, "1984-09-08T08:23:45Z")
     }
 
+    func testParsesRFC3339DateWithOffsets() {
+        let utc = NSDate(rfc3339String: "1984-09-08T08:23:45Z")
+        XCTAssertEqual(NSDate(rfc3339String: "1984-09-08T10:23:45+02:00"), utc)
+        XCTAssertEqual(NSDate(rfc3339String: "1984-09-08T02:53:45-05:30"), utc)
+        XCTAssertEqual(NSDate(rfc3339String: "1984-09-08T02:53:45-0530"), utc)
+    }
+
+    func testRFC3339ValidatesCalendarDates() {
+        XCTAssertNotNil(NSDate(rfc3339String: "2024-02-29T00:00:00Z"))
+        XCTAssertNil(NSDate(rfc3339String: "2023-02-29T00:00:00Z"))
+        XCTAssertNil(NSDate(rfc3339String: "2023-13-01T00:00:00Z"))
+        XCTAssertNil(NSDate(rfc3339String: "2023-01-01T25:00:00Z"))
+        XCTAssertNil(NSDate(rfc3339String: "2023-01-01"))
+    }
+
+    func testParsesRFC3339FractionalSeconds() {
+        let date = NSDate(rfc3339String: "1984-09-08T08:23:45.250Z")
+        XCTAssertEqual(date?.timeIntervalSince1970 ?? 0, 463_479_825.25, accuracy: 0.0001)
+    }
+
+    func testRFC3339StringBefore1970() {
+        let date = NSDate(timeIntervalSince1970: -1.5)
+        XCTAssertEqual(date.rfc3339String(), "1969-12-31T23:59:58Z")
+    }
+
+    func testRFC3339MatchesDateFormatter() {
+        let formatter = Self.makeRFC3339Formatter()
+        var generator = SystemRandomNumberGenerator()
+        for _ in 0..<1000 {
+            let date = Date(timeIntervalSince1970: TimeInterval(Int64.random(in: -2_000_000_000...4_000_000_000, using: &generator)))
+            let string = formatter.string(from: date)
+            XCTAssertEqual((date as NSDate).rfc3339String(), string)
+            XCTAssertEqual(NSDate(rfc3339String: string) as Date?, date)
+        }
+    }
+
+    func testISO8601FullDateIgnoresTime() {
+        let date = NSDate(iso8601DateString: "2020-06-02T16:59:56Z")
+        XCTAssertEqual(date, NSDate(iso8601DateString: "2020-06-02"))
+        XCTAssertEqual(date?.utcComponents().hour, 0)
+        XCTAssertNil(NSDate(iso8601DateString: "2020-06-31"))
+    }
+
+    // MARK: - Performance
+
+    private static func makeRFC3339Formatter() -> DateFormatter {
+        let formatter = DateFormatter()
+        formatter.locale = Locale(identifier: "en_US_POSIX")
+        formatter.timeZone = TimeZone(secondsFromGMT: 0)
+        formatter.dateFormat = "yyyy'-'MM'-'dd'T'HH':'mm':'ss'Z'"
+        return formatter
+    }
+
+    /// Baseline: what RFC 3339 parsing cost with a shared DateFormatter.
+    func testRFC3339FormatterParsingPerformance() {
+        let formatter = Self.makeRFC3339Formatter()
+        formatter.dateFormat = "yyyy'-'MM'-'dd'T'HH':'mm':'ssX5"
+
+        measure {
+            for _ in 0..<10_000 {
+                _ = formatter.date(from: "2014-06-02T16:59:56Z")
+            }
+        }
+    }
+
+    func testRFC3339ParsingPerformance() {
+        measure {
+            for _ in 0..<10_000 {
+                _ = NSDate(rfc3339String: "2014-06-02T16:59:56Z")
+            }
+        }
+    }
+
+    func testRFC3339FormattingPerformance() {
+        let date = NSDate(timeIntervalSince1970: 1_000_000_000)
+
+        measure {
+            for _ in 0..<10_000 {
+                _ = date.rfc3339String()
+            }
+        }
+    }
 }
@@ -58,6 +58,9 @@ final class CatalogRepositoryTestMock: CatalogRepositoryProtocol {
     /// The last URL passed to invalidateCache
     private(set) var lastInvalidatedURL: URL?
 
+    /// Snapshots passed to saveSnapshot, returned by snapshot(for:)
+    var snapshots: [URL: CatalogSnapshot] = [:]
+
     /// All URLs that were loaded
     private(set) var loadHistory: [URL] = []
 
@@ -111,6 +114,14 @@ final class CatalogRepositoryTestMock: CatalogRepositoryProtocol {
         lastInvalidatedURL = url
     }
 
+    func snapshot(for url: URL) async -> CatalogSnapshot? {
+        snapshots[url]
+    }
+
+    func saveSnapshot(_ snapshot: CatalogSnapshot, for url: URL) {
+        snapshots[url] = snapshot
+    }
+
     // MARK: - Test Helpers
 
     /// Resets all tracking state
@@ -128,6 +139,7 @@ final class CatalogRepositoryTestMock: CatalogRepositoryProtocol {
         lastSearchQuery = nil
         lastSearchBaseURL = nil
         lastInvalidatedURL = nil
+        snapshots.removeAll()
         loadHistory.removeAll()
         searchHistory.removeAll()
     }
@@ -8,6 +8,7 @@ class TPPBookRegistryMock: NSObject, TPPBookRegistryProvider {
     // MARK: - Publishers
     private let registrySubject = CurrentValueSubject<[String: TPPBookRegistryRecord], Never>([:])
     private let bookStateSubject = CurrentValueSubject<(String, TPPBookState), Never>(("", .unregistered))
+    private let changeSubject = PassthroughSubject<TPPBookRegistryChange, Never>()
     var isSyncing: Bool = false
 
     var registryPublisher: AnyPublisher<[String: TPPBookRegistryRecord], Never> {
@@ -18,6 +19,15 @@ class TPPBookRegistryMock: NSObject, TPPBookRegistryProvider {
         bookStateSubject.eraseToAnyPublisher()
     }
 
+    var changePublisher: AnyPublisher<TPPBookRegistryChange, Never> {
+        changeSubject.eraseToAnyPublisher()
+    }
+
+    /// Publishes a change-set as `TPPBookRegistry` does after mutations.
+    func sendChange(_ change: TPPBookRegistryChange) {
+        changeSubject.send(change)
+    }
+
     // MARK: - Mock Data Storage
     var registry = [String: TPPBookRegistryRecord]()
     private var processingBooks = Set<String>()
@@ -0,0 +1,99 @@
+//
+//  DownloadCompletionPipelineTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+final class DownloadCompletionPipelineTests: XCTestCase {
+
+    private actor Counter {
+        private(set) var current = 0
+        private(set) var peak = 0
+        private(set) var finished = 0
+
+        func enter() {
+            current += 1
+            peak = max(peak, current)
+        }
+
+        func leave() {
+            current -= 1
+            finished += 1
+        }
+    }
+
+    func testPerform_limitsConcurrentCompletions() async {
+        let pipeline = DownloadCompletionPipeline(maxConcurrent: 2)
+        let counter = Counter()
+
+        await withTaskGroup(of: Void.self) { group in
+            for _ in 0..<6 {
+                group.addTask {
+                    await pipeline.perform {
+                        await counter.enter()
+                        try? await Task.sleep(nanoseconds: 20_000_000)
+                        await counter.leave()
+                    }
+                }
+            }
+        }
+
+        let peak = await counter.peak
+        let finished = await counter.finished
+        XCTAssertEqual(peak, 2)
+        XCTAssertEqual(finished, 6)
+    }
+
+    func testSubmit_runsOffTheMainThread() {
+        let pipeline = DownloadCompletionPipeline()
+        let ran = expectation(description: "completion ran")
+
+        pipeline.submit {
+            XCTAssertFalse(Thread.isMainThread)
+            ran.fulfill()
+        }
+
+        wait(for: [ran], timeout: 5)
+    }
+}
+
+final class DownloadedFileSnifferTests: XCTestCase {
+
+    private var fileUrl: URL!
+
+    override func setUp() {
+        super.setUp()
+        fileUrl = FileManager.default.temporaryDirectory.appendingPathComponent("DownloadedFileSnifferTests-\(UUID().uuidString)")
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: fileUrl)
+        super.tearDown()
+    }
+
+    func testDocument_readsSmallFiles() throws {
+        let json = Data(#"{"access_token":"abc","location":"https://example.com/book.epub"}"#.utf8)
+        try json.write(to: fileUrl)
+
+        XCTAssertEqual(DownloadedFileSniffer.document(at: fileUrl), json)
+    }
+
+    func testDocument_skipsFilesLargerThanLimit() throws {
+        try Data(count: 2048).write(to: fileUrl)
+
+        XCTAssertNil(DownloadedFileSniffer.document(at: fileUrl, maximumLength: 1024))
+        XCTAssertNotNil(DownloadedFileSniffer.document(at: fileUrl, maximumLength: 2048))
+    }
+
+    func testIsAdobePDF_detectsPDFFormat() {
+        let pdf = Data("<fulfillmentToken><dc:format>application/pdf</dc:format></fulfillmentToken>".utf8)
+        let epub = Data("<fulfillmentToken><dc:format>application/epub+zip</dc:format></fulfillmentToken>".utf8)
+
+        XCTAssertTrue(DownloadedFileSniffer.isAdobePDF(acsm: pdf))
+        XCTAssertFalse(DownloadedFileSniffer.isAdobePDF(acsm: epub))
+    }
+}
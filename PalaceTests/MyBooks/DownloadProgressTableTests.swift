@@ -0,0 +1,123 @@
+//
+//  DownloadProgressTableTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+final class DownloadProgressTableTests: XCTestCase {
+
+    private func makeInfo(progress: CGFloat = 0, taskIdentifier: Int = 1) -> MyBooksDownloadInfo {
+        MyBooksDownloadInfo(
+            downloadProgress: progress,
+            downloadTask: MockURLSessionDownloadTask(taskIdentifier: taskIdentifier),
+            rightsManagement: .none
+        )
+    }
+
+    func testSetProgress_updatesInfoAndKeepsLatestValue() {
+        let table = DownloadProgressTable()
+        table.set("book-1", value: makeInfo())
+
+        XCTAssertTrue(table.setProgress(0.1, for: "book-1"))
+        XCTAssertFalse(table.setProgress(0.4, for: "book-1"))
+
+        XCTAssertEqual(table.progress(for: "book-1"), 0.4, accuracy: 0.0001)
+        XCTAssertEqual(table.takeUnpublishedProgress(), ["book-1": 0.4])
+        XCTAssertTrue(table.takeUnpublishedProgress().isEmpty)
+        XCTAssertTrue(table.setProgress(0.5, for: "book-1"))
+    }
+
+    func testRemove_dropsUnpublishedProgress() {
+        let table = DownloadProgressTable()
+        table.set("book-1", value: makeInfo())
+        table.setProgress(0.3, for: "book-1")
+
+        XCTAssertNotNil(table.remove("book-1"))
+
+        XCTAssertNil(table.get("book-1"))
+        XCTAssertEqual(table.progress(for: "book-1"), 0)
+        XCTAssertTrue(table.takeUnpublishedProgress().isEmpty)
+    }
+
+    func testChangedIdentifiers_collectedUntilTaken() {
+        let table = DownloadProgressTable()
+
+        XCTAssertTrue(table.scheduleBroadcast())
+        table.set("book-1", value: makeInfo(taskIdentifier: 1))
+        table.set("book-2", value: makeInfo(taskIdentifier: 2))
+        XCTAssertFalse(table.scheduleBroadcast())
+        table.remove("book-1")
+
+        XCTAssertEqual(table.takeChangedIdentifiers(), ["book-1", "book-2"])
+        XCTAssertTrue(table.takeChangedIdentifiers().isEmpty)
+        XCTAssertTrue(table.scheduleBroadcast())
+    }
+
+    func testSetProgress_marksBookChanged() {
+        let table = DownloadProgressTable()
+        table.set("book-1", value: makeInfo(taskIdentifier: 1))
+        table.set("book-2", value: makeInfo(taskIdentifier: 2))
+        _ = table.takeChangedIdentifiers()
+
+        table.setProgress(0.5, for: "book-2")
+
+        XCTAssertEqual(table.takeChangedIdentifiers(), ["book-2"])
+    }
+
+    func testChangeNotification_listsBooksWithNewProgress() {
+        let downloadCenter = MyBooksDownloadCenter(bookRegistry: TPPBookRegistryMock())
+        let notified = expectation(forNotification: .TPPMyBooksDownloadCenterDidChange, object: downloadCenter) { notification in
+            let identifiers = notification.userInfo?[TPPNotificationKeys.downloadCenterBookIdentifiersKey] as? [String]
+            return identifiers == ["book-1"]
+        }
+
+        downloadCenter.publishDownloadProgress(0.5, for: "book-1")
+        downloadCenter.broadcastUpdate()
+
+        wait(for: [notified], timeout: 5)
+    }
+
+    func testReads_doNotWaitOnConcurrentWriters() {
+        let table = DownloadProgressTable()
+        table.set("book-1", value: makeInfo())
+
+        DispatchQueue.concurrentPerform(iterations: 1_000) { index in
+            if index.isMultiple(of: 2) {
+                table.setProgress(Double(index) / 1_000, for: "book-1")
+            } else {
+                XCTAssertNotNil(table.get("book-1"))
+            }
+        }
+
+        XCTAssertNotNil(table.get("book-1"))
+    }
+
+    @MainActor
+    func testBroadcaster_publishesLatestProgressOncePerFrameThenStops() async throws {
+        let table = DownloadProgressTable()
+        var published = [(String, Double)]()
+        let broadcaster = DownloadProgressBroadcaster(table: table) { identifier, progress in
+            published.append((identifier, progress))
+        }
+
+        for step in 1...50 {
+            table.setProgress(Double(step) / 100, for: "book-1")
+            table.setProgress(Double(step) / 200, for: "book-2")
+        }
+        broadcaster.start()
+        XCTAssertTrue(broadcaster.isRunning)
+
+        // A few frames: one publishes, the next finds nothing and stops.
+        for _ in 0..<20 where broadcaster.isRunning {
+            try await Task.sleep(nanoseconds: 50_000_000)
+        }
+
+        XCTAssertFalse(broadcaster.isRunning)
+        XCTAssertEqual(published.count, 2)
+        XCTAssertEqual(Dictionary(uniqueKeysWithValues: published), ["book-1": 0.5, "book-2": 0.25])
+    }
+}
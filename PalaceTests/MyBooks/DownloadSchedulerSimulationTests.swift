@@ -0,0 +1,339 @@
+//
+//  DownloadSchedulerSimulationTests.swift
+//  PalaceTests
+//
+//  Simulation of download scheduling. Books are served by a local HTTP stub
+//  that shares a fixed bandwidth between the transfers in flight, and are
+//  admitted, suspended and resumed by `DownloadCoordinator`, the way
+//  `MyBooksDownloadCenter` does.
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+// MARK: - Throttled HTTP Stub
+
+/// Serves `bodySizes` over a simulated link of `bytesPerSecond`, split evenly
+/// between unpaused transfers.
+///
+/// URLProtocol-backed tasks keep loading while suspended, so the harness
+/// pauses their transfer on the link instead.
+final class ThrottledStubURLProtocol: URLProtocol {
+    static var bytesPerSecond = 4_000_000
+    private static let tickInterval: TimeInterval = 0.01
+
+    private static let linkQueue = DispatchQueue(label: "ThrottledStubURLProtocol.link")
+    private static var bodySizes = [URL: Int]()
+    private static var paused = Set<URL>()
+    private static var transfers = [ObjectIdentifier: ThrottledStubURLProtocol]()
+    private static var timer: DispatchSourceTimer?
+    private static var _requestCount = 0
+
+    /// Requests received since the last reset.
+    static var requestCount: Int {
+        linkQueue.sync { _requestCount }
+    }
+
+    private var remaining = 0
+    private var runLoop: RunLoop?
+
+    static func serve(_ url: URL, bytes: Int) {
+        linkQueue.sync { bodySizes[url] = bytes }
+    }
+
+    static func setPaused(_ isPaused: Bool, for url: URL) {
+        linkQueue.sync {
+            if isPaused {
+                paused.insert(url)
+            } else {
+                paused.remove(url)
+            }
+        }
+    }
+
+    static func reset() {
+        linkQueue.sync {
+            bodySizes.removeAll()
+            paused.removeAll()
+            transfers.removeAll()
+            _requestCount = 0
+            timer?.cancel()
+            timer = nil
+        }
+    }
+
+    override static func canInit(with request: URLRequest) -> Bool {
+        true
+    }
+
+    override static func canonicalRequest(for request: URLRequest) -> URLRequest {
+        request
+    }
+
+    override func startLoading() {
+        guard let url = request.url, let size = Self.linkQueue.sync(execute: { Self.bodySizes[url] }) else {
+            client?.urlProtocol(self, didFailWithError: URLError(.fileDoesNotExist))
+            return
+        }
+
+        runLoop = RunLoop.current
+        remaining = size
+        let response = HTTPURLResponse(url: url, statusCode: 200, httpVersion: "HTTP/1.1",
+                                       headerFields: ["Content-Length": "\(size)"])!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+
+        Self.linkQueue.sync {
+            Self._requestCount += 1
+            Self.transfers[ObjectIdentifier(self)] = self
+            Self.startTimerIfNeeded()
+        }
+    }
+
+    override func stopLoading() {
+        _ = Self.linkQueue.sync {
+            Self.transfers.removeValue(forKey: ObjectIdentifier(self))
+        }
+    }
+
+    /// Must be called on `linkQueue`.
+    private static func startTimerIfNeeded() {
+        guard timer == nil else { return }
+        let timer = DispatchSource.makeTimerSource(queue: linkQueue)
+        timer.schedule(deadline: .now() + tickInterval, repeating: tickInterval)
+        timer.setEventHandler { tick() }
+        timer.resume()
+        self.timer = timer
+    }
+
+    /// Must be called on `linkQueue`.
+    private static func tick() {
+        let flowing = transfers.values.filter { !paused.contains($0.request.url!) }
+        guard !flowing.isEmpty else { return }
+
+        let share = max(1, Int(Double(bytesPerSecond) * tickInterval) / flowing.count)
+        for transfer in flowing {
+            let count = min(share, transfer.remaining)
+            transfer.remaining -= count
+            let isFinished = transfer.remaining == 0
+            if isFinished {
+                transfers.removeValue(forKey: ObjectIdentifier(transfer))
+            }
+            transfer.runLoop?.perform {
+                transfer.client?.urlProtocol(transfer, didLoad: Data(count: count))
+                if isFinished {
+                    transfer.client?.urlProtocolDidFinishLoading(transfer)
+                }
+            }
+        }
+    }
+}
+
+// MARK: - Harness
+
+/// Forwards transfer events of the simulated downloads.
+private final class SimulationSessionDelegate: NSObject, URLSessionDataDelegate {
+    weak var simulation: DownloadSchedulerSimulation?
+
+    func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive data: Data) {
+        guard let identifier = dataTask.taskDescription else { return }
+        let count = data.count
+        Task { await simulation?.didReceive(count, for: identifier) }
+    }
+
+    func urlSession(_ session: URLSession, task: URLSessionTask, didCompleteWithError error: Error?) {
+        guard let identifier = task.taskDescription, error == nil else { return }
+        Task { await simulation?.didFinish(identifier) }
+    }
+}
+
+/// Downloads stubbed books, leaving every scheduling decision to a
+/// `DownloadCoordinator`: admission, preemption, resuming from the pending
+/// queue and the throughput-based concurrency limit.
+private actor DownloadSchedulerSimulation {
+    let coordinator = DownloadCoordinator()
+    private let session: URLSession
+    private let maxConcurrent: Int
+
+    private var urls = [String: URL]()
+    private var tasks = [String: URLSessionDataTask]()
+    private(set) var suspended = [String]()
+    private(set) var resumed = [String]()
+    private(set) var finishOrder = [String]()
+    private var finishWaiter: (count: Int, continuation: CheckedContinuation<Void, Never>)?
+
+    init(maxConcurrent: Int) {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [ThrottledStubURLProtocol.self]
+        configuration.httpMaximumConnectionsPerHost = 16
+        let delegate = SimulationSessionDelegate()
+        self.session = URLSession(configuration: configuration, delegate: delegate, delegateQueue: nil)
+        self.maxConcurrent = maxConcurrent
+        delegate.simulation = self
+    }
+
+    /// Requests a download, as `MyBooksDownloadCenter.startDownload(for:priority:)` does.
+    /// - Returns: `true` if it started right away, `false` if it was queued.
+    @discardableResult
+    func request(_ identifier: String, bytes: Int, priority: DownloadPriority) async -> Bool {
+        let url = URL(string: "https://stub.example.com/books/\(identifier)")!
+        ThrottledStubURLProtocol.serve(url, bytes: bytes)
+        urls[identifier] = url
+        await coordinator.setPriority(priority, for: identifier)
+
+        let canStart = await coordinator.admit(identifier, maxConcurrent: await limit()) { victim in
+            await self.suspend(victim)
+        }
+        if canStart {
+            await coordinator.registerStart(identifier: identifier)
+            start(identifier)
+        } else {
+            await coordinator.enqueuePending(Self.book(identifier))
+        }
+        return canStart
+    }
+
+    /// Waits until `count` downloads have finished.
+    func waitForFinishes(_ count: Int) async {
+        guard finishOrder.count < count else { return }
+        await withCheckedContinuation { finishWaiter = (count, $0) }
+    }
+
+    func cancelAll() {
+        session.invalidateAndCancel()
+    }
+
+    fileprivate func didReceive(_ bytes: Int, for identifier: String) async {
+        if await coordinator.recordProgress(identifier: identifier, bytes: Int64(bytes)) {
+            await schedulePending()
+        }
+    }
+
+    fileprivate func didFinish(_ identifier: String) async {
+        tasks.removeValue(forKey: identifier)
+        finishOrder.append(identifier)
+        await coordinator.registerCompletion(identifier: identifier)
+        await coordinator.clearScheduling(for: identifier)
+        await schedulePending()
+
+        if let finishWaiter, finishOrder.count >= finishWaiter.count {
+            self.finishWaiter = nil
+            finishWaiter.continuation.resume()
+        }
+    }
+
+    private func schedulePending() async {
+        let toStart = await coordinator.takePendingStarts(maxConcurrent: await limit()) { book in
+            self.resume(book.identifier)
+        }
+        for book in toStart {
+            await coordinator.registerStart(identifier: book.identifier)
+            start(book.identifier)
+        }
+    }
+
+    private func limit() async -> Int {
+        min(maxConcurrent, await coordinator.concurrencyLimit)
+    }
+
+    private func start(_ identifier: String) {
+        let task = session.dataTask(with: urls[identifier]!)
+        task.taskDescription = identifier
+        tasks[identifier] = task
+        task.resume()
+    }
+
+    /// URLProtocol-backed tasks keep loading while suspended, so the transfer
+    /// is paused on the link instead.
+    private func suspend(_ identifier: String) -> TPPBook? {
+        guard tasks[identifier] != nil, let url = urls[identifier] else { return nil }
+        ThrottledStubURLProtocol.setPaused(true, for: url)
+        suspended.append(identifier)
+        return Self.book(identifier)
+    }
+
+    private func resume(_ identifier: String) -> Bool {
+        guard tasks[identifier] != nil, let url = urls[identifier] else { return false }
+        ThrottledStubURLProtocol.setPaused(false, for: url)
+        resumed.append(identifier)
+        return true
+    }
+
+    private static func book(_ identifier: String) -> TPPBook {
+        TPPBookMocker.mockBook(identifier: identifier, title: identifier, distributorType: .EpubZip)
+    }
+}
+
+// MARK: - Tests
+
+final class DownloadSchedulerSimulationTests: XCTestCase {
+
+    private let audiobooks: Set<String> = ["audiobook-0", "audiobook-1", "audiobook-2"]
+
+    override func setUp() {
+        super.setUp()
+        ThrottledStubURLProtocol.reset()
+        ThrottledStubURLProtocol.bytesPerSecond = 4_000_000
+    }
+
+    override func tearDown() {
+        ThrottledStubURLProtocol.reset()
+        super.tearDown()
+    }
+
+    private func startAudiobooks(in simulation: DownloadSchedulerSimulation, priority: DownloadPriority) async {
+        for identifier in audiobooks.sorted() {
+            let started = await simulation.request(identifier, bytes: 1_000_000, priority: priority)
+            XCTAssertTrue(started, identifier)
+        }
+    }
+
+    /// Three audiobooks are downloading in the background when the patron
+    /// opens a book that isn't downloaded yet.
+    func testOpenedBook_suspendsBackgroundDownloadsAndFinishesFirst() async {
+        let simulation = DownloadSchedulerSimulation(maxConcurrent: 3)
+        await startAudiobooks(in: simulation, priority: .backgroundRedownload)
+
+        let started = await simulation.request("opened-book", bytes: 250_000, priority: .userOpen)
+        XCTAssertTrue(started, "The opened book doesn't wait for a free slot")
+        let suspended = await simulation.suspended
+        XCTAssertEqual(Set(suspended), audiobooks)
+        for identifier in audiobooks {
+            let isPending = await simulation.coordinator.isPending(identifier)
+            XCTAssertTrue(isPending, "\(identifier) waits in the pending queue")
+        }
+
+        // Prefetches wait while the opened book downloads, even with free slots
+        let prefetchStarted = await simulation.request("prefetch", bytes: 100_000, priority: .prefetch)
+        XCTAssertFalse(prefetchStarted)
+
+        await simulation.waitForFinishes(5)
+        await simulation.cancelAll()
+
+        let finishOrder = await simulation.finishOrder
+        XCTAssertEqual(finishOrder.first, "opened-book")
+        XCTAssertEqual(finishOrder.last, "prefetch", "Background downloads resume before prefetches start")
+        let resumed = await simulation.resumed
+        XCTAssertEqual(Set(resumed), audiobooks)
+        XCTAssertEqual(ThrottledStubURLProtocol.requestCount, 5, "Suspended downloads continue rather than start over")
+    }
+
+    /// Without a higher priority, a download waits for a free slot.
+    func testExplicitDownload_waitsForFreeSlotWithoutSuspending() async {
+        let simulation = DownloadSchedulerSimulation(maxConcurrent: 3)
+        await startAudiobooks(in: simulation, priority: .explicit)
+
+        let started = await simulation.request("other-book", bytes: 250_000, priority: .explicit)
+        XCTAssertFalse(started)
+        let suspended = await simulation.suspended
+        XCTAssertTrue(suspended.isEmpty)
+
+        await simulation.waitForFinishes(4)
+        await simulation.cancelAll()
+
+        let finishOrder = await simulation.finishOrder
+        XCTAssertEqual(finishOrder.last, "other-book")
+        XCTAssertEqual(ThrottledStubURLProtocol.requestCount, 4)
+    }
+}
@@ -0,0 +1,192 @@
+//
+//  DownloadSchedulingTests.swift
+//  PalaceTests
+//
+//  Tests for download priorities, preemption and throughput-based concurrency
+//  in DownloadCoordinator.
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+final class DownloadCoordinatorPriorityTests: XCTestCase {
+
+    private func book(_ identifier: String) -> TPPBook {
+        TPPBookMocker.mockBook(identifier: identifier, title: identifier, distributorType: .EpubZip)
+    }
+
+    func testDequeue_higherPriorityFirst_FIFOWithinPriority() async {
+        let coordinator = DownloadCoordinator()
+        await coordinator.setPriority(.prefetch, for: "prefetch")
+        await coordinator.setPriority(.userOpen, for: "open")
+
+        await coordinator.enqueuePending(book("prefetch"))
+        await coordinator.enqueuePending(book("explicit-1"))
+        await coordinator.enqueuePending(book("open"))
+        await coordinator.enqueuePending(book("explicit-2"))
+
+        let dequeued = await coordinator.dequeuePending(capacity: 4).map { $0.identifier }
+
+        XCTAssertEqual(dequeued, ["open", "explicit-1", "explicit-2", "prefetch"])
+    }
+
+    func testSetPriority_movesPendingBook() async {
+        let coordinator = DownloadCoordinator()
+        await coordinator.enqueuePending(book("a"))
+        await coordinator.enqueuePending(book("b"))
+
+        await coordinator.setPriority(.userOpen, for: "b")
+
+        let dequeued = await coordinator.dequeuePending(capacity: 1).map { $0.identifier }
+        XCTAssertEqual(dequeued, ["b"])
+    }
+
+    func testUserOpen_holdsBackBackgroundDownloads() async {
+        let coordinator = DownloadCoordinator()
+        await coordinator.setPriority(.userOpen, for: "open")
+        await coordinator.setPriority(.backgroundRedownload, for: "background")
+        await coordinator.registerStart(identifier: "open")
+        await coordinator.enqueuePending(book("background"))
+        await coordinator.enqueuePending(book("explicit"))
+
+        let canStartBackground = await coordinator.canStartDownload("background", maxConcurrent: 4)
+        let dequeued = await coordinator.dequeuePending(capacity: 4).map { $0.identifier }
+        let queueCount = await coordinator.queueCount
+
+        XCTAssertFalse(canStartBackground)
+        XCTAssertEqual(dequeued, ["explicit"])
+        XCTAssertEqual(queueCount, 1)
+
+        await coordinator.registerCompletion(identifier: "open")
+        let afterOpen = await coordinator.dequeuePending(capacity: 4).map { $0.identifier }
+        XCTAssertEqual(afterOpen, ["background"])
+    }
+
+    func testPreemptionVictims_userOpenSuspendsAllBackgroundDownloads() async {
+        let coordinator = DownloadCoordinator()
+        await coordinator.setPriority(.backgroundRedownload, for: "background")
+        await coordinator.setPriority(.prefetch, for: "prefetch")
+        await coordinator.setPriority(.userOpen, for: "open")
+        for identifier in ["background", "prefetch", "explicit"] {
+            await coordinator.registerStart(identifier: identifier)
+        }
+
+        let victims = await coordinator.preemptionVictims(for: "open", maxConcurrent: 4)
+
+        XCTAssertEqual(Set(victims), ["background", "prefetch"])
+    }
+
+    func testPreemptionVictims_whenFull_picksLowestPriority() async {
+        let coordinator = DownloadCoordinator()
+        await coordinator.setPriority(.prefetch, for: "prefetch")
+        await coordinator.registerStart(identifier: "explicit")
+        await coordinator.registerStart(identifier: "prefetch")
+
+        let victims = await coordinator.preemptionVictims(for: "new", maxConcurrent: 2)
+        let noVictims = await coordinator.preemptionVictims(for: "new", maxConcurrent: 3)
+
+        XCTAssertEqual(victims, ["prefetch"])
+        XCTAssertTrue(noVictims.isEmpty, "Nothing is suspended while there is a free slot")
+    }
+
+    func testPreemptionVictims_neverSuspendsEqualPriority() async {
+        let coordinator = DownloadCoordinator()
+        await coordinator.registerStart(identifier: "a")
+        await coordinator.registerStart(identifier: "b")
+
+        let victims = await coordinator.preemptionVictims(for: "c", maxConcurrent: 2)
+
+        XCTAssertTrue(victims.isEmpty)
+    }
+
+    func testRegisterPreempted_requeuesBook() async {
+        let coordinator = DownloadCoordinator()
+        await coordinator.registerStart(identifier: "a")
+
+        await coordinator.registerPreempted(book("a"))
+
+        let activeCount = await coordinator.activeCount
+        let isPending = await coordinator.isPending("a")
+        XCTAssertEqual(activeCount, 0)
+        XCTAssertTrue(isPending)
+    }
+
+    func testClearScheduling_removesPendingBookAndPriority() async {
+        let coordinator = DownloadCoordinator()
+        await coordinator.setPriority(.userOpen, for: "a")
+        await coordinator.enqueuePending(book("a"))
+
+        await coordinator.clearScheduling(for: "a")
+
+        let isPending = await coordinator.isPending("a")
+        let priority = await coordinator.priority(for: "a")
+        XCTAssertFalse(isPending)
+        XCTAssertEqual(priority, .explicit)
+    }
+}
+
+final class DownloadThroughputControllerTests: XCTestCase {
+
+    private let start = Date(timeIntervalSince1970: 1_700_000_000)
+
+    /// Feeds one sampling window in which `transfers` downloads receive `bytesPerSecond` in total.
+    private func feedWindow(_ controller: inout DownloadThroughputController, index: Int, transfers: Int, bytesPerSecond: Int64) -> Bool {
+        let windowStart = start.addingTimeInterval(Double(index) * controller.sampleInterval)
+        let share = bytesPerSecond * Int64(controller.sampleInterval) / Int64(transfers)
+        var changed = false
+        for transfer in 0..<transfers {
+            changed = controller.record(bytes: share, for: "book-\(transfer)", at: windowStart) || changed
+        }
+        let windowEnd = windowStart.addingTimeInterval(controller.sampleInterval)
+        return controller.record(bytes: 0, for: "book-0", at: windowEnd) || changed
+    }
+
+    func testLimit_growsWhileThroughputGrows() {
+        var controller = DownloadThroughputController(initialLimit: 2, sampleInterval: 1)
+        var index = 0
+
+        // Every added download brings another 1 MB/s, e.g. a server that caps each connection.
+        for _ in 0..<3 {
+            _ = feedWindow(&controller, index: index, transfers: controller.limit, bytesPerSecond: Int64(controller.limit) * 1_000_000)
+            index += 1
+        }
+
+        XCTAssertGreaterThan(controller.limit, 2)
+    }
+
+    func testLimit_backsOffWhenMoreDownloadsDontHelp() {
+        var controller = DownloadThroughputController(initialLimit: 3, sampleInterval: 1)
+
+        // The link is saturated: more downloads only split the same bandwidth.
+        _ = feedWindow(&controller, index: 0, transfers: 3, bytesPerSecond: 4_000_000)
+        XCTAssertEqual(controller.limit, 4, "A saturated window probes one more download")
+
+        _ = feedWindow(&controller, index: 1, transfers: 4, bytesPerSecond: 4_000_000)
+        XCTAssertEqual(controller.limit, 3)
+
+        for index in 2..<(2 + controller.probeBackoff) {
+            _ = feedWindow(&controller, index: index, transfers: 3, bytesPerSecond: 4_000_000)
+            XCTAssertEqual(controller.limit, 3, "No probing during backoff")
+        }
+    }
+
+    func testLimit_unchangedWhenSlotsAreIdle() {
+        var controller = DownloadThroughputController(initialLimit: 4, sampleInterval: 1)
+
+        for index in 0..<5 {
+            _ = feedWindow(&controller, index: index, transfers: 1, bytesPerSecond: 1_000_000)
+        }
+
+        XCTAssertEqual(controller.limit, 4)
+    }
+
+    func testLimit_staysWithinBounds() {
+        var controller = DownloadThroughputController(initialLimit: 100)
+        XCTAssertEqual(controller.limit, DownloadThroughputController.maximumLimit)
+
+        controller = DownloadThroughputController(initialLimit: 0)
+        XCTAssertEqual(controller.limit, DownloadThroughputController.minimumLimit)
+    }
+}
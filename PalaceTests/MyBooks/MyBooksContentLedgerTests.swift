@@ -0,0 +1,117 @@
+//
+//  MyBooksContentLedgerTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+final class MyBooksContentLedgerTests: XCTestCase {
+
+    private var ledgerUrl: URL!
+
+    override func setUp() {
+        super.setUp()
+        ledgerUrl = FileManager.default.temporaryDirectory
+            .appendingPathComponent("MyBooksContentLedgerTests-\(UUID().uuidString)")
+            .appendingPathComponent(MyBooksContentLedger.fileName)
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: ledgerUrl.deletingLastPathComponent())
+        super.tearDown()
+    }
+
+    private func date(_ offset: TimeInterval) -> Date {
+        Date(timeIntervalSince1970: 1_700_000_000 + offset)
+    }
+
+    // MARK: - Usage
+
+    func testRecord_updatesTotalIncrementally() {
+        let ledger = MyBooksContentLedger(url: ledgerUrl)
+        ledger.record("a", fileNames: ["a.epub"], bytes: 100)
+        ledger.record("b", fileNames: ["b.epub"], bytes: 50)
+        ledger.record("a", fileNames: ["a.epub"], bytes: 70)
+
+        XCTAssertEqual(ledger.totalBytes, 120)
+
+        ledger.remove("b")
+        ledger.remove("missing")
+
+        XCTAssertEqual(ledger.totalBytes, 70)
+    }
+
+    func testNeedsRebuild_untilFirstWrite() {
+        let ledger = MyBooksContentLedger(url: ledgerUrl)
+        XCTAssertTrue(ledger.needsRebuild)
+
+        ledger.rebuild(["a": .init(fileNames: ["a.epub"], bytes: 10, lastAccess: date(0))])
+
+        XCTAssertFalse(ledger.needsRebuild)
+        XCTAssertEqual(ledger.totalBytes, 10)
+    }
+
+    func testLedger_persistsAcrossInstances() {
+        let ledger = MyBooksContentLedger(url: ledgerUrl)
+        ledger.record("a", fileNames: ["a.epub", "a.lcpl"], bytes: 100, lastAccess: date(0))
+        ledger.touch("a", at: date(60))
+        ledger.flush()
+
+        let reloaded = MyBooksContentLedger(url: ledgerUrl)
+
+        XCTAssertFalse(reloaded.needsRebuild)
+        XCTAssertEqual(reloaded.totalBytes, 100)
+        XCTAssertEqual(reloaded.entry(for: "a"), .init(fileNames: ["a.epub", "a.lcpl"], bytes: 100, lastAccess: date(60)))
+    }
+
+    func testRemoveAll_deletesLedger() {
+        let ledger = MyBooksContentLedger(url: ledgerUrl)
+        ledger.record("a", fileNames: ["a.epub"], bytes: 100)
+        ledger.removeAll()
+        ledger.flush()
+
+        XCTAssertEqual(ledger.totalBytes, 0)
+        XCTAssertTrue(ledger.needsRebuild)
+        XCTAssertFalse(FileManager.default.fileExists(atPath: ledgerUrl.path))
+    }
+
+    // MARK: - Eviction Order
+
+    func testEvictionCandidates_orderedByRankThenRecency() {
+        let ledger = MyBooksContentLedger(url: ledgerUrl)
+        ledger.record("old", fileNames: ["old.epub"], bytes: 1, lastAccess: date(0))
+        ledger.record("recent", fileNames: ["recent.epub"], bytes: 1, lastAccess: date(100))
+        ledger.record("orphan", fileNames: ["orphan.epub"], bytes: 1, lastAccess: date(200))
+        ledger.record("latest", fileNames: ["latest.epub"], bytes: 1, lastAccess: date(300))
+
+        let candidates = ledger.evictionCandidates { $0 == "orphan" ? 0 : 1 }
+
+        XCTAssertEqual(candidates, ["orphan", "old", "recent"])
+    }
+
+    func testEvictionCandidates_skipPinnedAndUnrankedBooks() {
+        let ledger = MyBooksContentLedger(url: ledgerUrl)
+        ledger.record("lcp", fileNames: ["lcp.lcpa", "lcp.lcpl"], bytes: 1, lastAccess: date(0))
+        ledger.record("downloading", fileNames: ["downloading.epub"], bytes: 1, lastAccess: date(10))
+        ledger.record("epub", fileNames: ["epub.epub"], bytes: 1, lastAccess: date(20))
+        ledger.record("latest", fileNames: ["latest.epub"], bytes: 1, lastAccess: date(30))
+
+        let candidates = ledger.evictionCandidates { $0 == "downloading" ? nil : 1 }
+
+        XCTAssertEqual(candidates, ["epub"])
+    }
+
+    func testTouch_movesBookToEndOfEvictionOrder() {
+        let ledger = MyBooksContentLedger(url: ledgerUrl)
+        ledger.record("a", fileNames: ["a.epub"], bytes: 1, lastAccess: date(0))
+        ledger.record("b", fileNames: ["b.epub"], bytes: 1, lastAccess: date(10))
+        ledger.record("c", fileNames: ["c.epub"], bytes: 1, lastAccess: date(20))
+
+        ledger.touch("a", at: date(30))
+
+        XCTAssertEqual(ledger.evictionCandidates { _ in 1 }, ["b", "c"])
+    }
+}
@@ -252,49 +252,6 @@ final class DownloadCoordinatorIntegrationTests: XCTestCase {
         // Then should return zero (no recent starts)
         XCTAssertEqual(throttleDelay, 0, "Should not throttle when no recent starts")
     }
-
-    // MARK: - Download Info Cache Tests
-
-    func testCoordinator_downloadInfoCache_storesMultipleEntries() async {
-        // Given a coordinator
-        let coordinator = DownloadCoordinator()
-        let mockTask1 = MockURLSessionDownloadTask(taskIdentifier: 1)
-        let mockTask2 = MockURLSessionDownloadTask(taskIdentifier: 2)
-
-        let info1 = MyBooksDownloadInfo(downloadProgress: 0.25, downloadTask: mockTask1, rightsManagement: .none)
-        let info2 = MyBooksDownloadInfo(downloadProgress: 0.75, downloadTask: mockTask2, rightsManagement: .adobe)
-
-        // When caching multiple entries
-        await coordinator.cacheDownloadInfo(info1, for: "book-1")
-        await coordinator.cacheDownloadInfo(info2, for: "book-2")
-
-        // Then both should be retrievable
-        let cached1 = await coordinator.getCachedDownloadInfo(for: "book-1")
-        let cached2 = await coordinator.getCachedDownloadInfo(for: "book-2")
-
-        XCTAssertNotNil(cached1)
-        XCTAssertEqual(cached1?.downloadProgress, 0.25)
-
-        XCTAssertNotNil(cached2)
-        XCTAssertEqual(cached2?.downloadProgress, 0.75)
-    }
-
-    func testCoordinator_downloadInfoCache_updatesExistingEntry() async {
-        // Given a coordinator with cached info
-        let coordinator = DownloadCoordinator()
-        let mockTask = MockURLSessionDownloadTask(taskIdentifier: 1)
-
-        let initialInfo = MyBooksDownloadInfo(downloadProgress: 0.25, downloadTask: mockTask, rightsManagement: .none)
-        await coordinator.cacheDownloadInfo(initialInfo, for: "book-1")
-
-        // When updating with new progress
-        let updatedInfo = MyBooksDownloadInfo(downloadProgress: 0.75, downloadTask: mockTask, rightsManagement: .none)
-        await coordinator.cacheDownloadInfo(updatedInfo, for: "book-1")
-
-        // Then should have updated value
-        let cached = await coordinator.getCachedDownloadInfo(for: "book-1")
-        XCTAssertEqual(cached?.downloadProgress, 0.75, "Cached info should be updated")
-    }
 }
 
 // MARK: - Download State Machine Integration Tests
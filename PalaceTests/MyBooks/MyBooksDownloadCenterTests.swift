@@ -249,38 +249,6 @@ final class DownloadCoordinatorTests: XCTestCase {
         XCTAssertEqual(queueCount, 0)
     }
 
-    func testCoordinator_cacheDownloadInfo_storesAndRetrieves() async {
-        let coordinator = DownloadCoordinator()
-        let mockTask = MockURLSessionDownloadTask(taskIdentifier: 1)
-        let info = MyBooksDownloadInfo(
-            downloadProgress: 0.5,
-            downloadTask: mockTask,
-            rightsManagement: .none
-        )
-
-        await coordinator.cacheDownloadInfo(info, for: "book-1")
-
-        let cached = await coordinator.getCachedDownloadInfo(for: "book-1")
-        XCTAssertNotNil(cached)
-        XCTAssertEqual(cached?.downloadProgress, 0.5)
-    }
-
-    func testCoordinator_removeCachedDownloadInfo_removesEntry() async {
-        let coordinator = DownloadCoordinator()
-        let mockTask = MockURLSessionDownloadTask(taskIdentifier: 1)
-        let info = MyBooksDownloadInfo(
-            downloadProgress: 0.5,
-            downloadTask: mockTask,
-            rightsManagement: .none
-        )
-
-        await coordinator.cacheDownloadInfo(info, for: "book-1")
-        await coordinator.removeCachedDownloadInfo(for: "book-1")
-
-        let cached = await coordinator.getCachedDownloadInfo(for: "book-1")
-        XCTAssertNil(cached)
-    }
-
     func testCoordinator_redirectAttempts_tracksCorrectly() async {
         let coordinator = DownloadCoordinator()
         let taskID = 42
@@ -323,6 +291,48 @@ final class DownloadCoordinatorTests: XCTestCase {
     }
 }
 
+// MARK: - Content Eviction Tests
+
+final class ContentEvictionTests: XCTestCase {
+
+    private var bookRegistry: TPPBookRegistryMock!
+    private var downloadCenter: MyBooksDownloadCenter!
+
+    override func setUp() {
+        super.setUp()
+        bookRegistry = TPPBookRegistryMock()
+        downloadCenter = MyBooksDownloadCenter(bookRegistry: bookRegistry)
+    }
+
+    override func tearDown() {
+        downloadCenter = nil
+        bookRegistry = nil
+        super.tearDown()
+    }
+
+    private func entry(for book: TPPBook) -> MyBooksContentLedger.Entry {
+        .init(fileNames: ["\(book.identifier).epub"], bytes: 100, lastAccess: Date())
+    }
+
+    func testEvict_returnedBook_keepsItsState() {
+        let book = TPPBookMocker.mockBook(distributorType: .EpubZip)
+        bookRegistry.addBook(book, state: .unregistered)
+
+        downloadCenter.evictContent(for: book.identifier, entry: entry(for: book), account: nil)
+
+        XCTAssertEqual(bookRegistry.state(for: book.identifier), .unregistered)
+    }
+
+    func testEvict_downloadedBook_needsDownloadAgain() {
+        let book = TPPBookMocker.mockBook(distributorType: .EpubZip)
+        bookRegistry.addBook(book, state: .downloadSuccessful)
+
+        downloadCenter.evictContent(for: book.identifier, entry: entry(for: book), account: nil)
+
+        XCTAssertEqual(bookRegistry.state(for: book.identifier), .downloadNeeded)
+    }
+}
+
 // MARK: - Download Redirect Handling Tests
 
 /// Tests for redirect handling in downloads.
@@ -0,0 +1,423 @@
+//
+//  SegmentedRangeDownloadTests.swift
+//  PalaceTests
+//
+//  Tests for resumable and segmented downloads, against a local stub of a
+//  range-capable HTTP server that can cap the throughput of each connection.
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+// MARK: - Range-Capable HTTP Stub
+
+/// Serves a generated file of `length` bytes, supporting `Range` and `If-Range`.
+/// Byte `i` of the file is `i % 251`, so any part can be verified.
+final class RangeStubURLProtocol: URLProtocol {
+    static var length: Int64 = 0
+    static var eTag = "\"v1\""
+    /// Throughput of each connection; 0 sends as fast as possible.
+    static var bytesPerSecondPerConnection = 0
+    /// Requests after the first `servedRequestLimit` get a response but no
+    /// data until they're stopped; 0 serves every request.
+    static var servedRequestLimit = 0
+    /// Called when a request is held back by `servedRequestLimit`.
+    static var onHeldRequest: (() -> Void)?
+    private(set) static var rangeHeaders = [String?]()
+
+    private static let lock = NSLock()
+    static let chunkSize = 256 * 1024
+    private static let pattern = Data((0..<(chunkSize + 251)).map { UInt8($0 % 251) })
+    private static let tickInterval: TimeInterval = 0.01
+
+    private var timer: DispatchSourceTimer?
+    private var isStopped = false
+    private var runLoop: CFRunLoop?
+
+    static func reset() {
+        lock.lock()
+        defer { lock.unlock() }
+        length = 0
+        eTag = "\"v1\""
+        bytesPerSecondPerConnection = 0
+        servedRequestLimit = 0
+        onHeldRequest = nil
+        rangeHeaders.removeAll()
+    }
+
+    /// Bytes `offset..<offset + count` of the served file, up to `chunkSize` at a time.
+    static func expectedBytes(at offset: Int64, count: Int) -> Data {
+        let start = Int(offset % 251)
+        return pattern.subdata(in: start..<(start + count))
+    }
+
+    override static func canInit(with request: URLRequest) -> Bool {
+        true
+    }
+
+    override static func canonicalRequest(for request: URLRequest) -> URLRequest {
+        request
+    }
+
+    override func startLoading() {
+        Self.lock.lock()
+        let (length, eTag, rate) = (Self.length, Self.eTag, Self.bytesPerSecondPerConnection)
+        let rangeHeader = request.value(forHTTPHeaderField: "Range")
+        Self.rangeHeaders.append(rangeHeader)
+        let onHeldRequest = Self.servedRequestLimit > 0 && Self.rangeHeaders.count > Self.servedRequestLimit
+            ? Self.onHeldRequest : nil
+        Self.lock.unlock()
+
+        var range = Int64(0)...(length - 1)
+        var statusCode = 200
+        var headers = ["Accept-Ranges": "bytes", "ETag": eTag, "Content-Type": "application/epub+zip"]
+        let ifRange = request.value(forHTTPHeaderField: "If-Range")
+        let bounds = rangeHeader?.dropFirst("bytes=".count).split(separator: "-").compactMap { Int64($0) } ?? []
+        if bounds.count == 2, ifRange == nil || ifRange == eTag {
+            range = bounds[0]...min(bounds[1], length - 1)
+            statusCode = 206
+            headers["Content-Range"] = "bytes \(range.lowerBound)-\(range.upperBound)/\(length)"
+        }
+        headers["Content-Length"] = "\(range.count)"
+
+        let response = HTTPURLResponse(url: request.url!, statusCode: statusCode, httpVersion: "HTTP/1.1", headerFields: headers)!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+        if let onHeldRequest {
+            onHeldRequest()
+            return
+        }
+
+        runLoop = CFRunLoopGetCurrent()
+        var offset = range.lowerBound
+        let end = range.upperBound + 1
+        let bytesPerTick = rate > 0 ? max(1, Int(Double(rate) * Self.tickInterval)) : Self.chunkSize
+
+        let timer = DispatchSource.makeTimerSource(queue: DispatchQueue(label: "RangeStubURLProtocol.connection"))
+        timer.schedule(deadline: .now(), repeating: rate > 0 ? Self.tickInterval : 0.0001)
+        timer.setEventHandler { [weak self] in
+            guard let self else { return }
+            var budget = bytesPerTick
+            while budget > 0 && offset < end {
+                let count = min(budget, Self.chunkSize, Int(end - offset))
+                let data = Self.expectedBytes(at: offset, count: count)
+                offset += Int64(count)
+                budget -= count
+                self.perform { $0.client?.urlProtocol($0, didLoad: data) }
+            }
+            if offset >= end {
+                self.timer?.cancel()
+                self.perform { $0.client?.urlProtocolDidFinishLoading($0) }
+            }
+        }
+        self.timer = timer
+        timer.resume()
+    }
+
+    override func stopLoading() {
+        Self.lock.lock()
+        isStopped = true
+        Self.lock.unlock()
+        timer?.cancel()
+    }
+
+    /// Calls the client on the thread that started loading.
+    private func perform(_ block: @escaping (RangeStubURLProtocol) -> Void) {
+        guard let runLoop else { return }
+        CFRunLoopPerformBlock(runLoop, CFRunLoopMode.commonModes.rawValue) { [weak self] in
+            guard let self else { return }
+            Self.lock.lock()
+            let isStopped = self.isStopped
+            Self.lock.unlock()
+            if !isStopped {
+                block(self)
+            }
+        }
+        CFRunLoopWakeUp(runLoop)
+    }
+}
+
+// MARK: - Session Delegate
+
+/// Forwards the events of part tasks to the download, as the download center does.
+final class SegmentTaskForwarder: NSObject, URLSessionDownloadDelegate {
+    weak var download: SegmentedRangeDownload?
+
+    func urlSession(_ session: URLSession, downloadTask: URLSessionDownloadTask, didWriteData bytesWritten: Int64, totalBytesWritten: Int64, totalBytesExpectedToWrite: Int64) {
+        download?.didWriteData(for: downloadTask, totalBytesWritten: totalBytesWritten)
+    }
+
+    func urlSession(_ session: URLSession, downloadTask: URLSessionDownloadTask, didFinishDownloadingTo location: URL) {
+        let kept = FileManager.default.temporaryDirectory.appendingPathComponent(UUID().uuidString)
+        guard (try? FileManager.default.moveItem(at: location, to: kept)) != nil else { return }
+        download?.didFinishDownloading(downloadTask, to: kept)
+    }
+
+    func urlSession(_ session: URLSession, task: URLSessionTask, didCompleteWithError error: Error?) {
+        download?.didComplete(task, error: error)
+    }
+}
+
+// MARK: - Segmented Range Download
+
+final class SegmentedRangeDownloadTests: XCTestCase {
+
+    private let url = URL(string: "https://cdn.example.com/books/audiobook.zip")!
+    private var directory: URL!
+    private var forwarder: SegmentTaskForwarder!
+    private var session: URLSession!
+
+    override func setUp() {
+        super.setUp()
+        RangeStubURLProtocol.reset()
+        directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("SegmentedRangeDownloadTests-\(UUID().uuidString)")
+        forwarder = SegmentTaskForwarder()
+        session = URLSession(configuration: configuration, delegate: forwarder, delegateQueue: nil)
+    }
+
+    override func tearDown() {
+        session.invalidateAndCancel()
+        try? FileManager.default.removeItem(at: directory)
+        RangeStubURLProtocol.reset()
+        super.tearDown()
+    }
+
+    private var configuration: URLSessionConfiguration {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [RangeStubURLProtocol.self]
+        configuration.httpMaximumConnectionsPerHost = 8
+        return configuration
+    }
+
+    private func response(length: Int64, eTag: String? = "\"v1\"") -> HTTPURLResponse {
+        var headers = ["Accept-Ranges": "bytes", "Content-Length": "\(length)"]
+        headers["ETag"] = eTag
+        return HTTPURLResponse(url: url, statusCode: 200, httpVersion: "HTTP/1.1", headerFields: headers)!
+    }
+
+    private func makeDownload(
+        length: Int64,
+        segmentCount: Int = 4,
+        partLength: Int64 = SegmentedRangeDownload.defaultPartLength,
+        response: HTTPURLResponse? = nil
+    ) throws -> SegmentedRangeDownload {
+        let download = try SegmentedRangeDownload(
+            request: URLRequest(url: url),
+            response: response ?? self.response(length: length),
+            expectedLength: length,
+            directory: directory,
+            segmentCount: segmentCount,
+            partLength: partLength,
+            session: session,
+            identifier: "book"
+        )
+        forwarder.download = download
+        return download
+    }
+
+    private func run(_ download: SegmentedRangeDownload, timeout: TimeInterval = 30) -> Result<URL, Error>? {
+        let finished = expectation(description: "download finished")
+        var result: Result<URL, Error>?
+        download.start {
+            result = $0
+            finished.fulfill()
+        }
+        wait(for: [finished], timeout: timeout)
+        return result
+    }
+
+    /// Compares the file with the served bytes without reading it into memory at once.
+    private func assertMatchesServedFile(_ fileUrl: URL, length: Int64, file: StaticString = #filePath, line: UInt = #line) throws {
+        let handle = try FileHandle(forReadingFrom: fileUrl)
+        defer { try? handle.close() }
+        var offset: Int64 = 0
+        while let chunk = try handle.read(upToCount: RangeStubURLProtocol.chunkSize), !chunk.isEmpty {
+            guard chunk == RangeStubURLProtocol.expectedBytes(at: offset, count: chunk.count) else {
+                return XCTFail("Content differs in the chunk at offset \(offset)", file: file, line: line)
+            }
+            offset += Int64(chunk.count)
+        }
+        XCTAssertEqual(offset, length, file: file, line: line)
+    }
+
+    func testCanSegment_requiresRangeSupportAndSize() {
+        let length = SegmentedRangeDownload.minimumLength
+        XCTAssertTrue(SegmentedRangeDownload.canSegment(response(length: length), expectedLength: length))
+        XCTAssertFalse(SegmentedRangeDownload.canSegment(response(length: length - 1), expectedLength: length - 1))
+
+        let noRanges = HTTPURLResponse(url: url, statusCode: 200, httpVersion: "HTTP/1.1", headerFields: ["Content-Length": "\(length)"])
+        XCTAssertFalse(SegmentedRangeDownload.canSegment(noRanges, expectedLength: length))
+        XCTAssertFalse(SegmentedRangeDownload.canSegment(response(length: length, eTag: nil), expectedLength: length),
+                       "Parts can't be validated without ETag or Last-Modified")
+    }
+
+    func testTaskDescription_identifiesBook() {
+        let description = SegmentedRangeDownload.taskDescription(for: "urn:isbn:1")
+        XCTAssertEqual(SegmentedRangeDownload.identifier(fromTaskDescription: description), "urn:isbn:1")
+        XCTAssertNil(SegmentedRangeDownload.identifier(fromTaskDescription: "urn:isbn:1"))
+        XCTAssertNil(SegmentedRangeDownload.identifier(fromTaskDescription: nil))
+    }
+
+    func testDownload_joinsSegmentsAtTheirOffsets() throws {
+        let length: Int64 = 3 * 1024 * 1024 + 17
+        RangeStubURLProtocol.length = length
+
+        let download = try makeDownload(length: length)
+        let result = run(download)
+
+        let fileUrl = try XCTUnwrap(try result?.get())
+        try assertMatchesServedFile(fileUrl, length: length)
+        XCTAssertEqual(RangeStubURLProtocol.rangeHeaders.count, 4)
+        XCTAssertTrue(RangeStubURLProtocol.rangeHeaders.allSatisfy { $0?.hasPrefix("bytes=") == true })
+        XCTAssertFalse(FileManager.default.fileExists(atPath: directory.path), "Parts are cleaned up")
+        try? FileManager.default.removeItem(at: fileUrl)
+    }
+
+    func testDownload_continuesFromCheckpointAfterCancel() throws {
+        let length: Int64 = 4 * 1024 * 1024
+        RangeStubURLProtocol.length = length
+
+        // Serve the first part of each segment, then hold the requests for the
+        // next parts. Those are made once the first parts are checkpointed.
+        let checkpointed = expectation(description: "first parts checkpointed")
+        checkpointed.expectedFulfillmentCount = 2
+        RangeStubURLProtocol.servedRequestLimit = 2
+        RangeStubURLProtocol.onHeldRequest = { checkpointed.fulfill() }
+
+        let interrupted = try makeDownload(length: length, segmentCount: 2, partLength: 512 * 1024)
+        interrupted.start { _ in XCTFail("A cancelled download doesn't complete") }
+        wait(for: [checkpointed], timeout: 10)
+        interrupted.cancel()
+        let rangeCount = RangeStubURLProtocol.rangeHeaders.count
+
+        RangeStubURLProtocol.servedRequestLimit = 0
+        let resumed = try makeDownload(length: length, segmentCount: 2)
+        let received = resumed.manifest.received
+        XCTAssertEqual(received, [512 * 1024, 512 * 1024], "Both segments checkpointed their first part")
+
+        let fileUrl = try XCTUnwrap(try run(resumed).get())
+        try assertMatchesServedFile(fileUrl, length: length)
+
+        // The first part requested again by each segment starts at its checkpoint.
+        let resumedStarts = Set(RangeStubURLProtocol.rangeHeaders.suffix(from: rangeCount).prefix(2).compactMap {
+            $0?.split(separator: "-").first.map(String.init)
+        })
+        XCTAssertEqual(resumedStarts, ["bytes=\(received[0])", "bytes=\(length / 2 + received[1])"])
+        try? FileManager.default.removeItem(at: fileUrl)
+    }
+
+    func testDownload_withoutValidatorStartsOver() throws {
+        let length: Int64 = 1024 * 1024
+        let noValidator = response(length: length, eTag: nil)
+        let first = try makeDownload(length: length, segmentCount: 2, response: noValidator)
+        XCTAssertNil(first.manifest.ifRange)
+
+        // Parts of an unknown version of the file must not be reused.
+        var manifest = first.manifest
+        manifest.received = [1024, 1024]
+        try JSONEncoder().encode(manifest).write(to: directory.appendingPathComponent(SegmentedRangeDownload.manifestFileName))
+
+        let second = try makeDownload(length: length, segmentCount: 2, response: noValidator)
+        XCTAssertEqual(second.manifest.received, [0, 0])
+    }
+
+    func testDownload_failsAndDiscardsPartsWhenFileChanged() throws {
+        let length: Int64 = 1024 * 1024
+        RangeStubURLProtocol.length = length
+        RangeStubURLProtocol.eTag = "\"v2\""
+
+        let download = try makeDownload(length: length, response: response(length: length, eTag: "\"v1\""))
+        let result = run(download)
+
+        guard case .failure(let error)? = result else {
+            return XCTFail("Expected failure")
+        }
+        XCTAssertEqual(error as? SegmentedRangeDownload.Failure, .fileChanged)
+        XCTAssertFalse(FileManager.default.fileExists(atPath: directory.path))
+    }
+
+    // MARK: - Time to Complete
+
+    /// Payload of the time-to-complete measurements, from a server that caps
+    /// each connection at 16 MB/s, as CDNs commonly do.
+    @discardableResult
+    private func prepareThrottledServer() -> Int64 {
+        let length: Int64 = 4 * 1024 * 1024
+        RangeStubURLProtocol.length = length
+        RangeStubURLProtocol.bytesPerSecondPerConnection = 16 * 1024 * 1024
+        return length
+    }
+
+    func testTimeToComplete_singleStream() {
+        prepareThrottledServer()
+        let session = URLSession(configuration: configuration)
+        defer { session.invalidateAndCancel() }
+
+        measure {
+            let finished = expectation(description: "single stream finished")
+            session.downloadTask(with: url) { location, _, _ in
+                XCTAssertNotNil(location)
+                finished.fulfill()
+            }.resume()
+            wait(for: [finished], timeout: 10)
+        }
+    }
+
+    func testTimeToComplete_segmented() {
+        let length = prepareThrottledServer()
+
+        measure {
+            guard let download = try? makeDownload(length: length, partLength: 512 * 1024),
+                  let fileUrl = try? run(download, timeout: 10)?.get() else {
+                return XCTFail("Segmented download failed")
+            }
+            try? FileManager.default.removeItem(at: fileUrl)
+        }
+    }
+}
+
+// MARK: - Resume Store
+
+final class DownloadResumeStoreTests: XCTestCase {
+
+    private var store: DownloadResumeStore!
+    private let url = URL(string: "https://circulation.example.com/works/1/fulfill/2")!
+
+    override func setUp() {
+        super.setUp()
+        store = DownloadResumeStore(directory: FileManager.default.temporaryDirectory
+            .appendingPathComponent("DownloadResumeStoreTests-\(UUID().uuidString)"))
+    }
+
+    override func tearDown() {
+        store.removeAll()
+        super.tearDown()
+    }
+
+    func testTakeResumeData_returnsDataOnce() {
+        store.saveResumeData(Data([1, 2, 3]), for: "book", url: url)
+
+        XCTAssertEqual(store.takeResumeData(for: "book", url: url), Data([1, 2, 3]))
+        XCTAssertNil(store.takeResumeData(for: "book", url: url))
+    }
+
+    func testTakeResumeData_discardsDataOfAnotherRequest() {
+        store.saveResumeData(Data([1, 2, 3]), for: "book", url: url)
+
+        XCTAssertNil(store.takeResumeData(for: "book", url: URL(string: "https://circulation.example.com/works/1/fulfill/3")!))
+        XCTAssertNil(store.takeResumeData(for: "book", url: url))
+    }
+
+    func testRemove_deletesResumeDataAndSegments() throws {
+        store.saveResumeData(Data([1]), for: "book", url: url)
+        let segments = store.segmentsDirectory(for: "book")
+        try FileManager.default.createDirectory(at: segments, withIntermediateDirectories: true)
+
+        store.remove("book")
+
+        XCTAssertNil(store.takeResumeData(for: "book", url: url))
+        XCTAssertFalse(FileManager.default.fileExists(atPath: segments.path))
+    }
+}
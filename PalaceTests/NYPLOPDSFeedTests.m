@@ -1,6 +1,7 @@
 @import XCTest;
 
 #import "NSDate+NYPLDateAdditions.h"
+#import "TPPOPDSEntry.h"
 #import "TPPOPDSFeed.h"
 #import "TPPXML.h"
 
@@ -79,4 +80,69 @@
   XCTAssertEqual(dateComponents.second, 57);
 }
 
+- (void)testLargeFeedKeepsEntryOrder
+{
+  TPPXML *const feedXML = [TPPXML XMLWithData:[self largeFeedData]];
+  NSArray *const entryXMLs = [feedXML childrenWithName:@"entry"];
+  XCTAssertGreaterThanOrEqual(entryXMLs.count, 1000U);
+
+  NSMutableArray *const identifiers = [NSMutableArray array];
+  for(TPPXML *const entryXML in entryXMLs) {
+    TPPOPDSEntry *const entry = [[TPPOPDSEntry alloc] initWithXML:entryXML];
+    if(entry) {
+      [identifiers addObject:entry.identifier];
+    }
+  }
+
+  TPPOPDSFeed *const feed = [[TPPOPDSFeed alloc] initWithXML:feedXML];
+  XCTAssertEqualObjects([feed.entries valueForKey:@"identifier"], identifiers);
+}
+
+- (void)testPerformanceSerialEntries
+{
+  TPPXML *const feedXML = [TPPXML XMLWithData:[self largeFeedData]];
+  NSArray *const entryXMLs = [feedXML childrenWithName:@"entry"];
+
+  [self measureBlock:^{
+    NSMutableArray *const entries = [NSMutableArray arrayWithCapacity:entryXMLs.count];
+    for(TPPXML *const entryXML in entryXMLs) {
+      TPPOPDSEntry *const entry = [[TPPOPDSEntry alloc] initWithXML:entryXML];
+      if(entry) {
+        [entries addObject:entry];
+      }
+    }
+  }];
+}
+
+- (void)testPerformanceLargeFeed
+{
+  TPPXML *const feedXML = [TPPXML XMLWithData:[self largeFeedData]];
+
+  [self measureBlock:^{
+    (void)[[TPPOPDSFeed alloc] initWithXML:feedXML];
+  }];
+}
+
+/// main.xml with its entries repeated to more than 1000 entries.
+- (NSData *)largeFeedData
+{
+  NSString *const feed =
+    [NSString stringWithContentsOfFile:[[NSBundle bundleForClass:[self class]] pathForResource:@"main" ofType:@"xml"]
+                              encoding:NSUTF8StringEncoding
+                                 error:NULL];
+  NSRange const firstEntry = [feed rangeOfString:@"<entry"];
+  NSRange const end = [feed rangeOfString:@"</feed>" options:NSBackwardsSearch];
+  NSString *const entries = [feed substringWithRange:NSMakeRange(firstEntry.location, end.location - firstEntry.location)];
+
+  NSMutableString *const largeFeed = [[feed substringToIndex:firstEntry.location] mutableCopy];
+  for(int i = 0; i < 7; i++) {
+    // Unique identifiers so that order can be checked
+    [largeFeed appendString:[entries stringByReplacingOccurrencesOfString:@"<id>"
+                                                               withString:[NSString stringWithFormat:@"<id>%d-", i]]];
+  }
+  [largeFeed appendString:[feed substringFromIndex:end.location]];
+
+  return [largeFeed dataUsingEncoding:NSUTF8StringEncoding];
+}
+
 @end
@@ -87,6 +87,112 @@
   XCTAssertEqualObjects([baz childrenWithName:nil], @[]);
 }
 
+- (void)testEntitiesAndNamespacedAttributes
+{
+  NSString *const string = @"<feed xmlns=\"http://www.w3.org/2005/Atom\" xmlns:opf=\"http://www.idpf.org/2007/opf\">"
+  "<author opf:role=\"aut\" href=\"a?x=1&amp;y=2&#38;z&lt;\">A &amp; B &#233;</author></feed>";
+  TPPXML *const root = [TPPXML XMLWithData:[string dataUsingEncoding:NSUTF8StringEncoding]];
+  XCTAssert(root);
+  XCTAssertEqualObjects(root.attributes, @{});
+
+  TPPXML *const author = [root firstChildWithName:@"author"];
+  XCTAssertEqualObjects(author.namespaceURI, @"http://www.w3.org/2005/Atom");
+  NSDictionary *const attributes = @{@"opf:role": @"aut", @"href": @"a?x=1&y=2&z<"};
+  XCTAssertEqualObjects(author.attributes, attributes);
+  XCTAssertEqualObjects(author.value, @"A & B \u00e9");
+  XCTAssertEqualObjects(author.parent, root);
+  XCTAssertEqualObjects([root firstChildWithName:@"author"], author);
+  XCTAssertNil([root firstChildWithName:@"entry"]);
+  XCTAssertNil([root firstChildWithName:nil]);
+}
+
+- (void)testElementOutlivesRoot
+{
+  TPPXML *child;
+  @autoreleasepool {
+    NSString *const string = @"<a><b>value</b></a>";
+    child = [[TPPXML XMLWithData:[string dataUsingEncoding:NSUTF8StringEncoding]] firstChildWithName:@"b"];
+  }
+  XCTAssertEqualObjects(child.value, @"value");
+  XCTAssertEqualObjects(child.parent.name, @"a");
+}
+
+- (void)testParsePerformance
+{
+  NSData *const data = [NSData dataWithContentsOfURL:[[NSBundle bundleForClass:[self class]]
+                                                      URLForResource:@"main"
+                                                      withExtension:@"xml"]];
+  XCTAssert(data);
+
+  [self measureWithMetrics:@[[[XCTClockMetric alloc] init], [[XCTMemoryMetric alloc] init]] block:^{
+    for(int i = 0; i < 20; i++) {
+      TPPXML *const root = [TPPXML XMLWithData:data];
+      for(TPPXML *const entry in [root childrenWithName:@"entry"]) {
+        (void)[entry firstChildWithName:@"title"].value;
+        (void)[entry firstChildWithName:@"link"].attributes;
+      }
+    }
+  }];
+}
+
+- (void)testStreamParserMatchesDocumentParse
+{
+  NSData *const data = [NSData dataWithContentsOfURL:[[NSBundle bundleForClass:[self class]]
+                                                      URLForResource:@"main"
+                                                      withExtension:@"xml"]];
+  XCTAssert(data);
+
+  NSMutableArray *const titles = [NSMutableArray array];
+  NSMutableArray *const names = [NSMutableArray array];
+  TPPXMLStreamParser *const parser = [[TPPXMLStreamParser alloc] initWithElementHandler:^(TPPXML *const element) {
+    [names addObject:element.name];
+    if([element.name isEqualToString:@"entry"]) {
+      [titles addObject:[element firstChildWithName:@"title"].value ?: @""];
+    }
+  }];
+
+  // Small chunks split names, attributes and text across calls
+  for(NSUInteger offset = 0; offset < data.length; offset += 61) {
+    NSRange const range = NSMakeRange(offset, MIN((NSUInteger)61, data.length - offset));
+    XCTAssert([parser parseData:[data subdataWithRange:range]]);
+  }
+  TPPXML *const streamedRoot = [parser finish];
+  TPPXML *const root = [TPPXML XMLWithData:data];
+  XCTAssert(streamedRoot);
+
+  XCTAssertEqualObjects(names, [root.children valueForKey:@"name"]);
+  NSArray *const entries = [root childrenWithName:@"entry"];
+  XCTAssertGreaterThan(entries.count, 0U);
+  XCTAssertEqual(titles.count, entries.count);
+  for(NSUInteger i = 0; i < entries.count; i++) {
+    XCTAssertEqualObjects(titles[i], [entries[i] firstChildWithName:@"title"].value ?: @"");
+  }
+  XCTAssertEqualObjects(streamedRoot.name, root.name);
+  XCTAssertEqual([streamedRoot childrenWithName:@"entry"].count, entries.count);
+}
+
+- (void)testStreamParserInvalid
+{
+  NSData *const data = [NSData dataWithContentsOfURL:[[NSBundle bundleForClass:[self class]]
+                                                      URLForResource:@"invalid"
+                                                      withExtension:@"xml"]];
+  TPPXMLStreamParser *const parser = [[TPPXMLStreamParser alloc] initWithElementHandler:nil];
+  [parser parseData:data];
+  XCTAssertNil([parser finish]);
+}
+
+- (void)testStreamParserTruncated
+{
+  NSString *const string = @"<feed><entry><title>One</title></entry><entry><title>Tw";
+  __block NSUInteger count = 0;
+  TPPXMLStreamParser *const parser = [[TPPXMLStreamParser alloc] initWithElementHandler:^(__unused TPPXML *element) {
+    count++;
+  }];
+  XCTAssert([parser parseData:[string dataUsingEncoding:NSUTF8StringEncoding]]);
+  XCTAssertEqual(count, 1U);
+  XCTAssertNil([parser finish]);
+}
+
 - (void)testInvalid
 {
   TPPXML *const root = [TPPXML XMLWithData:[NSData dataWithContentsOfURL:
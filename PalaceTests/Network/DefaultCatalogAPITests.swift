@@ -354,6 +354,132 @@ final class DefaultCatalogAPITests: XCTestCase {
             XCTAssertEqual(networkClientMock.sendCallCount, 3)
         }
     }
+
+    // MARK: - Revalidation
+
+    private func stubResponse(for url: URL, xml: String = "", statusCode: Int = 200, headers: [String: String]) {
+        let httpResponse = HTTPURLResponse(url: url, statusCode: statusCode, httpVersion: "HTTP/1.1", headerFields: headers)!
+        networkClientMock.stubbedResponses[url] = NetworkResponse(data: Data(xml.utf8), response: httpResponse)
+    }
+
+    func testFetchFeed_NotModified_ReusesParsedFeed() async throws {
+        // Arrange
+        let cache = CatalogFeedValidatorCache()
+        sut = DefaultCatalogAPI(client: networkClientMock, parser: parser, validatorCache: cache)
+        let testURL = URL(string: "https://example.com/catalog")!
+        stubResponse(for: testURL, xml: NetworkClientMock.makeOPDSFeedXML(title: "Catalog", entries: 3),
+                     headers: ["ETag": "\"v1\"", "Last-Modified": "Mon, 01 Jan 2026 00:00:00 GMT"])
+        let first = try await sut.fetchFeed(at: testURL)
+
+        // Act
+        stubResponse(for: testURL, statusCode: 304, headers: ["ETag": "\"v1\""])
+        let second = try await sut.fetchFeed(at: testURL)
+
+        // Assert
+        XCTAssertEqual(networkClientMock.lastRequestedHeaders?["If-None-Match"], "\"v1\"")
+        XCTAssertEqual(networkClientMock.lastRequestedHeaders?["If-Modified-Since"], "Mon, 01 Jan 2026 00:00:00 GMT")
+        XCTAssertTrue(second?.opdsFeed === first?.opdsFeed)
+        XCTAssertEqual(second?.entries.count, 3)
+        XCTAssertEqual(cache.metrics.hits, 1)
+        XCTAssertEqual(cache.metrics.misses, 1)
+        XCTAssertEqual(cache.metrics.hitRate, 0.5)
+    }
+
+    func testFetchFeed_SameETag_ReusesParsedFeed() async throws {
+        // Arrange
+        let cache = CatalogFeedValidatorCache()
+        sut = DefaultCatalogAPI(client: networkClientMock, parser: parser, validatorCache: cache)
+        let testURL = URL(string: "https://example.com/catalog")!
+        stubResponse(for: testURL, xml: NetworkClientMock.makeOPDSFeedXML(title: "Catalog"), headers: ["ETag": "\"v1\""])
+
+        // Act
+        let first = try await sut.fetchFeed(at: testURL)
+        let second = try await sut.fetchFeed(at: testURL)
+
+        // Assert
+        XCTAssertTrue(second?.opdsFeed === first?.opdsFeed)
+        XCTAssertEqual(cache.metrics.hits, 1)
+    }
+
+    func testFetchFeed_ChangedFeed_IsParsedAgain() async throws {
+        // Arrange
+        let cache = CatalogFeedValidatorCache()
+        sut = DefaultCatalogAPI(client: networkClientMock, parser: parser, validatorCache: cache)
+        let testURL = URL(string: "https://example.com/catalog")!
+        stubResponse(for: testURL, xml: NetworkClientMock.makeOPDSFeedXML(title: "Old"), headers: ["ETag": "\"v1\""])
+        _ = try await sut.fetchFeed(at: testURL)
+
+        // Act
+        stubResponse(for: testURL, xml: NetworkClientMock.makeOPDSFeedXML(title: "New"), headers: ["ETag": "\"v2\""])
+        let feed = try await sut.fetchFeed(at: testURL)
+
+        // Assert
+        XCTAssertEqual(feed?.title, "New")
+        XCTAssertEqual(cache.metrics.hits, 0)
+        XCTAssertEqual(cache.conditionalHeaders(for: testURL, accountId: AccountsManager.shared.currentAccountId)["If-None-Match"], "\"v2\"")
+    }
+
+    func testFetchFeed_NotModifiedWithoutParsedFeed_RefetchesFeed() async throws {
+        // Arrange
+        let cache = CatalogFeedValidatorCache()
+        sut = DefaultCatalogAPI(client: networkClientMock, parser: parser, validatorCache: cache)
+        let testURL = URL(string: "https://example.com/catalog")!
+        stubResponse(for: testURL, statusCode: 304, headers: [:])
+        networkClientMock.failAfterCallCount = 1
+
+        // Act & Assert - the unconditional retry is the second call
+        do {
+            _ = try await sut.fetchFeed(at: testURL)
+            XCTFail("Expected the retry to reach the network")
+        } catch {
+            XCTAssertEqual(networkClientMock.sendCallCount, 2)
+            XCTAssertTrue(networkClientMock.requestHistory.allSatisfy { $0.headers.isEmpty })
+        }
+    }
+
+    func testFetchFeed_WithoutValidators_SendsNoConditionalHeaders() async throws {
+        // Arrange
+        let cache = CatalogFeedValidatorCache()
+        sut = DefaultCatalogAPI(client: networkClientMock, parser: parser, validatorCache: cache)
+        let testURL = URL(string: "https://example.com/catalog")!
+        networkClientMock.stubOPDSResponse(for: testURL, xml: NetworkClientMock.makeOPDSFeedXML(title: "Catalog"))
+
+        // Act
+        _ = try await sut.fetchFeed(at: testURL)
+        _ = try await sut.fetchFeed(at: testURL)
+
+        // Assert
+        XCTAssertEqual(networkClientMock.lastRequestedHeaders, [:])
+        XCTAssertEqual(cache.metrics, .init(hits: 0, misses: 2, parseTimeSaved: 0))
+    }
+
+    /// Revalidates a 200-entry feed answered with `304 Not Modified`, which
+    /// returns the parsed feed instead of parsing it again.
+    func testBenchmark_NotModifiedRevalidation() {
+        let cache = CatalogFeedValidatorCache()
+        sut = DefaultCatalogAPI(client: networkClientMock, parser: parser, validatorCache: cache)
+        let testURL = URL(string: "https://example.com/catalog")!
+        stubResponse(for: testURL, xml: NetworkClientMock.makeOPDSFeedXML(title: "Catalog", entries: 200), headers: ["ETag": "\"v1\""])
+
+        func fetchFeed() {
+            let fetched = expectation(description: "feed fetched")
+            Task {
+                _ = try? await self.sut.fetchFeed(at: testURL)
+                fetched.fulfill()
+            }
+            wait(for: [fetched], timeout: 10)
+        }
+
+        fetchFeed()
+        stubResponse(for: testURL, statusCode: 304, headers: [:])
+
+        measure {
+            fetchFeed()
+        }
+
+        XCTAssertEqual(cache.metrics.misses, 1)
+        XCTAssertGreaterThan(cache.metrics.hits, 0)
+    }
 }
 
 // MARK: - Integration with CatalogRepository Tests
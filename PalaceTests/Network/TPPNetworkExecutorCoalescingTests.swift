@@ -0,0 +1,174 @@
+//
+//  TPPNetworkExecutorCoalescingTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+final class TPPNetworkExecutorCoalescingTests: XCTestCase {
+
+    private var executor: TPPNetworkExecutor!
+    private var gate: DispatchSemaphore!
+    private var requestCount: Int { requestCountLock.withLock { _requestCount } }
+    private var _requestCount = 0
+    private let requestCountLock = NSLock()
+
+    private let url = URL(string: "https://example.com/feeds/loans")!
+    private let body = Data("<feed/>".utf8)
+
+    override func setUp() {
+        super.setUp()
+        HTTPStubURLProtocol.reset()
+        gate = DispatchSemaphore(value: 0)
+
+        // Responses wait for `gate`, so callers can join while the request is in flight
+        let gate = self.gate!
+        let body = self.body
+        HTTPStubURLProtocol.register { [weak self] request in
+            guard request.url?.path == "/feeds/loans" else { return nil }
+            self?.requestCountLock.withLock { self?._requestCount += 1 }
+            _ = gate.wait(timeout: .now() + 5)
+            return .init(statusCode: 200, headers: ["Content-Type": "application/atom+xml"], body: body)
+        }
+
+        let config = URLSessionConfiguration.ephemeral
+        config.protocolClasses = [HTTPStubURLProtocol.self]
+        executor = TPPNetworkExecutor(cachingStrategy: .ephemeral, sessionConfiguration: config)
+    }
+
+    override func tearDown() {
+        // Release any response still waiting
+        for _ in 0..<4 {
+            gate.signal()
+        }
+        HTTPStubURLProtocol.reset()
+        executor = nil
+        super.tearDown()
+    }
+
+    private func request(authorization: String = "Bearer token") -> URLRequest {
+        var request = URLRequest(url: url)
+        request.setValue(authorization, forHTTPHeaderField: "Authorization")
+        return request
+    }
+
+    private func isCancellation(_ result: NYPLResult<Data>) -> Bool {
+        if case let .failure(error as NSError, _) = result {
+            return error.domain == NSURLErrorDomain && error.code == NSURLErrorCancelled
+        }
+        return false
+    }
+
+    // MARK: - Tests
+
+    func testConcurrentCallers_shareOneRequest() {
+        let completed = expectation(description: "completed")
+        completed.expectedFulfillmentCount = 3
+        for _ in 0..<3 {
+            executor.executeCoalescedRequest(request(), enableTokenRefresh: false) { result in
+                if case let .success(data, _) = result {
+                    XCTAssertEqual(data, self.body)
+                } else {
+                    XCTFail("Expected the shared response")
+                }
+                completed.fulfill()
+            }
+        }
+        gate.signal()
+
+        wait(for: [completed], timeout: 5)
+
+        XCTAssertEqual(requestCount, 1)
+        XCTAssertEqual(executor.coalescingMetrics, .init(sent: 1, joined: 2, cancelled: 0, abandoned: 0))
+    }
+
+    func testOtherCredentials_sendSeparateRequests() {
+        executor.executeCoalescedRequest(request(authorization: "Bearer one"), enableTokenRefresh: false) { _ in }
+        executor.executeCoalescedRequest(request(authorization: "Bearer two"), enableTokenRefresh: false) { _ in }
+
+        XCTAssertEqual(executor.coalescingMetrics.sent, 2)
+        XCTAssertEqual(executor.coalescingMetrics.joined, 0)
+    }
+
+    func testCancellingOneCaller_keepsRequestForOthers() {
+        let cancelled = expectation(description: "cancelled")
+        let completed = expectation(description: "completed")
+        let first = executor.executeCoalescedRequest(request(), enableTokenRefresh: false) { result in
+            XCTAssertTrue(self.isCancellation(result))
+            cancelled.fulfill()
+        }
+        executor.executeCoalescedRequest(request(), enableTokenRefresh: false) { result in
+            if case let .success(data, _) = result {
+                XCTAssertEqual(data, self.body)
+            } else {
+                XCTFail("Remaining caller should get the response")
+            }
+            completed.fulfill()
+        }
+
+        first.cancel()
+        wait(for: [cancelled], timeout: 5)
+        gate.signal()
+        wait(for: [completed], timeout: 5)
+
+        XCTAssertEqual(requestCount, 1)
+        XCTAssertEqual(executor.coalescingMetrics, .init(sent: 1, joined: 1, cancelled: 1, abandoned: 0))
+    }
+
+    func testCancellingEveryCaller_cancelsRequest() {
+        let cancelled = expectation(description: "cancelled")
+        cancelled.expectedFulfillmentCount = 2
+        let callers = (0..<2).map { _ in
+            executor.executeCoalescedRequest(request(), enableTokenRefresh: false) { result in
+                XCTAssertTrue(self.isCancellation(result))
+                cancelled.fulfill()
+            }
+        }
+
+        callers.forEach { $0.cancel() }
+        wait(for: [cancelled], timeout: 5)
+
+        XCTAssertEqual(executor.coalescingMetrics.abandoned, 1)
+
+        // A later caller doesn't join the abandoned request
+        let completed = expectation(description: "completed")
+        executor.executeCoalescedRequest(request(), enableTokenRefresh: false) { result in
+            if case .success = result {} else {
+                XCTFail("New request should succeed")
+            }
+            completed.fulfill()
+        }
+        gate.signal()
+        gate.signal()
+        wait(for: [completed], timeout: 5)
+
+        XCTAssertEqual(executor.coalescingMetrics.sent, 2)
+    }
+
+    func testNetworkClient_cancelledTaskLeavesSharedRequestRunning() async throws {
+        let client = URLSessionNetworkClient(executor: executor)
+        let networkRequest = NetworkRequest(method: .GET, url: url, headers: ["Authorization": "Bearer token"])
+
+        let cancelledTask = Task { try await client.send(networkRequest) }
+        let remainingTask = Task { try await client.send(networkRequest) }
+        // Let both join before cancelling one
+        while executor.coalescingMetrics.sent + executor.coalescingMetrics.joined < 2 {
+            try await Task.sleep(nanoseconds: 10_000_000)
+        }
+        cancelledTask.cancel()
+        gate.signal()
+
+        let response = try await remainingTask.value
+        XCTAssertEqual(response.data, body)
+        do {
+            _ = try await cancelledTask.value
+            XCTFail("Cancelled task should throw")
+        } catch {
+            XCTAssertEqual((error as NSError).code, NSURLErrorCancelled)
+        }
+        XCTAssertEqual(requestCount, 1)
+    }
+}
@@ -0,0 +1,145 @@
+//
+//  OPDS2FeedArchiveTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+final class OPDS2FeedArchiveTests: XCTestCase {
+
+    // MARK: - Helpers
+
+    private func makePublication(_ index: Int) -> OPDS2Publication {
+        OPDS2Publication(
+            links: [
+                OPDS2Link(href: "https://example.com/works/\(index)", type: "application/atom+xml;type=entry;profile=opds-catalog", rel: "alternate"),
+                OPDS2Link(href: "https://example.com/works/\(index)/borrow", type: "application/vnd.adobe.adept+xml", rel: "http://opds-spec.org/acquisition/borrow")
+            ],
+            metadata: OPDS2Publication.Metadata(
+                updated: Date(timeIntervalSince1970: 1_700_000_000 + Double(index)),
+                description: String(repeating: "A description of book \(index). ", count: 8),
+                id: "urn:uuid:\(index)",
+                title: "Book \(index)"
+            ),
+            images: [
+                OPDS2Link(href: "https://covers.example.com/\(index).png", type: "image/png", rel: "http://opds-spec.org/image/thumbnail")
+            ]
+        )
+    }
+
+    private func makeFeed(publicationCount: Int) -> OPDS2Feed {
+        OPDS2Feed(
+            metadata: OPDS2FeedMetadata(title: "Feed", numberOfItems: publicationCount),
+            links: [OPDS2Link(href: "https://example.com/feed", rel: "self"), OPDS2Link(href: "https://example.com/feed?page=2", rel: "next")],
+            publications: (0..<publicationCount).map(makePublication),
+            facets: [OPDS2FacetGroup(
+                metadata: OPDS2FacetGroupMetadata(title: "Sort by"),
+                links: [OPDS2FacetLink(href: "https://example.com/feed?order=title", title: "Title")]
+            )]
+        )
+    }
+
+    // MARK: - Round Trip
+
+    func testArchive_roundTripsEntry() throws {
+        let entry = OPDSCacheEntry(feed: makeFeed(publicationCount: 5), etag: "\"abc\"", lastModified: "Mon, 01 Jan 2026 00:00:00 GMT")
+
+        let archive = try OPDS2FeedArchive(data: OPDS2FeedArchive.encode(entry))
+        let decoded = try archive.entry()
+
+        XCTAssertEqual(decoded.feed, entry.feed)
+        XCTAssertEqual(decoded.etag, entry.etag)
+        XCTAssertEqual(decoded.lastModified, entry.lastModified)
+        XCTAssertEqual(decoded.timestamp, entry.timestamp)
+    }
+
+    func testArchive_roundTripsGroupsAndNavigation() throws {
+        let feed = OPDS2Feed(
+            metadata: OPDS2FeedMetadata(title: "Grouped"),
+            links: [],
+            navigation: [OPDS2NavigationLink(href: "https://example.com/nav", title: "Fiction")],
+            groups: [
+                OPDS2Group(metadata: OPDS2GroupMetadata(title: "New"), publications: (0..<3).map(makePublication)),
+                OPDS2Group(metadata: OPDS2GroupMetadata(title: "Links only"), navigation: [OPDS2NavigationLink(href: "https://example.com/a", title: "A")]),
+                OPDS2Group(metadata: OPDS2GroupMetadata(title: "Popular"), publications: (10..<12).map(makePublication))
+            ]
+        )
+
+        let archive = try OPDS2FeedArchive(data: OPDS2FeedArchive.encode(OPDSCacheEntry(feed: feed)))
+
+        XCTAssertEqual(try archive.feed(), feed)
+        XCTAssertNil(try archive.feed().publications)
+        XCTAssertEqual(archive.publicationCount, 0)
+    }
+
+    // MARK: - Lazy Decoding
+
+    func testPublications_decodesRequestedPage() throws {
+        let feed = makeFeed(publicationCount: 100)
+        let archive = try OPDS2FeedArchive(data: OPDS2FeedArchive.encode(OPDSCacheEntry(feed: feed)))
+
+        XCTAssertEqual(archive.publicationCount, 100)
+        XCTAssertEqual(archive.metadata, feed.metadata)
+        XCTAssertEqual(try archive.publications(in: 40..<60), Array(feed.publications![40..<60]))
+        XCTAssertEqual(try archive.publications(in: 90..<120).count, 10)
+    }
+
+    func testFeed_withPublicationLimit_decodesFirstPublications() throws {
+        let group = OPDS2Group(metadata: OPDS2GroupMetadata(title: "Group"), publications: (200..<230).map(makePublication))
+        let feed = OPDS2Feed(
+            metadata: OPDS2FeedMetadata(title: "Feed"),
+            links: [],
+            publications: (0..<50).map(makePublication),
+            groups: [group]
+        )
+        let archive = try OPDS2FeedArchive(data: OPDS2FeedArchive.encode(OPDSCacheEntry(feed: feed)))
+
+        let firstScreen = try archive.feed(publicationLimit: 12)
+
+        XCTAssertEqual(firstScreen.publications, Array(feed.publications![0..<12]))
+        XCTAssertEqual(firstScreen.groups?.first?.publications, Array(group.publications![0..<12]))
+    }
+
+    func testOpen_rejectsOtherData() {
+        XCTAssertThrowsError(try OPDS2FeedArchive(data: Data("{\"feed\":{}}".utf8)))
+    }
+
+    func testOpen_rejectsTruncatedArchive() throws {
+        let data = try OPDS2FeedArchive.encode(OPDSCacheEntry(feed: makeFeed(publicationCount: 3)))
+
+        XCTAssertThrowsError(try OPDS2FeedArchive(data: data.dropLast(10)))
+    }
+
+    // MARK: - Benchmark
+
+    /// A cached 500-publication feed, encoded as JSON as before and as an archive.
+    private func makeCachedFeed() throws -> (entry: OPDSCacheEntry<OPDS2Feed>, json: Data, archive: Data) {
+        let entry = OPDSCacheEntry(feed: makeFeed(publicationCount: 500), etag: "\"etag\"")
+        return (entry, try JSONEncoder().encode(entry), try OPDS2FeedArchive.encode(entry))
+    }
+
+    func testBenchmark_500PublicationFeed_json() throws {
+        let json = try makeCachedFeed().json
+        measure(metrics: [XCTClockMetric(), XCTMemoryMetric()]) {
+            _ = try? JSONDecoder().decode(OPDSCacheEntry<OPDS2Feed>.self, from: json)
+        }
+    }
+
+    func testBenchmark_500PublicationFeed_archiveFirstScreen() throws {
+        let archive = try makeCachedFeed().archive
+        measure(metrics: [XCTClockMetric(), XCTMemoryMetric()]) {
+            _ = try? OPDS2FeedArchive(data: archive).feed(publicationLimit: 20)
+        }
+    }
+
+    func testBenchmark_500PublicationFeed_archiveAll() throws {
+        let cached = try makeCachedFeed()
+        XCTAssertEqual(try OPDS2FeedArchive(data: cached.archive).entry().feed, cached.entry.feed)
+        measure(metrics: [XCTClockMetric(), XCTMemoryMetric()]) {
+            _ = try? OPDS2FeedArchive(data: cached.archive).entry()
+        }
+    }
+}
@@ -129,6 +129,52 @@ final class OPDSFeedCacheTests: XCTestCase {
         XCTAssertNil(cached2, "Less recently accessed entry should be evicted")
     }
 
+    func testLRUCache_evictsLeastRecentlyUsed() {
+        var cache = LRUCache<String, Int>(capacity: 3)
+        cache.setValue(1, forKey: "a")
+        cache.setValue(2, forKey: "b")
+        cache.setValue(3, forKey: "c")
+        _ = cache.value(forKey: "a")
+        cache.removeValue(forKey: "c")
+        cache.setValue(4, forKey: "d")
+
+        let evicted = cache.setValue(5, forKey: "e")
+
+        XCTAssertEqual(evicted?.key, "b")
+        XCTAssertEqual(cache.keys, ["a", "d", "e"])
+        XCTAssertEqual(cache.peek("a"), 1)
+        XCTAssertEqual(cache.count, 3)
+    }
+
+    // MARK: - Disk
+
+    func testDiskEntry_opensWithoutDecodingPublications() async throws {
+        let diskCache = OPDS2FeedCache(configuration: .init(staleTTL: 60, maxAge: 600, maxMemoryEntries: 1, persistToDisk: true))
+        let url = URL(string: "https://example.com/disk-feed")!
+        let publications = (0..<30).map { index in
+            OPDS2Publication(
+                links: [OPDS2Link(href: "https://example.com/\(index)")],
+                metadata: .init(updated: Date(timeIntervalSince1970: 0), description: nil, id: "\(index)", title: "Book \(index)"),
+                images: nil
+            )
+        }
+        let feed = OPDS2Feed(metadata: OPDS2FeedMetadata(title: "Disk Feed"), links: [], publications: publications)
+        await diskCache.set(OPDSCacheEntry(feed: feed, etag: "\"disk\""), for: url)
+        // Push the feed out of memory
+        await diskCache.set(OPDSCacheEntry(feed: makeFeed(title: "Other")), for: URL(string: "https://example.com/other")!)
+
+        let firstScreen = await diskCache.get(for: url, publicationLimit: 5)
+        let rest = await diskCache.publications(for: url, in: 5..<30)
+        let cached = await diskCache.get(for: url)
+        await diskCache.clear()
+
+        XCTAssertEqual(firstScreen?.feed.metadata.title, "Disk Feed")
+        XCTAssertEqual(firstScreen?.etag, "\"disk\"")
+        XCTAssertEqual(firstScreen?.feed.publications, Array(publications[0..<5]))
+        XCTAssertEqual(rest, Array(publications[5..<30]))
+        XCTAssertEqual(cached?.feed, feed)
+    }
+
     // MARK: - Staleness and Expiration
 
     func testCacheEntryIsStale() async throws {
@@ -0,0 +1,180 @@
+//
+//  DecryptedBlockCacheTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+final class DecryptedBlockCacheTests: XCTestCase {
+
+    private static let key: UInt8 = 0x5A
+
+    /// Stands in for LCP decryption: XORs the bytes and takes `cost` per block.
+    private final class FakeDecryptor {
+        let encrypted: Data
+        let cost: TimeInterval
+        private let lock = NSLock()
+        private var _calls = 0
+
+        init(length: Int, cost: TimeInterval = 0) {
+            encrypted = Data((0..<length).map { UInt8($0 % 251) ^ DecryptedBlockCacheTests.key })
+            self.cost = cost
+        }
+
+        var calls: Int {
+            lock.lock()
+            defer { lock.unlock() }
+            return _calls
+        }
+
+        func decrypt(_ range: Range<Int>) -> Data? {
+            lock.lock()
+            _calls += 1
+            lock.unlock()
+            if cost > 0 {
+                Thread.sleep(forTimeInterval: cost)
+            }
+            return Data(encrypted[range].map { $0 ^ DecryptedBlockCacheTests.key })
+        }
+    }
+
+    private func expected(_ range: Range<Int>) -> Data {
+        Data(range.map { UInt8($0 % 251) })
+    }
+
+    // MARK: - Reads
+
+    func testRead_withinBlock_returnsDecryptedBytes() {
+        let decryptor = FakeDecryptor(length: 10_000)
+        let cache = DecryptedBlockCache(length: 10_000, blockSize: 1_024, capacity: 4, readAheadCount: 0, decryptor: decryptor.decrypt)
+
+        XCTAssertEqual(cache.read(100..<500), expected(100..<500))
+        XCTAssertEqual(cache.read(500..<1_024), expected(500..<1_024))
+        XCTAssertEqual(decryptor.calls, 1)
+    }
+
+    func testRead_spanningBlocks_stitchesBlocks() {
+        let decryptor = FakeDecryptor(length: 10_000)
+        let cache = DecryptedBlockCache(length: 10_000, blockSize: 1_024, capacity: 4, readAheadCount: 0, decryptor: decryptor.decrypt)
+
+        XCTAssertEqual(cache.read(1_000..<3_100), expected(1_000..<3_100))
+        XCTAssertEqual(decryptor.calls, 3)
+        XCTAssertEqual(cache.read(9_990..<10_000), expected(9_990..<10_000))
+    }
+
+    func testRead_outsideFile_returnsNil() {
+        let decryptor = FakeDecryptor(length: 1_000)
+        let cache = DecryptedBlockCache(length: 1_000, blockSize: 256, capacity: 4, readAheadCount: 0, decryptor: decryptor.decrypt)
+
+        XCTAssertNil(cache.read(900..<1_100))
+        XCTAssertNil(cache.read(10..<10))
+        XCTAssertEqual(decryptor.calls, 0)
+    }
+
+    // MARK: - Eviction
+
+    func testBackAndForth_betweenBlocks_decryptsEachBlockOnce() {
+        let decryptor = FakeDecryptor(length: 8_192)
+        let cache = DecryptedBlockCache(length: 8_192, blockSize: 1_024, capacity: 4, readAheadCount: 0, decryptor: decryptor.decrypt)
+
+        for _ in 0..<10 {
+            XCTAssertNotNil(cache.read(100..<200))
+            XCTAssertNotNil(cache.read(2_100..<2_200))
+        }
+
+        XCTAssertEqual(decryptor.calls, 2)
+    }
+
+    func testCapacity_evictsLeastRecentlyUsedBlock() {
+        let decryptor = FakeDecryptor(length: 8_192)
+        let cache = DecryptedBlockCache(length: 8_192, blockSize: 1_024, capacity: 2, readAheadCount: 0, decryptor: decryptor.decrypt)
+
+        _ = cache.read(0..<10)      // block 0
+        _ = cache.read(1_024..<1_034) // block 1
+        _ = cache.read(0..<10)      // block 0 used again
+        _ = cache.read(2_048..<2_058) // block 2 evicts block 1
+        XCTAssertEqual(cache.count, 2)
+        XCTAssertEqual(decryptor.calls, 3)
+
+        _ = cache.read(0..<10)
+        XCTAssertEqual(decryptor.calls, 3)
+        _ = cache.read(1_024..<1_034)
+        XCTAssertEqual(decryptor.calls, 4)
+    }
+
+    // MARK: - Read-Ahead
+
+    func testReadAhead_decryptsBlocksInReadingDirection() {
+        let decryptor = FakeDecryptor(length: 16_384)
+        let cache = DecryptedBlockCache(length: 16_384, blockSize: 1_024, capacity: 8, readAheadCount: 2, decryptor: decryptor.decrypt)
+
+        _ = cache.read(0..<10)
+        _ = cache.read(1_024..<1_034)
+
+        let readAhead = expectation(description: "blocks 2 and 3 decrypted ahead")
+        DispatchQueue.global().async {
+            while cache.count < 4 {
+                Thread.sleep(forTimeInterval: 0.005)
+            }
+            readAhead.fulfill()
+        }
+        wait(for: [readAhead], timeout: 5)
+
+        let calls = decryptor.calls
+        XCTAssertEqual(cache.read(2_048..<4_096), expected(2_048..<4_096))
+        XCTAssertEqual(decryptor.calls, calls)
+    }
+
+    // MARK: - Page-Turn Latency
+
+    /// Reads pages the way a scanned PDF is rendered: each page spans several
+    /// blocks and is read in 16 KB chunks. Pages forward, pausing on each page,
+    /// then flips between the last two pages.
+    private func readPages(capacity: Int, readAheadCount: Int) {
+        let blockSize = 64 * 1024
+        let pageSize = 96 * 1024
+        let pageCount = 12
+        let length = pageSize * pageCount
+        let chunkSize = 16 * 1024
+
+        let decryptor = FakeDecryptor(length: length, cost: 0.004)
+        let cache = DecryptedBlockCache(
+            length: length,
+            blockSize: blockSize,
+            capacity: capacity,
+            readAheadCount: readAheadCount,
+            decryptor: decryptor.decrypt
+        )
+
+        func renderPage(_ page: Int) {
+            for offset in stride(from: page * pageSize, to: (page + 1) * pageSize, by: chunkSize) {
+                XCTAssertNotNil(cache.read(offset..<offset + chunkSize))
+            }
+        }
+
+        for page in 0..<pageCount {
+            renderPage(page)
+            Thread.sleep(forTimeInterval: 0.02) // reading the page
+        }
+        for _ in 0..<5 {
+            renderPage(pageCount - 2)
+            renderPage(pageCount - 1)
+        }
+    }
+
+    /// The previous cache, which kept a single block.
+    func testPageTurnLatency_singleBlock() {
+        measure {
+            readPages(capacity: 1, readAheadCount: 0)
+        }
+    }
+
+    func testPageTurnLatency_lruWithReadAhead() {
+        measure {
+            readPages(capacity: 8, readAheadCount: 2)
+        }
+    }
+}
@@ -0,0 +1,137 @@
+//
+//  TPPEncryptedPDFDataProviderTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+import UIKit
+@testable import Palace
+
+final class TPPEncryptedPDFDataProviderTests: XCTestCase {
+
+    /// A PDF "encrypted" by XOR with `key`.
+    private struct EncryptedPDF {
+        let plain: Data
+        let encrypted: Data
+        let key: UInt8
+        let pageSize: CGSize
+        let pageCount: Int
+
+        init(pageCount: Int, pageSize: CGSize, key: UInt8) {
+            let renderer = UIGraphicsPDFRenderer(bounds: CGRect(origin: .zero, size: pageSize))
+            plain = renderer.pdfData { context in
+                for page in 0..<pageCount {
+                    context.beginPage()
+                    ("Page \(page + 1)" as NSString).draw(at: CGPoint(x: 20, y: 20), withAttributes: nil)
+                }
+            }
+            encrypted = Data(plain.map { $0 ^ key })
+            self.key = key
+            self.pageSize = pageSize
+            self.pageCount = pageCount
+        }
+
+        func decryptData(_ data: Data, _ start: UInt, _ end: UInt) -> Data {
+            Data(data[Int(start)..<Int(end)].map { $0 ^ key })
+        }
+
+        func decryptInto(_ data: Data, _ start: UInt, _ end: UInt, _ buffer: UnsafeMutableRawPointer) -> Bool {
+            let output = buffer.assumingMemoryBound(to: UInt8.self)
+            data.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) in
+                for (i, position) in (Int(start)..<Int(end)).enumerated() {
+                    output[i] = bytes[position] ^ key
+                }
+            }
+            return true
+        }
+    }
+
+    private func document(_ provider: TPPEncryptedPDFDataProvider) -> CGPDFDocument? {
+        CGPDFDocument(provider.dataProvider())
+    }
+
+    // MARK: - Reading
+
+    func testDataDecryptor_servesDecryptedDocument() throws {
+        let pdf = EncryptedPDF(pageCount: 3, pageSize: CGSize(width: 200, height: 300), key: 0x5A)
+        let provider = TPPEncryptedPDFDataProvider(data: pdf.encrypted, decryptor: pdf.decryptData)
+
+        let document = try XCTUnwrap(document(provider))
+
+        XCTAssertEqual(document.numberOfPages, 3)
+        XCTAssertEqual(document.page(at: 1)?.getBoxRect(.mediaBox).size, pdf.pageSize)
+    }
+
+    func testBufferDecryptor_servesDecryptedBytes() throws {
+        let pdf = EncryptedPDF(pageCount: 2, pageSize: CGSize(width: 200, height: 300), key: 0x33)
+        let provider = TPPEncryptedPDFDataProvider(data: pdf.encrypted, bufferDecryptor: pdf.decryptInto)
+
+        let data = try XCTUnwrap(provider.dataProvider().data as Data?)
+
+        XCTAssertEqual(data, pdf.plain)
+        XCTAssertEqual(document(provider)?.numberOfPages, 2)
+    }
+
+    // MARK: - Concurrency
+
+    /// Providers used to share their data and decryptor, so opening a second
+    /// document served the first one's reads with the wrong data.
+    func testTwoDocuments_readConcurrently() throws {
+        let first = EncryptedPDF(pageCount: 3, pageSize: CGSize(width: 200, height: 300), key: 0x5A)
+        let second = EncryptedPDF(pageCount: 5, pageSize: CGSize(width: 400, height: 500), key: 0xA5)
+        let firstProvider = TPPEncryptedPDFDataProvider(data: first.encrypted, bufferDecryptor: first.decryptInto)
+        let secondProvider = TPPEncryptedPDFDataProvider(data: second.encrypted, decryptor: second.decryptData)
+
+        let lock = NSLock()
+        var failures = [String]()
+
+        DispatchQueue.concurrentPerform(iterations: 20) { iteration in
+            let (pdf, provider) = iteration.isMultiple(of: 2) ? (first, firstProvider) : (second, secondProvider)
+            guard let document = CGPDFDocument(provider.dataProvider()) else {
+                lock.lock(); failures.append("document \(iteration) didn't open"); lock.unlock()
+                return
+            }
+            let renderer = UIGraphicsImageRenderer(size: pdf.pageSize)
+            for pageNumber in 1...pdf.pageCount {
+                guard let page = document.page(at: pageNumber), page.getBoxRect(.mediaBox).size == pdf.pageSize else {
+                    lock.lock(); failures.append("page \(pageNumber) of document \(iteration) is wrong"); lock.unlock()
+                    continue
+                }
+                _ = renderer.image { context in
+                    context.cgContext.drawPDFPage(page)
+                }
+            }
+            if document.numberOfPages != pdf.pageCount {
+                lock.lock(); failures.append("document \(iteration) has \(document.numberOfPages) pages"); lock.unlock()
+            }
+        }
+
+        XCTAssertEqual(failures, [])
+    }
+
+    // MARK: - Throughput
+
+    private func makeThroughputPDF() -> EncryptedPDF {
+        EncryptedPDF(pageCount: 400, pageSize: CGSize(width: 612, height: 792), key: 0x5A)
+    }
+
+    /// Reads a 400-page document through the data decryptor.
+    func testThroughput_dataMode() {
+        let pdf = makeThroughputPDF()
+        let provider = TPPEncryptedPDFDataProvider(data: pdf.encrypted, decryptor: pdf.decryptData)
+        measure {
+            XCTAssertEqual((provider.dataProvider().data as Data?)?.count, pdf.encrypted.count)
+        }
+    }
+
+    /// Reads a 400-page document through the buffer decryptor.
+    func testThroughput_bufferMode() {
+        let pdf = makeThroughputPDF()
+        let provider = TPPEncryptedPDFDataProvider(data: pdf.encrypted, bufferDecryptor: pdf.decryptInto)
+        measure {
+            XCTAssertEqual((provider.dataProvider().data as Data?)?.count, pdf.encrypted.count)
+        }
+    }
+}
@@ -0,0 +1,144 @@
+//
+//  TPPPDFSearchIndexTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+import UIKit
+@testable import Palace
+
+final class TPPPDFSearchIndexTests: XCTestCase {
+
+    private let pageBlocks: [[String]] = [
+        ["Chapter 1", "The mitochondria is the powerhouse", " of the cell."],
+        ["Cell biology, 2nd edition", "Photosynthesis-driven growth"],
+        ["Powerhouse", "mito", "chondria split across blocks"],
+        [],
+        ["Index: biology, cell, mitochondria"]
+    ]
+
+    /// The scan `TPPEncryptedPDFDocument.search(text:)` did before the index.
+    private func linearSearch(_ text: String) -> [(Int, String)] {
+        var result = [(Int, String)]()
+        for (page, blocks) in pageBlocks.enumerated() {
+            for block in blocks where block.lowercased().contains(text) {
+                result.append((page, block))
+            }
+        }
+        return result
+    }
+
+    private func indexSearch(_ index: TPPPDFSearchIndex, _ text: String) -> [(Int, String)] {
+        index.search(text: text).map { ($0.pageNumber, $0.title ?? "") }
+    }
+
+    func testSearch_matchesLinearScan() {
+        let index = TPPPDFSearchIndex(pageBlocks: pageBlocks, documentLength: 1_000)
+        let queries = [
+            "cell", "biology", "mitochondria", "chondria", "power", "house", "the power",
+            "powerhouse of", "2nd edition", "synthesis-driven", "-driven gr", "index:", "ce",
+            "of the cell.", "split across", "mitochondria split", "absent", ", ", "1"
+        ]
+
+        for query in queries {
+            let expected = linearSearch(query)
+            let actual = indexSearch(index, query)
+            XCTAssertEqual(actual.map(\.0), expected.map(\.0), "pages for '\(query)'")
+            XCTAssertEqual(actual.map(\.1), expected.map(\.1), "blocks for '\(query)'")
+        }
+    }
+
+    func testSearch_emptyQuery_returnsNothing() {
+        let index = TPPPDFSearchIndex(pageBlocks: pageBlocks, documentLength: 1_000)
+
+        XCTAssertTrue(index.search(text: "").isEmpty)
+    }
+
+    func testPostings_listEachPageOnce() {
+        let index = TPPPDFSearchIndex(pageBlocks: pageBlocks, documentLength: 1_000)
+
+        XCTAssertEqual(index.wordIndex.postings["cell"], [0, 1, 4])
+        XCTAssertEqual(index.wordIndex.postings["mito"], [2])
+        XCTAssertNil(index.wordIndex.postings["Cell"])
+    }
+
+    // MARK: - Storage
+
+    func testSaveAndLoad_roundTrips() throws {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).pdf.searchindex")
+        defer { try? FileManager.default.removeItem(at: url) }
+        let index = TPPPDFSearchIndex(pageBlocks: pageBlocks, documentLength: 1_000)
+
+        try index.save(to: url)
+
+        XCTAssertEqual(TPPPDFSearchIndex.load(from: url, documentLength: 1_000), index)
+        XCTAssertNil(TPPPDFSearchIndex.load(from: url, documentLength: 2_000))
+    }
+
+    func testSave_doesNotStorePageText() throws {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).pdf.searchindex")
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        try TPPPDFSearchIndex(pageBlocks: pageBlocks, documentLength: 1_000).save(to: url)
+
+        let stored = try Data(contentsOf: url)
+        XCTAssertNil(stored.range(of: Data("powerhouse".utf8)))
+        XCTAssertNil(stored.range(of: Data("Photosynthesis".utf8)))
+    }
+
+    func testURL_isNextToBook() {
+        let bookURL = URL(fileURLWithPath: "/tmp/content/book.pdf")
+
+        XCTAssertEqual(TPPPDFSearchIndex.url(forBookAt: bookURL).path, "/tmp/content/book.pdf.searchindex")
+    }
+
+    // MARK: - Indexing
+
+    private func makeDocument(pageCount: Int) -> CGPDFDocument? {
+        let renderer = UIGraphicsPDFRenderer(bounds: CGRect(x: 0, y: 0, width: 200, height: 300))
+        let data = renderer.pdfData { context in
+            for page in 0..<pageCount {
+                context.beginPage()
+                ("Page \(page + 1)" as NSString).draw(at: CGPoint(x: 20, y: 20), withAttributes: nil)
+            }
+        }
+        return CGDataProvider(data: data as CFData).flatMap(CGPDFDocument.init)
+    }
+
+    func testBuild_indexesEveryPage() async throws {
+        let document = try XCTUnwrap(makeDocument(pageCount: 12))
+
+        let index = try await TPPPDFSearchIndex.build(document: document, documentLength: 1_000)
+
+        XCTAssertEqual(index.pageCount, 12)
+        XCTAssertEqual(index.documentLength, 1_000)
+    }
+
+    func testBuild_stopsWhenCancelled() async throws {
+        let document = try XCTUnwrap(makeDocument(pageCount: 200))
+
+        let task = Task {
+            try await TPPPDFSearchIndex.build(document: document, documentLength: 1_000)
+        }
+        task.cancel()
+
+        do {
+            _ = try await task.value
+            XCTFail("Indexing should have been cancelled")
+        } catch {
+            XCTAssertTrue(error is CancellationError)
+        }
+    }
+
+    func testLoadOrBuild_savesIndexForNextOpen() async throws {
+        let document = try XCTUnwrap(makeDocument(pageCount: 3))
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).pdf.searchindex")
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        let built = try await TPPPDFSearchIndex.loadOrBuild(at: url, document: document, documentLength: 42)
+
+        XCTAssertEqual(TPPPDFSearchIndex.load(from: url, documentLength: 42), built)
+    }
+}
@@ -0,0 +1,200 @@
+//
+//  TPPPDFThumbnailStoreTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+import UIKit
+@testable import Palace
+
+final class TPPPDFThumbnailStoreTests: XCTestCase {
+
+    private var url: URL!
+
+    override func setUp() {
+        super.setUp()
+        url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).pdf.thumbnails")
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: url)
+        super.tearDown()
+    }
+
+    private func jpegData(_ value: UInt8, length: Int = 64) -> Data {
+        Data(repeating: value, count: length)
+    }
+
+    private func reopen(_ store: TPPPDFThumbnailStore, documentLength: Int = 1_000) -> TPPPDFThumbnailStore {
+        store.waitForWrites()
+        return TPPPDFThumbnailStore(url: url, documentLength: documentLength)
+    }
+
+    // MARK: - Store
+
+    func testStore_roundTripsAcrossReopen() {
+        let store = TPPPDFThumbnailStore(url: url, documentLength: 1_000)
+        store.store(jpegData(1), for: .init(page: 0, kind: .thumbnail))
+        store.store(jpegData(2, length: 100), for: .init(page: 0, kind: .preview))
+        store.store(jpegData(3), for: .init(page: 7, kind: .thumbnail))
+
+        XCTAssertEqual(store.data(for: .init(page: 7, kind: .thumbnail)), jpegData(3))
+
+        let reopened = reopen(store)
+
+        XCTAssertEqual(reopened.data(for: .init(page: 0, kind: .thumbnail)), jpegData(1))
+        XCTAssertEqual(reopened.data(for: .init(page: 0, kind: .preview)), jpegData(2, length: 100))
+        XCTAssertEqual(reopened.data(for: .init(page: 7, kind: .thumbnail)), jpegData(3))
+        XCTAssertFalse(reopened.contains(.init(page: 7, kind: .preview)))
+    }
+
+    func testStore_readsWrittenImagesFromFile() {
+        let store = TPPPDFThumbnailStore(url: url, documentLength: 1_000)
+        store.store(jpegData(1), for: .init(page: 0, kind: .thumbnail))
+        store.waitForWrites()
+        store.store(jpegData(2), for: .init(page: 1, kind: .thumbnail))
+        store.waitForWrites()
+
+        // Written images are no longer held in memory, so a memory warning loses none
+        NotificationCenter.default.post(name: UIApplication.didReceiveMemoryWarningNotification, object: nil)
+
+        XCTAssertEqual(store.data(for: .init(page: 0, kind: .thumbnail)), jpegData(1))
+        XCTAssertEqual(store.data(for: .init(page: 1, kind: .thumbnail)), jpegData(2))
+    }
+
+    func testOpen_dropsPartialRecord() throws {
+        let store = TPPPDFThumbnailStore(url: url, documentLength: 1_000)
+        store.store(jpegData(1), for: .init(page: 0, kind: .thumbnail))
+        store.store(jpegData(2), for: .init(page: 1, kind: .thumbnail))
+        _ = reopen(store)
+
+        // Cut the last record short, as a crash mid-write would.
+        let handle = try FileHandle(forWritingTo: url)
+        let size = try handle.seekToEnd()
+        try handle.truncate(atOffset: size - 10)
+        try handle.close()
+
+        let reopened = TPPPDFThumbnailStore(url: url, documentLength: 1_000)
+
+        XCTAssertEqual(reopened.data(for: .init(page: 0, kind: .thumbnail)), jpegData(1))
+        XCTAssertFalse(reopened.contains(.init(page: 1, kind: .thumbnail)))
+        let truncatedSize = try FileManager.default.attributesOfItem(atPath: url.path)[.size] as? Int
+        XCTAssertEqual(truncatedSize, 12 + 12 + 64)
+    }
+
+    func testOpen_forAnotherDocument_startsOver() {
+        let store = TPPPDFThumbnailStore(url: url, documentLength: 1_000)
+        store.store(jpegData(1), for: .init(page: 0, kind: .thumbnail))
+        _ = reopen(store)
+
+        let reopened = TPPPDFThumbnailStore(url: url, documentLength: 2_000)
+
+        XCTAssertFalse(reopened.contains(.init(page: 0, kind: .thumbnail)))
+        XCTAssertFalse(FileManager.default.fileExists(atPath: url.path))
+    }
+
+    func testURL_isNextToBook() {
+        let bookURL = URL(fileURLWithPath: "/tmp/content/book.pdf")
+
+        XCTAssertEqual(TPPPDFThumbnailStore.url(forBookAt: bookURL).path, "/tmp/content/book.pdf.thumbnails")
+    }
+
+    // MARK: - Pipeline
+
+    private func image(_ color: UIColor) -> UIImage {
+        UIGraphicsImageRenderer(size: CGSize(width: 8, height: 8)).image { context in
+            color.setFill()
+            context.fill(CGRect(x: 0, y: 0, width: 8, height: 8))
+        }
+    }
+
+    /// Renderer whose first two renders wait for `gate`, keeping both
+    /// pipeline slots busy while requests are enqueued.
+    private func gatedRenderer(_ gate: DispatchSemaphore, rendered: @escaping (Int) -> Void) -> TPPPDFThumbnailPipeline.Renderer {
+        let lock = NSLock()
+        var started = 0
+        return { page, _ in
+            lock.lock()
+            let isGated = started < 2
+            started += 1
+            lock.unlock()
+            if isGated {
+                gate.wait()
+            }
+            rendered(page)
+            return self.image(.gray)
+        }
+    }
+
+    func testPipeline_rendersRequestedPagesBeforePrefetch() {
+        let lock = NSLock()
+        var rendered = [Int]()
+        let gate = DispatchSemaphore(value: 0)
+        let pipeline = TPPPDFThumbnailPipeline(store: nil, renderer: gatedRenderer(gate) { page in
+            lock.lock(); rendered.append(page); lock.unlock()
+        })
+
+        pipeline.prefetch(pages: 0..<40, kind: .thumbnail)
+        let visible = expectation(description: "visible")
+        pipeline.request(page: 35, kind: .thumbnail) { image in
+            XCTAssertNotNil(image)
+            visible.fulfill()
+        }
+        gate.signal()
+        gate.signal()
+
+        wait(for: [visible], timeout: 5)
+
+        lock.lock()
+        let position = rendered.firstIndex(of: 35)
+        lock.unlock()
+        // Only the two renders already running go first.
+        XCTAssertLessThanOrEqual(position ?? .max, 2)
+    }
+
+    func testPipeline_cancelledRequestIsNotRendered() {
+        let lock = NSLock()
+        var rendered = Set<Int>()
+        let gate = DispatchSemaphore(value: 0)
+        let pipeline = TPPPDFThumbnailPipeline(store: nil, renderer: gatedRenderer(gate) { page in
+            lock.lock(); rendered.insert(page); lock.unlock()
+        })
+
+        let busy = expectation(description: "busy")
+        busy.expectedFulfillmentCount = 2
+        pipeline.request(page: 0, kind: .preview) { _ in busy.fulfill() }
+        pipeline.request(page: 1, kind: .preview) { _ in busy.fulfill() }
+        let cancelled = pipeline.request(page: 9, kind: .preview) { _ in
+            XCTFail("Cancelled request completed")
+        }
+        pipeline.cancel(cancelled)
+        gate.signal()
+        gate.signal()
+
+        wait(for: [busy], timeout: 5)
+        let done = expectation(description: "done")
+        pipeline.request(page: 2, kind: .preview) { _ in done.fulfill() }
+        wait(for: [done], timeout: 5)
+
+        lock.lock()
+        XCTAssertFalse(rendered.contains(9))
+        lock.unlock()
+    }
+
+    func testPipeline_servesStoredImagesWithoutRendering() {
+        let store = TPPPDFThumbnailStore(url: url, documentLength: 1_000)
+        let first = TPPPDFThumbnailPipeline(store: store) { _, _ in self.image(.red) }
+        XCTAssertNotNil(first.image(page: 3, kind: .thumbnail))
+
+        let reopened = reopen(store)
+        let second = TPPPDFThumbnailPipeline(store: reopened) { _, _ in
+            XCTFail("Stored page rendered again")
+            return nil
+        }
+
+        XCTAssertNotNil(second.cachedImage(page: 3, kind: .thumbnail))
+        XCTAssertNil(second.cachedImage(page: 4, kind: .thumbnail))
+    }
+}
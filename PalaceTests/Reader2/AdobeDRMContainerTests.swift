@@ -0,0 +1,262 @@
+//
+//  AdobeDRMContainerTests.swift
+//  PalaceTests
+//
+//  Tests for AdobeDRMContainer metadata caching and concurrent decoding.
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+final class AdobeDRMContainerTests: XCTestCase {
+
+    private var tempDirectory: URL!
+    private var bookURL: URL!
+
+    private let encryptedItemCount = 200
+
+    override func setUp() {
+        super.setUp()
+        tempDirectory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("AdobeDRMContainerTests-\(UUID().uuidString)")
+        try? FileManager.default.createDirectory(at: tempDirectory, withIntermediateDirectories: true)
+        // No `_rights.xml` next to the book: decryptors can't be created in tests,
+        // so these cover metadata parsing, item lookup and locking.
+        bookURL = tempDirectory.appendingPathComponent("book.epub")
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: tempDirectory)
+        super.tearDown()
+    }
+
+    // MARK: - Helpers
+
+    private func itemPath(_ index: Int) -> String {
+        "OEBPS/chapter\(index).xhtml"
+    }
+
+    private func originalLength(_ index: Int) -> Int {
+        4096 + index
+    }
+
+    private func makeEncryptionData() -> Data {
+        let items = (0..<encryptedItemCount).map { index in
+            """
+              <enc:EncryptedData>
+                <enc:EncryptionMethod Algorithm="http://www.w3.org/2001/04/xmlenc#aes128-cbc"/>
+                <ds:KeyInfo><resource xmlns="http://ns.adobe.com/adept">urn:uuid:00000000-0000-0000-0000-000000000000</resource></ds:KeyInfo>
+                <enc:CipherData><enc:CipherReference URI="\(itemPath(index))"/></enc:CipherData>
+                <enc:EncryptionProperties>
+                  <enc:EncryptionProperty xmlns:ns="http://www.idpf.org/2016/encryption#compression">
+                    <ns:Compression Method="8" OriginalLength="\(originalLength(index))"/>
+                  </enc:EncryptionProperty>
+                </enc:EncryptionProperties>
+              </enc:EncryptedData>
+            """
+        }.joined(separator: "\n")
+
+        let xml = """
+            <?xml version="1.0"?>
+            <encryption xmlns="urn:oasis:names:tc:opendocument:xmlns:container"
+                        xmlns:enc="http://www.w3.org/2001/04/xmlenc#"
+                        xmlns:ds="http://www.w3.org/2000/09/xmldsig#">
+            \(items)
+            </encryption>
+            """
+        return Data(xml.utf8)
+    }
+
+    private func makeContainer(cachesItemDecryptors: Bool = true) -> AdobeDRMContainer {
+        let container = AdobeDRMContainer(url: bookURL, encryptionData: makeEncryptionData())
+        container.cachesItemDecryptors = cachesItemDecryptors
+        return container
+    }
+
+    // MARK: - Decoding
+
+    func testDecode_itemNotInEncryptionXML_returnsInputWithError() {
+        let container = makeContainer()
+        let data = Data("plain".utf8)
+
+        let result = container.decode(data, at: "OEBPS/not-encrypted.css")
+
+        XCTAssertEqual(result, data)
+        XCTAssertEqual(container.epubDecodingError, "Missing EncryptionItemInfo")
+    }
+
+    func testDecode_withoutRightsFile_returnsInputWithError() {
+        let container = makeContainer()
+        let data = Data("encrypted".utf8)
+
+        let result = container.decode(data, at: itemPath(0))
+
+        XCTAssertEqual(result, data)
+        XCTAssertEqual(container.epubDecodingError, "Missing Rights XML Data")
+    }
+
+    func testDecode_repeatedCalls_reportSameErrorFromCache() {
+        let container = makeContainer()
+        let data = Data("encrypted".utf8)
+
+        _ = container.decode(data, at: itemPath(1))
+        let first = container.epubDecodingError
+        _ = container.decode(data, at: "OEBPS/not-encrypted.css")
+        _ = container.decode(data, at: itemPath(1))
+
+        XCTAssertEqual(container.epubDecodingError, first)
+    }
+
+    func testDecode_invalidEncryptionXML_reportsMissingMetadata() {
+        let container = AdobeDRMContainer(url: bookURL, encryptionData: Data("not xml".utf8))
+        let data = Data("encrypted".utf8)
+
+        XCTAssertEqual(container.decode(data, at: itemPath(0)), data)
+        XCTAssertEqual(container.epubDecodingError, "Missing EncryptionMetadata")
+    }
+
+    func testDecode_concurrentResources_returnInputForEveryItem() {
+        let container = makeContainer()
+        let results = UnsafeMutableBufferPointer<Bool>.allocate(capacity: encryptedItemCount)
+        results.initialize(repeating: false)
+        defer { results.deallocate() }
+
+        DispatchQueue.concurrentPerform(iterations: encryptedItemCount) { index in
+            let data = Data("resource \(index)".utf8)
+            results[index] = container.decode(data, at: itemPath(index)) == data
+        }
+
+        XCTAssertTrue(results.allSatisfy { $0 })
+    }
+
+    func testDecode_concurrentCalls_reportTheirOwnError() {
+        let container = makeContainer()
+        let errors = UnsafeMutableBufferPointer<NSString?>.allocate(capacity: encryptedItemCount)
+        errors.initialize(repeating: nil)
+        defer { errors.deallocate() }
+
+        // Even calls decode items missing from encryption.xml, odd calls encrypted items.
+        DispatchQueue.concurrentPerform(iterations: encryptedItemCount) { index in
+            let path = index.isMultiple(of: 2) ? "OEBPS/styles\(index).css" : itemPath(index)
+            var error: NSString?
+            _ = container.decode(Data("resource \(index)".utf8), at: path, error: &error)
+            errors[index] = error
+        }
+
+        for (index, error) in errors.enumerated() {
+            XCTAssertEqual(error as String?, index.isMultiple(of: 2) ? "Missing EncryptionItemInfo" : "Missing Rights XML Data")
+        }
+    }
+
+    func testDecode_withoutCache_reportsSameErrors() {
+        let container = makeContainer(cachesItemDecryptors: false)
+        let data = Data("encrypted".utf8)
+        var error: NSString?
+
+        XCTAssertEqual(container.decode(data, at: itemPath(0), error: &error), data)
+        XCTAssertEqual(error, "Missing Rights XML Data")
+        XCTAssertEqual(container.decode(data, at: "OEBPS/not-encrypted.css", error: &error), data)
+        XCTAssertEqual(error, "Missing EncryptionItemInfo")
+    }
+
+    // MARK: - Streaming
+
+    func testDecryptionStream_itemNotInEncryptionXML_returnsNilWithError() {
+        let container = makeContainer()
+
+        XCTAssertNil(container.decryptionStream(at: "OEBPS/images/cover.jpg"))
+        XCTAssertEqual(container.epubDecodingError, "Missing EncryptionItemInfo")
+    }
+
+    func testDecryptionStream_withoutRightsFile_returnsNilWithError() {
+        let container = makeContainer()
+
+        XCTAssertNil(container.decryptionStream(at: itemPath(2)))
+        XCTAssertEqual(container.epubDecodingError, "Missing Rights XML Data")
+    }
+
+    func testDecryptionStream_returnsErrorOfThisCall() {
+        let container = makeContainer()
+        var error: NSString?
+
+        XCTAssertNil(container.decryptionStream(at: "OEBPS/images/cover.jpg", error: &error))
+        XCTAssertEqual(error, "Missing EncryptionItemInfo")
+        XCTAssertNil(container.decryptionStream(at: itemPath(2), error: &error))
+        XCTAssertEqual(error, "Missing Rights XML Data")
+        XCTAssertNil(container.epubDecodingError, "Per-call variants leave the shared error alone")
+    }
+
+    func testDecryptionStream_clearsPreviousError() {
+        let container = makeContainer()
+        _ = container.decryptionStream(at: "OEBPS/images/cover.jpg")
+
+        _ = container.decryptionStream(at: itemPath(2))
+
+        XCTAssertEqual(container.epubDecodingError, "Missing Rights XML Data")
+    }
+
+    // MARK: - Original Length
+
+    func testOriginalLength_readsLengthFromEncryptionXML() {
+        let container = makeContainer()
+
+        XCTAssertEqual(container.originalLength(at: itemPath(0))?.intValue, originalLength(0))
+        XCTAssertEqual(container.originalLength(at: itemPath(42))?.intValue, originalLength(42))
+    }
+
+    func testOriginalLength_itemNotInEncryptionXML_isNil() {
+        let container = makeContainer()
+
+        XCTAssertNil(container.originalLength(at: "OEBPS/not-encrypted.css"))
+    }
+
+    // MARK: - Performance Tests
+
+    /// Time to first resource: a fresh container parses encryption.xml and builds one decryptor.
+    /// Opening a chapter decodes a few resources, the first chapter included.
+    private func timeToFirstResource(cachesItemDecryptors: Bool) {
+        let data = Data(repeating: 0x42, count: 16 * 1024)
+
+        measure {
+            for _ in 0..<20 {
+                let container = makeContainer(cachesItemDecryptors: cachesItemDecryptors)
+                for index in 0..<5 {
+                    _ = container.decode(data, at: itemPath(index), error: nil)
+                }
+            }
+        }
+    }
+
+    /// Throughput of a warm container serving many resources from multiple threads,
+    /// as Readium does when it opens a publication.
+    private func concurrentThroughput(cachesItemDecryptors: Bool) {
+        let container = makeContainer(cachesItemDecryptors: cachesItemDecryptors)
+        let data = Data(repeating: 0x42, count: 16 * 1024)
+
+        measure {
+            DispatchQueue.concurrentPerform(iterations: encryptedItemCount * 10) { index in
+                _ = container.decode(data, at: itemPath(index % encryptedItemCount), error: nil)
+            }
+        }
+    }
+
+    func testPerformance_timeToFirstResource() {
+        timeToFirstResource(cachesItemDecryptors: true)
+    }
+
+    /// Baseline: encryption.xml parsed and the decryptor created on every call under the global lock.
+    func testPerformance_timeToFirstResource_uncached() {
+        timeToFirstResource(cachesItemDecryptors: false)
+    }
+
+    func testPerformance_concurrentThroughput() {
+        concurrentThroughput(cachesItemDecryptors: true)
+    }
+
+    /// Baseline: encryption.xml parsed and the decryptor created on every call under the global lock.
+    func testPerformance_concurrentThroughput_uncached() {
+        concurrentThroughput(cachesItemDecryptors: false)
+    }
+}
@@ -0,0 +1,151 @@
+//
+//  DRMStreamingResourceTests.swift
+//  PalaceTests
+//
+//  Tests for streaming large entries that aren't listed in encryption.xml.
+//  Without an activated device decryption can't run in tests, so these cover
+//  locating entries, range reads and the read position.
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+import ReadiumShared
+@testable import Palace
+
+final class DRMStreamingResourceTests: XCTestCase {
+
+    private var tempDirectory: URL!
+    private var bookURL: URL!
+
+    private let imagePath = "OEBPS/images/map.png"
+    private let imageLength = 3 * 1024 * 1024 + 11
+
+    override func setUp() {
+        super.setUp()
+        tempDirectory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("DRMStreamingResourceTests-\(UUID().uuidString)")
+        try? FileManager.default.createDirectory(at: tempDirectory, withIntermediateDirectories: true)
+        bookURL = tempDirectory.appendingPathComponent("book.epub")
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: tempDirectory)
+        super.tearDown()
+    }
+
+    // MARK: - Helpers
+
+    private func imageData() -> Data {
+        Data((0..<imageLength).map { UInt8($0 % 251) })
+    }
+
+    /// Writes a ZIP file with stored (uncompressed) entries.
+    private func writeZIP(_ entries: [(path: String, data: Data)]) throws {
+        var file = Data()
+        var directory = Data()
+
+        func append16(_ value: Int, to data: inout Data) {
+            data.append(contentsOf: [UInt8(value & 0xFF), UInt8(value >> 8 & 0xFF)])
+        }
+        func append32(_ value: Int, to data: inout Data) {
+            append16(value & 0xFFFF, to: &data)
+            append16(value >> 16 & 0xFFFF, to: &data)
+        }
+
+        for entry in entries {
+            let name = Data(entry.path.utf8)
+            let headerOffset = file.count
+
+            append32(0x04034b50, to: &file)
+            [20, 0, 0, 0, 0].forEach { append16($0, to: &file) }
+            [0, entry.data.count, entry.data.count].forEach { append32($0, to: &file) }
+            [name.count, 0].forEach { append16($0, to: &file) }
+            file.append(name)
+            file.append(entry.data)
+
+            append32(0x02014b50, to: &directory)
+            [20, 20, 0, 0, 0, 0].forEach { append16($0, to: &directory) }
+            [0, entry.data.count, entry.data.count].forEach { append32($0, to: &directory) }
+            [name.count, 0, 0, 0, 0].forEach { append16($0, to: &directory) }
+            [0, headerOffset].forEach { append32($0, to: &directory) }
+            directory.append(name)
+        }
+
+        let directoryOffset = file.count
+        file.append(directory)
+        append32(0x06054b50, to: &file)
+        [0, 0, entries.count, entries.count].forEach { append16($0, to: &file) }
+        [directory.count, directoryOffset].forEach { append32($0, to: &file) }
+        append16(0, to: &file)
+
+        try file.write(to: bookURL)
+    }
+
+    private func makeResource() throws -> DRMStreamingResource {
+        try writeZIP([
+            ("mimetype", Data("application/epub+zip".utf8)),
+            (imagePath, imageData())
+        ])
+        let encryption = """
+            <?xml version="1.0"?>
+            <encryption xmlns="urn:oasis:names:tc:opendocument:xmlns:container"
+                        xmlns:enc="http://www.w3.org/2001/04/xmlenc#">
+              <enc:EncryptedData>
+                <enc:EncryptionMethod Algorithm="http://www.w3.org/2001/04/xmlenc#aes128-cbc"/>
+                <enc:CipherData><enc:CipherReference URI="OEBPS/chapter1.xhtml"/></enc:CipherData>
+              </enc:EncryptedData>
+            </encryption>
+            """
+        let container = AdobeDRMContainer(url: bookURL, encryptionData: Data(encryption.utf8))
+        return DRMStreamingResource(path: imagePath, encryptedLength: UInt64(imageLength), drmContainer: container)
+    }
+
+    // MARK: - Tests
+
+    func testLocate_findsStoredEntryData() throws {
+        try writeZIP([("mimetype", Data("application/epub+zip".utf8)), (imagePath, imageData())])
+
+        let location = try ZIPEntryLocation.locate(imagePath, in: bookURL)
+
+        XCTAssertEqual(location.uncompressedSize, UInt64(imageLength))
+        XCTAssertFalse(location.isDeflated)
+        let handle = try FileHandle(forReadingFrom: bookURL)
+        defer { try? handle.close() }
+        try handle.seek(toOffset: location.dataOffset)
+        XCTAssertEqual(try handle.read(upToCount: 1024), imageData().prefix(1024))
+    }
+
+    func testLocate_missingEntry_throws() throws {
+        try writeZIP([("mimetype", Data("application/epub+zip".utf8))])
+
+        XCTAssertThrowsError(try ZIPEntryLocation.locate(imagePath, in: bookURL))
+    }
+
+    func testRead_entryNotInEncryptionXML_returnsRawData() async throws {
+        let resource = try makeResource()
+
+        let data = try await resource.read(range: nil)
+
+        XCTAssertEqual(data, imageData())
+    }
+
+    func testRead_ranges_matchRawData() async throws {
+        let resource = try makeResource()
+        let expected = imageData()
+
+        // Forward reads continue from the previous position; a backward read starts over.
+        for range in [UInt64(0)..<100, 100..<70_000, 70_000..<70_001, 2_000_000..<2_100_000, 10..<20] {
+            let data = try await resource.read(range: range)
+            XCTAssertEqual(data, expected.subdata(in: Int(range.lowerBound)..<Int(range.upperBound)), "\(range)")
+        }
+    }
+
+    func testProperties_reportsLength() async throws {
+        let resource = try makeResource()
+
+        let properties = try await resource.properties().get()
+
+        XCTAssertEqual(properties.length, UInt64(imageLength))
+    }
+}
@@ -0,0 +1,111 @@
+//
+//  EPUBSearchIndexTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+import ReadiumShared
+@testable import Palace
+
+final class EPUBSearchIndexTests: XCTestCase {
+
+    private let texts = [
+        "Chapter One. The Café opened at dawn, and the baker's café-au-lait was famous.",
+        "Chapter Two. Nobody in town knew where the baker came from.",
+        "",
+        "Épilogue: the CAFE closed."
+    ]
+
+    private func makeIndex() -> EPUBSearchIndex {
+        let resources = texts.enumerated().map { index, text in
+            EPUBSearchIndex.Resource(href: "OEBPS/ch\(index).xhtml", mediaType: "application/xhtml+xml", title: "Chapter \(index)", text: text)
+        }
+        return EPUBSearchIndex(resources: resources, publicationIdentifier: "urn:isbn:1234")
+    }
+
+    /// Case- and diacritic-insensitive scan of every resource.
+    private func linearSearch(_ query: String) -> [(String, String)] {
+        var result = [(String, String)]()
+        for (index, text) in texts.enumerated() {
+            var range = text.startIndex..<text.endIndex
+            while let match = text.range(of: query, options: [.caseInsensitive, .diacriticInsensitive], range: range) {
+                result.append(("OEBPS/ch\(index).xhtml", String(text[match])))
+                range = match.upperBound..<text.endIndex
+            }
+        }
+        return result
+    }
+
+    // MARK: - Search
+
+    func testSearch_matchesLinearScan() {
+        let index = makeIndex()
+        let queries = ["cafe", "Café", "baker", "baker's", "the baker", "ake", "chapter two", "au-lait", "dawn, and", "epilogue:", "absent", "."]
+
+        for query in queries {
+            let expected = linearSearch(query)
+            let actual = index.search(query: query)
+            XCTAssertEqual(actual.map(\.href.string), expected.map(\.0), "resources for '\(query)'")
+            XCTAssertEqual(actual.map { $0.text.highlight ?? "" }, expected.map(\.1), "highlights for '\(query)'")
+        }
+    }
+
+    func testSearch_locatorHasContextAndProgression() throws {
+        let locator = try XCTUnwrap(makeIndex().search(query: "nobody").first)
+
+        XCTAssertEqual(locator.title, "Chapter 1")
+        XCTAssertEqual(locator.text.before, "Chapter Two. ")
+        XCTAssertEqual(locator.text.highlight, "Nobody")
+        XCTAssertTrue(locator.text.after?.hasPrefix(" in town") == true)
+        XCTAssertEqual(locator.locations.progression ?? -1, 13.0 / Double(texts[1].count), accuracy: 0.0001)
+        XCTAssertEqual(locator.locations.totalProgression ?? -1, Double(texts[0].count + 13) / Double(texts.joined().count), accuracy: 0.0001)
+    }
+
+    func testSearch_emptyQuery_returnsNothing() {
+        XCTAssertTrue(makeIndex().search(query: "  ").isEmpty)
+    }
+
+    // MARK: - HTML
+
+    func testPlainText_stripsMarkupScriptsAndEntities() {
+        let html = """
+        <html><head><title>Ignored</title><style>p { color: red; }</style></head>
+        <body><h1>Title</h1><p>Fish &amp; chips&#8212;tasty&nbsp;<em>today</em>.</p>
+        <script>var x = "<p>hidden</p>";</script><p>End &unknown; &#x41;</p></body></html>
+        """
+
+        XCTAssertEqual(EPUBSearchIndex.plainText(fromHTML: html), "Title Fish & chips—tasty today . End &unknown; A")
+    }
+
+    // MARK: - Storage
+
+    func testSaveAndLoad_roundTrips() throws {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).epub.searchindex")
+        defer { try? FileManager.default.removeItem(at: url) }
+        let index = makeIndex()
+
+        try index.save(to: url)
+
+        XCTAssertEqual(EPUBSearchIndex.load(from: url, publicationIdentifier: "urn:isbn:1234"), index)
+        XCTAssertNil(EPUBSearchIndex.load(from: url, publicationIdentifier: "urn:isbn:5678"))
+    }
+
+    func testSave_encryptsBookText() throws {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).epub.searchindex")
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        try makeIndex().save(to: url)
+
+        let stored = try Data(contentsOf: url)
+        XCTAssertNil(stored.range(of: Data("baker".utf8)))
+        XCTAssertNil(try? PropertyListDecoder().decode(EPUBSearchIndex.self, from: stored))
+    }
+
+    func testURL_isNextToBook() {
+        let bookURL = URL(fileURLWithPath: "/tmp/content/book.epub")
+
+        XCTAssertEqual(EPUBSearchIndex.url(forBookAt: bookURL).path, "/tmp/content/book.epub.searchindex")
+    }
+}
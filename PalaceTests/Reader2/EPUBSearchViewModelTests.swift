@@ -502,4 +502,26 @@ final class EPUBSearchViewModelTests: XCTestCase {
             XCTFail("State should be .failure when publication is not searchable")
         }
     }
+
+    // MARK: - Search Index Tests
+
+    func testSearch_WithIndex_ReturnsAllResultsWithoutSearchService() async {
+        let index = EPUBSearchIndex(resources: [
+            EPUBSearchIndex.Resource(href: "ch1.xhtml", mediaType: "application/xhtml+xml", title: "Chapter 1", text: "A test and another test."),
+            EPUBSearchIndex.Resource(href: "ch2.xhtml", mediaType: "application/xhtml+xml", title: "Chapter 2", text: "One more test.")
+        ], publicationIdentifier: "urn:test")
+        let indexedViewModel = EPUBSearchViewModel(publication: publication, searchIndex: index)
+
+        await indexedViewModel.search(with: "test")
+
+        XCTAssertEqual(mockSearchService.searchCallCount, 0, "Indexed search should not use the search service")
+        XCTAssertEqual(indexedViewModel.results.count, 3)
+        XCTAssertEqual(indexedViewModel.sections.map(\.title), ["Chapter 1", "Chapter 2"])
+        switch indexedViewModel.state {
+        case .end:
+            break // Expected - there are no more batches to fetch
+        default:
+            XCTFail("State should be .end after an indexed search, got \(indexedViewModel.state)")
+        }
+    }
 }
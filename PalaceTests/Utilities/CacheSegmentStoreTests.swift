@@ -0,0 +1,199 @@
+//
+//  CacheSegmentStoreTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+final class CacheSegmentStoreTests: XCTestCase {
+
+    private var directory: URL!
+
+    override func setUp() {
+        super.setUp()
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent("CacheSegmentStoreTests-\(UUID().uuidString)")
+    }
+
+    override func tearDown() {
+        try? FileManager.default.removeItem(at: directory)
+        super.tearDown()
+    }
+
+    private func value(_ byte: UInt8, length: Int = 100) -> Data {
+        Data(repeating: byte, count: length)
+    }
+
+    private func segmentFiles() -> [URL] {
+        ((try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: nil)) ?? [])
+            .filter { $0.pathExtension == "segment" }
+    }
+
+    // MARK: - Reading and Writing
+
+    func testSet_isReadableBeforeAndAfterWrite() {
+        let store = CacheSegmentStore(directory: directory, maxBytes: 10 * 1024 * 1024)
+
+        store.set(value(1), for: "a", expiration: nil)
+        XCTAssertEqual(store.data(for: "a"), value(1))
+
+        store.waitForWrites()
+        XCTAssertEqual(store.data(for: "a"), value(1))
+        XCTAssertEqual(store.count, 1)
+    }
+
+    func testReopen_rebuildsIndexFromSegments() {
+        let store = CacheSegmentStore(directory: directory, maxBytes: 10 * 1024 * 1024)
+        store.set(value(1), for: "a", expiration: nil)
+        store.set(value(2), for: "b", expiration: nil)
+        store.set(value(3), for: "a", expiration: nil)
+        store.remove("b")
+        store.waitForWrites()
+
+        let reopened = CacheSegmentStore(directory: directory, maxBytes: 10 * 1024 * 1024)
+
+        XCTAssertEqual(reopened.data(for: "a"), value(3))
+        XCTAssertNil(reopened.data(for: "b"))
+        XCTAssertEqual(reopened.count, 1)
+    }
+
+    func testExpiredEntry_isNotReturned() {
+        let store = CacheSegmentStore(directory: directory, maxBytes: 10 * 1024 * 1024)
+
+        store.set(value(1), for: "old", expiration: Date().addingTimeInterval(-1))
+        store.set(value(2), for: "new", expiration: Date().addingTimeInterval(60))
+        store.waitForWrites()
+
+        XCTAssertNil(store.data(for: "old"))
+        XCTAssertEqual(store.record(for: "new")?.data, value(2))
+    }
+
+    func testReopen_dropsPartialRecord() throws {
+        let store = CacheSegmentStore(directory: directory, maxBytes: 10 * 1024 * 1024)
+        store.set(value(1), for: "a", expiration: nil)
+        store.set(value(2), for: "b", expiration: nil)
+        store.waitForWrites()
+
+        let segment = try XCTUnwrap(segmentFiles().first)
+        let handle = try FileHandle(forWritingTo: segment)
+        let size = try handle.seekToEnd()
+        try handle.truncate(atOffset: size - 10)
+        try handle.close()
+
+        let reopened = CacheSegmentStore(directory: directory, maxBytes: 10 * 1024 * 1024)
+
+        XCTAssertEqual(reopened.data(for: "a"), value(1))
+        XCTAssertNil(reopened.data(for: "b"))
+        reopened.set(value(4), for: "c", expiration: nil)
+        reopened.waitForWrites()
+        XCTAssertEqual(CacheSegmentStore(directory: directory, maxBytes: 10 * 1024 * 1024).data(for: "c"), value(4))
+    }
+
+    // MARK: - Compaction
+
+    func testCompaction_evictsOldestUnreadEntries() {
+        let store = CacheSegmentStore(directory: directory, maxBytes: 40_000, segmentBytes: 10_000)
+        for i in 0..<20 {
+            store.set(value(UInt8(i), length: 1_000), for: "key\(i)", expiration: nil)
+        }
+        store.waitForWrites()
+        // Read an early entry so eviction keeps it
+        XCTAssertNotNil(store.data(for: "key0"))
+
+        for i in 20..<60 {
+            store.set(value(UInt8(i), length: 1_000), for: "key\(i)", expiration: nil)
+        }
+        store.waitForWrites()
+
+        XCTAssertLessThanOrEqual(store.totalSize, 40_000)
+        XCTAssertEqual(store.data(for: "key0"), value(0, length: 1_000))
+        XCTAssertNil(store.data(for: "key1"))
+        XCTAssertEqual(store.data(for: "key59"), value(59, length: 1_000))
+    }
+
+    func testCompaction_rewritesStaleSegments() {
+        let store = CacheSegmentStore(directory: directory, maxBytes: 1_000_000, segmentBytes: 10_000)
+        for round in 0..<5 {
+            for i in 0..<10 {
+                store.set(value(UInt8(round), length: 1_000), for: "key\(i)", expiration: nil)
+            }
+        }
+        store.waitForWrites()
+
+        // Only the latest round is current; older segments are rewritten away.
+        XCTAssertLessThan(store.totalSize, 25_000)
+        for i in 0..<10 {
+            XCTAssertEqual(store.data(for: "key\(i)"), value(4, length: 1_000))
+        }
+    }
+
+    func testRemovedEntry_staysRemovedAfterCompaction() {
+        let store = CacheSegmentStore(directory: directory, maxBytes: 1_000_000, segmentBytes: 5_000)
+        store.set(value(1, length: 1_000), for: "removed", expiration: nil)
+        for i in 0..<3 {
+            store.set(value(2, length: 1_000), for: "filler\(i)", expiration: nil)
+        }
+        store.remove("removed")
+        for round in 0..<4 {
+            for i in 0..<4 {
+                store.set(value(UInt8(round), length: 1_000), for: "churn\(i)", expiration: nil)
+            }
+        }
+        store.waitForWrites()
+
+        let reopened = CacheSegmentStore(directory: directory, maxBytes: 1_000_000, segmentBytes: 5_000)
+
+        XCTAssertNil(reopened.data(for: "removed"))
+        XCTAssertEqual(reopened.data(for: "filler2"), value(2, length: 1_000))
+    }
+
+    // MARK: - GeneralCache
+
+    func testGeneralCache_withSegments_persistsValues() {
+        let cacheName = "SegmentTest-\(UUID().uuidString)"
+        let cache = GeneralCache<String, String>(cacheName: cacheName, mode: .diskOnly, diskStorage: .segments(maxBytes: 1_000_000))
+        cache.set("Persisted", for: "key")
+        cache.set("Gone", for: "removed")
+        cache.remove(for: "removed")
+
+        XCTAssertEqual(cache.get(for: "key"), "Persisted")
+        XCTAssertNil(cache.get(for: "removed"))
+
+        cache.clear()
+        XCTAssertNil(cache.get(for: "key"))
+    }
+
+    // MARK: - Benchmark
+
+    private let benchmarkKeys = (0..<10_000).map { "https://covers.example.org/\($0).jpg" }
+    private let benchmarkPayload = Data(repeating: 7, count: 8 * 1024)
+
+    /// Writes 10,000 entries, then reads them back in random order.
+    private func setThenGet(_ diskStorage: CacheDiskStorage) {
+        let cache = GeneralCache<String, Data>(cacheName: "Benchmark-\(UUID().uuidString)", mode: .diskOnly, diskStorage: diskStorage)
+        defer { cache.clear() }
+
+        for key in benchmarkKeys {
+            cache.set(benchmarkPayload, for: key, expiresIn: 3600)
+        }
+        var hits = 0
+        for key in benchmarkKeys.shuffled() where cache.get(for: key) != nil {
+            hits += 1
+        }
+        XCTAssertEqual(hits, benchmarkKeys.count)
+    }
+
+    func testBenchmark_files() {
+        measure {
+            setThenGet(.files)
+        }
+    }
+
+    func testBenchmark_segments() {
+        measure {
+            setThenGet(.segments(maxBytes: 500 * 1024 * 1024))
+        }
+    }
+}
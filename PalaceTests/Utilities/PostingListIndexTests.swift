@@ -0,0 +1,47 @@
+//
+//  PostingListIndexTests.swift
+//  PalaceTests
+//
+//  Copyright © 2026 The Palace Project. All rights reserved.
+//
+
+import XCTest
+@testable import Palace
+
+final class PostingListIndexTests: XCTestCase {
+
+    private let index = PostingListIndex(sections: [
+        ["the cell membrane", "cell wall"],
+        ["mitochondria"],
+        ["membranes of the nucleus"],
+        []
+    ])
+
+    // MARK: - Postings
+
+    func testPostings_listEachSectionOnce() {
+        XCTAssertEqual(index.postings["cell"], [0])
+        XCTAssertEqual(index.postings["the"], [0, 2])
+        XCTAssertEqual(index.sectionCount, 4)
+    }
+
+    func testWords_splitOnNonAlphanumerics() {
+        XCTAssertEqual(PostingListIndex.words(in: "cell-wall, 2 µm"), ["cell", "wall", "2", "µm"])
+    }
+
+    // MARK: - Candidates
+
+    func testCandidates_singleWord_matchesInsideWords() {
+        XCTAssertEqual(index.candidateSections(for: "mbran"), [0, 2])
+        XCTAssertEqual(index.candidateSections(for: "chond"), [1])
+    }
+
+    func testCandidates_phrase_matchesFirstWordSuffixAndLastWordPrefix() {
+        XCTAssertEqual(index.candidateSections(for: "he cell mem"), [0])
+        XCTAssertEqual(index.candidateSections(for: "cell of"), [])
+    }
+
+    func testCandidates_withoutWords_returnsEverySection() {
+        XCTAssertEqual(index.candidateSections(for: " - "), [0, 1, 2, 3])
+    }
+}
@@ -77,6 +77,14 @@ final class CatalogRepositoryMock: CatalogRepositoryProtocol {
         // No-op for mock
     }
 
+    func snapshot(for url: URL) async -> CatalogSnapshot? {
+        nil
+    }
+
+    func saveSnapshot(_ snapshot: CatalogSnapshot, for url: URL) {
+        // No-op for mock
+    }
+
     // MARK: - Test Helpers
 
     func reset() {